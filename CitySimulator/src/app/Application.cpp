@@ -7,6 +7,7 @@
 #include "ui_system/ui_system.h"
 #include "render/render_base.h"
 #include "visualization/scene_system.h"
+#include "simulation/simulation_thread.h"
 
 #include <core/data_layer/world_data.h>
 #include <core/simulation/simulation_system.h>
@@ -16,6 +17,9 @@ namespace tjs {
 		: _commandLine(argc, argv) {
 	}
 
+	Application::~Application() {
+	}
+
 	void Application::load_settings() {
 		_settings.load();
 	}
@@ -31,6 +35,7 @@ namespace tjs {
 		_sceneSystem = std::move(sceneSystem);
 		_worldData = std::move(worldData);
 		_simulationSystem = std::move(simulationSystem);
+		_simulation_thread = std::make_unique<SimulationThread>(*_simulationSystem, _settings.render.targetFPS);
 
 		_frameStats.init(_settings.render.targetFPS);
 	}
@@ -55,23 +60,14 @@ namespace tjs {
 		int currentFPS = 0.0;
 
 		auto lastTimeSaveSettings = lastFrameTime;
-		auto prevFrameStart = lastFrameTime;
+		_simulation_thread->start();
 		while (!isFinished()) {
 			TJS_TRACY_NAMED("MainLoop");
 			// Record the start time of this frame
 			auto frameStart = std::chrono::high_resolution_clock::now();
 
-			// Calculate time elapsed since last simulation update for simulation calculations
-			const double durationInSeconds = std::chrono::duration_cast<std::chrono::duration<double>>(
-				frameStart - prevFrameStart)
-												 .count();
-			_simulationSystem->update(durationInSeconds);
-			auto simulation_end = std::chrono::high_resolution_clock::now();
-
-			prevFrameStart = frameStart;
-
-			_frameStats.simulation_update().update(
-				std::chrono::duration_cast<std::chrono::duration<double>>(simulation_end - frameStart).count());
+			// Simulation steps on its own thread, the frame only reads its snapshots
+			_frameStats.simulation_update().update(_simulation_thread->last_update_time());
 
 			// Run the update and draw operations
 			_uiSystem->update();
@@ -80,7 +76,7 @@ namespace tjs {
 
 			auto systems_end = std::chrono::high_resolution_clock::now();
 			_frameStats.systems_update().update(
-				std::chrono::duration_cast<std::chrono::duration<double>>(systems_end - simulation_end).count());
+				std::chrono::duration_cast<std::chrono::duration<double>>(systems_end - frameStart).count());
 
 			// Rendering
 			_renderer->begin_frame();
@@ -123,6 +119,8 @@ namespace tjs {
 			}
 		}
 
+		_simulation_thread->stop();
+
 		// Save settings before quit
 		_settings.save();
 
@@ -11,6 +11,7 @@ namespace tjs {
 
 	class UISystem;
 	class IRenderer;
+	class SimulationThread;
 
 	namespace visualization {
 		class SceneSystem;
@@ -100,6 +101,7 @@ namespace tjs {
 	class Application {
 	public:
 		Application(int& argc, char** argv);
+		~Application();
 
 		void setFinished() {
 			_isFinished = true;
@@ -153,6 +155,10 @@ namespace tjs {
 			return *_simulationSystem;
 		}
 
+		SimulationThread& simulation_thread() {
+			return *_simulation_thread;
+		}
+
 		core::model::DataModelStore& stores() {
 			return _models_store;
 		}
@@ -182,6 +188,7 @@ namespace tjs {
 		std::unique_ptr<visualization::SceneSystem> _sceneSystem;
 		std::unique_ptr<core::WorldData> _worldData;
 		std::unique_ptr<core::simulation::TrafficSimulationSystem> _simulationSystem;
+		std::unique_ptr<SimulationThread> _simulation_thread;
 
 		LogicHandler _logic_modules;
 	};
@@ -1,13 +1,13 @@
 #pragma once
 
 #include <common/message_dispatcher/Event.h>
-#include <core/simulation/agent/agent_data.h>
 
 namespace tjs::events {
+	// Agents live on the simulation thread, so the selection is passed by id
 	struct AgentSelected : common::Event {
-		core::AgentData* agent;
+		uint64_t agent_id; // 0 if selection was cleared
 
-		AgentSelected(core::AgentData* agent)
-			: agent(agent) {}
+		AgentSelected(uint64_t agent_id)
+			: agent_id(agent_id) {}
 	};
 } // namespace tjs::events
@@ -10,22 +10,23 @@
 
 namespace tjs::app::logic {
 
-	static float point_segment_distance(const Position& p, const Position& a, const Position& b) {
-		float dx = static_cast<float>(b.x - a.x);
-		float dy = static_cast<float>(b.y - a.y);
-		float l2 = dx * dx + dy * dy;
-		if (l2 == 0.0f) {
-			float dxp = static_cast<float>(p.x - a.x);
-			float dyp = static_cast<float>(p.y - a.y);
-			return std::sqrt(dxp * dxp + dyp * dyp);
+	static double point_segment_distance(const core::Coordinates& p, const core::Coordinates& a, const core::Coordinates& b) {
+		const double dx = b.x - a.x;
+		const double dy = b.y - a.y;
+		const double l2 = dx * dx + dy * dy;
+		if (l2 == 0.0) {
+			return std::hypot(p.x - a.x, p.y - a.y);
 		}
-		float t = ((p.x - a.x) * dx + (p.y - a.y) * dy) / l2;
-		t = std::clamp(t, 0.0f, 1.0f);
-		float projx = a.x + t * dx;
-		float projy = a.y + t * dy;
-		float dxp = static_cast<float>(p.x - projx);
-		float dyp = static_cast<float>(p.y - projy);
-		return std::sqrt(dxp * dxp + dyp * dyp);
+		const double t = std::clamp(((p.x - a.x) * dx + (p.y - a.y) * dy) / l2, 0.0, 1.0);
+		return std::hypot(p.x - (a.x + t * dx), p.y - (a.y + t * dy));
+	}
+
+	static double nearest_distance(const core::Coordinates& p, const core::Lane& lane) {
+		double best = std::numeric_limits<double>::max();
+		for (size_t i = 0; i + 1 < lane.centerLine.size(); ++i) {
+			best = std::min(best, point_segment_distance(p, lane.centerLine[i], lane.centerLine[i + 1]));
+		}
+		return best;
 	}
 
 	LanesSelector::LanesSelector(Application& app)
@@ -63,41 +64,17 @@ namespace tjs::app::logic {
 			return;
 		}
 
-		Position click { event.x, event.y };
-		core::Lane* nearestLane = nullptr;
-		float bestDist = _maxDistance / render_data->metersPerPixel;
-
-		for (const core::Edge& edge : segment.road_network->edges) {
-			for (const core::Lane& lane : edge.lanes) {
-				if (lane.centerLine.size() < 2) {
-					continue;
-				}
-				for (size_t i = 0; i + 1 < lane.centerLine.size(); ++i) {
-					Position a = visualization::convert_to_screen(
-						lane.centerLine[i], render_data->screen_center, render_data->metersPerPixel);
-					Position b = visualization::convert_to_screen(
-						lane.centerLine[i + 1], render_data->screen_center, render_data->metersPerPixel);
-					float dist = point_segment_distance(click, a, b);
-					if (dist < bestDist) {
-						bestDist = dist;
-						nearestLane = const_cast<core::Lane*>(&lane);
-					}
-				}
-			}
+		// a node wins over a lane passing at the same distance
+		const core::Coordinates click = visualization::convert_from_screen({ event.x, event.y }, render_data->screen_center, render_data->metersPerPixel);
+		core::Lane* nearestLane = core::find_nearest_lane(segment.spatialGrid, click, _maxDistance);
+		double bestDist = _maxDistance;
+		if (nearestLane) {
+			bestDist = nearest_distance(click, *nearestLane);
 		}
 
-		core::Node* nearest_node = nullptr;
-		for (auto& n : segment.road_network->nodes) {
-			Position p = visualization::convert_to_screen(n.second->coordinates, render_data->screen_center, render_data->metersPerPixel);
-
-			float dx = static_cast<float>(p.x - event.x);
-			float dy = static_cast<float>(p.y - event.y);
-			float dist = std::sqrt(dx * dx + dy * dy);
-			if (dist < bestDist) {
-				bestDist = dist;
-				nearestLane = nullptr;
-				nearest_node = n.second;
-			}
+		core::Node* nearest_node = core::find_nearest_node(segment.spatialGrid, click, bestDist);
+		if (nearest_node) {
+			nearestLane = nullptr;
 		}
 
 		debug_data->selectedNode = nearest_node;
@@ -49,24 +49,9 @@ namespace tjs::app::logic {
 		if (_application.worldData().segments().empty()) {
 			return;
 		}
-		auto& ways = _application.worldData().segments().front()->ways;
-
-		core::Node* nearest = nullptr;
-		const double squared_max_dist = _maxDistance * _maxDistance;
-		float best_dist = squared_max_dist;
-
-		for (auto& way_pair : ways) {
-			for (auto node : way_pair.second->nodes) {
-				FPoint node_point = visualization::convert_to_screen_f(node->coordinates, render->screen_center, render->metersPerPixel);
-				float dx = static_cast<float>(node_point.x - event.x);
-				float dy = static_cast<float>(node_point.y - event.y);
-				float squared_dist = dx * dx + dy * dy;
-				if (squared_dist < best_dist) {
-					best_dist = squared_dist;
-					nearest = node;
-				}
-			}
-		}
+		const auto& grid = _application.worldData().segments().front()->spatialGrid;
+		const core::Coordinates click = visualization::convert_from_screen({ event.x, event.y }, render->screen_center, render->metersPerPixel);
+		core::Node* nearest = core::find_nearest_node(grid, click, _maxDistance * render->metersPerPixel);
 
 		debug->selectedNode = nearest;
 		update_map_positioning();
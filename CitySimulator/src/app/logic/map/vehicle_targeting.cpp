@@ -9,7 +9,8 @@
 #include <core/store_models/vehicle_analyze_data.h>
 #include <core/simulation/agent/agent_data.h>
 #include <core/simulation/simulation_system.h>
-#include <core/simulation/transport_management/vehicle_system.h>
+#include <core/simulation/simulation_snapshot.h>
+#include <simulation/simulation_thread.h>
 #include <events/vehicle_events.h>
 
 namespace tjs::app::logic {
@@ -37,42 +38,50 @@ namespace tjs::app::logic {
 			return;
 		}
 
-		if (_application.simulationSystem().vehicle_system().vehicles().empty()) {
-			return;
-		}
-		auto& vehicles = _application.simulationSystem().vehicle_system().vehicles();
+		// pick on what is drawn, i.e. the published snapshot
+		std::optional<uint64_t> nearest_agent;
+		{
+			const auto snapshot = _application.simulation_thread().snapshot();
+			const auto& vehicles = snapshot->vehicles;
+			if (vehicles.size() == 0) {
+				return;
+			}
 
-		core::Vehicle* nearest = nullptr;
-		float best_dist = _maxDistance;
-		for (auto& info : vehicles) {
-			FPoint node_point = visualization::convert_to_screen_f(info->coordinates, render->screen_center, render->metersPerPixel);
-			float dx = static_cast<float>(node_point.x - event.x);
-			float dy = static_cast<float>(node_point.y - event.y);
-			float dist = dx * dx + dy * dy;
-			float scaler = _application.settings().render.vehicleScaler == 0 ? 1 : _application.settings().render.vehicleScaler;
-			float scaled_dist = dist / scaler;
-			if (scaled_dist < best_dist) {
-				best_dist = dist;
-				nearest = info;
+			float best_dist = _maxDistance;
+			for (size_t i = 0; i < vehicles.size(); ++i) {
+				FPoint node_point = visualization::convert_to_screen_f(vehicles.coordinates[i], render->screen_center, render->metersPerPixel);
+				float dx = static_cast<float>(node_point.x - event.x);
+				float dy = static_cast<float>(node_point.y - event.y);
+				float dist = dx * dx + dy * dy;
+				float scaler = _application.settings().render.vehicleScaler == 0 ? 1 : _application.settings().render.vehicleScaler;
+				float scaled_dist = dist / scaler;
+				if (scaled_dist < best_dist) {
+					best_dist = dist;
+					nearest_agent = vehicles.agent_id[i];
+				}
 			}
 		}
 
-		if (!nearest) {
-			model->agent = nullptr;
-			return;
-		}
+		uint64_t selected = 0;
+		{
+			auto lock = _application.simulation_thread().lock();
+			if (!nearest_agent.has_value()) {
+				model->agent.reset();
+				return;
+			}
 
-		auto& agents = _application.simulationSystem().agents();
-		core::AgentData* agent = nullptr;
-		for (auto a : agents) {
-			if (a->vehicle == nearest) {
-				agent = a;
-				break;
+			core::AgentData* agent = nullptr;
+			for (auto a : _application.simulationSystem().agents()) {
+				if (a->id == *nearest_agent) {
+					agent = a;
+					break;
+				}
 			}
+			model->agent = agent ? agent->handle : core::AgentHandle {};
+			selected = agent ? agent->id : 0;
 		}
 
-		model->agent = agent;
 		_application.message_dispatcher().handle_message(
-			events::AgentSelected { agent }, "map");
+			events::AgentSelected { selected }, "map");
 	}
 } // namespace tjs::app::logic
@@ -10,16 +10,23 @@
 #include <core/data_layer/world_creator.h>
 
 #include <core/simulation/simulation_system.h>
+#include <simulation/simulation_thread.h>
 
 namespace tjs {
 	bool open_map_simulation_reinit(std::string_view fileName, Application& application) {
-		if (tjs::core::WorldCreator::loadOSMData(application.worldData(), fileName)) {
+		// loading rebuilds the world the simulation steps on
+		auto lock = application.simulation_thread().lock();
+		tjs::core::MapLoadOptions options;
+		options.use_cache = application.settings().general.use_map_cache;
+		options.dispatcher = &application.message_dispatcher();
+		if (tjs::core::WorldCreator::loadOSMData(application.worldData(), fileName, options)) {
 			application.settings().general.selectedFile = fileName;
 
 			application.simulationSystem().initialize();
 
 			application.stores().reinit();
 			application.logic_modules().reinit();
+			lock.unlock();
 
 			application.message_dispatcher().handle_message(events::OpenMapEvent {}, "project");
 			return true;
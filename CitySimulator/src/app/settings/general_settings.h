@@ -12,6 +12,8 @@ namespace tjs::settings {
 		double zoomLevel;
 		tjs::Rectangle qt_window { 0, 0, 700, 800 };
 		tjs::Rectangle sdl_window { 0, 0, 1024, 768 };
+		// Restore maps from <map>.tjcache instead of parsing them on every open
+		bool use_map_cache = true;
 
 		static constexpr const char* NAME = "General";
 		NLOHMANN_DEFINE_TYPE_INTRUSIVE(GeneralSettings,
@@ -19,6 +21,7 @@ namespace tjs::settings {
 			screen_center,
 			zoomLevel,
 			qt_window,
-			sdl_window)
+			sdl_window,
+			use_map_cache)
 	};
 } // namespace tjs::settings
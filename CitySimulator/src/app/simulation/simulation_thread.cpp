@@ -0,0 +1,84 @@
+#include <stdafx.h>
+
+#include <simulation/simulation_thread.h>
+
+#include <core/simulation/simulation_system.h>
+
+namespace tjs {
+	SimulationThread::SimulationThread(core::simulation::TrafficSimulationSystem& system, float updates_per_sec)
+		: _system(system)
+		, _period(1.0 / std::max(1.0f, updates_per_sec)) {
+	}
+
+	SimulationThread::~SimulationThread() {
+		stop();
+	}
+
+	void SimulationThread::start() {
+		if (is_running()) {
+			return;
+		}
+		_stop = false;
+		_thread = std::thread(&SimulationThread::run, this);
+	}
+
+	void SimulationThread::stop() {
+		if (!is_running()) {
+			return;
+		}
+		_stop = true;
+		_thread.join();
+	}
+
+	std::unique_lock<std::mutex> SimulationThread::lock() {
+		++_waiting;
+		std::unique_lock lock(_mutex);
+		if (--_waiting == 0) {
+			_idle.notify_one();
+		}
+		return lock;
+	}
+
+	void SimulationThread::defer(std::function<void()> fn) {
+		_deferred.push_back(std::move(fn));
+	}
+
+	void SimulationThread::run() {
+		using clock = std::chrono::steady_clock;
+
+		auto prev_start = clock::now();
+		while (!_stop) {
+			const auto start = clock::now();
+			update(std::chrono::duration<double>(start - prev_start).count());
+			prev_start = start;
+
+			const auto end = clock::now();
+			_last_update_time.store(std::chrono::duration<double>(end - start).count(), std::memory_order_relaxed);
+
+			const auto next = start + std::chrono::duration_cast<clock::duration>(_period);
+			if (end < next) {
+				std::this_thread::sleep_until(next);
+			}
+		}
+	}
+
+	void SimulationThread::update(double dt) {
+		TJS_TRACY_NAMED("SimulationThread_Update");
+
+		std::vector<std::function<void()>> deferred;
+		{
+			// std::mutex is not fair: without the wait a simulation slower than
+			// the period would re-lock right away and starve UI commands
+			std::unique_lock lock(_mutex);
+			_idle.wait(lock, [this] { return _waiting.load() == 0; });
+			_system.update(dt);
+			core::simulation::capture_snapshot(_system, _snapshots.back());
+			deferred.swap(_deferred);
+		}
+		_snapshots.publish();
+
+		for (auto& fn : deferred) {
+			fn();
+		}
+	}
+} // namespace tjs
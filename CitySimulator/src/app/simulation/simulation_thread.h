@@ -0,0 +1,81 @@
+#pragma once
+
+#include <core/simulation/simulation_snapshot.h>
+
+#include <condition_variable>
+#include <mutex>
+
+namespace tjs::core::simulation {
+	class TrafficSimulationSystem;
+} // namespace tjs::core::simulation
+
+namespace tjs {
+	// Steps TrafficSimulationSystem on a dedicated thread and publishes a
+	// SimulationSnapshot after every update.
+	//
+	// The UI thread only reads snapshots. Anything that has to touch the live
+	// simulation (pause, single step, regenerate, map reload, agent selection)
+	// must hold lock() while doing so.
+	class SimulationThread {
+	public:
+		using SnapshotGuard = core::simulation::SnapshotBuffer::ReadGuard;
+
+	public:
+		// `updates_per_sec` paces TrafficSimulationSystem::update the same way the
+		// render loop did; an update that takes longer is followed by the next one
+		// immediately.
+		SimulationThread(core::simulation::TrafficSimulationSystem& system, float updates_per_sec);
+		~SimulationThread();
+
+		SimulationThread(const SimulationThread&) = delete;
+		SimulationThread& operator=(const SimulationThread&) = delete;
+
+		void start();
+		void stop();
+
+		bool is_running() const {
+			return _thread.joinable();
+		}
+
+		// Exclusive access to the live simulation
+		std::unique_lock<std::mutex> lock();
+
+		SnapshotGuard snapshot() const {
+			return _snapshots.read();
+		}
+
+		// Runs `fn` on the simulation thread right after the next snapshot is
+		// published, so it observes the effect of the current step. Meant for
+		// simulation event handlers; the caller must hold the simulation, which
+		// is always true inside them.
+		void defer(std::function<void()> fn);
+
+		// Wall time of the last update including snapshot capture [s]
+		double last_update_time() const {
+			return _last_update_time.load(std::memory_order_relaxed);
+		}
+
+	private:
+		void run();
+		void update(double dt);
+
+	private:
+		core::simulation::TrafficSimulationSystem& _system;
+		const std::chrono::duration<double> _period;
+
+		core::simulation::SnapshotBuffer _snapshots;
+
+		std::thread _thread;
+		std::atomic<bool> _stop { false };
+		std::atomic<double> _last_update_time { 0.0 };
+
+		// guards the simulation; an update waits on _idle until no UI command
+		// is _waiting for it
+		std::mutex _mutex;
+		std::condition_variable _idle;
+		std::atomic<int> _waiting { 0 };
+
+		// filled under _mutex
+		std::vector<std::function<void()>> _deferred;
+	};
+} // namespace tjs
@@ -2,9 +2,8 @@
 #include "Application.h"
 #include "data/map_renderer_data.h"
 
-#include <core/simulation/simulation_system.h>
-#include <core/simulation/transport_management/vehicle_system.h>
-#include <core/data_layer/vehicle.h>
+#include <core/simulation/simulation_snapshot.h>
+#include <simulation/simulation_thread.h>
 
 #include <core/data_layer/world_data.h>
 #include <core/data_layer/enums.h>
@@ -158,21 +157,36 @@ namespace tjs::ui {
 		}
 
 		QStringList vehicle_info;
-		const auto& lanes = _application.simulationSystem().vehicle_system().lane_runtime();
-		const auto& rt_lane = lanes[lane->index_in_buffer];
-		vehicle_info.reserve(rt_lane.idx.size());
-		for (core::Vehicle* vehicle : rt_lane.idx) {
-			QString vehicleStr;
-			vehicleStr.reserve(50); // Reserve approximate needed size
-			vehicleStr = QString::number(vehicle->uid) + ": " + QString::number(vehicle->s_on_lane);
-			if (vehicle->lane_target != nullptr) {
-				if (vehicle->current_lane == lane) {
-					vehicleStr += " (to: " + QString::number(vehicle->lane_target->get_id()) + "; " + QString::number(vehicle->state) + ")";
-				} else {
-					vehicleStr += " (from: " + QString::number(vehicle->current_lane->get_id()) + "; " + QString::number(vehicle->state) + ")";
+		{
+			const auto snapshot = _application.simulation_thread().snapshot();
+			const auto& vehicles = snapshot->vehicles;
+			const int lane_id = lane->get_id();
+
+			// vehicles on the lane and those merging into it, front first as in LaneRuntime::idx
+			std::vector<size_t> on_lane;
+			for (size_t i = 0; i < vehicles.size(); ++i) {
+				if (vehicles.lane_id[i] == lane_id || vehicles.target_id[i] == lane_id) {
+					on_lane.push_back(i);
 				}
 			}
-			vehicle_info << vehicleStr;
+			std::ranges::sort(on_lane, [&vehicles](size_t a, size_t b) {
+				return vehicles.s_on_lane[a] > vehicles.s_on_lane[b];
+			});
+
+			vehicle_info.reserve(on_lane.size());
+			for (size_t i : on_lane) {
+				QString vehicleStr;
+				vehicleStr.reserve(50); // Reserve approximate needed size
+				vehicleStr = QString::number(vehicles.uid[i]) + ": " + QString::number(vehicles.s_on_lane[i]);
+				if (vehicles.target_id[i] != -1) {
+					if (vehicles.lane_id[i] == lane_id) {
+						vehicleStr += " (to: " + QString::number(vehicles.target_id[i]) + "; " + QString::number(vehicles.state[i]) + ")";
+					} else {
+						vehicleStr += " (from: " + QString::number(vehicles.lane_id[i]) + "; " + QString::number(vehicles.state[i]) + ")";
+					}
+				}
+				vehicle_info << vehicleStr;
+			}
 		}
 
 		QString text = QString("Lane %1\nWidth: %2\nTurn: %3\nOutgoing: %4\nIncoming: %5\nVehicles: %6")
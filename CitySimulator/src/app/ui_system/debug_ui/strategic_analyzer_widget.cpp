@@ -4,8 +4,8 @@
 #include <QVBoxLayout>
 #include <QTimer>
 
-#include <core/simulation/simulation_system.h>
-#include <core/simulation/agent/agent_data.h>
+#include <core/simulation/simulation_snapshot.h>
+#include <simulation/simulation_thread.h>
 
 namespace tjs::ui {
 
@@ -23,11 +23,12 @@ namespace tjs::ui {
 
 	void StrategicAnalyzerWidget::updateInfo() {
 		_list->clear();
-		const auto& agents = _application.simulationSystem().agents();
+		const auto snapshot = _application.simulation_thread().snapshot();
+		const auto& agents = snapshot->agents;
 		for (size_t i = 0; i < agents.size(); ++i) {
 			const auto& agent = agents[i];
-			if (agent->stucked) {
-				_list->addItem(QString("[%1] Agent %2").arg(i).arg(agent->id));
+			if (agent.stucked) {
+				_list->addItem(QString("[%1] Agent %2").arg(i).arg(agent.id));
 			}
 		}
 	}
@@ -6,12 +6,15 @@
 #include <QtWidgets/QFormLayout>
 #include <QtWidgets/QLabel>
 #include <QtWidgets/QListWidget>
+#include <QTimer>
 
 #include <Application.h>
 #include <core/store_models/vehicle_analyze_data.h>
 #include <core/simulation/agent/agent_data.h>
 #include <core/simulation/simulation_system.h>
 #include <core/simulation/simulation_debug.h>
+#include <core/simulation/simulation_snapshot.h>
+#include <simulation/simulation_thread.h>
 #include <events/vehicle_events.h>
 
 namespace tjs::ui {
@@ -37,34 +40,43 @@ namespace tjs::ui {
 		_application.message_dispatcher().unregister_handler<events::OpenMapEvent>("VehicleAnalyzeWidget");
 	}
 
+	// Simulation events are raised while the simulation is held, possibly on its
+	// thread: both handlers only schedule a refresh from the next snapshot.
 	void VehicleAnalyzeWidget::handle_simulation_initialized(const core::events::SimulationInitialized& event) {
-		_application.stores().get_entry<core::model::VehicleAnalyzeData>()->agent = nullptr;
-		initialize();
+		_application.stores().get_entry<core::model::VehicleAnalyzeData>()->agent.reset();
+		schedule_refresh();
 	}
 
 	void VehicleAnalyzeWidget::handle_population(const core::events::VehiclesPopulated& event) {
-		auto prev_agent = _application.stores().get_entry<core::model::VehicleAnalyzeData>()->agent;
+		schedule_refresh();
+	}
 
-		initialize();
+	void VehicleAnalyzeWidget::schedule_refresh() {
+		_application.simulation_thread().defer([this]() {
+			QMetaObject::invokeMethod(this, [this]() { initialize(); }, Qt::QueuedConnection);
+		});
 	}
 
 	void VehicleAnalyzeWidget::handle_open_map(const events::OpenMapEvent& event) {
-		_application.stores().get_entry<core::model::VehicleAnalyzeData>()->agent = nullptr;
+		{
+			auto lock = _application.simulation_thread().lock();
+			_application.stores().get_entry<core::model::VehicleAnalyzeData>()->agent.reset();
+		}
+		_selected_agent = 0;
 		initialize();
 	}
 
 	void VehicleAnalyzeWidget::handle_agent_selected(const events::AgentSelected& event) {
-		core::model::VehicleAnalyzeData* model = _application.stores().get_entry<core::model::VehicleAnalyzeData>();
-		model->set_agent(event.agent);
-		if (event.agent) {
+		select_agent(event.agent_id);
+		if (_selected_agent != 0) {
 			// Update combo box to selected agent
 			for (int i = 0; i < _agentComboBox->count(); ++i) {
-				if (_agentComboBox->itemData(i).value<uint64_t>() == event.agent->id) {
+				if (_agentComboBox->itemData(i).value<uint64_t>() == _selected_agent) {
 					_agentComboBox->setCurrentIndex(i);
 					break;
 				}
 			}
-			updateAgentDetails(event.agent);
+			updateAgentDetails();
 			_detailsGroup->setVisible(true);
 		} else {
 			_agentComboBox->setCurrentIndex(0);
@@ -72,17 +84,36 @@ namespace tjs::ui {
 		}
 	}
 
+	void VehicleAnalyzeWidget::select_agent(uint64_t agent_id) {
+		// the simulation reads the tracked agent, so it is switched under its lock
+		auto lock = _application.simulation_thread().lock();
+		core::model::VehicleAnalyzeData* model = _application.stores().get_entry<core::model::VehicleAnalyzeData>();
+
+		core::AgentData* agent = nullptr;
+		if (agent_id != 0) {
+			const auto& agents = _application.simulationSystem().agents();
+			auto it = std::find_if(agents.begin(), agents.end(),
+				[agent_id](const core::AgentData* a) { return a->id == agent_id; });
+			if (it != agents.end()) {
+				agent = *it;
+			}
+		}
+
+		model->set_agent(agent ? agent->handle : core::AgentHandle {});
+		_selected_agent = agent ? agent->id : 0;
+	}
+
 	void VehicleAnalyzeWidget::initialize() {
-		auto& simulation_system = _application.simulationSystem();
-		const auto& agents = simulation_system.agents();
+		const auto snapshot = _application.simulation_thread().snapshot();
+		const auto& agents = snapshot->agents;
 
-		auto setupAgentCombo = [this, &agents](core::AgentData* prev_agent = nullptr) {
+		auto setupAgentCombo = [this, &agents](uint64_t prev_agent = 0) {
 			_agentComboBox->addItem("-- None --", QVariant::fromValue<uint64_t>(0));
 
 			std::optional<size_t> idx {};
 			for (size_t i = 0; i < agents.size(); ++i) {
-				const core::AgentData& agent = *agents[i];
-				if (&agent == prev_agent) {
+				const auto& agent = agents[i];
+				if (prev_agent != 0 && agent.id == prev_agent) {
 					idx = i;
 				}
 				_agentComboBox->addItem(
@@ -99,9 +130,10 @@ namespace tjs::ui {
 		};
 
 		if (_agentComboBox != nullptr) {
-			auto prev_agent = _application.stores().get_entry<core::model::VehicleAnalyzeData>()->agent;
+			// keep the selection signal quiet, it would re-select the agent
+			const QSignalBlocker blocker(_agentComboBox);
 			_agentComboBox->clear();
-			setupAgentCombo(prev_agent);
+			setupAgentCombo(snapshot->tracked ? snapshot->tracked->id : 0);
 			return;
 		}
 
@@ -199,6 +231,7 @@ namespace tjs::ui {
 			this, &VehicleAnalyzeWidget::handleAgentSelection);
 
 		auto updateVehicles = [this]() {
+			auto lock = _application.simulation_thread().lock();
 			auto& vec = _application.settings().simulationSettings.debug_data.vehicle_indices;
 			vec.clear();
 			for (int i = 0; i < _vehicleList->count(); ++i) {
@@ -234,47 +267,51 @@ namespace tjs::ui {
 			_application.settings().simulationSettings.debug_data.movement_phase = static_cast<core::simulation::SimulationMovementPhase>(index);
 		});
 
+		// details follow the simulation
+		QTimer* timer = new QTimer(this);
+		connect(timer, &QTimer::timeout, this, [this]() {
+			if (_detailsGroup->isVisible()) {
+				updateAgentDetails();
+			}
+		});
+		timer->start(500);
+
 		setLayout(mainLayout);
 	}
 
 	void VehicleAnalyzeWidget::handleAgentSelection(int index) {
-		core::model::VehicleAnalyzeData* model = _application.stores().get_entry<core::model::VehicleAnalyzeData>();
-
 		if (index <= 0) { // "-- None --" selected
-			model->set_agent(nullptr);
+			select_agent(0);
 			_detailsGroup->setVisible(false);
 			return;
 		}
 
-		uint64_t agentId = _agentComboBox->currentData().value<uint64_t>();
-		auto& agents = _application.simulationSystem().agents();
-
-		auto it = std::find_if(agents.begin(), agents.end(),
-			[agentId](const core::AgentData* a) { return a->id == agentId; });
-
-		if (it != agents.end()) {
-			model->set_agent(*it);
-			updateAgentDetails(*it);
+		select_agent(_agentComboBox->currentData().value<uint64_t>());
+		if (_selected_agent != 0) {
+			updateAgentDetails();
 			_detailsGroup->setVisible(true);
 		}
 	}
 
-	void VehicleAnalyzeWidget::updateAgentDetails(const core::AgentData* agent) {
-		if (!agent) {
+	void VehicleAnalyzeWidget::updateAgentDetails() {
+		const auto snapshot = _application.simulation_thread().snapshot();
+		_agentIdValue->setText(QString::number(_selected_agent));
+
+		// the snapshot catches up with a new selection after the next simulation update
+		if (!snapshot->tracked.has_value() || snapshot->tracked->id != _selected_agent) {
 			return;
 		}
+		const auto& agent = *snapshot->tracked;
 
-		_agentIdValue->setText(QString::number(agent->id));
-
-		if (agent->vehicle) {
-			_vehicleIdValue->setText(QString::number(agent->vehicle->uid));
+		if (agent.has_vehicle) {
+			_vehicleIdValue->setText(QString::number(agent.vehicle_uid));
 		} else {
 			_vehicleIdValue->setText("N/A");
 		}
 
 		// Convert behaviour to string
 		QString behaviourStr;
-		switch (agent->behaviour) {
+		switch (agent.behaviour) {
 			case core::TacticalBehaviour::Normal:
 				behaviourStr = "Normal";
 				break;
@@ -292,27 +329,36 @@ namespace tjs::ui {
 		}
 		_behaviourValue->setText(behaviourStr);
 
-		_currentGoalValue->setText(agent->currentGoal ?
-									   QString::number(agent->currentGoal->uid) :
+		_currentGoalValue->setText(agent.has_goal ?
+									   QString::number(agent.goal_uid) :
 									   "None");
 
-		if (agent->currentGoal) {
-			auto& coordinates = agent->currentGoal->coordinates;
+		if (agent.has_goal) {
+			auto& coordinates = agent.goal;
 			_currentStepGoalValue->setText(
 				QString("(%1, %2)").arg(coordinates.latitude).arg(coordinates.longitude));
 		}
 
-		_pathNodeCountValue->setText(QString::number(agent->path.size()));
+		_pathNodeCountValue->setText(QString::number(agent.path.size()));
+
+		// rebuilding on every refresh would collapse the tree under the user
+		std::vector<uint64_t> path_nodes;
+		path_nodes.reserve(agent.path.size());
+		for (const auto& edge : agent.path) {
+			path_nodes.push_back(edge.end_node_uid);
+		}
+		if (path_nodes == _shown_path) {
+			return;
+		}
+		_shown_path = std::move(path_nodes);
+
 		_pathTreeWidget->clear();
 		QTreeWidgetItem* rootItem = new QTreeWidgetItem(_pathTreeWidget);
 		rootItem->setText(0, "Path Nodes");
 		rootItem->setExpanded(false);
-		for (const core::Edge* edge : agent->path) {
-			if (!edge || !edge->end_node) {
-				continue;
-			}
+		for (uint64_t node_uid : _shown_path) {
 			QTreeWidgetItem* item = new QTreeWidgetItem();
-			item->setText(0, QString::number(edge->end_node->uid));
+			item->setText(0, QString::number(node_uid));
 			rootItem->addChild(item);
 		}
 	}
@@ -29,7 +29,9 @@ namespace tjs {
 			void handleAgentSelection(int index);
 
 		private:
-			void updateAgentDetails(const tjs::core::AgentData* agent);
+			void updateAgentDetails();
+			void schedule_refresh();
+			void select_agent(uint64_t agent_id);
 
 			void handle_simulation_initialized(const core::events::SimulationInitialized& event);
 			void handle_population(const core::events::VehiclesPopulated& event);
@@ -38,6 +40,9 @@ namespace tjs {
 
 			Application& _application;
 			tjs::model::VehicleAnalyzeData* _model;
+			// agent shown in details, 0 if none
+			uint64_t _selected_agent = 0;
+			std::vector<uint64_t> _shown_path;
 
 			// UI elements
 			QComboBox* _agentComboBox;
@@ -25,6 +25,7 @@
 #include <core/simulation/simulation_settings.h>
 #include <core/simulation/agent/agent_data.h>
 #include <core/store_models/vehicle_analyze_data.h>
+#include <simulation/simulation_thread.h>
 
 namespace tjs {
 	namespace ui {
@@ -202,6 +203,17 @@ namespace tjs {
 			algoLayout->addWidget(_movementAlgoCombo);
 			mainLayout->addLayout(algoLayout);
 
+			QHBoxLayout* routingLayout = new QHBoxLayout();
+			QLabel* routingLabel = new QLabel("Routing Algo:", this);
+			_routingAlgoCombo = new QComboBox(this);
+			_routingAlgoCombo->addItem("A*", static_cast<int>(core::RoutingAlgoType::AStar));
+			_routingAlgoCombo->addItem("A* with landmarks (ALT)", static_cast<int>(core::RoutingAlgoType::Landmarks));
+			_routingAlgoCombo->addItem("Bidirectional A*", static_cast<int>(core::RoutingAlgoType::Bidirectional));
+			_routingAlgoCombo->setCurrentIndex(static_cast<int>(_application.settings().simulationSettings.routing_algo));
+			routingLayout->addWidget(routingLabel);
+			routingLayout->addWidget(_routingAlgoCombo);
+			mainLayout->addLayout(routingLayout);
+
 			_regenerateVehiclesButton = new QPushButton("Regenerate vehicles", this);
 			mainLayout->addWidget(_regenerateVehiclesButton);
 
@@ -231,7 +243,11 @@ namespace tjs {
 
 			connect(_add_spawn_button, &QPushButton::clicked, [this]() {
 				auto& spawns = _application.settings().simulationSettings.spawn_requests;
-				spawns.push_back({});
+				{
+					// the flow generator iterates them during a step
+					auto lock = _application.simulation_thread().lock();
+					spawns.push_back({});
+				}
 				add_spawn_row(spawns.back());
 			});
 
@@ -261,8 +277,19 @@ namespace tjs {
 						static_cast<core::MovementAlgoType>(index);
 				});
 
+			// takes effect on the next regenerate, which builds the landmarks
+			connect(_routingAlgoCombo,
+				QOverload<int>::of(&QComboBox::currentIndexChanged),
+				[this](int index) {
+					_application.settings().simulationSettings.routing_algo =
+						static_cast<core::RoutingAlgoType>(index);
+				});
+
 			connect(_regenerateVehiclesButton, &QPushButton::clicked, [this]() {
-				_application.simulationSystem().initialize();
+				{
+					auto lock = _application.simulation_thread().lock();
+					_application.simulationSystem().initialize();
+				}
 				if (_populationLabel) {
 					_populationLabel->clear();
 				}
@@ -499,6 +526,11 @@ namespace tjs {
 		}
 
 		void MapControlWidget::handle_population(const core::events::VehiclesPopulated& event) {
+			// raised on the simulation thread
+			QMetaObject::invokeMethod(this, [this, event]() { show_population(event); }, Qt::QueuedConnection);
+		}
+
+		void MapControlWidget::show_population(const core::events::VehiclesPopulated& event) {
 			if (!_populationLabel) {
 				return;
 			}
@@ -511,7 +543,7 @@ namespace tjs {
 				return;
 			}
 
-			const auto generator_type = _application.simulationSystem().settings().generator_type;
+			const auto generator_type = _application.settings().simulationSettings.generator_type;
 			if (generator_type == core::simulation::GeneratorType::Bulk && event.current >= event.total) {
 				_populationLabel->setText(
 					QString("Generated %1 for %2 ticks")
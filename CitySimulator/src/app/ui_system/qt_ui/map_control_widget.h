@@ -42,6 +42,7 @@ namespace tjs {
 			void createVehicleInformation(QVBoxLayout* layout);
 			void createLayerSelection(QVBoxLayout* layout);
 			void handle_population(const core::events::VehiclesPopulated& event);
+			void show_population(const core::events::VehiclesPopulated& event);
 
 		private slots:
 			void onUpdate();
@@ -69,6 +70,7 @@ namespace tjs {
 			QCheckBox* randomSeed = nullptr;
 			QSpinBox* seedValue = nullptr;
 			QComboBox* _movementAlgoCombo = nullptr;
+			QComboBox* _routingAlgoCombo = nullptr;
 			QPushButton* _regenerateVehiclesButton = nullptr;
 
 			QLabel* _zoomLevel = nullptr;
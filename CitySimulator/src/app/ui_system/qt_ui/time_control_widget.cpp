@@ -12,6 +12,7 @@
 #include <QLabel>
 
 #include <core/simulation/simulation_system.h>
+#include <simulation/simulation_thread.h>
 #include <ctime>
 #include <iomanip>
 #include <sstream>
@@ -27,7 +28,10 @@ namespace tjs {
 			// Create start/pause button
 			_startPauseButton = new QPushButton("Start", this);
 			connect(_startPauseButton, &QPushButton::clicked, this, &TimeControlWidget::onStartPauseClicked);
-			_isRunning = !_application.simulationSystem().timeModule().state().isPaused && !_application.simulationSystem().settings().simulation_paused;
+			{
+				auto lock = _application.simulation_thread().lock();
+				_isRunning = !_application.simulationSystem().timeModule().state().isPaused && !_application.simulationSystem().settings().simulation_paused;
+			}
 
 			_startPauseButton->setText(_isRunning ? "Pause" : "Start");
 			layout->addWidget(_startPauseButton);
@@ -81,6 +85,7 @@ namespace tjs {
 		}
 
 		void TimeControlWidget::onStartPauseClicked() {
+			auto lock = _application.simulation_thread().lock();
 			if (_isRunning) {
 				_application.simulationSystem().timeModule().pause();
 				_startPauseButton->setText("Start");
@@ -94,23 +99,26 @@ namespace tjs {
 		}
 
 		void TimeControlWidget::onStepDeltaChanged(double value) {
-			_application.simulationSystem().timeModule().set_step_delta(value);
-			_application.settings().simulationSettings.step_delta_sec = value;
+			{
+				auto lock = _application.simulation_thread().lock();
+				_application.simulationSystem().timeModule().set_step_delta(value);
+				_application.settings().simulationSettings.step_delta_sec = value;
+			}
 			updateTimeLabel();
 		}
 
 		void TimeControlWidget::onStepsOnUpdateChanged(int value) {
+			auto lock = _application.simulation_thread().lock();
 			_application.settings().simulationSettings.steps_on_update = value;
 		}
 
 		void TimeControlWidget::onStepClicked() {
+			// the label follows once the step is published
+			auto lock = _application.simulation_thread().lock();
 			_application.simulationSystem().step();
-			updateTimeLabel();
 		}
 
-		std::string format_time(const core::TimeState& time_state) {
-			const auto& current_time = time_state.current_time();
-
+		std::string format_time(const core::SimTimePoint& current_time) {
 			// Convert to integral time point
 			auto integral_time = std::chrono::time_point_cast<std::chrono::system_clock::duration>(current_time);
 
@@ -133,8 +141,8 @@ namespace tjs {
 		}
 
 		void TimeControlWidget::updateTimeLabel() {
-			const auto& time_state = _application.simulationSystem().timeModule().state();
-			_timeLabel->setText(QString("Time: %1").arg(format_time(time_state)));
+			const auto snapshot = _application.simulation_thread().snapshot();
+			_timeLabel->setText(QString("Time: %1").arg(format_time(snapshot->current_time)));
 		}
 
 		void TimeControlWidget::updateButtonStates() {
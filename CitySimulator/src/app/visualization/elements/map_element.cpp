@@ -672,10 +672,10 @@ namespace tjs::visualization {
 
 		bool filter = _render_data.networkOnlyForSelected && _debugData != nullptr && !_debugData->reachableNodes.empty();
 		// Render edges from edge graph
-		for (const auto& [node, edges] : network.edge_graph) {
+		for (const Node* node : network.graph_nodes) {
 			const bool is_node_filtered = filter && !_debugData->reachableNodes.contains(node->uid);
 			const FPoint start = convert_to_screen_f(node->coordinates, _render_data.screen_center, _render_data.metersPerPixel);
-			for (const Edge* edge : edges) {
+			for (const Edge* edge : network.outgoing_edges(node)) {
 				Node* neighbor = edge->end_node;
 				const bool is_neighbor_filtered = filter && !_debugData->reachableNodes.contains(neighbor->uid);
 				const FPoint end = convert_to_screen_f(neighbor->coordinates, _render_data.screen_center, _render_data.metersPerPixel);
@@ -706,6 +706,16 @@ namespace tjs::visualization {
 		return { screenX, screenY };
 	}
 
+	Coordinates convert_from_screen(
+		const Position& screen,
+		const Position& screen_center,
+		double meters_per_pixel) {
+		Coordinates coord {};
+		coord.x = (screen.x - screen_center.x) * meters_per_pixel;
+		coord.y = (screen_center.y - screen.y) * meters_per_pixel;
+		return coord;
+	}
+
 	void MapElement::handle_open_map_simulation_reinit(const events::OpenMapEvent& event) {
 		on_map_updated();
 	}
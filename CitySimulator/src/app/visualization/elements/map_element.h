@@ -65,4 +65,9 @@ namespace tjs::visualization {
 		const core::Coordinates& coord,
 		const Position& screen_center,
 		double meters_per_pixel);
+	// World point under a screen position
+	core::Coordinates convert_from_screen(
+		const Position& screen,
+		const Position& screen_center,
+		double meters_per_pixel);
 } // namespace tjs::visualization
@@ -11,8 +11,8 @@
 #include <core/data_layer/road_network.h>
 #include <core/data_layer/vehicle.h>
 #include <core/math_constants.h>
-#include <core/store_models/vehicle_analyze_data.h>
-#include <core/simulation/agent/agent_data.h>
+#include <core/simulation/simulation_snapshot.h>
+#include <simulation/simulation_thread.h>
 #include <data/map_renderer_data.h>
 #include <visualization/elements/map_element.h>
 
@@ -39,19 +39,19 @@ namespace tjs::visualization {
 
 	void PathRenderer::render(IRenderer& renderer) {
 		TJS_TRACY_NAMED("PathRenderer_Render");
-		core::model::VehicleAnalyzeData* model = _application.stores().get_entry<core::model::VehicleAnalyzeData>();
-		if (model->agent == nullptr || model->agent->currentGoal == nullptr) {
+		const auto snapshot = _application.simulation_thread().snapshot();
+		if (!snapshot->tracked.has_value() || !snapshot->tracked->has_goal || !snapshot->tracked->has_vehicle) {
 			return;
 		}
 
-		auto* agent = model->agent;
-		auto& path = agent->path;
-		size_t path_offset = agent->path_offset;
+		const auto& agent = *snapshot->tracked;
+		const auto& path = agent.path;
+		size_t path_offset = agent.path_offset;
 		if (path.empty() || path_offset >= path.size()) {
 			return;
 		}
 
-		const Coordinates& vehicle_pos = agent->vehicle->coordinates;
+		const Coordinates& vehicle_pos = agent.vehicle_position;
 
 		auto convert = [this](const Coordinates& coordinates) {
 			return convert_to_screen_f(coordinates, _mapRendererData.screen_center, _mapRendererData.metersPerPixel);
@@ -67,15 +67,15 @@ namespace tjs::visualization {
 		// From vehicle position back to start of path (reverse order for blue path)
 		for (int i = static_cast<int>(path_offset); i >= 0; --i) {
 			if (i != path_offset) {
-				past_points.push_back(convert(path[i]->end_node->coordinates));
+				past_points.push_back(convert(path[i].end));
 			}
-			past_points.push_back(convert(path[i]->start_node->coordinates));
+			past_points.push_back(convert(path[i].start));
 		}
 
 		// From vehicle forward to destination (green)
 		future_points.push_back(convert(vehicle_pos));
 		for (size_t i = path_offset; i < path.size(); ++i) {
-			future_points.push_back(convert(path[i]->end_node->coordinates));
+			future_points.push_back(convert(path[i].end));
 		}
 
 		// Draw past path in Blue
@@ -88,7 +88,7 @@ namespace tjs::visualization {
 		// Draw goal marker
 		renderer.set_draw_color(FColor::Yellow);
 		const auto current_goal_screen = convert_to_screen(
-			agent->currentGoal->coordinates,
+			agent.goal,
 			_mapRendererData.screen_center,
 			_mapRendererData.metersPerPixel);
 		renderer.draw_circle(current_goal_screen.x, current_goal_screen.y, 5.0f, true);
@@ -10,8 +10,8 @@
 #include <core/data_layer/data_types.h>
 #include <core/store_models/idata_model.h>
 #include <core/data_layer/world_data.h>
-#include <core/simulation/simulation_system.h>
-#include <core/simulation/transport_management/vehicle_system.h>
+#include <core/simulation/simulation_snapshot.h>
+#include <simulation/simulation_thread.h>
 
 #include <visualization/elements/map_element.h>
 #include <data/persistent_render_data.h>
@@ -36,8 +36,9 @@ namespace tjs::visualization {
 
 	void VehicleRenderer::render(IRenderer& renderer) {
 		TJS_TRACY_NAMED("VehicleRenderer_Render");
-		for (auto vehicle : _application.simulationSystem().vehicle_system().vehicles()) {
-			render(renderer, *vehicle);
+		const auto snapshot = _application.simulation_thread().snapshot();
+		for (size_t i = 0; i < snapshot->vehicles.size(); ++i) {
+			render(renderer, *snapshot, i);
 		}
 	}
 
@@ -61,18 +62,19 @@ namespace tjs::visualization {
 		}
 	};
 
-	void VehicleRenderer::render(IRenderer& renderer, const core::Vehicle& vehicle) {
+	void VehicleRenderer::render(IRenderer& renderer, const core::simulation::SimulationSnapshot& snapshot, size_t vehicle) {
 		const float metersPerPixel = _mapRendererData.metersPerPixel;
+		const auto& vehicles = snapshot.vehicles;
 
 		// Get the settings for the vehicle based on its type
-		const VehicleRenderSettings& settings = vehicleSettings.renderSettings[static_cast<int>(vehicle.type)];
+		const VehicleRenderSettings& settings = vehicleSettings.renderSettings[static_cast<int>(vehicles.type[vehicle])];
 
 		// Set the color for the vehicle
 		renderer.set_draw_color(settings.color);
 
 		// Convert coordinates to screen coordinates
 		auto screenPos = tjs::visualization::convert_to_screen(
-			vehicle.coordinates,
+			vehicles.coordinates[vehicle],
 			_mapRendererData.screen_center,
 			_mapRendererData.metersPerPixel);
 		int screenX = screenPos.x;
@@ -84,8 +86,8 @@ namespace tjs::visualization {
 
 		// Calculate width and height in pixels based on metersPerPixel
 		const float scaler = _application.settings().render.vehicleScaler;
-		const float widthInPixels = scaler * vehicle.width / metersPerPixel;
-		const float lengthInPixels = scaler * vehicle.length / metersPerPixel;
+		const float widthInPixels = scaler * vehicles.width[vehicle] / metersPerPixel;
+		const float lengthInPixels = scaler * vehicles.length[vehicle] / metersPerPixel;
 
 		// Define vertices for the rectangle. The vehicle length is aligned
 		// with the X-axis so that a rotation angle of 0 corresponds to
@@ -97,7 +99,7 @@ namespace tjs::visualization {
 			{ { screenX - lengthInPixels / 2.0f, screenY + widthInPixels / 2.0f }, settings.color, { 0.f, 0.f } }  // top-left
 		};
 
-		const float angle = -vehicle.rotationAngle;
+		const float angle = -vehicles.rotation_angle[vehicle];
 		for (auto& v : vertices) {
 			// Translate to origin, rotate, then translate back
 			float dx = v.position.x - screenX;
@@ -7,7 +7,9 @@ namespace tjs {
 	class IRenderer;
 
 	namespace core {
-		struct Vehicle;
+		namespace simulation {
+			struct SimulationSnapshot;
+		} // namespace simulation
 
 		namespace model {
 			struct MapRendererData;
@@ -31,7 +33,7 @@ namespace tjs::visualization {
 		virtual void render(IRenderer& renderer) override;
 
 	private:
-		void render(IRenderer& renderer, const core::Vehicle& vehicle);
+		void render(IRenderer& renderer, const core::simulation::SimulationSnapshot& snapshot, size_t vehicle);
 
 	private:
 		core::model::MapRendererData& _mapRendererData;
@@ -0,0 +1,61 @@
+#pragma once
+
+#include <span>
+#include <vector>
+
+namespace tjs::common {
+	/**
+	 * @brief Compressed sparse row adjacency over dense row indices.
+	 *
+	 * The targets of row `i` are `targets[offsets[i]] .. targets[offsets[i + 1] - 1]`,
+	 * all rows live in one array, so walking neighbours is a contiguous read
+	 * and there is no per-row allocation.
+	 *
+	 * Filled either at once from (row, target) pairs or row by row:
+	 * clear(), push targets of row 0, close_row(), push targets of row 1, ...
+	 */
+	template<typename T>
+	struct CsrAdjacency {
+		std::vector<uint32_t> offsets; // rows() + 1 entries, starts with 0
+		std::vector<T> targets;
+
+		size_t rows() const {
+			return offsets.empty() ? 0 : offsets.size() - 1;
+		}
+
+		size_t size() const {
+			return targets.size();
+		}
+
+		std::span<const T> operator[](size_t row) const {
+			return { targets.data() + offsets[row], targets.data() + offsets[row + 1] };
+		}
+
+		void clear() {
+			offsets.assign(1, 0);
+			targets.clear();
+		}
+
+		// Ends the current row with the targets pushed since the previous one
+		void close_row() {
+			offsets.push_back(static_cast<uint32_t>(targets.size()));
+		}
+
+		// Targets of a row keep the order they have in `entries`
+		void assign(size_t row_count, const std::vector<std::pair<uint32_t, T>>& entries) {
+			offsets.assign(row_count + 1, 0);
+			for (const auto& entry : entries) {
+				++offsets[entry.first + 1];
+			}
+			for (size_t i = 0; i < row_count; ++i) {
+				offsets[i + 1] += offsets[i];
+			}
+
+			targets.resize(entries.size());
+			std::vector<uint32_t> cursor(offsets.begin(), offsets.end() - 1);
+			for (const auto& [row, target] : entries) {
+				targets[cursor[row]++] = target;
+			}
+		}
+	};
+} // namespace tjs::common
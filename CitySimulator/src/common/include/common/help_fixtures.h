@@ -10,8 +10,13 @@ namespace tjs::common {
 			return _id;
 		}
 
-		static void reset_id() {
-			WithId<_T>::global_id = 0;
+		// Used when objects are restored from a serialized form
+		void set_id(int id) {
+			_id = id;
+		}
+
+		static void reset_id(int next_id = 0) {
+			WithId<_T>::global_id = next_id;
 		}
 
 	private:
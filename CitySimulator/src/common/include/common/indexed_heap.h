@@ -0,0 +1,134 @@
+#pragma once
+
+#include <vector>
+
+namespace tjs::common {
+	/**
+	 * @brief Min-heap of dense ids with decrease-key, `Arity` children per node.
+	 *
+	 * Each id is in the heap at most once; its slot is kept in a position array
+	 * indexed by id, so lowering the key of a queued id is a sift-up instead of
+	 * a duplicate entry. A 4-ary layout keeps the heap shallow and the children
+	 * of a slot on one cache line.
+	 *
+	 * Storage only grows: after resize() to the largest id range in use,
+	 * push/pop/clear do not allocate.
+	 */
+	template<size_t Arity = 4>
+	class IndexedDaryHeap {
+		static_assert(Arity >= 2, "heap needs at least two children per node");
+
+	public:
+		static constexpr uint32_t NOT_QUEUED = std::numeric_limits<uint32_t>::max();
+
+	public:
+		// Makes ids [0, count) usable
+		void resize(size_t count) {
+			if (_position.size() < count) {
+				_position.resize(count, NOT_QUEUED);
+			}
+			_heap.reserve(count);
+		}
+
+		// O(size()), not O(ids)
+		void clear() {
+			for (const Entry& entry : _heap) {
+				_position[entry.id] = NOT_QUEUED;
+			}
+			_heap.clear();
+		}
+
+		bool empty() const {
+			return _heap.empty();
+		}
+
+		size_t size() const {
+			return _heap.size();
+		}
+
+		bool contains(uint32_t id) const {
+			return _position[id] != NOT_QUEUED;
+		}
+
+		uint32_t top() const {
+			return _heap.front().id;
+		}
+
+		double top_key() const {
+			return _heap.front().key;
+		}
+
+		uint32_t pop() {
+			const uint32_t id = _heap.front().id;
+			_position[id] = NOT_QUEUED;
+			const Entry last = _heap.back();
+			_heap.pop_back();
+			if (!_heap.empty()) {
+				sift_down(0, last);
+			}
+			return id;
+		}
+
+		// Queues `id` or lowers its key; a key not lower than the queued one is ignored
+		void push_or_decrease(uint32_t id, double key) {
+			uint32_t slot = _position[id];
+			if (slot == NOT_QUEUED) {
+				slot = static_cast<uint32_t>(_heap.size());
+				_heap.push_back({ key, id });
+			} else if (key >= _heap[slot].key) {
+				return;
+			}
+			sift_up(slot, { key, id });
+		}
+
+	private:
+		struct Entry {
+			double key;
+			uint32_t id;
+		};
+
+		void place(size_t slot, const Entry& entry) {
+			_heap[slot] = entry;
+			_position[entry.id] = static_cast<uint32_t>(slot);
+		}
+
+		void sift_up(size_t slot, const Entry& entry) {
+			while (slot > 0) {
+				const size_t parent = (slot - 1) / Arity;
+				if (!(entry.key < _heap[parent].key)) {
+					break;
+				}
+				place(slot, _heap[parent]);
+				slot = parent;
+			}
+			place(slot, entry);
+		}
+
+		void sift_down(size_t slot, const Entry& entry) {
+			const size_t count = _heap.size();
+			for (;;) {
+				const size_t first = slot * Arity + 1;
+				if (first >= count) {
+					break;
+				}
+				const size_t last = std::min(first + Arity, count);
+				size_t best = first;
+				for (size_t child = first + 1; child < last; ++child) {
+					if (_heap[child].key < _heap[best].key) {
+						best = child;
+					}
+				}
+				if (!(_heap[best].key < entry.key)) {
+					break;
+				}
+				place(slot, _heap[best]);
+				slot = best;
+			}
+			place(slot, entry);
+		}
+
+	private:
+		std::vector<Entry> _heap;
+		std::vector<uint32_t> _position;
+	};
+} // namespace tjs::common
@@ -0,0 +1,50 @@
+#pragma once
+
+#include <cstddef>
+#include <filesystem>
+#include <span>
+
+namespace tjs::common {
+	/**
+	 * @brief Read-only memory mapping of a whole file.
+	 *
+	 * Pages are loaded by the OS on first access, so opening a large file costs
+	 * next to nothing and reading it costs no more than the bytes touched.
+	 * The mapping lives as long as the object; spans obtained from data() must
+	 * not outlive it.
+	 */
+	class MappedFile {
+	public:
+		MappedFile() = default;
+		~MappedFile();
+
+		MappedFile(const MappedFile&) = delete;
+		MappedFile& operator=(const MappedFile&) = delete;
+		MappedFile(MappedFile&& other) noexcept;
+		MappedFile& operator=(MappedFile&& other) noexcept;
+
+		// Returns false if the file does not exist, is empty or cannot be mapped
+		bool open(const std::filesystem::path& path);
+		void close();
+
+		bool is_open() const {
+			return _data != nullptr;
+		}
+
+		std::span<const std::byte> data() const {
+			return { _data, _size };
+		}
+
+		size_t size() const {
+			return _size;
+		}
+
+	private:
+		const std::byte* _data = nullptr;
+		size_t _size = 0;
+#if defined(_WIN32)
+		void* _file = nullptr;
+		void* _mapping = nullptr;
+#endif
+	};
+} // namespace tjs::common
@@ -0,0 +1,95 @@
+#pragma once
+
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace tjs::common {
+	/**
+	 * @brief Forward-only pull reader for large, simple XML documents.
+	 *
+	 * Walks the text element by element without building a tree, so memory
+	 * does not grow with the document. Covers what data dumps such as OSM use:
+	 * elements, attributes, character data, comments, processing instructions
+	 * and a DOCTYPE. Text content is skipped; CDATA sections are skipped as
+	 * well. There is no namespace handling and no validation beyond well-formed
+	 * tags.
+	 *
+	 * An empty element `<a/>` is reported as StartElement followed by
+	 * EndElement, so callers can track nesting the same way for both forms.
+	 * Names and raw attribute values point into the source text and stay valid
+	 * as long as it does.
+	 */
+	class XmlStreamReader {
+	public:
+		enum class Token {
+			StartElement,
+			EndElement,
+			End,
+			Error
+		};
+
+	public:
+		explicit XmlStreamReader(std::string_view text)
+			: _text(text) {
+		}
+
+		Token next();
+
+		std::string_view name() const {
+			return _name;
+		}
+
+		// Nesting level of the current element, the root element is 1
+		size_t depth() const {
+			return _depth;
+		}
+
+		// Bytes consumed so far
+		size_t offset() const {
+			return _pos;
+		}
+
+		size_t size() const {
+			return _text.size();
+		}
+
+		// Attributes of the current start element in document order; values
+		// are raw, use decode() if they may contain entities
+		const std::vector<std::pair<std::string_view, std::string_view>>& attributes() const {
+			return _attributes;
+		}
+
+		// Raw value or empty if there is no such attribute
+		std::string_view attribute(std::string_view name) const;
+
+		// Attribute value with entity and character references replaced
+		std::string attribute_text(std::string_view name) const {
+			return decode(attribute(name));
+		}
+
+		static std::string decode(std::string_view raw);
+
+	private:
+		Token fail() {
+			_pos = _text.size();
+			return Token::Error;
+		}
+
+		bool skip_past(std::string_view terminator);
+		bool parse_start_tag();
+
+	private:
+		std::string_view _text;
+		size_t _pos = 0;
+		size_t _depth = 0;
+		std::string_view _name;
+		std::vector<std::pair<std::string_view, std::string_view>> _attributes;
+
+		// `<a/>` was just reported as a start, the matching end comes next
+		bool _pending_end = false;
+		// an end was reported, depth drops on the next call
+		bool _closing = false;
+	};
+} // namespace tjs::common
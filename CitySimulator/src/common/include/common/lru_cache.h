@@ -0,0 +1,101 @@
+#pragma once
+
+#include <list>
+#include <unordered_map>
+
+namespace tjs::common {
+	/**
+	 * @brief Bounded key-value cache that evicts the least recently used entry.
+	 *
+	 * Entries live in a list ordered by use, most recent first, with a hash
+	 * index into it; find() and insert() are O(1). Capacity 0 disables the
+	 * cache: nothing is stored and every find() is a miss.
+	 */
+	template<typename Key, typename Value, typename Hash = std::hash<Key>>
+	class LruCache {
+	public:
+		struct Stats {
+			size_t hits = 0;
+			size_t misses = 0;
+			size_t evictions = 0;
+		};
+
+	public:
+		explicit LruCache(size_t capacity = 0)
+			: _capacity(capacity) {
+		}
+
+		// Value of `key` marked as most recently used, nullptr if not cached
+		const Value* find(const Key& key) {
+			auto it = _index.find(key);
+			if (it == _index.end()) {
+				++_stats.misses;
+				return nullptr;
+			}
+			++_stats.hits;
+			_entries.splice(_entries.begin(), _entries, it->second);
+			return &it->second->second;
+		}
+
+		// Stores or replaces the value of `key`, evicting the oldest entry when full
+		void insert(const Key& key, Value value) {
+			if (_capacity == 0) {
+				return;
+			}
+			auto it = _index.find(key);
+			if (it != _index.end()) {
+				it->second->second = std::move(value);
+				_entries.splice(_entries.begin(), _entries, it->second);
+				return;
+			}
+			if (_entries.size() >= _capacity) {
+				evict();
+			}
+			_entries.emplace_front(key, std::move(value));
+			_index.emplace(key, _entries.begin());
+		}
+
+		void clear() {
+			_entries.clear();
+			_index.clear();
+		}
+
+		void set_capacity(size_t capacity) {
+			_capacity = capacity;
+			while (_entries.size() > _capacity) {
+				evict();
+			}
+		}
+
+		size_t capacity() const {
+			return _capacity;
+		}
+
+		size_t size() const {
+			return _entries.size();
+		}
+
+		const Stats& stats() const {
+			return _stats;
+		}
+
+		void reset_stats() {
+			_stats = {};
+		}
+
+	private:
+		void evict() {
+			_index.erase(_entries.back().first);
+			_entries.pop_back();
+			++_stats.evictions;
+		}
+
+	private:
+		using Entry = std::pair<Key, Value>;
+
+		size_t _capacity;
+		std::list<Entry> _entries;
+		std::unordered_map<Key, typename std::list<Entry>::iterator, Hash> _index;
+		Stats _stats;
+	};
+} // namespace tjs::common
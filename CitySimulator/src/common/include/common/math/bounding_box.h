@@ -1,5 +1,8 @@
 #pragma once
 
+#include <algorithm>
+#include <cmath>
+
 namespace tjs::common {
 	struct BoundingBox {
 		double min_x;
@@ -24,4 +27,11 @@ namespace tjs::common {
 	inline double area(const BoundingBox& b) {
 		return (b.max_x - b.min_x) * (b.max_y - b.min_y);
 	}
+
+	// Distance from (x, y) to the closest point of the box, 0 inside it
+	inline double box_distance(const BoundingBox& b, double x, double y) {
+		const double dx = std::max({ b.min_x - x, 0.0, x - b.max_x });
+		const double dy = std::max({ b.min_y - y, 0.0, y - b.max_y });
+		return std::sqrt(dx * dx + dy * dy);
+	}
 } // namespace tjs::common
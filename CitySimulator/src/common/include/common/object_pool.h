@@ -1,6 +1,8 @@
 
 #pragma once
 
+#include <common/pool_handle.h>
+
 #if defined(__cpp_lib_hardware_interference_size)
 // available in some libstdc++
 #include <new>
@@ -68,17 +70,19 @@ namespace tjs::common {
 		};
 
 		ObjectPool() {
-#if TJS_SIMULATION_DEBUG
-			for (size_t i = 0; i < TLSCacheSize; ++i) {
-				assert(tls_cache_.buf[i] == 0);
-			}
-			assert(tls_cache_.size == 0);
-#endif
 			T** tbl = nullptr;
 			blocks_tbl_.store(tbl, std::memory_order_release);
 			blocks_cnt_.store(0, std::memory_order_release);
+
+			std::lock_guard<std::mutex> reg(_registry_lock());
+			_registry().emplace(id_, this);
 		}
 		~ObjectPool() {
+			{
+				// thread caches still holding our ids drop them from here on
+				std::lock_guard<std::mutex> reg(_registry_lock());
+				_registry().erase(id_);
+			}
 			destroy_all_live();
 			_free_all_blocks();
 		}
@@ -96,9 +100,9 @@ namespace tjs::common {
 				auto* block = tbl[b];
 				for (uint32_t o = 0; o < BlockSize; ++o) {
 					uint32_t idx = b * BlockSize + o;
-					if (block[o].load(std::memory_order_relaxed)) {
+					if (block[o].load(std::memory_order_relaxed) & ALIVE_BIT) {
 						std::destroy_at(_slot_ptr(idx));
-						block[o].store(false, std::memory_order_relaxed);
+						set_alive(idx, false);
 					}
 				}
 			}
@@ -116,11 +120,12 @@ namespace tjs::common {
 		// Acquire an object slot, construct T in-place, return pooled_ptr (idx + pointer).
 		template<typename... Args>
 		pooled_ptr acquire(Args&&... args) {
+			auto& cache = _tls_cache();
 			uint32_t idx;
-			if (!_tls_pop(idx)) {
+			if (!_tls_pop(cache, idx)) {
 				// refill TLS from global list
-				_refill_tls_cache();
-				if (!_tls_pop(idx)) {
+				_refill_tls_cache(cache);
+				if (!_tls_pop(cache, idx)) {
 					// global also empty → make a new block
 					std::lock_guard<std::mutex> lk(global_lock_);
 					if (free_list_.empty()) {
@@ -150,7 +155,7 @@ namespace tjs::common {
 			// Call destructor *before* marking free
 			std::destroy_at(pp.ptr);
 			set_alive(idx, false);
-			_tls_push(idx);
+			_tls_push(_tls_cache(), idx);
 		}
 
 		// Access by index (e.g., if you keep ids in your structures).
@@ -167,7 +172,11 @@ namespace tjs::common {
 		size_t block_count() const noexcept { return blocks_.size(); }
 
 	protected:
-		const std::atomic<std::atomic<bool>**>& alive_table() const noexcept { return alive_tbl_; }
+		// Per slot state: ALIVE_BIT, above it the number of times the slot was released
+		static constexpr uint32_t ALIVE_BIT = 1;
+		using slot_state_t = std::atomic<uint32_t>;
+
+		const std::atomic<slot_state_t**>& alive_table() const noexcept { return alive_tbl_; }
 		const std::atomic<uint32_t>& alive_cnt() const noexcept { return alive_cnt_; }
 
 		T* _slot_ptr(uint32_t idx) const noexcept {
@@ -189,28 +198,35 @@ namespace tjs::common {
 			return UINT32_MAX;
 		}
 
-	private:
+		// Releasing a slot also counts it, so the state tells reuses apart
 		void set_alive(uint32_t idx, bool v) noexcept {
 			uint32_t b = idx / BlockSize, o = idx % BlockSize;
-			auto** tbl = alive_tbl_.load(std::memory_order_relaxed);
-			tbl[b][o].store(v, std::memory_order_release);
+			auto** tbl = alive_tbl_.load(std::memory_order_acquire);
+			slot_state_t& state = tbl[b][o];
+			const uint32_t current = state.load(std::memory_order_relaxed);
+			state.store(v ? (current | ALIVE_BIT) : ((current | ALIVE_BIT) + 1), std::memory_order_release);
 		}
 
-		bool is_alive(uint32_t idx) const noexcept {
+		uint32_t slot_state(uint32_t idx) const noexcept {
 			uint32_t b = idx / BlockSize, o = idx % BlockSize;
-			auto** tbl = alive_tbl_.load(std::memory_order_relaxed);
-			return tbl[b][o].load(std::memory_order_release);
+			auto** tbl = alive_tbl_.load(std::memory_order_acquire);
+			return tbl[b][o].load(std::memory_order_acquire);
+		}
+
+		bool is_alive(uint32_t idx) const noexcept {
+			return slot_state(idx) & ALIVE_BIT;
 		}
 
+	private:
 		void _allocate_block_unsafe() {
 			// Aligned allocation improves line sharing; requires matching delete.
 			T* block = reinterpret_cast<T*>(_details::allocate_block<T>(BlockSize));
 			blocks_.push_back(block);
 
 			// alive flags for this block
-			auto alive = std::make_unique<std::atomic<bool>[]>(BlockSize);
+			auto alive = std::make_unique<slot_state_t[]>(BlockSize);
 			for (size_t i = 0; i < BlockSize; ++i) {
-				alive[i].store(false, std::memory_order_relaxed);
+				alive[i].store(0, std::memory_order_relaxed);
 			}
 			alive_blocks_.push_back(std::move(alive));
 
@@ -234,8 +250,33 @@ namespace tjs::common {
 			return id;
 		}
 
-		bool _tls_pop(uint32_t& out) noexcept {
+		// The thread cache is shared by all pools of the type; ids cached for
+		// another pool go back to it (or are dropped if it is gone) before
+		// this one uses the cache.
+		struct tls_cache_t;
+		tls_cache_t& _tls_cache() {
 			auto& c = tls_cache_;
+			if (c.owner != id_) [[unlikely]] {
+				if (c.size > 0) {
+					std::lock_guard<std::mutex> reg(_registry_lock());
+					auto& pools = _registry();
+					if (auto it = pools.find(c.owner); it != pools.end()) {
+						it->second->_take_back(c.buf, c.size);
+					}
+				}
+				c.owner = id_;
+				c.size = 0;
+			}
+			return c;
+		}
+
+		void _take_back(const uint32_t* ids, uint32_t count) {
+			std::lock_guard<std::mutex> lk(global_lock_);
+			free_list_.insert(free_list_.end(), ids, ids + count);
+			free_list_size_.store(free_list_.size(), std::memory_order_relaxed);
+		}
+
+		bool _tls_pop(tls_cache_t& c, uint32_t& out) noexcept {
 			if (c.size == 0) {
 				return false;
 			}
@@ -243,8 +284,7 @@ namespace tjs::common {
 			return true;
 		}
 
-		void _tls_push(uint32_t id) {
-			auto& c = tls_cache_;
+		void _tls_push(tls_cache_t& c, uint32_t id) {
 			if (c.size < TLSCacheSize) {
 				c.buf[c.size++] = id;
 				return;
@@ -259,9 +299,8 @@ namespace tjs::common {
 			free_list_size_.store(free_list_.size(), std::memory_order_relaxed);
 		}
 
-		void _refill_tls_cache() {
+		void _refill_tls_cache(tls_cache_t& c) {
 			std::lock_guard<std::mutex> lk(global_lock_);
-			auto& c = tls_cache_;
 			const uint32_t want = TLSCacheSize;
 			uint32_t got = 0;
 			while (!free_list_.empty() && got < want) {
@@ -280,8 +319,8 @@ namespace tjs::common {
 		void _publish_alive_table_nolock(uint32_t cnt) {
 			const uint32_t n = static_cast<uint32_t>(alive_blocks_.size()); // under lock
 			// allocate exact n entries (can choose pow2 growth if you want fewer allocations)
-			auto** new_tbl = static_cast<std::atomic<bool>**>(
-				::operator new[](sizeof(std::atomic<bool>*) * cnt));
+			auto** new_tbl = static_cast<slot_state_t**>(
+				::operator new[](sizeof(slot_state_t*) * cnt));
 			for (uint32_t i = 0; i < n; ++i) {
 				new_tbl[i] = alive_blocks_[i].get();
 			}
@@ -345,10 +384,9 @@ namespace tjs::common {
 			free_list_.clear();
 			free_list_size_.store(0);
 
-			for (size_t i = 0; i < TLSCacheSize; ++i) {
-				tls_cache_.buf[i] = 0;
+			if (tls_cache_.owner == id_) {
+				tls_cache_.size = 0;
 			}
-			tls_cache_.size = 0;
 
 			_free_tables();
 		}
@@ -357,7 +395,7 @@ namespace tjs::common {
 		std::mutex global_lock_;
 		// -------- storage layout --------
 		std::vector<T*> blocks_;                                         // slabs
-		std::vector<std::unique_ptr<std::atomic<bool>[]>> alive_blocks_; // 1 byte each, ok for millions
+		std::vector<std::unique_ptr<slot_state_t[]>> alive_blocks_; // 4 bytes each, ok for millions
 		std::vector<uint32_t> free_list_;                                // global free ids (LIFO)
 		std::atomic<size_t> free_list_size_ { 0 };                       // approximate for stats
 
@@ -366,85 +404,165 @@ namespace tjs::common {
 		std::atomic<T**> blocks_tbl_ { nullptr };
 		std::atomic<uint32_t> blocks_cnt_ { 0 };
 
-		std::atomic<std::atomic<bool>**> alive_tbl_ { nullptr }; // array of pointers to per-block flags
+		std::atomic<slot_state_t**> alive_tbl_ { nullptr }; // array of pointers to per-block states
 		std::atomic<uint32_t> alive_cnt_ { 0 };                  // number of published blocks
 
 		// Keep all previous tables to free them in ~ObjectPool
-		std::vector<std::atomic<bool>**> alive_tbl_old_;
+		std::vector<slot_state_t**> alive_tbl_old_;
 		std::vector<T**> blocks_tbl_old_;
 
 		// Per-thread cache of ids to avoid taking the global lock on every op.
+		// One per thread and type, `owner` is the pool the ids belong to.
 		struct tls_cache_t {
+			uint64_t owner { 0 };
 			uint32_t buf[ObjectPool::TLSCacheSize];
 			uint32_t size { 0 };
 		};
 		static thread_local tls_cache_t tls_cache_;
+
+		// Live pools of the type by id; ids are never reused, so a cache of a
+		// destroyed pool cannot be mistaken for a new one
+		static inline std::atomic<uint64_t> next_id_ { 1 };
+		const uint64_t id_ = next_id_.fetch_add(1, std::memory_order_relaxed);
+
+		static std::mutex& _registry_lock() {
+			static std::mutex lock;
+			return lock;
+		}
+		static std::unordered_map<uint64_t, ObjectPool*>& _registry() {
+			static std::unordered_map<uint64_t, ObjectPool*> pools;
+			return pools;
+		}
 	};
 
 	template<typename T, size_t BS, size_t CacheSize>
 	thread_local typename ObjectPool<T, BS, CacheSize>::tls_cache_t ObjectPool<T, BS, CacheSize>::tls_cache_ {};
 
+	// ObjectPool that also keeps the live objects as a dense list and hands out
+	// generational handles.
+	//
+	// The list is kept incrementally: acquire appends, release moves the last
+	// object into the freed position (each slot remembers its position), so
+	// objects() never rescans the blocks. Its order is the order of
+	// acquisition, disturbed by releases.
 	template<typename _T, size_t _BlockSize = 65536u, size_t _TLSCacheSize = 1024u>
 	class ObjectPoolExt : public ObjectPool<_T, _BlockSize, _TLSCacheSize> {
+		using Base = ObjectPool<_T, _BlockSize, _TLSCacheSize>;
+
 	public:
 		using T = _T;
+		using handle = PoolHandle<_T>;
 		static constexpr size_t BlockSize = _BlockSize;
 
-		// Update internal objects, use locks so not use in parallel after acquire
-		void update_objects() const {
-			if (_valid_objects.load(std::memory_order_acquire)) {
-				return;
-			}
-			// no need to lock: read the snapshot table atomically
-			auto** tbl = this->alive_table().load(std::memory_order_acquire);
-			uint32_t n = this->alive_cnt().load(std::memory_order_acquire);
-
-			_objects.clear();
-			_objects.reserve(this->capacity());
+		// nullptr once the pool holds handle::MAX_INDEX + 1 slots
+		template<typename... Args>
+		T* acquire_ptr(Args&&... args) {
+			return _acquire(std::forward<Args>(args)...).ptr;
+		}
 
-			for (uint32_t b = 0; b < n; ++b) {
-				auto* flags = tbl[b];
-				for (uint32_t o = 0; o < BlockSize; ++o) {
-					if (flags[o].load(std::memory_order_relaxed)) {
-						uint32_t idx = b * BlockSize + o;
-						_objects.push_back(this->_slot_ptr(idx));
-					}
-				}
+		// Same as acquire_ptr, but returns a handle that stays checkable after release
+		// (an invalid one when the pool is full)
+		template<typename... Args>
+		handle acquire_handle(Args&&... args) {
+			const auto pp = _acquire(std::forward<Args>(args)...);
+			if (!pp) {
+				return handle::invalid();
 			}
-
-			_valid_objects.store(true, std::memory_order_release);
+			return handle::make(pp.idx, _generation(this->slot_state(pp.idx)));
 		}
 
-		template<typename... Args>
-		T* acquire_ptr(Args&&... args) {
-			T* p = ObjectPool<_T, _BlockSize, _TLSCacheSize>::acquire(std::forward<Args>(args)...).ptr;
-			_valid_objects.store(false, std::memory_order_release);
-			return p;
+		// O(1); nullptr for an invalid handle or one whose object was released
+		T* resolve(handle h) noexcept {
+			return _is_current(h) ? this->_slot_ptr(h.index()) : nullptr;
+		}
+		const T* resolve(handle h) const noexcept {
+			return _is_current(h) ? this->_slot_ptr(h.index()) : nullptr;
 		}
 
 		void clear() {
-			ObjectPool<_T, _BlockSize, _TLSCacheSize>::destroy_all_live();
+			Base::destroy_all_live();
+			std::lock_guard<std::mutex> lk(_objects_lock);
 			_objects.clear();
-			_valid_objects.store(false, std::memory_order_release);
+			_object_slots.clear();
 		}
 
+		// O(1); stale handles are ignored.
+		// Every release (clear() too) makes the handles to the slot stale.
+		void release(handle h) {
+			if (!_is_current(h)) {
+				return;
+			}
+			_release(this->_slot_ptr(h.index()), h.index());
+		}
+
+		// Scans the blocks to find the slot, prefer release(handle)
 		void release(T* ptr) {
 			const uint32_t idx = this->_index_of_ptr(ptr);
 			if (idx == UINT32_MAX) {
 				return;
 			}
-			ObjectPool<_T, _BlockSize, _TLSCacheSize>::release({ ptr, idx });
-			_valid_objects.store(false, std::memory_order_release);
+			_release(ptr, idx);
 		}
 
+		// Live objects; acquire and release change it, so do not hold it
+		// across them (release from the back when releasing while iterating)
 		const std::vector<T*>& objects() const {
-			update_objects();
 			return _objects;
 		}
 
 	private:
-		mutable std::atomic<bool> _valid_objects = true;
-		mutable std::vector<T*> _objects;
+		template<typename... Args>
+		typename Base::pooled_ptr _acquire(Args&&... args) {
+			auto pp = Base::acquire(std::forward<Args>(args)...);
+			if (pp.idx > handle::MAX_INDEX) {
+				// a handle could not tell this slot from a lower one, refuse it
+				Base::release(pp);
+				return {};
+			}
+			std::lock_guard<std::mutex> lk(_objects_lock);
+			if (pp.idx >= _positions.size()) {
+				_positions.resize(std::max<size_t>(pp.idx + 1, _positions.size() * 2));
+			}
+			_positions[pp.idx] = static_cast<uint32_t>(_objects.size());
+			_objects.push_back(pp.ptr);
+			_object_slots.push_back(pp.idx);
+			return pp;
+		}
+
+		void _release(T* ptr, uint32_t idx) {
+			{
+				// out of the list before the slot can be handed out again
+				std::lock_guard<std::mutex> lk(_objects_lock);
+				const uint32_t pos = _positions[idx];
+				const uint32_t last = _object_slots.back();
+				_objects[pos] = _objects.back();
+				_object_slots[pos] = last;
+				_positions[last] = pos;
+				_objects.pop_back();
+				_object_slots.pop_back();
+			}
+			Base::release({ ptr, idx });
+		}
+
+		bool _is_current(handle h) const noexcept {
+			const uint32_t idx = h.index();
+			if (!h.valid() || idx >= this->alive_cnt().load(std::memory_order_acquire) * BlockSize) {
+				return false;
+			}
+			const uint32_t state = this->slot_state(idx);
+			return (state & Base::ALIVE_BIT) && _generation(state) == h.generation();
+		}
+
+		// Release count of the slot folded into the handle range, 0 is never issued
+		static uint32_t _generation(uint32_t state) noexcept {
+			return (state >> 1) % handle::MAX_GENERATION + 1;
+		}
+
+	private:
+		std::mutex _objects_lock;
+		std::vector<T*> _objects;
+		std::vector<uint32_t> _object_slots; // slot of every _objects entry
+		std::vector<uint32_t> _positions;    // per slot, its entry in _objects while alive
 	};
 
 } // namespace tjs::common
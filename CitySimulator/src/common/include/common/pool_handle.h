@@ -0,0 +1,55 @@
+#pragma once
+
+namespace tjs::common {
+
+	// Generational 32-bit reference to an object of an ObjectPoolExt.
+	//
+	// Low INDEX_BITS hold the pool slot, the rest the slot generation at
+	// acquire time. The pool bumps the generation when the slot is released,
+	// so a handle kept past its object resolves to nullptr instead of to
+	// whatever reuses the slot. Generations start at 1 and wrap after
+	// MAX_GENERATION reuses of one slot, which is the limit of the detection.
+	//
+	// Generation 0 is never issued, so a zeroed handle is the invalid one and
+	// PoolHandle stays trivial inside POD records.
+	template<typename T>
+	struct PoolHandle {
+		static constexpr uint32_t INDEX_BITS = 22;
+		static constexpr uint32_t INDEX_MASK = (1u << INDEX_BITS) - 1;
+		static constexpr uint32_t MAX_INDEX = INDEX_MASK;
+		static constexpr uint32_t MAX_GENERATION = (1u << (32 - INDEX_BITS)) - 1;
+
+		uint32_t value;
+
+		static constexpr PoolHandle make(uint32_t index, uint32_t generation) noexcept {
+			return PoolHandle { (generation << INDEX_BITS) | (index & INDEX_MASK) };
+		}
+
+		static constexpr PoolHandle invalid() noexcept {
+			return PoolHandle { 0 };
+		}
+
+		uint32_t index() const noexcept {
+			return value & INDEX_MASK;
+		}
+
+		uint32_t generation() const noexcept {
+			return value >> INDEX_BITS;
+		}
+
+		bool valid() const noexcept {
+			return generation() != 0;
+		}
+
+		explicit operator bool() const noexcept {
+			return valid();
+		}
+
+		void reset() noexcept {
+			value = 0;
+		}
+
+		friend bool operator==(PoolHandle, PoolHandle) = default;
+	};
+
+} // namespace tjs::common
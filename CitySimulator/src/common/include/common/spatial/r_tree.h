@@ -3,12 +3,32 @@
 #include <common/stdafx.h>
 #include <common/math/bounding_box.h>
 
+#include <cmath>
+#include <queue>
+#include <span>
+
 namespace tjs::common {
+	// Node of the flat form of an RTree; children of a node, and entries of a
+	// leaf, are contiguous and come after it
+	struct RTreeFlatNode {
+		BoundingBox box;
+		uint32_t first; // first child, or first entry of a leaf
+		uint32_t count;
+		uint32_t leaf;
+	};
+
 	/**
 	 * @brief Minimal R-tree with linear split and logN query complexity.
+	 *
+	 * Besides box queries it answers k-nearest-neighbour queries best-first:
+	 * nodes and entries are visited in order of their distance to the point,
+	 * so only the part of the tree closer than the k-th result is opened.
 	 */
 	template<typename T, size_t NODE_CAPACITY = 4>
 	class RTree {
+	public:
+		using FlatNode = RTreeFlatNode;
+
 	public:
 		void insert(const BoundingBox& box, const T& value) {
 			if (!_root) {
@@ -34,8 +54,139 @@ namespace tjs::common {
 			query_node(*_root, box, out);
 		}
 
+		// Up to `k` values closest to (x, y) by the distance to their box, closest first
+		template<typename OutputIt>
+		void nearest(double x, double y, size_t k, OutputIt out, double max_distance = std::numeric_limits<double>::infinity()) const {
+			nearest(x, y, k, out, [x, y](const T&, const BoundingBox& box) { return box_distance(box, x, y); }, max_distance);
+		}
+
+		// Same with `distance(value, box)` as the metric. It must not be less than
+		// the distance to the box of the value; infinity skips the value.
+		template<typename OutputIt, typename Distance>
+		void nearest(double x, double y, size_t k, OutputIt out, Distance&& distance, double max_distance = std::numeric_limits<double>::infinity()) const {
+			if (!_root || k == 0) {
+				return;
+			}
+
+			struct Candidate {
+				double distance;
+				const Node* node;   // subtree to open
+				const Entry* entry; // or value to report
+			};
+			const auto farther = [](const Candidate& a, const Candidate& b) { return a.distance > b.distance; };
+			std::priority_queue<Candidate, std::vector<Candidate>, decltype(farther)> open(farther);
+
+			open.push({ box_distance(_root->box, x, y), _root.get(), nullptr });
+			while (!open.empty() && k > 0) {
+				const Candidate candidate = open.top();
+				open.pop();
+				if (candidate.distance > max_distance) {
+					return;
+				}
+				if (candidate.entry) {
+					*out++ = candidate.entry->value;
+					--k;
+					continue;
+				}
+
+				const Node& node = *candidate.node;
+				if (node.leaf) {
+					for (const auto& e : node.entries) {
+						const double d = distance(e.value, e.box);
+						if (std::isfinite(d) && d <= max_distance) {
+							open.push({ d, nullptr, &e });
+						}
+					}
+				} else {
+					for (const auto& c : node.children) {
+						open.push({ box_distance(c->box, x, y), c.get(), nullptr });
+					}
+				}
+			}
+		}
+
 		size_t size() const { return _size; }
 
+		// Breadth-first copy of the tree as it is, entries in leaf order
+		void flatten(std::vector<FlatNode>& nodes, std::vector<BoundingBox>& boxes, std::vector<T>& values) const {
+			nodes.clear();
+			boxes.clear();
+			values.clear();
+			if (!_root) {
+				return;
+			}
+
+			std::vector<const Node*> order { _root.get() };
+			for (size_t i = 0; i < order.size(); ++i) {
+				const Node& node = *order[i];
+				if (node.leaf) {
+					nodes.push_back({ node.box, static_cast<uint32_t>(boxes.size()), static_cast<uint32_t>(node.entries.size()), 1 });
+					for (const auto& e : node.entries) {
+						boxes.push_back(e.box);
+						values.push_back(e.value);
+					}
+				} else {
+					nodes.push_back({ node.box, static_cast<uint32_t>(order.size()), static_cast<uint32_t>(node.children.size()), 0 });
+					for (const auto& c : node.children) {
+						order.push_back(c.get());
+					}
+				}
+			}
+		}
+
+		// Rebuilds the tree flatten() produced; false, leaving the tree empty,
+		// when the arrays do not describe one
+		bool unflatten(std::span<const FlatNode> nodes, std::span<const BoundingBox> boxes, std::span<const T> values) {
+			_root.reset();
+			_size = 0;
+			if (nodes.empty()) {
+				return boxes.empty() && values.empty();
+			}
+			if (boxes.size() != values.size()) {
+				return false;
+			}
+
+			// every node and entry is referenced once, in the order flatten()
+			// emits them, and children come after their parent
+			size_t next_node = 1;
+			size_t next_entry = 0;
+			for (size_t i = 0; i < nodes.size(); ++i) {
+				const FlatNode& flat = nodes[i];
+				size_t& next = flat.leaf ? next_entry : next_node;
+				if (flat.first != next || flat.count > (flat.leaf ? boxes.size() : nodes.size()) - next || (!flat.leaf && flat.first <= i)) {
+					return false;
+				}
+				next += flat.count;
+			}
+			if (next_node != nodes.size() || next_entry != boxes.size()) {
+				return false;
+			}
+
+			// build from the back so children exist before their parent
+			std::vector<std::unique_ptr<Node>> built(nodes.size());
+			for (size_t i = nodes.size(); i-- > 0;) {
+				const FlatNode& flat = nodes[i];
+				auto node = std::make_unique<Node>();
+				node->leaf = flat.leaf != 0;
+				node->box = flat.box;
+				if (node->leaf) {
+					node->entries.reserve(flat.count);
+					for (uint32_t e = flat.first; e < flat.first + flat.count; ++e) {
+						node->entries.push_back({ boxes[e], values[e] });
+					}
+				} else {
+					node->children.reserve(flat.count);
+					for (uint32_t c = flat.first; c < flat.first + flat.count; ++c) {
+						node->children.push_back(std::move(built[c]));
+					}
+				}
+				built[i] = std::move(node);
+			}
+			_root = std::move(built.front());
+			_size = values.size();
+			return true;
+		}
+
 	private:
 		struct Entry {
 			BoundingBox box;
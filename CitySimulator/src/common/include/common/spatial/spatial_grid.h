@@ -7,7 +7,7 @@
 
 namespace tjs::common {
 
-	template<typename CellEntry, typename TreeEntry>
+	template<typename CellEntry, typename TreeEntry, typename PointEntry>
 	struct SpatialGrid {
 		using GridKey = std::pair<int, int>;
 		using EntriesInCell = std::vector<CellEntry*>;
@@ -16,6 +16,8 @@ namespace tjs::common {
 		double cellSize = 1.0;
 
 		RTree<TreeEntry*> tree;
+		// point objects, for nearest-neighbour lookups
+		RTree<PointEntry*> points;
 
 		inline GridKey make_key(double x, double y) const {
 			return std::make_pair(static_cast<int>(x / cellSize),
@@ -38,6 +40,11 @@ namespace tjs::common {
 			tree.insert(box, value);
 		}
 
+		template<typename PointLike>
+		inline void add_point_entry(PointEntry* entry, const PointLike& point) {
+			points.insert(BoundingBox { point.x, point.y, point.x, point.y }, entry);
+		}
+
 		inline std::optional<std::reference_wrapper<const EntriesInCell>>
 			get_entries_in_cell(GridKey&& key) const {
 			auto it = spatialGrid.find(key);
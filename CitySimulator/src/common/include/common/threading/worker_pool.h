@@ -0,0 +1,154 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace tjs::common {
+	// Small fork-join pool for data-parallel passes inside one simulation step.
+	//
+	//  • `size()` workers in total; the calling thread is worker 0 and always
+	//    takes part, so a pool of size 1 owns no threads and runs inline.
+	//  • `parallel_for(count, fn)` hands out task indices [0, count) one by
+	//    one and returns only after every task has finished.
+	//  • fn(task, worker) – `worker` is stable for the duration of the call and
+	//    lies in [0, size()), so callers may keep per-worker scratch buffers.
+	//
+	// The pool does not schedule tasks deterministically; callers that need
+	// reproducible results must make each task independent of the others.
+	class WorkerPool {
+	public:
+		using TaskFn = std::function<void(size_t task, size_t worker)>;
+
+		explicit WorkerPool(size_t threads = 0) {
+			resize(threads);
+		}
+
+		~WorkerPool() {
+			stop();
+		}
+
+		WorkerPool(const WorkerPool&) = delete;
+		WorkerPool& operator=(const WorkerPool&) = delete;
+
+		// 0 selects std::thread::hardware_concurrency()
+		void resize(size_t threads) {
+			if (threads == 0) {
+				threads = std::max<size_t>(1, std::thread::hardware_concurrency());
+			}
+			if (threads == size()) {
+				return;
+			}
+
+			stop();
+			uint64_t generation = 0;
+			{
+				std::lock_guard lock(_mutex);
+				_stopping = false;
+				generation = _generation;
+			}
+			// new workers wait for the next job, not the last one
+			_threads.reserve(threads - 1);
+			for (size_t i = 1; i < threads; ++i) {
+				_threads.emplace_back([this, i, generation]() { worker_loop(i, generation); });
+			}
+		}
+
+		size_t size() const {
+			return _threads.size() + 1;
+		}
+
+		void parallel_for(size_t count, const TaskFn& fn) {
+			if (count == 0) {
+				return;
+			}
+
+			if (_threads.empty() || count == 1) {
+				for (size_t t = 0; t < count; ++t) {
+					fn(t, 0);
+				}
+				return;
+			}
+
+			{
+				std::lock_guard lock(_mutex);
+				_job = &fn;
+				_job_count = count;
+				_next_task.store(0, std::memory_order_relaxed);
+				_busy_workers = _threads.size();
+				++_generation;
+			}
+			_wake.notify_all();
+
+			run_tasks(0);
+
+			std::unique_lock lock(_mutex);
+			_done.wait(lock, [this]() { return _busy_workers == 0; });
+			_job = nullptr;
+		}
+
+	private:
+		void stop() {
+			{
+				std::lock_guard lock(_mutex);
+				_stopping = true;
+			}
+			_wake.notify_all();
+			for (auto& thread : _threads) {
+				thread.join();
+			}
+			_threads.clear();
+		}
+
+		void run_tasks(size_t worker) {
+			const TaskFn& fn = *_job;
+			for (;;) {
+				const size_t t = _next_task.fetch_add(1, std::memory_order_relaxed);
+				if (t >= _job_count) {
+					break;
+				}
+				fn(t, worker);
+			}
+		}
+
+		void worker_loop(size_t worker, uint64_t seen_generation) {
+			for (;;) {
+				{
+					std::unique_lock lock(_mutex);
+					_wake.wait(lock, [&]() { return _stopping || _generation != seen_generation; });
+					if (_stopping) {
+						return;
+					}
+					seen_generation = _generation;
+				}
+
+				run_tasks(worker);
+
+				{
+					std::lock_guard lock(_mutex);
+					--_busy_workers;
+				}
+				_done.notify_one();
+			}
+		}
+
+	private:
+		std::vector<std::thread> _threads;
+
+		std::mutex _mutex;
+		std::condition_variable _wake;
+		std::condition_variable _done;
+
+		const TaskFn* _job = nullptr;
+		size_t _job_count = 0;
+		std::atomic<size_t> _next_task { 0 };
+		size_t _busy_workers = 0;
+		uint64_t _generation = 0;
+		bool _stopping = false;
+	};
+} // namespace tjs::common
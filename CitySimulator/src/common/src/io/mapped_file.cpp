@@ -0,0 +1,124 @@
+#include <common/stdafx.h>
+
+#include <common/io/mapped_file.h>
+
+#if defined(_WIN32)
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace tjs::common {
+	MappedFile::~MappedFile() {
+		close();
+	}
+
+	MappedFile::MappedFile(MappedFile&& other) noexcept {
+		*this = std::move(other);
+	}
+
+	MappedFile& MappedFile::operator=(MappedFile&& other) noexcept {
+		if (this != &other) {
+			close();
+			_data = std::exchange(other._data, nullptr);
+			_size = std::exchange(other._size, 0);
+#if defined(_WIN32)
+			_file = std::exchange(other._file, nullptr);
+			_mapping = std::exchange(other._mapping, nullptr);
+#endif
+		}
+		return *this;
+	}
+
+#if defined(_WIN32)
+	bool MappedFile::open(const std::filesystem::path& path) {
+		close();
+
+		HANDLE file = CreateFileW(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+		if (file == INVALID_HANDLE_VALUE) {
+			return false;
+		}
+
+		LARGE_INTEGER size {};
+		if (!GetFileSizeEx(file, &size) || size.QuadPart == 0) {
+			CloseHandle(file);
+			return false;
+		}
+
+		HANDLE mapping = CreateFileMappingW(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+		if (mapping == nullptr) {
+			CloseHandle(file);
+			return false;
+		}
+
+		void* view = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+		if (view == nullptr) {
+			CloseHandle(mapping);
+			CloseHandle(file);
+			return false;
+		}
+
+		_file = file;
+		_mapping = mapping;
+		_data = static_cast<const std::byte*>(view);
+		_size = static_cast<size_t>(size.QuadPart);
+		return true;
+	}
+
+	void MappedFile::close() {
+		if (_data != nullptr) {
+			UnmapViewOfFile(_data);
+		}
+		if (_mapping != nullptr) {
+			CloseHandle(static_cast<HANDLE>(_mapping));
+		}
+		if (_file != nullptr) {
+			CloseHandle(static_cast<HANDLE>(_file));
+		}
+		_data = nullptr;
+		_size = 0;
+		_mapping = nullptr;
+		_file = nullptr;
+	}
+#else
+	bool MappedFile::open(const std::filesystem::path& path) {
+		close();
+
+		const int fd = ::open(path.c_str(), O_RDONLY);
+		if (fd < 0) {
+			return false;
+		}
+
+		struct stat st {};
+		if (::fstat(fd, &st) != 0 || st.st_size <= 0) {
+			::close(fd);
+			return false;
+		}
+
+		void* view = ::mmap(nullptr, static_cast<size_t>(st.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+		// the mapping keeps its own reference to the file
+		::close(fd);
+		if (view == MAP_FAILED) {
+			return false;
+		}
+
+		_data = static_cast<const std::byte*>(view);
+		_size = static_cast<size_t>(st.st_size);
+		return true;
+	}
+
+	void MappedFile::close() {
+		if (_data != nullptr) {
+			::munmap(const_cast<std::byte*>(_data), _size);
+		}
+		_data = nullptr;
+		_size = 0;
+	}
+#endif
+} // namespace tjs::common
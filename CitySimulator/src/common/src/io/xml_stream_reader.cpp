@@ -0,0 +1,226 @@
+#include <common/stdafx.h>
+
+#include <common/io/xml_stream_reader.h>
+
+#include <charconv>
+
+namespace tjs::common {
+	namespace {
+		bool is_space(char c) {
+			return c == ' ' || c == '\t' || c == '\n' || c == '\r';
+		}
+
+		bool is_name_end(char c) {
+			return is_space(c) || c == '/' || c == '>' || c == '=';
+		}
+
+		void append_utf8(std::string& out, uint32_t cp) {
+			if (cp < 0x80) {
+				out.push_back(static_cast<char>(cp));
+			} else if (cp < 0x800) {
+				out.push_back(static_cast<char>(0xC0 | (cp >> 6)));
+				out.push_back(static_cast<char>(0x80 | (cp & 0x3F)));
+			} else if (cp < 0x10000) {
+				out.push_back(static_cast<char>(0xE0 | (cp >> 12)));
+				out.push_back(static_cast<char>(0x80 | ((cp >> 6) & 0x3F)));
+				out.push_back(static_cast<char>(0x80 | (cp & 0x3F)));
+			} else {
+				out.push_back(static_cast<char>(0xF0 | (cp >> 18)));
+				out.push_back(static_cast<char>(0x80 | ((cp >> 12) & 0x3F)));
+				out.push_back(static_cast<char>(0x80 | ((cp >> 6) & 0x3F)));
+				out.push_back(static_cast<char>(0x80 | (cp & 0x3F)));
+			}
+		}
+	} // namespace
+
+	XmlStreamReader::Token XmlStreamReader::next() {
+		if (_pending_end) {
+			_pending_end = false;
+			return Token::EndElement;
+		}
+		if (_closing) {
+			_closing = false;
+			--_depth;
+		}
+
+		for (;;) {
+			const size_t open = _text.find('<', _pos);
+			if (open == std::string_view::npos) {
+				_pos = _text.size();
+				return _depth == 0 ? Token::End : Token::Error;
+			}
+			_pos = open;
+			const std::string_view rest = _text.substr(_pos);
+
+			if (rest.starts_with("<?")) {
+				if (!skip_past("?>")) {
+					return fail();
+				}
+			} else if (rest.starts_with("<!--")) {
+				if (!skip_past("-->")) {
+					return fail();
+				}
+			} else if (rest.starts_with("<![CDATA[")) {
+				if (!skip_past("]]>")) {
+					return fail();
+				}
+			} else if (rest.starts_with("<!")) {
+				// DOCTYPE without an internal subset
+				if (!skip_past(">")) {
+					return fail();
+				}
+			} else if (rest.starts_with("</")) {
+				const size_t name_begin = _pos + 2;
+				const size_t close = _text.find('>', name_begin);
+				if (close == std::string_view::npos || _depth == 0) {
+					return fail();
+				}
+				_name = _text.substr(name_begin, close - name_begin);
+				while (!_name.empty() && is_space(_name.back())) {
+					_name.remove_suffix(1);
+				}
+				_attributes.clear();
+				_pos = close + 1;
+				_closing = true;
+				return Token::EndElement;
+			} else {
+				if (!parse_start_tag()) {
+					return fail();
+				}
+				return Token::StartElement;
+			}
+		}
+	}
+
+	std::string_view XmlStreamReader::attribute(std::string_view name) const {
+		for (const auto& [key, value] : _attributes) {
+			if (key == name) {
+				return value;
+			}
+		}
+		return {};
+	}
+
+	std::string XmlStreamReader::decode(std::string_view raw) {
+		std::string out;
+		out.reserve(raw.size());
+		size_t pos = 0;
+		while (pos < raw.size()) {
+			const size_t amp = raw.find('&', pos);
+			if (amp == std::string_view::npos) {
+				out.append(raw.substr(pos));
+				break;
+			}
+			out.append(raw.substr(pos, amp - pos));
+
+			const size_t semi = raw.find(';', amp);
+			if (semi == std::string_view::npos) {
+				out.append(raw.substr(amp));
+				break;
+			}
+			const std::string_view entity = raw.substr(amp + 1, semi - amp - 1);
+			if (entity == "amp") {
+				out.push_back('&');
+			} else if (entity == "lt") {
+				out.push_back('<');
+			} else if (entity == "gt") {
+				out.push_back('>');
+			} else if (entity == "quot") {
+				out.push_back('"');
+			} else if (entity == "apos") {
+				out.push_back('\'');
+			} else if (entity.starts_with('#')) {
+				const bool hex = entity.size() > 1 && (entity[1] == 'x' || entity[1] == 'X');
+				const std::string_view digits = entity.substr(hex ? 2 : 1);
+				uint32_t cp = 0;
+				const auto [ptr, ec] = std::from_chars(digits.data(), digits.data() + digits.size(), cp, hex ? 16 : 10);
+				if (ec == std::errc {} && ptr == digits.data() + digits.size() && cp <= 0x10FFFF) {
+					append_utf8(out, cp);
+				} else {
+					out.append(raw.substr(amp, semi - amp + 1));
+				}
+			} else {
+				// unknown entity, keep as is
+				out.append(raw.substr(amp, semi - amp + 1));
+			}
+			pos = semi + 1;
+		}
+		return out;
+	}
+
+	bool XmlStreamReader::skip_past(std::string_view terminator) {
+		const size_t end = _text.find(terminator, _pos);
+		if (end == std::string_view::npos) {
+			return false;
+		}
+		_pos = end + terminator.size();
+		return true;
+	}
+
+	bool XmlStreamReader::parse_start_tag() {
+		_attributes.clear();
+
+		size_t pos = _pos + 1;
+		const size_t name_begin = pos;
+		while (pos < _text.size() && !is_name_end(_text[pos])) {
+			++pos;
+		}
+		if (pos == name_begin || pos >= _text.size()) {
+			return false;
+		}
+		_name = _text.substr(name_begin, pos - name_begin);
+
+		for (;;) {
+			while (pos < _text.size() && is_space(_text[pos])) {
+				++pos;
+			}
+			if (pos >= _text.size()) {
+				return false;
+			}
+
+			if (_text[pos] == '>') {
+				_pos = pos + 1;
+				++_depth;
+				return true;
+			}
+			if (_text[pos] == '/') {
+				if (pos + 1 >= _text.size() || _text[pos + 1] != '>') {
+					return false;
+				}
+				_pos = pos + 2;
+				++_depth;
+				_pending_end = true;
+				_closing = true;
+				return true;
+			}
+
+			// name="value" or name='value'
+			const size_t key_begin = pos;
+			while (pos < _text.size() && !is_name_end(_text[pos])) {
+				++pos;
+			}
+			const std::string_view key = _text.substr(key_begin, pos - key_begin);
+			while (pos < _text.size() && is_space(_text[pos])) {
+				++pos;
+			}
+			if (key.empty() || pos >= _text.size() || _text[pos] != '=') {
+				return false;
+			}
+			++pos;
+			while (pos < _text.size() && is_space(_text[pos])) {
+				++pos;
+			}
+			if (pos >= _text.size() || (_text[pos] != '"' && _text[pos] != '\'')) {
+				return false;
+			}
+			const char quote = _text[pos];
+			const size_t value_begin = pos + 1;
+			const size_t value_end = _text.find(quote, value_begin);
+			if (value_end == std::string_view::npos) {
+				return false;
+			}
+			_attributes.emplace_back(key, _text.substr(value_begin, value_end - value_begin));
+			pos = value_end + 1;
+		}
+	}
+} // namespace tjs::common
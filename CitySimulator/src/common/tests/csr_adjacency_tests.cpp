@@ -0,0 +1,39 @@
+#include <stdafx.h>
+
+#include <common/csr_adjacency.h>
+
+using namespace tjs::common;
+
+TEST(CsrAdjacencyTest, AssignGroupsByRowInInputOrder) {
+	CsrAdjacency<int> csr;
+	csr.assign(4, { { 2, 20 }, { 0, 1 }, { 2, 21 }, { 0, 2 }, { 2, 22 } });
+
+	ASSERT_EQ(csr.rows(), 4);
+	EXPECT_EQ(csr.size(), 5);
+	EXPECT_TRUE(std::ranges::equal(csr[0], std::vector { 1, 2 }));
+	EXPECT_TRUE(csr[1].empty());
+	EXPECT_TRUE(std::ranges::equal(csr[2], std::vector { 20, 21, 22 }));
+	EXPECT_TRUE(csr[3].empty());
+}
+
+TEST(CsrAdjacencyTest, RowByRow) {
+	CsrAdjacency<int> csr;
+	EXPECT_EQ(csr.rows(), 0);
+
+	csr.clear();
+	csr.targets.push_back(7);
+	csr.close_row();
+	csr.close_row();
+	csr.targets.push_back(8);
+	csr.targets.push_back(9);
+	csr.close_row();
+
+	ASSERT_EQ(csr.rows(), 3);
+	EXPECT_TRUE(std::ranges::equal(csr[0], std::vector { 7 }));
+	EXPECT_TRUE(csr[1].empty());
+	EXPECT_TRUE(std::ranges::equal(csr[2], std::vector { 8, 9 }));
+
+	csr.clear();
+	EXPECT_EQ(csr.rows(), 0);
+	EXPECT_EQ(csr.size(), 0);
+}
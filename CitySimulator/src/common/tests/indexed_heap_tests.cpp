@@ -0,0 +1,67 @@
+#include <stdafx.h>
+
+#include <common/indexed_heap.h>
+
+#include <random>
+
+using namespace tjs::common;
+
+TEST(IndexedHeapTest, PopsInKeyOrder) {
+	IndexedDaryHeap<4> heap;
+	heap.resize(1000);
+
+	std::mt19937 rng(7);
+	std::uniform_real_distribution<double> key(0.0, 100.0);
+	std::vector<double> keys(1000);
+	for (uint32_t id = 0; id < keys.size(); ++id) {
+		keys[id] = key(rng);
+		heap.push_or_decrease(id, keys[id]);
+	}
+	EXPECT_EQ(heap.size(), keys.size());
+
+	double previous = -1.0;
+	while (!heap.empty()) {
+		const double top_key = heap.top_key();
+		const uint32_t id = heap.pop();
+		EXPECT_EQ(keys[id], top_key);
+		EXPECT_LE(previous, top_key);
+		EXPECT_FALSE(heap.contains(id));
+		previous = top_key;
+	}
+}
+
+TEST(IndexedHeapTest, DecreaseKeyKeepsOneEntry) {
+	IndexedDaryHeap<4> heap;
+	heap.resize(8);
+	heap.push_or_decrease(1, 10.0);
+	heap.push_or_decrease(2, 5.0);
+	heap.push_or_decrease(3, 7.0);
+
+	heap.push_or_decrease(1, 1.0);
+	heap.push_or_decrease(3, 9.0); // higher key is ignored
+	EXPECT_EQ(heap.size(), 3);
+
+	EXPECT_EQ(heap.top(), 1);
+	EXPECT_EQ(heap.top_key(), 1.0);
+	EXPECT_EQ(heap.pop(), 1);
+	EXPECT_EQ(heap.pop(), 2);
+	EXPECT_EQ(heap.top_key(), 7.0);
+	EXPECT_EQ(heap.pop(), 3);
+	EXPECT_TRUE(heap.empty());
+}
+
+TEST(IndexedHeapTest, ClearForgetsQueuedIds) {
+	IndexedDaryHeap<2> heap;
+	heap.resize(4);
+	heap.push_or_decrease(0, 3.0);
+	heap.push_or_decrease(3, 1.0);
+	heap.clear();
+
+	EXPECT_TRUE(heap.empty());
+	EXPECT_FALSE(heap.contains(0));
+	EXPECT_FALSE(heap.contains(3));
+
+	heap.push_or_decrease(3, 2.0);
+	EXPECT_EQ(heap.size(), 1);
+	EXPECT_EQ(heap.pop(), 3);
+}
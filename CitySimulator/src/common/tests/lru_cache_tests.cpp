@@ -0,0 +1,61 @@
+#include <stdafx.h>
+
+#include <common/lru_cache.h>
+
+using namespace tjs::common;
+
+TEST(LruCacheTest, EvictsLeastRecentlyUsed) {
+	LruCache<int, std::string> cache(2);
+	cache.insert(1, "one");
+	cache.insert(2, "two");
+
+	// touching 1 leaves 2 as the oldest
+	ASSERT_NE(cache.find(1), nullptr);
+	cache.insert(3, "three");
+
+	EXPECT_EQ(cache.size(), 2);
+	EXPECT_EQ(cache.find(2), nullptr);
+	ASSERT_NE(cache.find(1), nullptr);
+	EXPECT_EQ(*cache.find(1), "one");
+	ASSERT_NE(cache.find(3), nullptr);
+	EXPECT_EQ(*cache.find(3), "three");
+	EXPECT_EQ(cache.stats().evictions, 1);
+}
+
+TEST(LruCacheTest, CountsHitsAndMisses) {
+	LruCache<int, int> cache(4);
+	EXPECT_EQ(cache.find(1), nullptr);
+	cache.insert(1, 10);
+	cache.insert(1, 11); // replaces
+	ASSERT_NE(cache.find(1), nullptr);
+	EXPECT_EQ(*cache.find(1), 11);
+
+	EXPECT_EQ(cache.size(), 1);
+	EXPECT_EQ(cache.stats().hits, 2);
+	EXPECT_EQ(cache.stats().misses, 1);
+
+	cache.reset_stats();
+	EXPECT_EQ(cache.stats().hits, 0);
+}
+
+TEST(LruCacheTest, CapacityBoundsSize) {
+	LruCache<int, int> disabled;
+	disabled.insert(1, 1);
+	EXPECT_EQ(disabled.size(), 0);
+	EXPECT_EQ(disabled.find(1), nullptr);
+
+	LruCache<int, int> cache(8);
+	for (int i = 0; i < 8; ++i) {
+		cache.insert(i, i);
+	}
+	cache.set_capacity(3);
+	EXPECT_EQ(cache.size(), 3);
+	for (int i = 5; i < 8; ++i) {
+		EXPECT_NE(cache.find(i), nullptr);
+	}
+	EXPECT_EQ(cache.find(4), nullptr);
+
+	cache.clear();
+	EXPECT_EQ(cache.size(), 0);
+	EXPECT_EQ(cache.find(7), nullptr);
+}
@@ -0,0 +1,51 @@
+#include <stdafx.h>
+#include <common/io/mapped_file.h>
+
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <numeric>
+
+using namespace tjs::common;
+
+namespace {
+	std::filesystem::path temp_file(std::string_view name) {
+		return std::filesystem::temp_directory_path() / name;
+	}
+} // namespace
+
+TEST(mapped_file, maps_whole_file) {
+	const auto path = temp_file("tjs_mapped_file_test.bin");
+	std::vector<uint32_t> values(10000);
+	std::iota(values.begin(), values.end(), 0u);
+	{
+		std::ofstream out(path, std::ios::binary | std::ios::trunc);
+		out.write(reinterpret_cast<const char*>(values.data()), values.size() * sizeof(uint32_t));
+	}
+
+	MappedFile file;
+	ASSERT_TRUE(file.open(path));
+	ASSERT_EQ(file.size(), values.size() * sizeof(uint32_t));
+	EXPECT_EQ(std::memcmp(file.data().data(), values.data(), file.size()), 0);
+
+	// moving keeps the mapping alive
+	MappedFile moved = std::move(file);
+	EXPECT_FALSE(file.is_open());
+	ASSERT_TRUE(moved.is_open());
+	EXPECT_EQ(reinterpret_cast<const uint32_t*>(moved.data().data())[9999], 9999u);
+
+	moved.close();
+	EXPECT_FALSE(moved.is_open());
+	std::filesystem::remove(path);
+}
+
+TEST(mapped_file, missing_or_empty_file_fails) {
+	MappedFile file;
+	EXPECT_FALSE(file.open(temp_file("tjs_mapped_file_missing.bin")));
+
+	const auto path = temp_file("tjs_mapped_file_empty.bin");
+	std::ofstream(path, std::ios::binary | std::ios::trunc).close();
+	EXPECT_FALSE(file.open(path));
+	EXPECT_FALSE(file.is_open());
+	std::filesystem::remove(path);
+}
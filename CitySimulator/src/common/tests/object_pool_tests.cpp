@@ -231,6 +231,55 @@ TEST_F(object_pool_fixture, reserve_exact_fit_then_grow) {
 	pool.release(extra);
 }
 
+// 8) Pools of one type share the thread cache, but never each other's slots
+TEST_F(object_pool_fixture, two_pools_of_one_type_keep_their_slots) {
+	pool8x4_t<> first;
+	auto kept = acquire_n(first, 3);
+	first.release(kept.back()); // cached on this thread for `first`
+	kept.pop_back();
+
+	std::unordered_set<test_obj*> second_objects;
+	{
+		pool8x4_t<> second;
+		for (int i = 0; i < 12; ++i) {
+			auto pp = second.acquire(100 + i);
+			ASSERT_EQ(second.get(pp.idx), pp.ptr);
+			second_objects.insert(pp.ptr);
+			if (i % 3 == 0) {
+				second.release(pp); // its slot goes to this thread's cache
+				second_objects.erase(pp.ptr);
+			}
+		}
+		for (auto& pp : kept) {
+			EXPECT_EQ(second_objects.count(pp.ptr), 0u);
+		}
+
+		// back to `first`: the cache of `second` is returned to it
+		auto pp = first.acquire(7);
+		EXPECT_EQ(second_objects.count(pp.ptr), 0u);
+		EXPECT_EQ(first.get(pp.idx), pp.ptr);
+		kept.push_back(pp);
+		for (const auto& p : kept) {
+			EXPECT_GE(p->id, 1u);
+			EXPECT_LT(p->id, 100u);
+		}
+	}
+
+	// `second` is gone, its cached ids must not leak into `first`
+	for (int i = 0; i < 8; ++i) {
+		kept.push_back(first.acquire(200 + i));
+	}
+	std::unordered_set<test_obj*> unique;
+	for (auto& pp : kept) {
+		EXPECT_EQ(first.get(pp.idx), pp.ptr);
+		unique.insert(pp.ptr);
+	}
+	EXPECT_EQ(unique.size(), kept.size());
+	for (auto& pp : kept) {
+		first.release(pp);
+	}
+}
+
 // ---------------- ObjectPoolExt Tests ----------------
 class object_pool_ext_fixture : public object_pool_fixture {};
 
@@ -241,7 +290,7 @@ using ext_pool_t = ObjectPoolExt<test_obj, BS, TLS>;
 // 1) Empty snapshot is empty
 TEST_F(object_pool_ext_fixture, snapshot_empty) {
 	ext_pool_t<> pool;
-	const auto& vec = pool.objects(); // triggers update_objects() once
+	const auto& vec = pool.objects();
 	EXPECT_TRUE(vec.empty());
 }
 
@@ -373,7 +422,7 @@ TEST_F(object_pool_ext_fixture, release_pointer_across_slabs) {
 	EXPECT_EQ(s.count(ptrs[6]), 1u);
 }
 
-// 8) Concurrency note: update_objects is main-thread-only; but we can
+// 8) Concurrency note: objects() is main-thread-only; but we can
 // still stress concurrent alloc/free then snapshot on main thread.
 TEST_F(object_pool_ext_fixture, concurrent_mutations_then_snapshot) {
 	ext_pool_t<4, 4> pool;
@@ -414,3 +463,104 @@ TEST_F(object_pool_ext_fixture, destruction_cleans_even_without_snapshot) {
 	}
 	// TearDown will check live==0
 }
+
+// 10) Handles resolve in O(1) and go stale once their object is released
+TEST_F(object_pool_ext_fixture, handle_goes_stale_on_release) {
+	ext_pool_t<4, 2> pool;
+	using handle_t = ext_pool_t<4, 2>::handle;
+
+	EXPECT_EQ(pool.resolve(handle_t {}), nullptr);
+
+	std::vector<handle_t> handles;
+	for (int i = 0; i < 6; ++i) {
+		handles.push_back(pool.acquire_handle(i + 1)); // 2 slabs
+	}
+	for (int i = 0; i < 6; ++i) {
+		ASSERT_NE(pool.resolve(handles[i]), nullptr);
+		EXPECT_EQ(pool.resolve(handles[i])->id, uint64_t(i + 1));
+	}
+
+	const handle_t old = handles[4];
+	pool.release(old);
+	EXPECT_EQ(pool.resolve(old), nullptr);
+	EXPECT_EQ(pool.objects().size(), 5u);
+
+	// the slot is reused, the old handle still does not reach the new object
+	const handle_t reused = pool.acquire_handle(42);
+	EXPECT_EQ(reused.index(), old.index());
+	EXPECT_NE(reused, old);
+	EXPECT_EQ(pool.resolve(old), nullptr);
+	ASSERT_NE(pool.resolve(reused), nullptr);
+	EXPECT_EQ(pool.resolve(reused)->id, 42u);
+
+	// releasing through a stale handle leaves the new object alone
+	pool.release(old);
+	EXPECT_NE(pool.resolve(reused), nullptr);
+	EXPECT_EQ(pool.objects().size(), 6u);
+}
+
+// 11) Release by pointer and clear() make handles stale too
+TEST_F(object_pool_ext_fixture, handle_stale_after_pointer_release_and_clear) {
+	ext_pool_t<> pool;
+
+	const auto first = pool.acquire_handle(1);
+	const auto second = pool.acquire_handle(2);
+	pool.release(pool.resolve(first));
+	EXPECT_EQ(pool.resolve(first), nullptr);
+	EXPECT_NE(pool.resolve(second), nullptr);
+
+	pool.clear();
+	EXPECT_EQ(pool.resolve(second), nullptr);
+	EXPECT_TRUE(pool.objects().empty());
+}
+
+// 12) Under churn objects() always holds exactly the live objects, once each
+TEST_F(object_pool_ext_fixture, live_list_follows_churn) {
+	ext_pool_t<4, 2> pool;
+	using handle_t = ext_pool_t<4, 2>::handle;
+
+	std::vector<handle_t> live;
+	std::mt19937 rng(7);
+	for (int step = 0; step < 500; ++step) {
+		if (live.empty() || rng() % 3 != 0) {
+			live.push_back(pool.acquire_handle(step));
+		} else {
+			const size_t i = rng() % live.size();
+			pool.release(live[i]);
+			live[i] = live.back();
+			live.pop_back();
+		}
+
+		const auto& objs = pool.objects();
+		ASSERT_EQ(objs.size(), live.size());
+		std::unordered_set<test_obj*> s(objs.begin(), objs.end());
+		ASSERT_EQ(s.size(), objs.size());
+		for (const handle_t& h : live) {
+			ASSERT_EQ(s.count(pool.resolve(h)), 1u);
+		}
+	}
+}
+
+// 13) Slots a handle cannot address are refused instead of aliasing lower ones
+TEST(object_pool_ext, refuses_slots_beyond_handle_range) {
+	using pool_t = ObjectPoolExt<uint8_t, (1u << 20)>;
+	using handle_t = pool_t::handle;
+	pool_t pool;
+
+	handle_t last {};
+	for (uint32_t i = 0; i <= handle_t::MAX_INDEX; ++i) {
+		last = pool.acquire_handle(uint8_t(i));
+		ASSERT_TRUE(last.valid());
+	}
+
+	EXPECT_FALSE(pool.acquire_handle(uint8_t(1)).valid());
+	EXPECT_EQ(pool.acquire_ptr(uint8_t(1)), nullptr);
+	EXPECT_EQ(pool.objects().size(), size_t(handle_t::MAX_INDEX) + 1);
+
+	// freed slots in range are handed out again
+	pool.release(last);
+	const handle_t reused = pool.acquire_handle(uint8_t(2));
+	ASSERT_TRUE(reused.valid());
+	EXPECT_EQ(reused.index(), last.index());
+	EXPECT_NE(reused, last);
+}
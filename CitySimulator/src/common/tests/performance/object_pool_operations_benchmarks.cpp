@@ -195,3 +195,81 @@ BENCHMARK(bm_vector_contiguous_create_iter_destroy)
     ->Arg(1 << 10)
     ->Arg(1 << 15)
     ->Arg(1 << 20);
+
+// -------------------------------------------------------------
+// 4) EXT POOL — CHURN: a live population where a few objects are
+// released and acquired every step (vehicles leaving and spawning),
+// then the whole live list is walked like a simulation step does.
+// Args: live objects, objects replaced per step.
+// -------------------------------------------------------------
+
+class churn_pool_fixture : public benchmark::Fixture {
+public:
+    using pool_t   = tjs::common::ObjectPoolExt<simple_t>;
+    using handle_t = pool_t::handle;
+
+    void SetUp(const ::benchmark::State& state) override {
+        pool_.clear();
+        live_.clear();
+        const std::size_t n = static_cast<std::size_t>(state.range(0));
+        pool_.reserve(n);
+        for (std::size_t i = 0; i < n; ++i) {
+            live_.push_back(pool_.acquire_handle());
+        }
+        rng_.seed(42);
+    }
+
+    void TearDown(const ::benchmark::State&) override {
+        pool_.clear();
+        live_.clear();
+    }
+
+protected:
+    // replace `churn` random live objects
+    void churn(std::size_t churn) {
+        std::uniform_int_distribution<std::size_t> pick(0, live_.size() - 1);
+        for (std::size_t i = 0; i < churn; ++i) {
+            handle_t& h = live_[pick(rng_)];
+            pool_.release(h);
+            h = pool_.acquire_handle();
+        }
+    }
+
+    pool_t pool_;
+    std::vector<handle_t> live_;
+    std::mt19937 rng_;
+};
+
+// release + acquire `churn` objects, then iterate all live ones
+BENCHMARK_DEFINE_F(churn_pool_fixture, churn_step)(benchmark::State& state) {
+    const std::size_t churn_per_step = static_cast<std::size_t>(state.range(1));
+    for (auto _ : state) {
+        churn(churn_per_step);
+        for (simple_t* p : pool_.objects()) {
+            trivial_op(p);
+        }
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) * state.range(0));
+}
+
+BENCHMARK_REGISTER_F(churn_pool_fixture, churn_step)
+    ->Name("ext_pool/churn_step")
+    ->Args({ 1 << 15, 64 })
+    ->Args({ 1 << 17, 256 })
+    ->Args({ 1 << 17, 4096 });
+
+// release + acquire one object and look at the live list each time,
+// the worst case for a list rebuilt on demand
+BENCHMARK_DEFINE_F(churn_pool_fixture, churn_each)(benchmark::State& state) {
+    for (auto _ : state) {
+        churn(1);
+        benchmark::DoNotOptimize(pool_.objects().data());
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations()));
+}
+
+BENCHMARK_REGISTER_F(churn_pool_fixture, churn_each)
+    ->Name("ext_pool/churn_each")
+    ->Args({ 1 << 15, 1 })
+    ->Args({ 1 << 17, 1 });
@@ -44,3 +44,110 @@ TEST(RTreeTest, HandlesManyInserts) {
 		EXPECT_EQ(out[i - 2], i);
 	}
 }
+
+TEST(RTreeTest, NearestMatchesSortedDistances) {
+	RTree<int> tree;
+	std::vector<BoundingBox> boxes;
+	// deterministic scatter, some boxes overlap
+	for (int i = 0; i < 200; i++) {
+		const double x = (i * 37) % 101;
+		const double y = (i * 53) % 97;
+		boxes.push_back({ x, y, x + (i % 3), y + (i % 5) });
+		tree.insert(boxes.back(), i);
+	}
+
+	const double px = 42.3;
+	const double py = 17.8;
+	std::vector<int> out;
+	tree.nearest(px, py, 10, std::back_inserter(out));
+	ASSERT_EQ(out.size(), 10);
+
+	std::vector<double> expected;
+	for (const auto& box : boxes) {
+		expected.push_back(box_distance(box, px, py));
+	}
+	std::sort(expected.begin(), expected.end());
+	for (size_t i = 0; i < out.size(); i++) {
+		EXPECT_DOUBLE_EQ(box_distance(boxes[out[i]], px, py), expected[i]);
+	}
+}
+
+TEST(RTreeTest, NearestRespectsMaxDistanceAndMetric) {
+	RTree<int> tree;
+	for (int i = 0; i < 10; i++) {
+		tree.insert(BoundingBox { double(i), 0.0, double(i), 0.0 }, i);
+	}
+
+	std::vector<int> out;
+	tree.nearest(0.0, 0.0, 10, std::back_inserter(out), 2.5);
+	EXPECT_EQ(out, (std::vector<int> { 0, 1, 2 }));
+
+	// odd values are filtered out by the metric
+	out.clear();
+	tree.nearest(0.0, 0.0, 3, std::back_inserter(out), [](int value, const BoundingBox& box) {
+		return value % 2 ? std::numeric_limits<double>::infinity() : box.min_x;
+	});
+	EXPECT_EQ(out, (std::vector<int> { 0, 2, 4 }));
+
+	// skipped values are not reported even when nothing else is left
+	out.clear();
+	tree.nearest(0.0, 0.0, 3, std::back_inserter(out), [](int value, const BoundingBox& box) {
+		return value > 0 ? std::numeric_limits<double>::infinity() : box.min_x;
+	});
+	EXPECT_EQ(out, (std::vector<int> { 0 }));
+
+	RTree<int> empty;
+	out.clear();
+	empty.nearest(0.0, 0.0, 3, std::back_inserter(out));
+	EXPECT_TRUE(out.empty());
+}
+
+TEST(RTreeTest, FlattenRoundTrip) {
+	RTree<int> tree;
+	for (int i = 0; i < 200; i++) {
+		const double x = (i * 37) % 101;
+		const double y = (i * 53) % 97;
+		tree.insert(BoundingBox { x, y, x + 1.5, y + 0.5 }, i);
+	}
+
+	std::vector<RTree<int>::FlatNode> nodes;
+	std::vector<BoundingBox> boxes;
+	std::vector<int> values;
+	tree.flatten(nodes, boxes, values);
+	ASSERT_EQ(values.size(), 200u);
+	ASSERT_GT(nodes.size(), 1u);
+
+	RTree<int> restored;
+	ASSERT_TRUE(restored.unflatten(nodes, boxes, values));
+	EXPECT_EQ(restored.size(), tree.size());
+
+	// same shape, so the same answers in the same order
+	std::vector<RTree<int>::FlatNode> again_nodes;
+	std::vector<BoundingBox> again_boxes;
+	std::vector<int> again_values;
+	restored.flatten(again_nodes, again_boxes, again_values);
+	EXPECT_EQ(again_values, values);
+	ASSERT_EQ(again_nodes.size(), nodes.size());
+	for (size_t i = 0; i < nodes.size(); ++i) {
+		EXPECT_EQ(again_nodes[i].first, nodes[i].first);
+		EXPECT_EQ(again_nodes[i].count, nodes[i].count);
+	}
+
+	std::vector<int> expected;
+	std::vector<int> out;
+	tree.nearest(40.0, 40.0, 15, std::back_inserter(expected));
+	restored.nearest(40.0, 40.0, 15, std::back_inserter(out));
+	EXPECT_EQ(out, expected);
+
+	// a node pointing back at itself is rejected
+	auto broken = nodes;
+	broken[0].first = 0;
+	EXPECT_FALSE(restored.unflatten(broken, boxes, values));
+	EXPECT_EQ(restored.size(), 0u);
+
+	RTree<int> empty;
+	empty.flatten(nodes, boxes, values);
+	EXPECT_TRUE(nodes.empty());
+	EXPECT_TRUE(restored.unflatten(nodes, boxes, values));
+	EXPECT_EQ(restored.size(), 0u);
+}
@@ -0,0 +1,69 @@
+#include <stdafx.h>
+#include <common/threading/worker_pool.h>
+
+using namespace tjs::common;
+
+TEST(worker_pool, single_worker_runs_inline) {
+	WorkerPool pool(1);
+	EXPECT_EQ(pool.size(), 1u);
+
+	const auto caller = std::this_thread::get_id();
+	std::vector<size_t> order;
+	pool.parallel_for(5, [&](size_t task, size_t worker) {
+		EXPECT_EQ(worker, 0u);
+		EXPECT_EQ(std::this_thread::get_id(), caller);
+		order.push_back(task);
+	});
+	EXPECT_EQ(order, (std::vector<size_t> { 0, 1, 2, 3, 4 }));
+}
+
+TEST(worker_pool, every_task_runs_once) {
+	WorkerPool pool(4);
+	EXPECT_EQ(pool.size(), 4u);
+
+	constexpr size_t TASKS = 1000;
+	std::vector<std::atomic<int>> hits(TASKS);
+	std::atomic<bool> bad_worker { false };
+
+	// several rounds to exercise the wake/join handshake
+	for (int round = 0; round < 50; ++round) {
+		pool.parallel_for(TASKS, [&](size_t task, size_t worker) {
+			if (worker >= pool.size()) {
+				bad_worker = true;
+			}
+			hits[task].fetch_add(1, std::memory_order_relaxed);
+		});
+	}
+
+	EXPECT_FALSE(bad_worker.load());
+	for (size_t i = 0; i < TASKS; ++i) {
+		EXPECT_EQ(hits[i].load(), 50) << "task " << i;
+	}
+}
+
+TEST(worker_pool, resize_keeps_pool_usable) {
+	WorkerPool pool(2);
+	pool.resize(3);
+	EXPECT_EQ(pool.size(), 3u);
+
+	std::atomic<size_t> sum { 0 };
+	pool.parallel_for(100, [&](size_t task, size_t) { sum += task; });
+	EXPECT_EQ(sum.load(), 4950u);
+
+	// workers spawned after a job must wait for the next one, not return
+	// from the finished one and let parallel_for end early
+	for (int round = 0; round < 200; ++round) {
+		pool.resize(2 + round % 3);
+		std::vector<std::atomic<int>> hits(16);
+		pool.parallel_for(hits.size(), [&](size_t task, size_t) {
+			std::this_thread::sleep_for(std::chrono::microseconds(20));
+			++hits[task];
+		});
+		for (const auto& hit : hits) {
+			ASSERT_EQ(hit.load(), 1);
+		}
+	}
+
+	pool.resize(0);
+	EXPECT_GE(pool.size(), 1u);
+}
@@ -0,0 +1,74 @@
+#include <stdafx.h>
+#include <common/io/xml_stream_reader.h>
+
+using namespace tjs::common;
+using Token = XmlStreamReader::Token;
+
+TEST(xml_stream_reader, walks_elements_and_attributes) {
+	const std::string_view text = R"(<?xml version="1.0" encoding="UTF-8"?>
+<!-- generator -->
+<osm version="0.6">
+	<node id="1" lat='0.5' lon="1.5"/>
+	<way id="2">
+		<nd ref="1" />
+		<tag k="name" v="A &amp; B &#x410;"/>
+		text is skipped
+	</way>
+</osm>
+)";
+
+	XmlStreamReader reader(text);
+	ASSERT_EQ(reader.next(), Token::StartElement);
+	EXPECT_EQ(reader.name(), "osm");
+	EXPECT_EQ(reader.depth(), 1u);
+	EXPECT_EQ(reader.attribute("version"), "0.6");
+
+	ASSERT_EQ(reader.next(), Token::StartElement);
+	EXPECT_EQ(reader.name(), "node");
+	EXPECT_EQ(reader.depth(), 2u);
+	ASSERT_EQ(reader.attributes().size(), 3u);
+	EXPECT_EQ(reader.attribute("lat"), "0.5");
+	EXPECT_EQ(reader.attribute("lon"), "1.5");
+	EXPECT_EQ(reader.attribute("missing"), "");
+	ASSERT_EQ(reader.next(), Token::EndElement);
+	EXPECT_EQ(reader.name(), "node");
+	EXPECT_EQ(reader.depth(), 2u);
+
+	ASSERT_EQ(reader.next(), Token::StartElement);
+	EXPECT_EQ(reader.name(), "way");
+	EXPECT_EQ(reader.depth(), 2u);
+	ASSERT_EQ(reader.next(), Token::StartElement);
+	EXPECT_EQ(reader.name(), "nd");
+	EXPECT_EQ(reader.depth(), 3u);
+	ASSERT_EQ(reader.next(), Token::EndElement);
+	ASSERT_EQ(reader.next(), Token::StartElement);
+	EXPECT_EQ(reader.name(), "tag");
+	EXPECT_EQ(reader.attribute_text("v"), "A & B \xD0\x90");
+	ASSERT_EQ(reader.next(), Token::EndElement);
+	ASSERT_EQ(reader.next(), Token::EndElement);
+	EXPECT_EQ(reader.name(), "way");
+	EXPECT_EQ(reader.depth(), 2u);
+
+	ASSERT_EQ(reader.next(), Token::EndElement);
+	EXPECT_EQ(reader.name(), "osm");
+	EXPECT_EQ(reader.depth(), 1u);
+	EXPECT_EQ(reader.next(), Token::End);
+	EXPECT_EQ(reader.offset(), reader.size());
+}
+
+TEST(xml_stream_reader, reports_malformed_input) {
+	for (std::string_view text : { "<osm><node id=\"1\"", "<osm><node id=1/></osm>", "<osm>", "</osm>", "<osm><!-- open" }) {
+		XmlStreamReader reader(text);
+		Token token = Token::StartElement;
+		while (token != Token::End && token != Token::Error) {
+			token = reader.next();
+		}
+		EXPECT_EQ(token, Token::Error) << text;
+	}
+}
+
+TEST(xml_stream_reader, decodes_references) {
+	EXPECT_EQ(XmlStreamReader::decode("&lt;a&gt; &quot;b&quot; &apos;c&apos;"), "<a> \"b\" 'c'");
+	EXPECT_EQ(XmlStreamReader::decode("&#65;&#x42;"), "AB");
+	EXPECT_EQ(XmlStreamReader::decode("&unknown; & tail"), "&unknown; & tail");
+}
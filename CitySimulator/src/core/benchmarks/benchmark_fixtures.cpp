@@ -0,0 +1,49 @@
+#include "stdafx.h"
+
+#include <benchmark_fixtures.h>
+
+#include <core/data_layer/world_creator.h>
+#include <core/store_models/vehicle_analyze_data.h>
+#include <core/simulation/agent/agent_generator.h>
+
+namespace tjs::core::benchmarks {
+	std::filesystem::path sample_file(std::string_view name) {
+		auto benchmarks_folder = std::filesystem::path(__FILE__).parent_path();
+		auto repo_root = benchmarks_folder.parent_path().parent_path().parent_path().parent_path();
+		return repo_root / "sample_maps" / name;
+	}
+
+	SimulationSetup& populated_simulation(std::string_view map, size_t vehicles) {
+		static std::map<std::pair<std::string, size_t>, std::unique_ptr<SimulationSetup>> cache;
+
+		auto key = std::make_pair(std::string(map), vehicles);
+		if (auto it = cache.find(key); it != cache.end()) {
+			return *it->second;
+		}
+
+		auto setup = std::make_unique<SimulationSetup>();
+		if (!WorldCreator::loadOSMData(setup->world, sample_file(map).string())) {
+			throw std::runtime_error("Failed to load benchmark map " + std::string(map));
+		}
+
+		setup->store.create<model::VehicleAnalyzeData>();
+
+		auto& settings = setup->settings;
+		settings.randomSeed = false;
+		settings.seedValue = 42;
+		settings.vehiclesCount = vehicles;
+		settings.movement_algo = MovementAlgoType::IDM;
+		settings.generator_type = simulation::GeneratorType::Bulk;
+
+		setup->system = std::make_unique<simulation::TrafficSimulationSystem>(setup->world, setup->store, settings);
+		setup->system->initialize();
+
+		// generator spawns in batches and needs moving traffic to free the lanes
+		auto* generator = setup->system->agent_manager().get_generator();
+		while (!generator->is_done()) {
+			setup->system->step();
+		}
+
+		return *cache.emplace(key, std::move(setup)).first->second;
+	}
+} // namespace tjs::core::benchmarks
@@ -0,0 +1,24 @@
+#pragma once
+
+#include <core/data_layer/world_data.h>
+#include <core/store_models/idata_model.h>
+#include <core/simulation/simulation_settings.h>
+#include <core/simulation/simulation_system.h>
+
+namespace tjs::core::benchmarks {
+	// File from sample_maps/
+	std::filesystem::path sample_file(std::string_view name);
+
+	struct SimulationSetup {
+		WorldData world;
+		model::DataModelStore store;
+		SimulationSettings settings;
+		std::unique_ptr<simulation::TrafficSimulationSystem> system;
+	};
+
+	// Map from sample_maps/ with a running IDM simulation stepped until the bulk
+	// generator placed `vehicles` agents (or gave up because the map is full).
+	// Built once per (map, vehicles) and shared by every benchmark of the process.
+	SimulationSetup& populated_simulation(std::string_view map, size_t vehicles);
+
+} // namespace tjs::core::benchmarks
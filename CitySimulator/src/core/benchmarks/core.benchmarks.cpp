@@ -0,0 +1,35 @@
+#include "stdafx.h"
+
+// Results are always written as JSON (core_benchmarks.json next to the executable,
+// i.e. in the build directory, unless --benchmark_out is given) so runs can be
+// compared between releases without dirtying the source tree.
+int main(int argc, char* argv[]) {
+	std::vector<char*> args(argv, argv + argc);
+
+	bool has_out = false;
+	bool has_format = false;
+	for (int i = 1; i < argc; ++i) {
+		const std::string_view arg = argv[i];
+		has_out |= arg.starts_with("--benchmark_out=");
+		has_format |= arg.starts_with("--benchmark_out_format=");
+	}
+
+	const std::filesystem::path out_path = std::filesystem::absolute(argv[0]).parent_path() / "core_benchmarks.json";
+	std::string out_arg = "--benchmark_out=" + out_path.string();
+	std::string format_arg = "--benchmark_out_format=json";
+	if (!has_out) {
+		args.push_back(out_arg.data());
+	}
+	if (!has_format) {
+		args.push_back(format_arg.data());
+	}
+
+	int args_count = static_cast<int>(args.size());
+	::benchmark::Initialize(&args_count, args.data());
+	if (::benchmark::ReportUnrecognizedArguments(args_count, args.data())) {
+		return 1;
+	}
+	::benchmark::RunSpecifiedBenchmarks();
+	::benchmark::Shutdown();
+	return 0;
+}
@@ -0,0 +1,154 @@
+#include "stdafx.h"
+
+#include <benchmark_fixtures.h>
+
+#include <core/data_layer/vehicle.h>
+#include <core/simulation/movement/idm/idm_kernel.h>
+#include <core/simulation/movement/idm/idm_utils.h>
+#include <core/simulation/movement/idm/lane_agnostic_movement.h>
+
+using namespace tjs::core;
+using namespace tjs::core::simulation;
+
+namespace {
+	constexpr std::string_view KERNEL_MAP = "10k_lanes_grid.osmx";
+	constexpr size_t KERNEL_VEHICLES = 10'000;
+
+	const std::vector<LaneRuntime>& lanes() {
+		return benchmarks::populated_simulation(KERNEL_MAP, KERNEL_VEHICLES).system->vehicle_system().lane_runtime();
+	}
+
+	void set_vehicle_counters(benchmark::State& state, size_t vehicles) {
+		state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * vehicles));
+		state.counters["vehicles"] = static_cast<double>(vehicles);
+	}
+
+	size_t count_vehicles(const std::vector<LaneRuntime>& lane_rt) {
+		size_t count = 0;
+		for (const auto& rt : lane_rt) {
+			count += rt.idx.size();
+		}
+		return count;
+	}
+} // namespace
+
+// Car-following the way phase 1 did it before packing: pointer chasing through
+// LaneRuntime::idx and one idm_scalar (with std::pow) per follower.
+static void BM_IDM_CarFollowing_Pointers(benchmark::State& state) {
+	const auto& lane_rt = lanes();
+	const idm::idm_params_t p {};
+
+	for (auto _ : state) {
+		float sum = 0.0f;
+		for (const LaneRuntime& rt : lane_rt) {
+			const auto& idx = rt.idx;
+			for (size_t k = 0; k < idx.size(); ++k) {
+				const Vehicle* vehicle = idx[k];
+				float s_gap = idm::FREE_ROAD_GAP;
+				if (k > 0) {
+					s_gap = idm::actual_gap(idx[k - 1]->s_on_lane(), vehicle->s_on_lane(), idx[k - 1]->length(), vehicle->length());
+				}
+				sum += idm::idm_scalar(vehicle->currentSpeed(), vehicle->currentSpeed(), s_gap, p);
+			}
+		}
+		benchmark::DoNotOptimize(sum);
+	}
+	set_vehicle_counters(state, count_vehicles(lane_rt));
+}
+BENCHMARK(BM_IDM_CarFollowing_Pointers)->Unit(benchmark::kMicrosecond);
+
+// Same work the way phase 1 does it now: every lane packed into one batch, one kernel call
+static void BM_IDM_CarFollowing_Packed(benchmark::State& state) {
+	const auto& lane_rt = lanes();
+	const idm::idm_params_t p {};
+	const auto isa = static_cast<idm::KernelIsa>(state.range(0));
+	state.SetLabel(idm::to_string(isa));
+
+	idm::LaneSoA soa;
+	const size_t total = count_vehicles(lane_rt);
+	for (auto _ : state) {
+		soa.resize(total);
+		size_t offset = 0;
+		for (const LaneRuntime& rt : lane_rt) {
+			const auto& idx = rt.idx;
+			for (size_t k = 0; k < idx.size(); ++k) {
+				soa.s_on_lane[offset + k] = static_cast<float>(idx[k]->s_on_lane());
+				soa.v_follower[offset + k] = idx[k]->currentSpeed();
+				soa.length[offset + k] = idx[k]->length();
+			}
+			idm::build_leader_inputs(soa, offset, idx.size());
+			offset += idx.size();
+		}
+		idm::idm_accel_batch(soa, total, p, isa);
+		benchmark::DoNotOptimize(soa.accel.data());
+		benchmark::ClobberMemory();
+	}
+	set_vehicle_counters(state, total);
+}
+BENCHMARK(BM_IDM_CarFollowing_Packed)
+	->Arg(static_cast<int>(idm::KernelIsa::Scalar))
+	->Arg(static_cast<int>(idm::KernelIsa::SSE))
+	->Arg(static_cast<int>(idm::KernelIsa::AVX2))
+	->Unit(benchmark::kMicrosecond);
+
+// Raw arithmetic: all vehicles of the map in one packed batch vs idm_scalar per element
+static void BM_IDM_Kernel(benchmark::State& state) {
+	const auto& lane_rt = lanes();
+	const idm::idm_params_t p {};
+	const int isa_arg = static_cast<int>(state.range(0));
+
+	idm::LaneSoA all;
+	all.resize(count_vehicles(lane_rt));
+	size_t offset = 0;
+	for (const LaneRuntime& rt : lane_rt) {
+		for (size_t k = 0; k < rt.idx.size(); ++k) {
+			all.s_on_lane[offset + k] = static_cast<float>(rt.idx[k]->s_on_lane());
+			all.v_follower[offset + k] = rt.idx[k]->currentSpeed();
+			all.length[offset + k] = rt.idx[k]->length();
+		}
+		idm::build_leader_inputs(all, offset, rt.idx.size());
+		offset += rt.idx.size();
+	}
+	const size_t n = all.v_follower.size();
+
+	if (isa_arg < 0) {
+		state.SetLabel("idm_scalar");
+		for (auto _ : state) {
+			for (size_t i = 0; i < n; ++i) {
+				all.accel[i] = idm::idm_scalar(all.v_follower[i], all.v_leader[i], all.s_gap[i], p);
+			}
+			benchmark::DoNotOptimize(all.accel.data());
+			benchmark::ClobberMemory();
+		}
+	} else {
+		const auto isa = static_cast<idm::KernelIsa>(isa_arg);
+		state.SetLabel(idm::to_string(isa));
+		for (auto _ : state) {
+			idm::idm_accel_batch(all, n, p, isa);
+			benchmark::DoNotOptimize(all.accel.data());
+			benchmark::ClobberMemory();
+		}
+	}
+	set_vehicle_counters(state, n);
+}
+BENCHMARK(BM_IDM_Kernel)
+	->Arg(-1)
+	->Arg(static_cast<int>(idm::KernelIsa::Scalar))
+	->Arg(static_cast<int>(idm::KernelIsa::SSE))
+	->Arg(static_cast<int>(idm::KernelIsa::AVX2))
+	->Unit(benchmark::kMicrosecond);
+
+// Whole phase 1 (car-following plus lane-change decisions), single thread; arg = requested vehicles
+static void BM_IDM_Phase1(benchmark::State& state) {
+	auto& setup = benchmarks::populated_simulation(KERNEL_MAP, static_cast<size_t>(state.range(0)));
+	auto& system = *setup.system;
+	setup.settings.simulation_threads = 1;
+	system.worker_pool().resize(1);
+
+	auto& lane_rt = system.vehicle_system().lane_runtime();
+	for (auto _ : state) {
+		idm::phase1_simd(system, lane_rt, 0.1);
+	}
+	set_vehicle_counters(state, count_vehicles(lane_rt));
+}
+BENCHMARK(BM_IDM_Phase1)->Arg(KERNEL_VEHICLES)->Arg(100'000)->Unit(benchmark::kMicrosecond);
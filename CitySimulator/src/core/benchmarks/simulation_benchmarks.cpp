@@ -0,0 +1,272 @@
+#include "stdafx.h"
+
+#include <benchmark_fixtures.h>
+
+#include <core/data_layer/world_creator.h>
+#include <core/data_layer/world_data.h>
+#include <core/data_layer/map_cache.h>
+#include <core/data_layer/road_network.h>
+#include <core/data_layer/edge.h>
+#include <core/data_layer/lane.h>
+#include <core/data_layer/node.h>
+#include <core/map_math/contraction_builder.h>
+#include <core/map_math/lane_connector_builder.h>
+#include <core/map_math/landmarks.h>
+#include <core/map_math/path_finder.h>
+#include <core/map_math/search_context.h>
+#include <core/map_math/shortest_path_tree.h>
+
+using namespace tjs::core;
+
+namespace {
+	constexpr const char* GRID_MAP = "10k_lanes_grid.osmx";
+	constexpr const char* CHICAGO_MAP = "chicago_like_grid.osmx";
+
+	// Loaded once per map for the map-building benchmarks, separate from the simulation setups
+	WorldData& static_world(const std::string& map) {
+		static std::map<std::string, std::unique_ptr<WorldData>> worlds;
+		auto& world = worlds[map];
+		if (!world) {
+			world = std::make_unique<WorldData>();
+			if (!WorldCreator::loadOSMData(*world, benchmarks::sample_file(map).string())) {
+				throw std::runtime_error("Failed to load benchmark map " + map);
+			}
+		}
+		return *world;
+	}
+
+	RoadNetwork& static_network(const std::string& map) {
+		return *static_world(map).segments().front()->road_network;
+	}
+
+	void set_network_counters(benchmark::State& state, const RoadNetwork& network) {
+		size_t lanes = 0;
+		for (const auto& edge : network.edges) {
+			lanes += edge.lanes.size();
+		}
+		state.counters["nodes"] = static_cast<double>(network.nodes.size());
+		state.counters["edges"] = static_cast<double>(network.edges.size());
+		state.counters["lanes"] = static_cast<double>(lanes);
+	}
+} // namespace
+
+// Parse + preprocess + road network build, i.e. everything opening a map costs
+static void BM_MapLoad(benchmark::State& state, const char* map) {
+	const auto path = benchmarks::sample_file(map).string();
+	for (auto _ : state) {
+		WorldData world;
+		benchmark::DoNotOptimize(WorldCreator::loadOSMData(world, path));
+	}
+}
+BENCHMARK_CAPTURE(BM_MapLoad, grid, GRID_MAP)->Unit(benchmark::kMillisecond);
+BENCHMARK_CAPTURE(BM_MapLoad, chicago, CHICAGO_MAP)->Unit(benchmark::kMillisecond);
+
+// Same result as BM_MapLoad restored from the binary map cache
+static void BM_MapLoadCached(benchmark::State& state, const char* map) {
+	const auto source = benchmarks::sample_file(map);
+	const auto cache = std::filesystem::temp_directory_path() / (std::string(map) + ".tjcache");
+	if (!details::save_map_cache(static_world(map), cache, source)) {
+		state.SkipWithError("Failed to write map cache");
+		return;
+	}
+
+	for (auto _ : state) {
+		WorldData world;
+		benchmark::DoNotOptimize(details::load_map_cache(world, cache, source));
+	}
+	state.counters["cache_mb"] = static_cast<double>(std::filesystem::file_size(cache)) / (1024.0 * 1024.0);
+	std::filesystem::remove(cache);
+}
+BENCHMARK_CAPTURE(BM_MapLoadCached, grid, GRID_MAP)->Unit(benchmark::kMillisecond);
+BENCHMARK_CAPTURE(BM_MapLoadCached, chicago, CHICAGO_MAP)->Unit(benchmark::kMillisecond);
+
+static void BM_BuildGraph(benchmark::State& state, const char* map) {
+	auto& world = static_world(map);
+	auto& network = static_network(map);
+
+	algo::ContractionBuilder builder;
+	for (auto _ : state) {
+		builder.build_graph(network);
+	}
+
+	// edges were recreated, bring the rest of the network back in sync
+	details::create_road_network(*world.segments().front());
+	set_network_counters(state, network);
+}
+BENCHMARK_CAPTURE(BM_BuildGraph, grid, GRID_MAP)->Unit(benchmark::kMillisecond);
+BENCHMARK_CAPTURE(BM_BuildGraph, chicago, CHICAGO_MAP)->Unit(benchmark::kMillisecond);
+
+static void BM_BuildLaneConnections(benchmark::State& state, const char* map) {
+	auto& network = static_network(map);
+	for (auto _ : state) {
+		algo::LaneConnectorBuilder::build_lane_connections(network);
+	}
+	state.counters["lane_links"] = static_cast<double>(network.lane_links.size());
+	set_network_counters(state, network);
+}
+BENCHMARK_CAPTURE(BM_BuildLaneConnections, grid, GRID_MAP)->Unit(benchmark::kMillisecond);
+BENCHMARK_CAPTURE(BM_BuildLaneConnections, chicago, CHICAGO_MAP)->Unit(benchmark::kMillisecond);
+
+static void BM_BuildLandmarks(benchmark::State& state, const char* map) {
+	auto& network = static_network(map);
+	for (auto _ : state) {
+		benchmark::DoNotOptimize(algo::LandmarkTable::build(network));
+	}
+	set_network_counters(state, network);
+}
+BENCHMARK_CAPTURE(BM_BuildLandmarks, grid, GRID_MAP)->Unit(benchmark::kMillisecond);
+BENCHMARK_CAPTURE(BM_BuildLandmarks, chicago, CHICAGO_MAP)->Unit(benchmark::kMillisecond);
+
+namespace {
+	using PathQuery = std::pair<const Lane*, Node*>;
+
+	// Random (lane, goal) queries with a fixed seed
+	std::vector<PathQuery> path_queries(const RoadNetwork& network, size_t count) {
+		std::vector<const Lane*> lanes;
+		for (const auto& edge : network.edges) {
+			for (const auto& lane : edge.lanes) {
+				lanes.push_back(&lane);
+			}
+		}
+		std::vector<Node*> nodes;
+		nodes.reserve(network.nodes.size());
+		for (const auto& [id, node] : network.nodes) {
+			nodes.push_back(node);
+		}
+		std::ranges::sort(nodes, {}, &Node::uid);
+
+		std::mt19937 rng(42);
+		std::vector<PathQuery> queries;
+		for (size_t i = 0; i < count; ++i) {
+			queries.emplace_back(
+				lanes[std::uniform_int_distribution<size_t>(0, lanes.size() - 1)(rng)],
+				nodes[std::uniform_int_distribution<size_t>(0, nodes.size() - 1)(rng)]);
+		}
+		return queries;
+	}
+
+	// Records a search of the calling thread closed, 0 when it does not count them
+	size_t no_expansions() {
+		return 0;
+	}
+
+	size_t a_star_expansions() {
+		return algo::thread_search_context().expanded();
+	}
+
+	size_t bidirectional_expansions() {
+		const auto& context = algo::thread_bidirectional_context();
+		return context.forward.expanded() + context.backward.expanded();
+	}
+
+	// Cycles through the queries, one per iteration
+	template<typename Find>
+	void run_path_queries(benchmark::State& state, const std::vector<PathQuery>& queries, Find&& find, size_t (*expansions)() = no_expansions) {
+		size_t found = 0;
+		size_t path_edges = 0;
+		size_t expanded = 0;
+		size_t i = 0;
+		for (auto _ : state) {
+			const auto& [lane, goal] = queries[i++ % queries.size()];
+			auto path = find(lane, goal);
+			found += !path.empty();
+			path_edges += path.size();
+			expanded += expansions();
+			benchmark::DoNotOptimize(path);
+		}
+
+		const double runs = static_cast<double>(state.iterations());
+		state.SetItemsProcessed(state.iterations());
+		state.counters["found_ratio"] = found / runs;
+		state.counters["avg_path_edges"] = path_edges / runs;
+		if (expansions != no_expansions) {
+			state.counters["avg_expanded"] = expanded / runs;
+		}
+	}
+
+	constexpr size_t PATH_QUERIES = 512;
+} // namespace
+
+static void BM_PathFromLane(benchmark::State& state, const char* map) {
+	auto& network = static_network(map);
+	run_path_queries(state, path_queries(network, PATH_QUERIES), [&](const Lane* lane, Node* goal) {
+		return algo::PathFinder::find_edge_path_a_star_from_lane(network, lane, goal, true);
+	},
+		a_star_expansions);
+}
+BENCHMARK_CAPTURE(BM_PathFromLane, grid, GRID_MAP)->Unit(benchmark::kMicrosecond);
+BENCHMARK_CAPTURE(BM_PathFromLane, chicago, CHICAGO_MAP)->Unit(benchmark::kMicrosecond);
+
+// Same queries with the landmark (ALT) heuristic, tables built outside the timing
+static void BM_PathFromLaneALT(benchmark::State& state, const char* map) {
+	auto& network = static_network(map);
+	if (!network.landmarks) {
+		network.landmarks = algo::LandmarkTable::build(network);
+	}
+	run_path_queries(state, path_queries(network, PATH_QUERIES), [&](const Lane* lane, Node* goal) {
+		return algo::PathFinder::find_edge_path_alt_from_lane(network, lane, goal, true);
+	},
+		a_star_expansions);
+}
+BENCHMARK_CAPTURE(BM_PathFromLaneALT, grid, GRID_MAP)->Unit(benchmark::kMicrosecond);
+BENCHMARK_CAPTURE(BM_PathFromLaneALT, chicago, CHICAGO_MAP)->Unit(benchmark::kMicrosecond);
+
+// Same queries searched from both ends over the edge graph
+static void BM_PathFromLaneBidirectional(benchmark::State& state, const char* map) {
+	auto& network = static_network(map);
+	run_path_queries(state, path_queries(network, PATH_QUERIES), [&](const Lane* lane, Node* goal) {
+		return algo::PathFinder::find_edge_path_bidirectional_from_lane(network, lane, goal, true);
+	},
+		bidirectional_expansions);
+}
+BENCHMARK_CAPTURE(BM_PathFromLaneBidirectional, grid, GRID_MAP)->Unit(benchmark::kMicrosecond);
+BENCHMARK_CAPTURE(BM_PathFromLaneBidirectional, chicago, CHICAGO_MAP)->Unit(benchmark::kMicrosecond);
+
+// Same with landmark potentials, tables built outside the timing
+static void BM_PathFromLaneBidirectionalALT(benchmark::State& state, const char* map) {
+	auto& network = static_network(map);
+	if (!network.landmarks) {
+		network.landmarks = algo::LandmarkTable::build(network);
+	}
+	run_path_queries(state, path_queries(network, PATH_QUERIES), [&](const Lane* lane, Node* goal) {
+		return algo::PathFinder::find_edge_path_bidirectional_from_lane(network, lane, goal, true);
+	},
+		bidirectional_expansions);
+}
+BENCHMARK_CAPTURE(BM_PathFromLaneBidirectionalALT, grid, GRID_MAP)->Unit(benchmark::kMicrosecond);
+BENCHMARK_CAPTURE(BM_PathFromLaneBidirectionalALT, chicago, CHICAGO_MAP)->Unit(benchmark::kMicrosecond);
+
+// Zone-to-zone travel matrix, one edge-based tree per origin; arg = zones
+// (graph nodes spread evenly over the map), origins and destinations alike
+static void BM_DistanceMatrix(benchmark::State& state, const char* map) {
+	auto& network = static_network(map);
+	const size_t zones = std::min<size_t>(static_cast<size_t>(state.range(0)), network.graph_nodes.size());
+	std::vector<const Node*> nodes;
+	for (size_t i = 0; i < zones; ++i) {
+		nodes.push_back(network.graph_nodes[i * network.graph_nodes.size() / zones]);
+	}
+
+	for (auto _ : state) {
+		benchmark::DoNotOptimize(algo::distance_matrix(network, nodes, nodes));
+	}
+	state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * zones * zones));
+}
+BENCHMARK_CAPTURE(BM_DistanceMatrix, chicago, CHICAGO_MAP)->Arg(100)->Arg(1'000)->Unit(benchmark::kMillisecond);
+
+// Full TrafficSimulationSystem::step() on a populated map; arg = requested vehicles
+static void BM_SimulationStep(benchmark::State& state, const char* map) {
+	auto& setup = benchmarks::populated_simulation(map, static_cast<size_t>(state.range(0)));
+	auto& system = *setup.system;
+
+	size_t vehicle_updates = 0;
+	for (auto _ : state) {
+		system.step();
+		vehicle_updates += system.vehicle_system().vehicles().size();
+	}
+
+	state.SetItemsProcessed(static_cast<int64_t>(vehicle_updates));
+	state.counters["vehicles"] = static_cast<double>(system.vehicle_system().vehicles().size());
+	state.counters["threads"] = static_cast<double>(system.worker_pool().size());
+}
+BENCHMARK_CAPTURE(BM_SimulationStep, grid, GRID_MAP)->Arg(1'000)->Arg(10'000)->Arg(100'000)->Unit(benchmark::kMillisecond);
+BENCHMARK_CAPTURE(BM_SimulationStep, chicago, CHICAGO_MAP)->Arg(1'000)->Arg(10'000)->Arg(100'000)->Unit(benchmark::kMillisecond);
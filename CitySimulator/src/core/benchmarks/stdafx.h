@@ -0,0 +1,13 @@
+#ifndef __STDAFX_H__
+#define __STDAFX_H__
+
+#include <functional>
+#include <filesystem>
+#include <map>
+#include <string_view>
+
+#include <benchmark/benchmark.h>
+
+#include <core/core_includes.h>
+
+#endif
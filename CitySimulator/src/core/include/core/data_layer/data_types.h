@@ -8,7 +8,7 @@
 #include <common/spatial/spatial_grid.h>
 
 namespace tjs::core {
-	using SpatialGrid = tjs::common::SpatialGrid<WayInfo, Lane>;
+	using SpatialGrid = tjs::common::SpatialGrid<WayInfo, Lane, Node>;
 
 	struct SegmentBoundingBox {
 		Coordinates left;
@@ -39,4 +39,18 @@ namespace tjs::core {
 	};
 
 	void add_way(SpatialGrid& grid, WayInfo* way);
+	// Lanes with an empty center line are skipped
+	void add_lane(SpatialGrid& grid, Lane* lane);
+	// Nodes that are not part of any way are skipped
+	void add_node(SpatialGrid& grid, Node* node);
+
+	// Nearest-neighbour lookups over the trees of the grid, logN per result.
+	// Nothing farther than `max_distance` is returned.
+	constexpr double ANY_DISTANCE = std::numeric_limits<double>::infinity();
+
+	// Up to `k` way nodes, closest first
+	std::vector<Node*> find_nearest_nodes(const SpatialGrid& grid, const Coordinates& coordinates, size_t k, double max_distance = ANY_DISTANCE);
+	Node* find_nearest_node(const SpatialGrid& grid, const Coordinates& coordinates, double max_distance = ANY_DISTANCE);
+	// Lane whose center line passes closest
+	Lane* find_nearest_lane(const SpatialGrid& grid, const Coordinates& coordinates, double max_distance = ANY_DISTANCE);
 } // namespace tjs::core
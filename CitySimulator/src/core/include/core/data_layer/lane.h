@@ -6,7 +6,6 @@
 namespace tjs::core {
 	struct Edge;
 	struct Lane;
-	struct Vehicle;
 
 	struct LaneLink {
 		Lane* from = nullptr;
@@ -26,10 +25,8 @@ namespace tjs::core {
 		TurnDirection turn = TurnDirection::None;
 		std::vector<LaneLinkHandler> outgoing_connections;
 		std::vector<LaneLinkHandler> incoming_connections;
-		std::vector<Vehicle*> vehicles;
 
 		size_t index_in_edge;
-		size_t index_in_buffer;
 
 		Lane* left() const;
 		Lane* right() const;
@@ -0,0 +1,29 @@
+#pragma once
+
+#include <filesystem>
+
+namespace tjs::core {
+	class WorldData;
+
+	// Binary snapshot of the prepared world: nodes, ways, edges, lanes, lane links,
+	// the graph tables of the road network (CSR adjacency, transition tables,
+	// components), the spatial index with its trees and the landmark tables,
+	// exactly as WorldCreator leaves them.
+	//
+	// The file is memory-mapped on load and objects are restored from flat
+	// index-based records, so neither XML parsing nor graph building runs.
+	// A cache is valid only for the source file it was written from (size and
+	// modification time), the same load options and the current MAP_CACHE_VERSION.
+	namespace details {
+		// Bump when the layout changes or when the road network builders produce
+		// a different result for the same map
+		constexpr uint32_t MAP_CACHE_VERSION = 4;
+
+		// <source>.tjcache next to the source map
+		std::filesystem::path map_cache_path(std::string_view source_file);
+
+		// Replaces the segments of `data` only on success
+		bool load_map_cache(WorldData& data, const std::filesystem::path& cache_file, const std::filesystem::path& source_file, bool car_ways_only = false);
+		bool save_map_cache(WorldData& data, const std::filesystem::path& cache_file, const std::filesystem::path& source_file, bool car_ways_only = false);
+	} // namespace details
+} // namespace tjs::core
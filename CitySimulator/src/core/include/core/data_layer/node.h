@@ -5,12 +5,16 @@ namespace tjs::core {
 
 	struct WayInfo;
 	struct Node {
+		static constexpr uint32_t NO_GRAPH_INDEX = std::numeric_limits<uint32_t>::max();
+
 		uint64_t uid;
 		Coordinates coordinates;
 		NodeTags tags;
 
 		// Additional data for faster search
 		std::vector<WayInfo*> ways;
+		// Dense index in RoadNetwork::graph_nodes, NO_GRAPH_INDEX if no edge touches the node
+		uint32_t graph_index = NO_GRAPH_INDEX;
 
 		static std::unique_ptr<Node> create(uint64_t uid, const Coordinates& coordinates, NodeTags tags) {
 			auto node = std::make_unique<Node>();
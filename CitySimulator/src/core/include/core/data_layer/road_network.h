@@ -1,41 +1,171 @@
 #pragma once
 
 #include <core/data_layer/edge.h>
+#include <core/data_layer/node.h>
+#include <common/csr_adjacency.h>
+
+namespace tjs::core::algo {
+	class LandmarkTable;
+} // namespace tjs::core::algo
 
 namespace tjs::core {
-	// [DON`t USE IT NOW] CH data structures
-	struct Edge_Contract {
-		uint64_t target;
-		double weight;
-		bool is_shortcut;
-		uint64_t shortcut_id1;
-		uint64_t shortcut_id2;
-
-		Edge_Contract(uint64_t t, double w, bool sc = false, uint64_t s1 = 0, uint64_t s2 = 0)
-			: target(t)
-			, weight(w)
-			, is_shortcut(sc)
-			, shortcut_id1(s1)
-			, shortcut_id2(s2) {}
+	struct WayInfo;
+
+	// Outgoing edge of a node in the dense graph
+	struct GraphArc {
+		uint32_t edge;   // index in RoadNetwork::edges
+		uint32_t target; // graph index of the edge end node
+		double length;
 	};
 
-	struct WayInfo;
-	struct Node;
+	// Lane to take into the next edge of a route
+	struct LaneEntry {
+		Lane* lane = nullptr; // nullptr when the source lane has no link there
+		bool yield = true;
+	};
 
 	struct RoadNetwork {
+		static constexpr uint32_t NO_COMPONENT = std::numeric_limits<uint32_t>::max();
+		static constexpr uint32_t NO_TRANSITION = std::numeric_limits<uint32_t>::max();
+		// component_reach takes components^2 bits, 8 MiB at this count
+		static constexpr uint32_t MAX_REACH_COMPONENTS = 8192;
+
 		// List of structures for easier access
 		std::unordered_map<uint64_t, Node*> nodes;
 		std::unordered_map<uint64_t, WayInfo*> ways;
 
 		std::vector<Edge> edges;
-		std::unordered_map<Node*, std::vector<Edge*>> edge_graph;
 
 		// lane connectors
 		std::vector<LaneLink> lane_links;
-		std::unordered_map<Lane*, std::vector<LaneLinkHandler>> lane_graph;
 
-		// Trivial network for A* without considering lanes
-		std::unordered_map<Node*, std::vector<std::pair<Node*, double>>> adjacency_list;
+		// Dense graph in CSR form. Indices:
+		//  node - position in graph_nodes, kept in Node::graph_index
+		//  edge - position in edges
+		//  lane - lane_offsets[edge] + Lane::index_in_edge
+		//  link - position in lane_links
+		std::vector<Node*> graph_nodes;
+		common::CsrAdjacency<GraphArc> node_graph;        // node -> outgoing edges
+		common::CsrAdjacency<uint32_t> incoming_edges;    // node -> edges ending there
+		common::CsrAdjacency<uint32_t> edge_transitions;  // edge -> edges reachable through lane links
+		common::CsrAdjacency<uint32_t> edge_predecessors; // edge_transitions reversed
+		std::vector<uint32_t> lane_offsets;               // edges.size() + 1 entries
+		common::CsrAdjacency<uint32_t> lane_graph;        // lane -> outgoing links
+
+		// Lane choice per transition, i.e. per entry of edge_transitions, filled by
+		// build_lane_graph. A slot is the position of the next edge in its row.
+		std::vector<uint32_t> transition_goal_masks; // lanes of the edge linked into the next edge
+		std::vector<uint32_t> entry_offsets;         // per edge, entries of its lanes one row after another
+		std::vector<LaneEntry> lane_entries;         // non-yield first, then the smallest lane shift
+
+		// Strongly connected components of edge_transitions, numbered in
+		// topological order of the condensation: a transition never leads to a
+		// lower component. Filled by build_lane_graph.
+		std::vector<uint32_t> edge_component;
+		// Highest component of the edges ending at a node, by graph index;
+		// NO_COMPONENT when no edge ends there
+		std::vector<uint32_t> node_component;
+		// Transitive closure of the condensation: row c, component_words words
+		// long, has the bit of every component a route entering c can get to,
+		// c included. Empty above MAX_REACH_COMPONENTS.
+		std::vector<uint64_t> component_reach;
+		uint32_t component_words = 0;
+
+		// ALT bounds for RoutingAlgoType::Landmarks, dropped whenever the node
+		// graph is rebuilt; stored in the map cache
+		std::shared_ptr<const algo::LandmarkTable> landmarks;
+
+		// Bumped whenever the graph is rebuilt; bump it when edge lengths change
+		// so routes cached against the old graph are dropped
+		uint32_t revision = 0;
+
+		// Indexes nodes and edges, call after edges are created
+		void build_node_graph();
+		// Call after lane links and Edge::outgoing_edges are built
+		void build_lane_graph();
+		// Part of build_lane_graph: edge_component, node_component and component_reach
+		void build_components();
+		// Part of build_lane_graph: goal masks and entry lanes of the transitions
+		void build_transition_tables();
+
+		// Changes the cost of an edge without rebuilding the graph. Drops the
+		// landmark tables when the edge gets shorter than they assume
+		void set_edge_length(uint32_t edge, double length);
+
+		uint32_t edge_index(const Edge* edge) const {
+			return static_cast<uint32_t>(edge - edges.data());
+		}
+
+		uint32_t lane_index(const Lane* lane) const {
+			return lane_offsets[edge_index(lane->parent)] + static_cast<uint32_t>(lane->index_in_edge);
+		}
+
+		// Whether some route leaving `from` through edge_transitions ends at
+		// `goal`; a few bit tests over the transitions of `from` and the edges
+		// into `goal`. Without component_reach it only rules out goals in lower
+		// components, and without components everything is reachable.
+		bool can_reach(const Edge& from, const Node& goal) const {
+			if (edge_component.size() != edges.size() || goal.graph_index >= node_component.size()) {
+				return true;
+			}
+			if (component_reach.empty()) {
+				const uint32_t reach = node_component[goal.graph_index];
+				return reach != NO_COMPONENT && reach >= edge_component[edge_index(&from)];
+			}
+
+			for (uint32_t next : edge_transitions[edge_index(&from)]) {
+				const uint64_t* row = component_reach.data() + size_t(edge_component[next]) * component_words;
+				for (uint32_t e : incoming_edges[goal.graph_index]) {
+					const uint32_t c = edge_component[e];
+					if (row[c >> 6] >> (c & 63) & 1) {
+						return true;
+					}
+				}
+			}
+			return false;
+		}
+
+		// Slot of `next` among the transitions of `edge`, NO_TRANSITION if there is no link.
+		// Rows hold a few edges, so this is a short scan
+		uint32_t transition_slot(const Edge& edge, const Edge& next) const {
+			const auto transitions = edge_transitions[edge_index(&edge)];
+			const auto it = std::ranges::find(transitions, edge_index(&next));
+			return it == transitions.end() ? NO_TRANSITION : static_cast<uint32_t>(it - transitions.begin());
+		}
+
+		uint32_t goal_mask(const Edge& edge, uint32_t slot) const {
+			return transition_goal_masks[edge_transitions.offsets[edge_index(&edge)] + slot];
+		}
+
+		const LaneEntry& lane_entry(const Lane& lane, uint32_t slot) const {
+			const uint32_t edge = edge_index(lane.parent);
+			return lane_entries[entry_offsets[edge] + lane.index_in_edge * edge_transitions[edge].size() + slot];
+		}
+
+		size_t lane_count() const {
+			return lane_offsets.empty() ? 0 : lane_offsets.back();
+		}
+
+		std::span<const GraphArc> arcs(const Node* node) const {
+			if (node->graph_index >= graph_nodes.size()) {
+				return {};
+			}
+			return node_graph[node->graph_index];
+		}
+
+		// Pointer views over the dense graph
+
+		auto outgoing_edges(const Node* node) const {
+			return arcs(node) | std::views::transform([this](const GraphArc& arc) { return &edges[arc.edge]; });
+		}
+
+		auto outgoing_edges(const Node* node) {
+			return arcs(node) | std::views::transform([this](const GraphArc& arc) { return &edges[arc.edge]; });
+		}
+
+		auto outgoing_links(const Lane* lane) const {
+			return lane_graph[lane_index(lane)] | std::views::transform([this](uint32_t link) { return &lane_links[link]; });
+		}
 	};
 
 } // namespace tjs::core
@@ -5,11 +5,14 @@
 
 #include <core/simulation/movement/idm/idm_params.h>
 
+#include <span>
+
 namespace tjs::core {
 
 	struct WayInfo;
 	struct Lane;
 	struct AgentData;
+	struct Vehicle;
 
 	enum class VehicleType : char {
 		SimpleCar,
@@ -31,50 +34,214 @@ namespace tjs::core {
 		uint8_t uniquness;
 	};
 
-	struct Vehicle {
-		ProfileInfo profile;
-		// ---- 8‑byte group (kept together to avoid padding) ----
+	// Vehicle fields the movement does not touch every step
+	struct VehicleInfo {
 		uint64_t uid;
-
-		double s_on_lane;
-		double s_next;
-		double lateral_offset;
-		double action_time;
-
 		Coordinates coordinates;
 		WayInfo* currentWay;
-		Lane* current_lane;
-		Lane* lane_target;
-		AgentData* agent;
-		Vehicle* cooperation_vehicle;
-
-		// ---- 4‑byte group ----
-		float currentSpeed;
-		float v_next;
+		AgentHandle agent;
 		float rotationAngle;
-		float length;
 		float width;
 		float maxSpeed;
-		uint32_t goal_lane_mask; // bitmask for current edge exit
 		int currentSegmentIndex;
-		uint32_t idx_in_lane;
-		uint32_t idx_in_target_lane;
-
+		ProfileInfo profile;
 		VehicleType type;
 		simulation::VehicleMovementError error;
-
-		// ---- 2‑byte group ----
-		uint16_t state;
 		uint16_t previous_state;
+	};
+
+	// Storage behind Vehicle, split by how often a step needs a field.
+	//
+	// Hot fields are columns indexed by Vehicle::row. Car-following reads the
+	// leader of every vehicle as well as the vehicle itself, so a step streams a
+	// few dense arrays instead of pulling whole records; reorder() keeps the rows
+	// in lane order for that. Cold fields are VehicleInfo records indexed by
+	// Vehicle::id, which never changes while the vehicle lives.
+	class VehicleStore {
+	public:
+		std::vector<double> s_on_lane;
+		std::vector<double> s_next;
+		std::vector<double> lateral_offset;
+		std::vector<float> speed;
+		std::vector<float> v_next;
+		std::vector<float> length;
+		std::vector<uint16_t> state;
+		std::vector<uint8_t> has_position_changes;
+
+		std::vector<VehicleInfo> info;
+
+	public:
+		// Binds `vehicle` to a zero-initialised row and record.
+		// Columns grow, so do not hold references into them across acquire.
+		void acquire(Vehicle& vehicle);
+		void release(const Vehicle& vehicle);
+		void clear();
+
+		// Rows ever handed out, live or free
+		size_t rows() const {
+			return s_on_lane.size();
+		}
+
+		size_t live() const {
+			return rows() - _free_rows.size();
+		}
+
+		// Moves every row to its next kinematic state (s_next, v_next)
+		void commit_step() noexcept;
+
+		// Renumbers rows in the order of `order` and updates Vehicle::row, so a
+		// pass that walks vehicles in that order reads every column front to back.
+		// `order` must hold each live vehicle once; false (nothing changed) if not.
+		bool reorder(std::span<Vehicle* const> order);
+
+	private:
+		std::vector<uint32_t> _free_rows;
+		std::vector<uint32_t> _free_ids;
+
+		// reorder scratch
+		std::vector<uint32_t> _source; // old row of every new row
+		std::vector<uint8_t> _taken;
+		// one permuted column per element type, swapped with the column it was built for
+		std::vector<double> _permuted_f64;
+		std::vector<float> _permuted_f32;
+		std::vector<uint16_t> _permuted_u16;
+		std::vector<uint8_t> _permuted_u8;
+	};
 
-		// ---- 1‑byte group ----
+	// Handle of one vehicle: a cache line with what the movement reads per
+	// vehicle, the rest is reached through `store`.
+	struct alignas(64) Vehicle {
+		VehicleStore* store;
+		Lane* current_lane;
+		Lane* lane_target;
+		double action_time;
+
+		VehicleHandle handle;              // own slot in the VehicleSystem pool
+		VehicleHandle cooperation_vehicle; // merging vehicle this one yields to
+		uint32_t row;                      // hot columns of `store`, changes on reorder
+		uint32_t id;                       // cold record of `store`, stable
+		uint32_t goal_lane_mask;           // bitmask for current edge exit
+		uint32_t idx_in_lane;
+		uint32_t idx_in_target_lane;
 		int8_t lane_change_dir;
-		bool has_position_changes;
+
+		// ---- hot ----
+		double& s_on_lane() {
+			return store->s_on_lane[row];
+		}
+		double s_on_lane() const {
+			return store->s_on_lane[row];
+		}
+		double& s_next() {
+			return store->s_next[row];
+		}
+		double s_next() const {
+			return store->s_next[row];
+		}
+		double& lateral_offset() {
+			return store->lateral_offset[row];
+		}
+		double lateral_offset() const {
+			return store->lateral_offset[row];
+		}
+		float& currentSpeed() {
+			return store->speed[row];
+		}
+		float currentSpeed() const {
+			return store->speed[row];
+		}
+		float& v_next() {
+			return store->v_next[row];
+		}
+		float v_next() const {
+			return store->v_next[row];
+		}
+		float& length() {
+			return store->length[row];
+		}
+		float length() const {
+			return store->length[row];
+		}
+		uint16_t& state() {
+			return store->state[row];
+		}
+		uint16_t state() const {
+			return store->state[row];
+		}
+		uint8_t& has_position_changes() {
+			return store->has_position_changes[row];
+		}
+		bool has_position_changes() const {
+			return store->has_position_changes[row] != 0;
+		}
+
+		// ---- cold ----
+		VehicleInfo& info() {
+			return store->info[id];
+		}
+		const VehicleInfo& info() const {
+			return store->info[id];
+		}
+		uint64_t& uid() {
+			return info().uid;
+		}
+		uint64_t uid() const {
+			return info().uid;
+		}
+		Coordinates& coordinates() {
+			return info().coordinates;
+		}
+		const Coordinates& coordinates() const {
+			return info().coordinates;
+		}
+		AgentHandle& agent() {
+			return info().agent;
+		}
+		AgentHandle agent() const {
+			return info().agent;
+		}
+		float& rotationAngle() {
+			return info().rotationAngle;
+		}
+		float rotationAngle() const {
+			return info().rotationAngle;
+		}
+		float& width() {
+			return info().width;
+		}
+		float width() const {
+			return info().width;
+		}
+		float& maxSpeed() {
+			return info().maxSpeed;
+		}
+		float maxSpeed() const {
+			return info().maxSpeed;
+		}
+		VehicleType& type() {
+			return info().type;
+		}
+		VehicleType type() const {
+			return info().type;
+		}
+		simulation::VehicleMovementError& error() {
+			return info().error;
+		}
+		simulation::VehicleMovementError error() const {
+			return info().error;
+		}
+		uint16_t& previous_state() {
+			return info().previous_state;
+		}
+		uint16_t previous_state() const {
+			return info().previous_state;
+		}
 
 		// Return if vehicle is shadow in lane (behin to change lane)
 		bool is_merging(const Lane& lane) const;
 	};
 	static_assert(std::is_pod<Vehicle>::value, "Data object expect to be POD");
+	static_assert(sizeof(Vehicle) == 64, "Vehicle handle must fit one cache line");
 
 	using Vehicles = std::vector<Vehicle>;
 
@@ -2,19 +2,33 @@
 
 #include <core/simulation/simulation_settings.h>
 
+#include <common/message_dispatcher/message_dispatcher.h>
+
 namespace tjs::core {
 	class WorldData;
 	struct WorldSegment;
 
+	struct MapLoadOptions {
+		// Restore the prepared world from <map>.tjcache when it is up to date,
+		// (re)write the cache after a full load otherwise
+		bool use_cache = false;
+		// Keep only ways a car can drive on (and their nodes), for runs that
+		// do not draw the map
+		bool car_ways_only = false;
+		// Receives events::MapLoadProgress from publisher "world_creator"
+		common::MessageDispatcher* dispatcher = nullptr;
+	};
+
 	namespace details {
-		bool loadOSMXmlData(WorldData& data, std::string_view osmFileName);
+		bool loadOSMXmlData(WorldData& data, std::string_view osmFileName, const MapLoadOptions& options = {});
 		void preprocess_segment(WorldSegment& segment);
 		void create_road_network(WorldSegment& segment);
 	} // namespace details
 
 	class WorldCreator final {
 	public:
-		static bool loadOSMData(WorldData& data, std::string_view osmFilename);
+		// Nodes that no loaded way references are dropped while reading
+		static bool loadOSMData(WorldData& data, std::string_view osmFilename, const MapLoadOptions& options = {});
 
 	private:
 		WorldCreator() = delete;
@@ -0,0 +1,27 @@
+#pragma once
+
+#include <common/message_dispatcher/Event.h>
+
+namespace tjs::core::events {
+	ENUM(MapLoadStage, char,
+		ReadingCache,
+		ReadingWays,
+		ReadingNodes,
+		BuildingRoadNetwork,
+		WritingCache,
+		Finished);
+
+	// Sent by WorldCreator while a map loads, from the loading thread
+	struct MapLoadProgress : common::Event {
+		MapLoadStage stage;
+		double progress = 0.0; // of the current stage [0, 1]
+		size_t nodes = 0;      // kept so far
+		size_t ways = 0;
+
+		MapLoadProgress(MapLoadStage stage_, double progress_, size_t nodes_, size_t ways_)
+			: stage(stage_)
+			, progress(progress_)
+			, nodes(nodes_)
+			, ways(ways_) {}
+	};
+} // namespace tjs::core::events
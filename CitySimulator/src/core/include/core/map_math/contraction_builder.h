@@ -4,7 +4,6 @@
 
 namespace tjs::core {
 	struct RoadNetwork;
-	struct Edge_Contract;
 } // namespace tjs::core
 
 namespace tjs::core::algo {
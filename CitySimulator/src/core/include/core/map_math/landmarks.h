@@ -0,0 +1,83 @@
+#pragma once
+
+#include <span>
+
+namespace tjs::core {
+	struct RoadNetwork;
+} // namespace tjs::core
+
+namespace tjs::core::algo {
+	// ALT lower bounds: shortest distances to and from a few landmark nodes
+	// of RoadNetwork::node_graph.
+	//
+	// For every landmark L the triangle inequality gives
+	//   d(v, t) >= d(L, t) - d(L, v)   and   d(v, t) >= d(v, L) - d(t, L),
+	// which on grid maps is much tighter than the straight line. Landmarks are
+	// picked farthest-point: each is the node farthest from those chosen before.
+	//
+	// Bounds stay admissible while no edge is shorter than when the table was
+	// built, so costs may grow at runtime without rebuilding it;
+	// RoadNetwork::set_edge_length drops the table when an edge gets shorter.
+	class LandmarkTable {
+	public:
+		static constexpr size_t DEFAULT_LANDMARKS = 8;
+
+		// d(L, node) and d(node, L), infinity when there is no route
+		struct Distances {
+			double from;
+			double to;
+		};
+
+	public:
+		// Needs node_graph of `network`
+		static std::shared_ptr<LandmarkTable> build(const RoadNetwork& network, size_t count = DEFAULT_LANDMARKS);
+
+		// Tables read back from the map cache, nullptr if they do not fit `network`
+		static std::shared_ptr<LandmarkTable> restore(const RoadNetwork& network, std::span<const uint32_t> landmarks, std::span<const Distances> distances);
+
+		// Lower bound of the route length from `node` to `target`, graph indices
+		double lower_bound(uint32_t node, uint32_t target) const {
+			const size_t count = _landmarks.size();
+			const Distances* at_node = _distances.data() + node * count;
+			const Distances* at_target = _distances.data() + target * count;
+
+			double bound = 0.0;
+			for (size_t i = 0; i < count; ++i) {
+				// a landmark that does not reach both nodes proves nothing
+				const double forward = at_target[i].from - at_node[i].from;
+				const double backward = at_node[i].to - at_target[i].to;
+				if (std::isfinite(forward)) {
+					bound = std::max(bound, forward);
+				}
+				if (std::isfinite(backward)) {
+					bound = std::max(bound, backward);
+				}
+			}
+			return bound;
+		}
+
+		// Graph indices of the landmarks
+		std::span<const uint32_t> landmarks() const {
+			return _landmarks;
+		}
+
+		// Node-major: landmark_count() entries per node
+		std::span<const Distances> distances() const {
+			return _distances;
+		}
+
+		size_t node_count() const {
+			return _landmarks.empty() ? 0 : _distances.size() / _landmarks.size();
+		}
+
+		// Length of `edge` the bounds were computed with
+		double base_length(uint32_t edge) const {
+			return _base_lengths[edge];
+		}
+
+	private:
+		std::vector<uint32_t> _landmarks;
+		std::vector<Distances> _distances;
+		std::vector<double> _base_lengths;
+	};
+} // namespace tjs::core::algo
@@ -5,7 +5,9 @@
 namespace tjs::core::algo {
 	class LaneConnectorBuilder {
 	public:
-		static void build_lane_connections(RoadNetwork& network);
+		// Nodes are processed on `threads` workers (0 - all hardware threads),
+		// the result does not depend on the number of threads
+		static void build_lane_connections(RoadNetwork& network, size_t threads = 0);
 	};
 
 	namespace details {
@@ -15,7 +17,20 @@ namespace tjs::core::algo {
 			Edge* primary = nullptr;
 		};
 
+		// node -> edges that start or end in it, ordered as in network.edges
+		using EdgeIncidence = std::unordered_map<Node*, AdjacentEdges>;
+
+		// Scans all edges, use build_edge_incidence for more than a few nodes
 		AdjacentEdges get_adjacent_edges(RoadNetwork& network, Node* node);
+		void add_adjacent_edge(AdjacentEdges& adjacent, Edge* edge, Node* node);
+		// Sorts incoming/outgoing from right to left relative to the primary road
+		void order_adjacent_edges(AdjacentEdges& adjacent);
+		EdgeIncidence build_edge_incidence(RoadNetwork& network);
+
+		// Lane links of one node; touches only lanes and edges around the node
+		// and skips connections that already exist
+		void connect_lanes(const AdjacentEdges& adjacent, std::vector<LaneLink>& links);
+		void store_links(RoadNetwork& network, const std::vector<LaneLink>& links);
 		void process_node(RoadNetwork& network, Node* node);
 	} // namespace details
 } // namespace tjs::core::algo
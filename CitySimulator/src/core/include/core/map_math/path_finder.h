@@ -1,26 +1,34 @@
 #pragma once
 
+#include <span>
+
 namespace tjs::core {
 	struct RoadNetwork;
 	struct Node;
-	struct Edge_Contract;
 	struct Edge;
 	struct Lane;
 } // namespace tjs::core
 
+namespace tjs::core::algo {
+	class SearchContext;
+	struct BidirectionalSearchContext;
+} // namespace tjs::core::algo
+
 namespace tjs::core::algo {
 	class PathFinder {
 	public:
 		static std::deque<Node*> find_path_a_star(const RoadNetwork& network, Node* source, Node* target);
 		static std::unordered_set<Node*> reachable_nodes(const RoadNetwork& network, Node* source);
 		static std::vector<const Edge*> find_edge_path_a_star(const RoadNetwork& network, Node* source, Node* target);
+		// Leaves the route in context.path() as edge indices, returns false if there is none
+		static bool find_edge_path_a_star(const RoadNetwork& network, const Node* source, const Node* target, SearchContext& context);
 
 		// ────────────────────────────────────────────────────────────────────
 		//  A* from *lane*            (multi-source front edges)
 		//  --------------------------------------------------
 		//  • start_lane  : the lane the vehicle is physically in **now**
 		//  • target      : destination node
-		//  • network     : unchanged RoadNetwork with edge_graph
+		//  • network     : RoadNetwork with node_graph and lane graph built
 		//
 		//  Returns edge sequence   start_lane → … → target
 		//  or empty vector if no route exists.
@@ -30,48 +38,46 @@ namespace tjs::core::algo {
 			Node* target,
 			bool look_adjacent_lanes);
 
-	private:
-		// Вспомогательная функция для проверки возможности перехода через shortcut
-		static bool can_traverse_shortcut(
-			const RoadNetwork& network,
-			uint64_t from, uint64_t to,
-			const Edge_Contract& shortcut);
+		// Same search, the route is left in context.path() as edge indices.
+		// Does not allocate once the context has grown to the network size.
+		static bool find_edge_path_a_star_from_lane(const RoadNetwork& network,
+			const Lane* start_lane,
+			const Node* target,
+			bool look_adjacent_lanes,
+			SearchContext& context);
+
+		// Same search guided by network.landmarks (ALT) on top of the straight
+		// line; plain A* when the tables are missing or belong to another graph
+		static std::vector<const Edge*> find_edge_path_alt_from_lane(const RoadNetwork& network,
+			const Lane* start_lane,
+			Node* target,
+			bool look_adjacent_lanes);
 
-	private:
-		// Вспомогательные функции для проверок
-		static bool is_geometry_valid(
-			const RoadNetwork& network,
-			uint64_t from, uint64_t to,
-			const Edge_Contract& shortcut) {
-			// Проверка на корректность геометрии shortcut-ребра
-			// Можно добавить проверку на пересечение с другими объектами
-			// Можно добавить проверку на прямолинейность
-			return true;
-		}
+		static bool find_edge_path_alt_from_lane(const RoadNetwork& network,
+			const Lane* start_lane,
+			const Node* target,
+			bool look_adjacent_lanes,
+			SearchContext& context);
 
-		static bool is_time_valid(const RoadNetwork& network,
-			uint64_t from, uint64_t to,
-			const Edge_Contract& shortcut) {
-			// Проверка временных ограничений (если они есть)
-			// Например, проверка на время суток для определенных дорог
-			return true;
-		}
+		// Same route request searched from both ends over the edge graph:
+		// forward through edge_transitions from the lanes the start lane links
+		// into, backward through edge_predecessors from the edges ending at
+		// `target`. Both halves use the average of the straight-line bounds to
+		// the two ends as a consistent potential. Labels are per edge, so the
+		// route is the shortest one under turn restrictions; unlike the A*
+		// above, the first edge counts towards its length.
+		static std::vector<const Edge*> find_edge_path_bidirectional_from_lane(const RoadNetwork& network,
+			const Lane* start_lane,
+			Node* target,
+			bool look_adjacent_lanes);
 
-		static bool is_transport_valid(const RoadNetwork& network,
-			uint64_t from, uint64_t to,
-			const Edge_Contract& shortcut) {
-			// Проверка транспортных ограничений
-			// Например, проверка на допустимый тип транспорта
-			return true;
-		}
+		static bool find_edge_path_bidirectional_from_lane(const RoadNetwork& network,
+			const Lane* start_lane,
+			const Node* target,
+			bool look_adjacent_lanes,
+			BidirectionalSearchContext& context);
 
-		static bool is_obstacle_free(const RoadNetwork& network,
-			uint64_t from, uint64_t to,
-			const Edge_Contract& shortcut) {
-			// Проверка на отсутствие физических препятствий
-			// Например, проверка на наличие закрытых дорог
-			return true;
-		}
+		static std::vector<const Edge*> to_edges(const RoadNetwork& network, std::span<const uint32_t> edge_indices);
 	};
 
 } // namespace tjs::core::algo
@@ -0,0 +1,109 @@
+#pragma once
+
+#include <common/indexed_heap.h>
+
+namespace tjs::core::algo {
+	// Reusable state of a search over RoadNetwork::node_graph.
+	//
+	// Records are a flat array indexed by graph node and stamped with a
+	// generation, so reset() is O(1): a record whose stamp is old reads as
+	// untouched. Arrays only grow, so once a context has seen the largest
+	// graph a search allocates nothing.
+	//
+	// A context serves one search at a time; use one per thread.
+	class SearchContext {
+	public:
+		static constexpr uint32_t NO_INDEX = std::numeric_limits<uint32_t>::max();
+
+		struct NodeRecord {
+			double g_score = std::numeric_limits<double>::infinity();
+			double h_score = -1.0;      // negative until computed
+			uint32_t parent = NO_INDEX; // graph index
+			uint32_t via = NO_INDEX;    // edge index
+			bool closed = false;
+
+		private:
+			friend class SearchContext;
+			// generation that last wrote the record, fits the padding
+			uint32_t stamp = 0;
+		};
+
+	public:
+		void reset(size_t node_count) {
+			if (_records.size() < node_count) {
+				_records.resize(node_count);
+				_open.resize(node_count);
+			}
+			_open.clear();
+			_path.clear();
+			_expanded = 0;
+			if (++_generation == 0) {
+				// wrapped, old stamps could match again
+				for (NodeRecord& record : _records) {
+					record.stamp = 0;
+				}
+				_generation = 1;
+			}
+		}
+
+		// Record of `node`, fresh if this search has not touched it yet
+		NodeRecord& record(uint32_t node) {
+			NodeRecord& record = _records[node];
+			if (record.stamp != _generation) {
+				record = {};
+				record.stamp = _generation;
+			}
+			return record;
+		}
+
+		bool touched(uint32_t node) const {
+			return _records[node].stamp == _generation;
+		}
+
+		// Only meaningful for a touched node
+		const NodeRecord& get(uint32_t node) const {
+			return _records[node];
+		}
+
+		// Records closed since reset(), for statistics
+		size_t expanded() const {
+			return _expanded;
+		}
+
+		void count_expanded() {
+			++_expanded;
+		}
+
+		common::IndexedDaryHeap<4>& open() {
+			return _open;
+		}
+
+		// Edge indices of the last route found, first edge first
+		std::vector<uint32_t>& path() {
+			return _path;
+		}
+
+		const std::vector<uint32_t>& path() const {
+			return _path;
+		}
+
+	private:
+		uint32_t _generation = 0;
+		size_t _expanded = 0;
+		std::vector<NodeRecord> _records;
+		common::IndexedDaryHeap<4> _open;
+		std::vector<uint32_t> _path;
+	};
+
+	// Forward and backward halves of a bidirectional search, records per edge;
+	// the route ends up in path
+	struct BidirectionalSearchContext {
+		SearchContext forward;
+		SearchContext backward;
+		std::vector<uint32_t> path;
+	};
+
+	// Contexts of the calling thread, used by the PathFinder overloads without one
+	SearchContext& thread_search_context();
+	BidirectionalSearchContext& thread_bidirectional_context();
+} // namespace tjs::core::algo
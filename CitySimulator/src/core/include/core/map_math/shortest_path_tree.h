@@ -0,0 +1,77 @@
+#pragma once
+
+#include <common/indexed_heap.h>
+
+#include <span>
+
+namespace tjs::core {
+	struct RoadNetwork;
+	struct Node;
+} // namespace tjs::core
+
+namespace tjs::core::algo {
+	// One-to-all routes from a node, Dijkstra over the edge graph.
+	//
+	// Labels are per edge, so a route turns only where lanes connect
+	// (RoadNetwork::edge_transitions) and the result is exact under turn
+	// restrictions; a node takes the best of its incoming edges. Results are
+	// dense arrays indexed by edge and by graph node. Storage is reused, so
+	// after the first build of a network further builds do not allocate.
+	//
+	// A tree serves one build at a time; use one per thread.
+	class ShortestPathTree {
+	public:
+		static constexpr uint32_t NO_INDEX = std::numeric_limits<uint32_t>::max();
+
+	public:
+		// Needs the lane graph of `network`, false if `source` is not in it.
+		// With `targets` (graph indices) the search stops once all of them are
+		// settled; only their labels and the ones settled before are final then.
+		bool build(const RoadNetwork& network, const Node* source, std::span<const uint32_t> targets = {});
+
+		// Route length to a graph node, 0 at the source, infinity when unreachable
+		double distance(uint32_t node) const {
+			return _node_distance[node];
+		}
+
+		// Last edge of the route to a graph node, NO_INDEX at the source or when unreachable
+		uint32_t last_edge(uint32_t node) const {
+			return _node_via[node];
+		}
+
+		// Edge indices from the source to `node`, false when there is no route
+		bool route_to(uint32_t node, std::vector<uint32_t>& path) const;
+
+		// Per graph node
+		std::span<const double> node_distances() const {
+			return _node_distance;
+		}
+
+		// Per edge: route length to the end of the edge and the edge before it
+		std::span<const double> edge_distances() const {
+			return _edge_distance;
+		}
+
+		std::span<const uint32_t> edge_parents() const {
+			return _edge_parent;
+		}
+
+	private:
+		std::vector<double> _edge_distance;
+		std::vector<uint32_t> _edge_parent;
+		std::vector<double> _node_distance;
+		std::vector<uint32_t> _node_via;
+		std::vector<bool> _wanted;
+		common::IndexedDaryHeap<4> _open;
+	};
+
+	// Route lengths from every origin to every destination, row-major
+	// origins.size() x destinations.size(), infinity where there is no route.
+	// One tree per origin, origins are spread over `threads` workers
+	// (0 - all hardware threads); the result does not depend on their number.
+	std::vector<double> distance_matrix(
+		const RoadNetwork& network,
+		std::span<const Node* const> origins,
+		std::span<const Node* const> destinations,
+		size_t threads = 0);
+} // namespace tjs::core::algo
@@ -17,20 +17,72 @@ namespace tjs::core {
 		// profile -> school, work, shopping
 	};
 
+	// Route an agent follows: the edge it starts on, then a shared Route.
+	//
+	// Routes are never modified once found, and agents sent the same way hold
+	// the same one through the route cache, so a path costs a reference
+	// instead of a copy of its edges. Edges are indices into RoadNetwork::edges.
+	class AgentPath {
+	public:
+		AgentPath() = default;
+
+		// `route` must not be null, an empty one makes a path of the start edge only
+		AgentPath(RoadNetwork& network, const Edge& start, simulation::Route route)
+			: _edges(network.edges.data())
+			, _route(std::move(route))
+			, _start(network.edge_index(&start)) {
+		}
+
+		bool empty() const {
+			return _route == nullptr;
+		}
+
+		size_t size() const {
+			return empty() ? 0 : _route->size() + 1;
+		}
+
+		Edge* operator[](size_t i) const {
+			return _edges + (i == 0 ? _start : (*_route)[i - 1]);
+		}
+
+		Edge* front() const {
+			return (*this)[0];
+		}
+
+		Edge* back() const {
+			return (*this)[size() - 1];
+		}
+
+		void clear() {
+			_route.reset();
+		}
+
+		// Shared edges after the start one
+		const simulation::Route& route() const {
+			return _route;
+		}
+
+	private:
+		Edge* _edges = nullptr;
+		simulation::Route _route;
+		uint32_t _start = 0;
+	};
+
 	struct AgentData {
 		uint64_t id;
 		TacticalBehaviour behaviour = TacticalBehaviour::Normal;
 		AgentProfile profile;
 		core::Node* currentGoal = nullptr;
-		Vehicle* vehicle = nullptr;
-		std::vector<core::Edge*> path; // Path to follow
+		AgentHandle handle {};    // own slot in the AgentManager pool
+		VehicleHandle vehicle {}; // resolve through VehicleSystem::get
+		AgentPath path; // Path to follow
 		size_t path_offset = 0;
 		double distanceTraveled = 0.0; // Total distance traveled
 		bool stucked = false;
 		bool to_remove = false;
 		int goalFailCount = 0;
 
-		AgentData(uint64_t uid, Vehicle* vehicle_ = nullptr)
+		AgentData(uint64_t uid, VehicleHandle vehicle_ = {})
 			: id(uid)
 			, vehicle(vehicle_) {
 		}
@@ -29,6 +29,11 @@ namespace tjs::core::simulation {
 			return _agent_pool.objects();
 		}
 
+		// nullptr once the agent is removed
+		AgentData* get(AgentHandle handle) {
+			return _agent_pool.resolve(handle);
+		}
+
 	private:
 		void remove_agents();
 		void populate_agents();
@@ -0,0 +1,70 @@
+#pragma once
+
+#include <core/simulation/movement/idm/idm_params.h>
+
+namespace tjs::core::simulation::idm {
+	// Instruction set the batched IDM kernel runs on.
+	// Best available one is picked at runtime; others stay callable for tests and benchmarks.
+	enum class KernelIsa : char {
+		Scalar,
+		SSE,
+		AVX2
+	};
+
+	// Maximal difference between idm_accel_batch and idm_scalar, [m/s²].
+	// The batch kernel replaces std::pow(x, 4) by (x²)² and may reorder float
+	// operations, so results are equal only up to a few ULPs of a_max; the
+	// bound below has a wide margin over what is observed on sample maps.
+	static constexpr float KERNEL_TOLERANCE = 1e-4f;
+
+	// Gap used when nobody is ahead [m]
+	static constexpr float FREE_ROAD_GAP = 1e9f;
+
+	// Packed car-following state of one or several lanes. Each lane occupies a
+	// contiguous range ordered front→rear like LaneRuntime::idx, so inside a
+	// range vehicle k-1 is the leader of vehicle k.
+	struct LaneSoA {
+		std::vector<float> s_on_lane;  // [m]
+		std::vector<float> v_follower; // [m/s]
+		std::vector<float> length;     // [m]
+
+		// derived by build_leader_inputs, may be overridden per vehicle afterwards
+		std::vector<float> v_leader; // [m/s]
+		std::vector<float> s_gap;    // [m] bumper-to-bumper gap to the leader
+
+		std::vector<float> accel; // [m/s²] output
+
+		void resize(size_t n) {
+			s_on_lane.resize(n);
+			v_follower.resize(n);
+			length.resize(n);
+			v_leader.resize(n);
+			s_gap.resize(n);
+			accel.resize(n);
+		}
+	};
+
+	// actual_gap() to the leader for the lane packed in [first, first + n); its front
+	// vehicle gets a free road. Leader speed starts equal to the follower's own
+	// (Δv = 0), as phase 1 always did.
+	void build_leader_inputs(LaneSoA& lane, size_t first, size_t n) noexcept;
+
+	KernelIsa best_kernel_isa() noexcept;
+	const char* to_string(KernelIsa isa) noexcept;
+
+	// Vectorised equivalent of idm_scalar over n followers:
+	//   out[i] = idm_scalar(v_follower[i], v_leader[i], s_gap[i], p)   (± KERNEL_TOLERANCE)
+	// Falls back to the scalar loop when `isa` is not supported by the CPU.
+	void idm_accel_batch(
+		const float* v_follower,
+		const float* v_leader,
+		const float* s_gap,
+		float* out,
+		size_t n,
+		const idm_params_t& p,
+		KernelIsa isa = best_kernel_isa()) noexcept;
+
+	inline void idm_accel_batch(LaneSoA& lane, size_t n, const idm_params_t& p, KernelIsa isa = best_kernel_isa()) noexcept {
+		idm_accel_batch(lane.v_follower.data(), lane.v_leader.data(), lane.s_gap.data(), lane.accel.data(), n, p, isa);
+	}
+} // namespace tjs::core::simulation::idm
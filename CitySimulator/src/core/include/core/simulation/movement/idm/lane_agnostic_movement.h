@@ -8,17 +8,18 @@
 namespace tjs::core {
 	struct Lane;
 	struct Edge;
+	struct RoadNetwork;
 	struct AgentData;
 	struct Vehicle;
 } // namespace tjs::core
 
 namespace tjs::core::simulation {
 	class TrafficSimulationSystem;
+	class VehicleSystem;
 
 	namespace idm {
 		void phase1_simd(
 			TrafficSimulationSystem& system,
-			const std::vector<AgentData*>& agents,
 			const std::vector<LaneRuntime>& lane_rt,
 			double dt);
 
@@ -40,28 +41,28 @@ namespace tjs::core::simulation {
 		//------------------------------------------------------------------
 		//  move_index
 		//     • row          = Vehicle index to move
-		//     • lane_rt      = global vector<LaneRuntime> (indexed by Lane::id())
+		//     • vehicles     = owner of the per-lane runtime
 		//     • src / tgt    = source & destination Lane* (may be identical)
-		//     • vehicles     = reference to vehicles vector
 		//
-		//  Effect: removes `row` from src-lane's idx vector and inserts it in
-		//          order into tgt-lane's idx vector so both stay sorted.
+		//  Effect: removes `row` from src-lane's idx vector at its stored
+		//          Vehicle::idx_in_lane and inserts it in order into tgt-lane's
+		//          idx vector so both stay sorted.
 		//------------------------------------------------------------------
 		void move_index(Vehicle* vehicle_ptr,
-			std::vector<LaneRuntime>& lane_rt,
+			VehicleSystem& vehicles,
 			const Lane* src,
-			const Lane* tgt,
-			bool shadow = false);
+			const Lane* tgt);
 
 		//------------------------------------------------------------------
 		//  choose_entry_lane
+		//     • network      = road network with transition tables built
 		//     • src_lane     = current lane
 		//     • next_edge    = target edge
 		//     • err          = error output
 		//
 		//  Returns: best lane to enter on next_edge, or nullptr if impossible
 		//------------------------------------------------------------------
-		Lane* choose_entry_lane(const Lane* src_lane, const Edge* next_edge, VehicleMovementError& err);
+		Lane* choose_entry_lane(const RoadNetwork& network, const Lane* src_lane, const Edge* next_edge, VehicleMovementError& err);
 
 	} // namespace idm
 } // namespace tjs::core::simulation
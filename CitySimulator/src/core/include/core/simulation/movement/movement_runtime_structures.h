@@ -6,11 +6,47 @@ namespace tjs::core {
 } // namespace tjs::core
 
 namespace tjs::core::simulation {
+	// Per-lane occupancy. Both lists are ordered front→rear (descending s_on_lane)
+	// and every vehicle knows its position in them:
+	//  • Vehicle::idx_in_lane        – slot in `idx` of its current lane;
+	//  • Vehicle::idx_in_target_lane – slot in `vehicle_slots` of the lane it merges
+	//    into, NO_SLOT when it is not listed there.
+	// Erasing leaves a nullptr hole, so it does not move anyone; lane_compact /
+	// lane_resort drop the holes. Go through the helpers below so the stored
+	// positions stay valid.
 	struct LaneRuntime {
+		static constexpr uint32_t NO_SLOT = std::numeric_limits<uint32_t>::max();
+
 		Lane* static_lane = nullptr;
 		double length;
 		float max_speed;
 		std::vector<Vehicle*> idx;
 		std::vector<Vehicle*> vehicle_slots;
+		uint32_t idx_holes = 0;
+		uint32_t slot_holes = 0;
 	};
+
+	// Sorted insert into `idx`; takes a neighbouring hole when there is one,
+	// otherwise renumbers the vehicles behind it
+	void lane_insert(LaneRuntime& rt, Vehicle* vehicle);
+	// O(1): leaves a hole at the stored position
+	void lane_erase(LaneRuntime& rt, Vehicle* vehicle);
+
+	// Same for `vehicle_slots`; inserting a listed vehicle is a no-op
+	void slot_insert(LaneRuntime& rt, Vehicle* vehicle);
+	void slot_erase(LaneRuntime& rt, Vehicle* vehicle);
+
+	// Drops the holes of both lists and renumbers the vehicles that moved
+	void lane_compact(LaneRuntime& rt);
+
+	// Compacts and restores the order after positions moved. Vehicles rarely
+	// overtake within a step, so this is an insertion sort over nearly sorted lists.
+	void lane_resort(LaneRuntime& rt);
+
+	// Searches over a front→rear list that may hold holes:
+	// first position whose vehicle is not ahead of `s` (lower bound) ...
+	std::size_t lane_position(const std::vector<Vehicle*>& list, double s);
+	// ... and the nearest vehicle before / at or after a position, nullptr if none
+	Vehicle* lane_ahead(const std::vector<Vehicle*>& list, std::size_t pos);
+	Vehicle* lane_behind(const std::vector<Vehicle*>& list, std::size_t pos);
 } // namespace tjs::core::simulation
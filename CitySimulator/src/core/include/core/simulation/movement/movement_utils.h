@@ -6,15 +6,16 @@
 namespace tjs::core {
 	struct Lane;
 	struct Edge;
+	struct RoadNetwork;
 	struct AgentData;
 	struct Vehicle;
 } // namespace tjs::core
 
 namespace tjs::core::simulation {
 	// ------------------------------------------------------------------
-	// Build a 32-bit mask for *current* edge that flags which lanes can
-	// exit into `next_edge` according to LaneLink table.
+	// 32-bit mask for *current* edge that flags which lanes can exit into
+	// `next_edge`, looked up in the network's transition tables.
 	// ------------------------------------------------------------------
-	uint32_t build_goal_mask(const Edge& curr_edge, const Edge& next_edge);
+	uint32_t build_goal_mask(const RoadNetwork& network, const Edge& curr_edge, const Edge& next_edge);
 	void stop_moving(size_t i, AgentData& ag, Vehicle& vehicle, Lane* lane, VehicleMovementError error);
 } // namespace tjs::core::simulation
@@ -37,6 +37,15 @@ namespace tjs::core {
 		static constexpr size_t DEFAULT_VEHICLES_COUNT = 100;
 		static constexpr double DEFAULT_FIXED_STEP_SEC = 1.0;
 		static constexpr int DEFAULT_STEPS_ON_UPDATE = 10;
+		// 0 - use all hardware threads
+		static constexpr size_t DEFAULT_SIMULATION_THREADS = 0;
+		// routes kept by tactical planning, 0 - no cache
+		static constexpr size_t DEFAULT_ROUTE_CACHE_SIZE = 4096;
+		// background route searches, 0 - search inline during tactical planning
+		static constexpr size_t DEFAULT_ROUTE_PLANNER_THREADS = 1;
+		// landmarks of RoutingAlgoType::Landmarks; the map cache keeps
+		// LandmarkTable::DEFAULT_LANDMARKS, another count rebuilds the tables
+		static constexpr size_t DEFAULT_LANDMARKS_COUNT = 8;
 
 		bool randomSeed = true;
 		int seedValue = 0;
@@ -46,6 +55,11 @@ namespace tjs::core {
 		bool simulation_paused = true;
 		MovementAlgoType movement_algo = MovementAlgoType::IDM;
 		simulation::GeneratorType generator_type = simulation::GeneratorType::Bulk;
+		size_t simulation_threads = DEFAULT_SIMULATION_THREADS;
+		RoutingAlgoType routing_algo = RoutingAlgoType::AStar;
+		size_t route_cache_size = DEFAULT_ROUTE_CACHE_SIZE;
+		size_t route_planner_threads = DEFAULT_ROUTE_PLANNER_THREADS;
+		size_t landmarks_count = DEFAULT_LANDMARKS_COUNT;
 		std::vector<simulation::AgentTask> spawn_requests;
 
 		// It is here for saving debug information between launches
@@ -62,6 +76,11 @@ namespace tjs::core {
 			movement_algo,
 			debug_data,
 			generator_type,
+			simulation_threads,
+			routing_algo,
+			route_cache_size,
+			route_planner_threads,
+			landmarks_count,
 			spawn_requests);
 	};
 
@@ -0,0 +1,161 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <optional>
+
+#include <core/map_math/coordinates.h>
+#include <core/data_layer/vehicle.h>
+#include <core/simulation/time_module.h>
+
+namespace tjs::core::simulation {
+	class TrafficSimulationSystem;
+
+	// Copy of everything the UI reads from the simulation, taken after a step.
+	// Renderers and widgets must not touch live simulation objects while the
+	// simulation runs on its own thread, so they read this instead.
+	struct SimulationSnapshot {
+		// One row per vehicle, columns indexed the same way
+		struct Vehicles {
+			std::vector<uint64_t> uid;
+			std::vector<uint64_t> agent_id; // 0 if the vehicle has no agent
+			std::vector<Coordinates> coordinates;
+			std::vector<float> rotation_angle;
+			std::vector<float> length;
+			std::vector<float> width;
+			std::vector<float> s_on_lane;
+			std::vector<VehicleType> type;
+			std::vector<uint16_t> state;
+			std::vector<int> lane_id;   // -1 if not on a lane
+			std::vector<int> target_id; // lane the vehicle moves to, -1 if none
+
+			size_t size() const {
+				return uid.size();
+			}
+
+			void clear();
+			void reserve(size_t n);
+		};
+
+		struct Agent {
+			uint64_t id;
+			uint64_t vehicle_uid;
+			bool stucked;
+		};
+
+		// Path details of VehicleAnalyzeData::agent
+		struct TrackedAgent {
+			struct PathEdge {
+				Coordinates start;
+				Coordinates end;
+				uint64_t end_node_uid;
+			};
+
+			uint64_t id = 0;
+			uint64_t vehicle_uid = 0;
+			bool has_vehicle = false;
+			TacticalBehaviour behaviour = TacticalBehaviour::Normal;
+			Coordinates vehicle_position {};
+
+			bool has_goal = false;
+			uint64_t goal_uid = 0;
+			Coordinates goal {};
+
+			std::vector<PathEdge> path;
+			size_t path_offset = 0;
+		};
+
+		uint64_t version = 0; // number of captures so far
+		SimTimePoint current_time {};
+		bool paused = true;
+
+		Vehicles vehicles;
+		std::vector<Agent> agents;
+		std::optional<TrackedAgent> tracked;
+	};
+
+	// Fills `snapshot` from the current simulation state, reusing its storage.
+	// Must be called from the thread that steps the simulation.
+	void capture_snapshot(TrafficSimulationSystem& system, SimulationSnapshot& snapshot);
+
+	// Three snapshots: the simulation thread fills the back one, readers look at
+	// the front one and the middle one holds the latest publish. publish() and
+	// read() hand buffers over through one atomic exchange, so neither side
+	// ever waits for the other.
+	//
+	// One writer thread and one reader thread. A reader may nest read() calls;
+	// the front is only replaced once no guard is alive.
+	class SnapshotBuffer {
+	public:
+		class ReadGuard {
+		public:
+			ReadGuard(const SnapshotBuffer& buffer, const SimulationSnapshot& snapshot)
+				: _buffer(&buffer)
+				, _snapshot(&snapshot) {
+			}
+
+			ReadGuard(ReadGuard&& other) noexcept
+				: _buffer(std::exchange(other._buffer, nullptr))
+				, _snapshot(other._snapshot) {
+			}
+
+			ReadGuard(const ReadGuard&) = delete;
+			ReadGuard& operator=(const ReadGuard&) = delete;
+			ReadGuard& operator=(ReadGuard&&) = delete;
+
+			~ReadGuard() {
+				if (_buffer) {
+					--_buffer->_readers;
+				}
+			}
+
+			const SimulationSnapshot& operator*() const {
+				return *_snapshot;
+			}
+			const SimulationSnapshot* operator->() const {
+				return _snapshot;
+			}
+
+		private:
+			const SnapshotBuffer* _buffer;
+			const SimulationSnapshot* _snapshot;
+		};
+
+	public:
+		// Writer side, single thread only
+		SimulationSnapshot& back() {
+			return _buffers[_back];
+		}
+
+		// Makes back() visible to readers and takes the middle buffer as the
+		// next back(). Never blocks.
+		void publish() {
+			_buffers[_back].version = ++_published;
+			_back = _middle.exchange(_back | FRESH, std::memory_order_acq_rel) & INDEX;
+		}
+
+		// Reader side, single thread only. Returns the latest published
+		// snapshot; it stays unchanged while the guard is alive, however many
+		// times the writer publishes meanwhile.
+		ReadGuard read() const {
+			if (_readers == 0 && (_middle.load(std::memory_order_relaxed) & FRESH)) {
+				_front = _middle.exchange(_front, std::memory_order_acq_rel) & INDEX;
+			}
+			++_readers;
+			return ReadGuard(*this, _buffers[_front]);
+		}
+
+	private:
+		// _middle holds a buffer index and whether it was published since the
+		// reader last took it
+		static constexpr uint32_t INDEX = 3;
+		static constexpr uint32_t FRESH = 4;
+
+		std::array<SimulationSnapshot, 3> _buffers;
+		uint32_t _back = 0;
+		uint64_t _published = 0;
+		mutable std::atomic<uint32_t> _middle { 1 };
+		mutable uint32_t _front = 2;
+		mutable uint32_t _readers = 0; // live guards
+	};
+} // namespace tjs::core::simulation
@@ -8,6 +8,7 @@
 #include <core/simulation/agent/agent_manager.h>
 
 #include <common/message_dispatcher/message_dispatcher.h>
+#include <common/threading/worker_pool.h>
 
 namespace tjs::core {
 	class WorldData;
@@ -70,6 +71,10 @@ namespace tjs::core::simulation {
 			return _settings;
 		}
 
+		common::WorkerPool& worker_pool() {
+			return _worker_pool;
+		}
+
 	private:
 		TimeModule _timeModule;
 		StrategicPlanningModule _strategicModule;
@@ -85,5 +90,6 @@ namespace tjs::core::simulation {
 		core::WorldData& _worldData;
 
 		common::MessageDispatcher _message_dispatcher;
+		common::WorkerPool _worker_pool { 1 };
 	};
 } // namespace tjs::core::simulation
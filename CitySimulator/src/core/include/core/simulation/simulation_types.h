@@ -1,6 +1,14 @@
 #pragma once
 
+#include <common/pool_handle.h>
+
 namespace tjs::core {
+	struct Vehicle;
+	struct AgentData;
+
+	// Checked references into VehicleSystem and AgentManager pools
+	using VehicleHandle = common::PoolHandle<Vehicle>;
+	using AgentHandle = common::PoolHandle<AgentData>;
 
 	ENUM_FLAG(TacticalBehaviour, char,
 		Normal,
@@ -17,4 +25,14 @@ namespace tjs::core {
 		Agent,
 		IDM);
 
+	ENUM(RoutingAlgoType, char,
+		AStar,
+		Landmarks,
+		Bidirectional);
+
 } // namespace tjs::core
+
+namespace tjs::core::simulation {
+	// Edge indices of a route, the start edge not included; never modified once stored
+	using Route = std::shared_ptr<const std::vector<uint32_t>>;
+} // namespace tjs::core::simulation
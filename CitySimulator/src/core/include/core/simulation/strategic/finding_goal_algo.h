@@ -2,18 +2,23 @@
 
 #include <common/spatial/spatial_grid.h>
 
+#include <functional>
+
 namespace tjs::core {
 	struct Node;
 	struct Coordinates;
 	struct WayInfo;
 	struct Lane;
-	using SpatialGrid = tjs::common::SpatialGrid<WayInfo, Lane>;
+	using SpatialGrid = tjs::common::SpatialGrid<WayInfo, Lane, Node>;
 } // namespace tjs::core
 
 namespace tjs::core::simulation {
+	// Random node minRadius..maxRadius away; `accept`, when set, filters the
+	// candidates, e.g. the ones the vehicle cannot reach
 	Node* find_random_goal(
 		const SpatialGrid& grid,
 		const Coordinates& coord,
 		double minRadius,
-		double maxRadius);
+		double maxRadius,
+		const std::function<bool(const Node&)>& accept = {});
 } // namespace tjs::core::simulation
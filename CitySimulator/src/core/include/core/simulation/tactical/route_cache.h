@@ -0,0 +1,71 @@
+#pragma once
+
+#include <common/lru_cache.h>
+
+#include <core/simulation/simulation_types.h>
+
+namespace tjs::core {
+	struct RoadNetwork;
+	struct Lane;
+	struct Node;
+} // namespace tjs::core
+
+namespace tjs::core::simulation {
+	// A route request: from a lane, or from any lane of its edge, to a goal node
+	struct RouteKey {
+		uint32_t start;  // lane index, edge index when from_edge
+		uint32_t goal;   // graph index
+		RoutingAlgoType algo;
+		bool from_edge;
+
+		bool operator==(const RouteKey&) const = default;
+	};
+
+	struct RouteKeyHash {
+		size_t operator()(const RouteKey& key) const {
+			const uint64_t packed = (static_cast<uint64_t>(key.start) << 32) | key.goal;
+			return std::hash<uint64_t> {}(packed) ^ (static_cast<size_t>(key.algo) << 1 | key.from_edge);
+		}
+	};
+
+	// Routes found by tactical planning, shared by agents asking the same question.
+	//
+	// Flow generators send many vehicles from one lane to one goal, so most
+	// requests repeat. A null Route records that there is no route. All
+	// routes are dropped once RoadNetwork::revision moves on.
+	class RouteCache {
+	public:
+		using Stats = common::LruCache<RouteKey, Route, RouteKeyHash>::Stats;
+
+	public:
+		static RouteKey make_key(const RoadNetwork& network, const Lane* start_lane, const Node* goal, bool look_adjacent_lanes, RoutingAlgoType algo);
+
+		// Drops the routes if they were found on another network or revision
+		void validate(const RoadNetwork& network);
+
+		// Cached answer, nullptr on a miss
+		const Route* find(const RouteKey& key) {
+			return _routes.find(key);
+		}
+
+		void store(const RouteKey& key, Route route) {
+			_routes.insert(key, std::move(route));
+		}
+
+		// Clears routes and counters; capacity 0 disables the cache
+		void reset(size_t capacity);
+
+		size_t size() const {
+			return _routes.size();
+		}
+
+		const Stats& stats() const {
+			return _routes.stats();
+		}
+
+	private:
+		common::LruCache<RouteKey, Route, RouteKeyHash> _routes;
+		const RoadNetwork* _network = nullptr;
+		uint32_t _revision = 0;
+	};
+} // namespace tjs::core::simulation
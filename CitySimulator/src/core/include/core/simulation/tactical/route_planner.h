@@ -0,0 +1,68 @@
+#pragma once
+
+#include <core/simulation/tactical/route_cache.h>
+
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
+namespace tjs::core::simulation {
+	// Route searches off the simulation thread.
+	//
+	// submit() queues a search and returns its ticket. Workers take searches
+	// in any order, collect() waits for all of them (helping with the rest)
+	// and returns the results indexed by ticket, so a caller applying them in
+	// ticket order stays deterministic whatever the timing.
+	//
+	// The network must not change between submit() and collect().
+	class RoutePlanner {
+	public:
+		struct Request {
+			const Lane* start_lane;
+			const Node* goal;
+			bool look_adjacent_lanes;
+			RoutingAlgoType algo;
+		};
+
+	public:
+		RoutePlanner() = default;
+		~RoutePlanner();
+
+		RoutePlanner(const RoutePlanner&) = delete;
+		RoutePlanner& operator=(const RoutePlanner&) = delete;
+
+		// Searches one route on the calling thread, null if there is none
+		static Route search(const RoadNetwork& network, const Request& request);
+
+		// Background threads; with 0 collect() runs every search itself
+		void resize(size_t threads);
+
+		size_t size() const {
+			return _threads.size();
+		}
+
+		size_t submit(const RoadNetwork& network, const Request& request);
+
+		// Results of every search submitted since the last collect(), by ticket
+		std::vector<Route> collect();
+
+	private:
+		void worker_loop();
+		// Runs the next queued search, `lock` is held on entry and exit
+		void run_next(std::unique_lock<std::mutex>& lock);
+		void stop();
+
+	private:
+		std::vector<std::thread> _threads;
+		std::mutex _mutex;
+		std::condition_variable _wake;
+		std::condition_variable _done;
+		bool _stopping = false;
+
+		const RoadNetwork* _network = nullptr;
+		std::vector<Request> _requests;
+		std::vector<Route> _results;
+		size_t _next = 0;     // first request no worker has taken
+		size_t _finished = 0; // requests with a result
+	};
+} // namespace tjs::core::simulation
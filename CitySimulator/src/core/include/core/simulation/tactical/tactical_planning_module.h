@@ -1,6 +1,7 @@
 #pragma once
 #include "core/data_layer/data_types.h"
 #include "core/simulation/agent/agent_data.h"
+#include "core/simulation/tactical/route_planner.h"
 
 namespace tjs::core::simulation {
 	class TrafficSimulationSystem;
@@ -12,9 +13,30 @@ namespace tjs::core::simulation {
 		void initialize();
 		void release();
 		void update();
+		// Step boundary: waits for the searches update() queued and applies them
+		void apply_routes();
+
+		// Applies a cached route at once; otherwise queues the search for
+		// apply_routes(), with or without planner threads
+		void plan_route(AgentData& agent, Lane& start_lane, Node& goal, bool look_adjacent_lanes);
+
+		RouteCache& route_cache() {
+			return _route_cache;
+		}
 
 	private:
+		struct PendingRoute {
+			AgentHandle agent; // the agent may retire before apply_routes()
+			Lane* start_lane;
+			RouteKey key;
+			size_t ticket;
+		};
+
 		TrafficSimulationSystem& _system;
+		RouteCache _route_cache;
+		RoutePlanner _planner;
+		std::vector<PendingRoute> _pending;
+		std::unordered_map<RouteKey, size_t, RouteKeyHash> _tickets; // this step's searches
 	};
 
 	namespace simulation_details {
@@ -3,6 +3,7 @@
 #include <core/simulation/transport_management/vehicle_state.h>
 
 #include <core/data_layer/vehicle.h>
+#include <core/data_layer/lane.h>
 #include <core/simulation/movement/idm/lane_agnostic_movement.h>
 #include <common/object_pool.h>
 
@@ -28,33 +29,75 @@ namespace tjs::core::simulation {
 		void initialize();
 		void release();
 		void update();
+		// Drops the holes removals left in the lane lists
+		void compact_lanes();
 
 		const std::vector<Vehicle*>& vehicles() {
 			return _vehicle_pool.objects();
 		}
 
+		// nullptr once the vehicle is removed
+		Vehicle* get(VehicleHandle handle) {
+			return _vehicle_pool.resolve(handle);
+		}
+
+		VehicleStore& store() {
+			return _store;
+		}
+
 		const VehicleConfigs& vehicle_configs() const {
 			return _vehicle_configs;
 		}
 
-		void commit();
-
 		// return handle to vehicle
 		std::optional<Vehicle*> create_vehicle(Lane& lane, VehicleType type, float desired_speed);
 		void remove_vehicle(Vehicle* vehicle);
 
+		// Puts the vehicle on `lane` at its s_on_lane, nullptr takes it off the road.
+		// Same lane re-inserts it, e.g. after it moved.
+		void move_to_lane(Vehicle& vehicle, Lane* lane);
+
+		// Vehicles on the lane, front to rear. The map keeps no occupancy,
+		// this is the only per-lane list.
+		const std::vector<Vehicle*>& lane_vehicles(const Lane& lane) const;
+
 	private:
 		TrafficSimulationSystem& _system;
 
 		VehicleConfigs _vehicle_configs;
 		VehiclePool _vehicle_pool;
+		VehicleStore _store;
+		// VehicleStore rows are renumbered in lane order every REORDER_INTERVAL updates
+		static constexpr size_t REORDER_INTERVAL = 16;
+		size_t _steps_since_reorder = 0;
+		std::vector<Vehicle*> _row_order;
+		std::vector<uint8_t> _row_taken;
 
 		std::vector<LaneRuntime> _lane_runtime;
+		// Lane id → slot in _lane_runtime. The map is shared read-only,
+		// so the simulation keeps its own lookup.
+		std::vector<uint32_t> _lane_slots;
+		int _first_lane_id = 0;
 
 	public:
 		std::vector<LaneRuntime>& lane_runtime() {
 			return _lane_runtime;
 		}
+		const std::vector<LaneRuntime>& lane_runtime() const {
+			return _lane_runtime;
+		}
+
+		// LaneRuntime::NO_SLOT for lanes outside the simulated network
+		uint32_t lane_slot(const Lane& lane) const {
+			const size_t key = static_cast<size_t>(lane.get_id() - _first_lane_id);
+			return key < _lane_slots.size() ? _lane_slots[key] : LaneRuntime::NO_SLOT;
+		}
+		LaneRuntime& lane_runtime(const Lane& lane) {
+			return _lane_runtime[lane_slot(lane)];
+		}
+		const LaneRuntime& lane_runtime(const Lane& lane) const {
+			return _lane_runtime[lane_slot(lane)];
+		}
 	};
 
 } // namespace tjs::core::simulation
@@ -1,25 +1,23 @@
 #pragma once
 
 #include <core/store_models/idata_model.h>
-
-namespace tjs::core {
-	struct AgentData;
-} // namespace tjs::core
+#include <core/simulation/simulation_types.h>
 
 namespace tjs::core::model {
 	struct VehicleAnalyzeData : public IDataModel {
-		core::AgentData* agent = nullptr;
+		// resolves to nullptr once the agent is removed
+		core::AgentHandle agent {};
 
 		static std::type_index get_type() {
 			return typeid(VehicleAnalyzeData);
 		}
 
-		void set_agent(core::AgentData* agent) {
+		void set_agent(core::AgentHandle agent) {
 			this->agent = agent;
 		}
 
 		void reinit() {
-			agent = nullptr;
+			agent.reset();
 		}
 	};
 } // namespace tjs::core::model
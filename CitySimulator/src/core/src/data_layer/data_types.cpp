@@ -30,6 +30,9 @@ namespace tjs::core {
 		for (const auto& [_, way] : ways) {
 			add_way(spatialGrid, way.get());
 		}
+		for (const auto& [_, node] : nodes) {
+			add_node(spatialGrid, node.get());
+		}
 	}
 
 	void add_way(SpatialGrid& grid, WayInfo* way) {
@@ -44,22 +47,69 @@ namespace tjs::core {
 		for (auto& edgeHandler : way->edges) {
 			const auto& edge = *edgeHandler;
 			for (const auto& lane : edge.lanes) {
-				if (lane.centerLine.empty()) {
-					continue;
-				}
-				common::BoundingBox box { lane.centerLine.front().x,
-					lane.centerLine.front().y,
-					lane.centerLine.front().x,
-					lane.centerLine.front().y };
-				for (const auto& c : lane.centerLine) {
-					box.min_x = std::min(box.min_x, c.x);
-					box.min_y = std::min(box.min_y, c.y);
-					box.max_x = std::max(box.max_x, c.x);
-					box.max_y = std::max(box.max_y, c.y);
-				}
-				grid.add_tree_entry(box, const_cast<Lane*>(&lane));
+				add_lane(grid, const_cast<Lane*>(&lane));
 			}
 		}
 	}
 
+	void add_lane(SpatialGrid& grid, Lane* lane) {
+		if (lane == nullptr || lane->centerLine.empty()) {
+			return;
+		}
+		common::BoundingBox box { lane->centerLine.front().x,
+			lane->centerLine.front().y,
+			lane->centerLine.front().x,
+			lane->centerLine.front().y };
+		for (const auto& c : lane->centerLine) {
+			box.min_x = std::min(box.min_x, c.x);
+			box.min_y = std::min(box.min_y, c.y);
+			box.max_x = std::max(box.max_x, c.x);
+			box.max_y = std::max(box.max_y, c.y);
+		}
+		grid.add_tree_entry(box, lane);
+	}
+
+	void add_node(SpatialGrid& grid, Node* node) {
+		if (node == nullptr || node->ways.empty()) {
+			return;
+		}
+		grid.add_point_entry(node, node->coordinates);
+	}
+
+	std::vector<Node*> find_nearest_nodes(const SpatialGrid& grid, const Coordinates& coordinates, size_t k, double max_distance) {
+		std::vector<Node*> result;
+		result.reserve(std::min(k, grid.points.size()));
+		grid.points.nearest(coordinates.x, coordinates.y, k, std::back_inserter(result), max_distance);
+		return result;
+	}
+
+	Node* find_nearest_node(const SpatialGrid& grid, const Coordinates& coordinates, double max_distance) {
+		Node* nearest = nullptr;
+		grid.points.nearest(coordinates.x, coordinates.y, 1, &nearest, max_distance);
+		return nearest;
+	}
+
+	Lane* find_nearest_lane(const SpatialGrid& grid, const Coordinates& coordinates, double max_distance) {
+		const double x = coordinates.x;
+		const double y = coordinates.y;
+		// the box of a lane holds its center line, so this is never less than the box distance
+		auto center_line_distance = [x, y](const Lane* lane, const common::BoundingBox&) {
+			const auto& line = lane->centerLine;
+			double best = std::hypot(line.front().x - x, line.front().y - y);
+			for (size_t i = 0; i + 1 < line.size(); ++i) {
+				const double dx = line[i + 1].x - line[i].x;
+				const double dy = line[i + 1].y - line[i].y;
+				const double length2 = dx * dx + dy * dy;
+				double t = length2 > 0.0 ? ((x - line[i].x) * dx + (y - line[i].y) * dy) / length2 : 0.0;
+				t = std::clamp(t, 0.0, 1.0);
+				best = std::min(best, std::hypot(line[i].x + t * dx - x, line[i].y + t * dy - y));
+			}
+			return best;
+		};
+
+		Lane* nearest = nullptr;
+		grid.tree.nearest(x, y, 1, &nearest, center_line_distance, max_distance);
+		return nearest;
+	}
+
 } // namespace tjs::core
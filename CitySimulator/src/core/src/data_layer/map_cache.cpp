@@ -0,0 +1,891 @@
+#include <core/stdafx.h>
+
+#include <core/data_layer/map_cache.h>
+#include <core/data_layer/world_data.h>
+#include <core/data_layer/world_creator.h>
+#include <core/map_math/landmarks.h>
+
+#include <common/io/mapped_file.h>
+
+#include <cstring>
+#include <fstream>
+#include <random>
+#include <span>
+
+namespace tjs::core::details {
+	namespace {
+		constexpr std::array<char, 4> MAGIC = { 'T', 'J', 'M', 'C' };
+		constexpr size_t ALIGNMENT = 8;
+
+		// All records are plain data; pointers are stored as indices into the
+		// record arrays of the same segment, variable-sized members as ranges
+		// in the pools that follow them.
+		struct Range {
+			uint32_t begin;
+			uint32_t count;
+		};
+
+		struct Header {
+			std::array<char, 4> magic;
+			uint32_t version;
+			uint64_t source_size;
+			int64_t source_mtime;
+			uint32_t segments;
+			uint32_t car_ways_only;
+		};
+
+		struct NodeRecord {
+			uint64_t uid;
+			Coordinates coordinates;
+			Range ways;
+			NodeTags tags;
+		};
+
+		struct WayRecord {
+			uint64_t uid;
+			double lane_width;
+			int32_t lanes;
+			int32_t lanes_forward;
+			int32_t lanes_backward;
+			int32_t max_speed;
+			int32_t layer;
+			Range node_refs;
+			Range nodes;
+			Range forward_turns;
+			Range backward_turns;
+			Range edges;
+			WayType type;
+			WayTag tags;
+			bool is_oneway;
+		};
+
+		struct EdgeRecord {
+			int32_t id;
+			uint32_t start_node;
+			uint32_t end_node;
+			uint32_t way;
+			double length;
+			Range lanes;
+			Range outgoing_edges;
+			LaneOrientation orientation;
+			uint8_t opposite_side;
+		};
+
+		struct LaneRecord {
+			int32_t id;
+			uint32_t index_in_edge;
+			double width;
+			double length;
+			Range center_line;
+			float rotation_angle;
+			TurnDirection turn;
+			LaneOrientation orientation;
+		};
+
+		struct LinkRecord {
+			uint32_t from;
+			uint32_t to;
+			bool yield;
+		};
+
+		struct CellRecord {
+			int32_t x;
+			int32_t y;
+			Range ways;
+		};
+
+		constexpr uint32_t NO_LANE = std::numeric_limits<uint32_t>::max();
+
+		struct EntryRecord {
+			uint32_t lane; // NO_LANE when there is no link
+			uint32_t yield;
+		};
+
+		using LaneTree = common::RTree<Lane*>;
+		using PointTree = common::RTree<Node*>;
+		using TreeNode = common::RTreeFlatNode;
+
+		constexpr size_t aligned(size_t size) {
+			return (size + ALIGNMENT - 1) & ~(ALIGNMENT - 1);
+		}
+
+		class Writer {
+		public:
+			template<typename T>
+			void value(const T& v) {
+				static_assert(std::is_trivially_copyable_v<T>);
+				append(&v, sizeof(T));
+			}
+
+			template<typename T>
+			void array(const std::vector<T>& items) {
+				static_assert(std::is_trivially_copyable_v<T>);
+				value<uint64_t>(items.size());
+				append(items.data(), items.size() * sizeof(T));
+			}
+
+			template<typename T>
+			void csr(const common::CsrAdjacency<T>& adjacency) {
+				array(adjacency.offsets);
+				array(adjacency.targets);
+			}
+
+			const std::vector<std::byte>& buffer() const {
+				return _buffer;
+			}
+
+		private:
+			// Every block starts 8-byte aligned so records can be read in place
+			void append(const void* data, size_t size) {
+				const size_t offset = _buffer.size();
+				_buffer.resize(offset + aligned(size));
+				if (size != 0) {
+					std::memcpy(_buffer.data() + offset, data, size);
+				}
+			}
+
+		private:
+			std::vector<std::byte> _buffer;
+		};
+
+		class Reader {
+		public:
+			explicit Reader(std::span<const std::byte> data)
+				: _data(data) {
+			}
+
+			template<typename T>
+			bool value(T& out) {
+				const std::byte* ptr = take(sizeof(T));
+				if (ptr == nullptr) {
+					return false;
+				}
+				std::memcpy(&out, ptr, sizeof(T));
+				return true;
+			}
+
+			// Points into the mapping, valid while the file is mapped
+			template<typename T>
+			bool array(std::span<const T>& out) {
+				static_assert(alignof(T) <= ALIGNMENT);
+				uint64_t count = 0;
+				if (!value(count) || count > (_data.size() - _offset) / sizeof(T)) {
+					return false;
+				}
+				const std::byte* ptr = take(count * sizeof(T));
+				if (ptr == nullptr) {
+					return false;
+				}
+				out = { reinterpret_cast<const T*>(ptr), static_cast<size_t>(count) };
+				return true;
+			}
+
+			template<typename T>
+			bool csr(std::span<const uint32_t>& offsets, std::span<const T>& targets) {
+				return array(offsets) && array(targets);
+			}
+
+		private:
+			const std::byte* take(size_t size) {
+				if (aligned(size) > _data.size() - _offset) {
+					return nullptr;
+				}
+				const std::byte* ptr = _data.data() + _offset;
+				_offset += aligned(size);
+				return ptr;
+			}
+
+		private:
+			std::span<const std::byte> _data;
+			size_t _offset = 0;
+		};
+
+		bool source_stamp(const std::filesystem::path& source_file, uint64_t& size, int64_t& mtime) {
+			std::error_code ec;
+			size = std::filesystem::file_size(source_file, ec);
+			if (ec) {
+				return false;
+			}
+			const auto time = std::filesystem::last_write_time(source_file, ec);
+			if (ec) {
+				return false;
+			}
+			mtime = static_cast<int64_t>(time.time_since_epoch().count());
+			return true;
+		}
+
+		template<typename T>
+		Range append_range(std::vector<T>& pool, const T* items, size_t count) {
+			Range range { static_cast<uint32_t>(pool.size()), static_cast<uint32_t>(count) };
+			pool.insert(pool.end(), items, items + count);
+			return range;
+		}
+
+		bool in_bounds(const Range& range, size_t pool_size) {
+			return static_cast<size_t>(range.begin) + range.count <= pool_size;
+		}
+
+		// Copies a stored CsrAdjacency of `rows` rows if its offsets are sane
+		template<typename T>
+		bool restore_csr(common::CsrAdjacency<T>& out, std::span<const uint32_t> offsets, std::span<const T> targets, size_t rows) {
+			if (offsets.size() != rows + 1 || offsets.front() != 0 || offsets.back() != targets.size()
+				|| !std::ranges::is_sorted(offsets)) {
+				return false;
+			}
+			out.offsets.assign(offsets.begin(), offsets.end());
+			out.targets.assign(targets.begin(), targets.end());
+			return true;
+		}
+
+		template<typename T, typename Index>
+		bool restore_tree(common::RTree<T>& tree, std::span<const TreeNode> nodes, std::span<const common::BoundingBox> boxes, std::span<const uint32_t> values, const std::vector<Index>& objects) {
+			std::vector<T> resolved;
+			resolved.reserve(values.size());
+			for (uint32_t i : values) {
+				if (i >= objects.size()) {
+					return false;
+				}
+				resolved.push_back(objects[i]);
+			}
+			return tree.unflatten(nodes, boxes, resolved);
+		}
+
+		// ------------------------------------------------------------------ //
+		// Save                                                               //
+		// ------------------------------------------------------------------ //
+		void save_segment(Writer& writer, WorldSegment& segment) {
+			RoadNetwork& network = *segment.road_network;
+
+			std::unordered_map<const Node*, uint32_t> node_index;
+			std::unordered_map<const WayInfo*, uint32_t> way_index;
+			std::vector<const Node*> nodes;
+			std::vector<const WayInfo*> ways;
+			nodes.reserve(segment.nodes.size());
+			ways.reserve(segment.ways.size());
+			for (const auto& [_, node] : segment.nodes) {
+				node_index.emplace(node.get(), static_cast<uint32_t>(nodes.size()));
+				nodes.push_back(node.get());
+			}
+			for (const auto& [_, way] : segment.ways) {
+				way_index.emplace(way.get(), static_cast<uint32_t>(ways.size()));
+				ways.push_back(way.get());
+			}
+
+			auto edge_index = [&network](const Edge* edge) {
+				return static_cast<uint32_t>(edge - network.edges.data());
+			};
+
+			std::vector<uint32_t> lane_begin(network.edges.size());
+			size_t lanes_count = 0;
+			for (size_t i = 0; i < network.edges.size(); ++i) {
+				lane_begin[i] = static_cast<uint32_t>(lanes_count);
+				lanes_count += network.edges[i].lanes.size();
+			}
+			auto lane_index = [&](const Lane* lane) {
+				const Edge* edge = lane->parent;
+				return lane_begin[edge_index(edge)] + static_cast<uint32_t>(lane - edge->lanes.data());
+			};
+
+			writer.value(segment.boundingBox);
+
+			// Nodes
+			std::vector<NodeRecord> node_records(nodes.size());
+			std::vector<uint32_t> node_ways;
+			for (size_t i = 0; i < nodes.size(); ++i) {
+				const Node& node = *nodes[i];
+				NodeRecord& record = node_records[i];
+				record.uid = node.uid;
+				record.coordinates = node.coordinates;
+				record.tags = node.tags;
+				record.ways = { static_cast<uint32_t>(node_ways.size()), static_cast<uint32_t>(node.ways.size()) };
+				for (const WayInfo* way : node.ways) {
+					node_ways.push_back(way_index.at(way));
+				}
+			}
+			writer.array(node_records);
+			writer.array(node_ways);
+
+			// Ways
+			std::vector<WayRecord> way_records(ways.size());
+			std::vector<uint64_t> node_refs;
+			std::vector<uint32_t> way_nodes;
+			std::vector<TurnDirection> turns;
+			std::vector<uint32_t> way_edges;
+			for (size_t i = 0; i < ways.size(); ++i) {
+				const WayInfo& way = *ways[i];
+				WayRecord& record = way_records[i];
+				record.uid = way.uid;
+				record.lane_width = way.laneWidth;
+				record.lanes = way.lanes;
+				record.lanes_forward = way.lanesForward;
+				record.lanes_backward = way.lanesBackward;
+				record.max_speed = way.maxSpeed;
+				record.layer = way.layer;
+				record.type = way.type;
+				record.tags = way.tags;
+				record.is_oneway = way.isOneway;
+				record.node_refs = append_range(node_refs, way.nodeRefs.data(), way.nodeRefs.size());
+				record.forward_turns = append_range(turns, way.forwardTurns.data(), way.forwardTurns.size());
+				record.backward_turns = append_range(turns, way.backwardTurns.data(), way.backwardTurns.size());
+
+				record.nodes = { static_cast<uint32_t>(way_nodes.size()), static_cast<uint32_t>(way.nodes.size()) };
+				for (const Node* node : way.nodes) {
+					way_nodes.push_back(node_index.at(node));
+				}
+				record.edges = { static_cast<uint32_t>(way_edges.size()), static_cast<uint32_t>(way.edges.size()) };
+				for (const EdgeHandler& edge : way.edges) {
+					way_edges.push_back(edge_index(&*edge));
+				}
+			}
+			writer.array(way_records);
+			writer.array(node_refs);
+			writer.array(way_nodes);
+			writer.array(turns);
+			writer.array(way_edges);
+
+			std::vector<uint32_t> sorted_ways;
+			sorted_ways.reserve(segment.sorted_ways.size());
+			for (const WayInfo* way : segment.sorted_ways) {
+				sorted_ways.push_back(way_index.at(way));
+			}
+			writer.array(sorted_ways);
+
+			// Edges and lanes
+			std::vector<EdgeRecord> edge_records(network.edges.size());
+			std::vector<uint32_t> outgoing_edges;
+			std::vector<LaneRecord> lane_records(lanes_count);
+			std::vector<Coordinates> center_lines;
+			for (size_t i = 0; i < network.edges.size(); ++i) {
+				const Edge& edge = network.edges[i];
+				EdgeRecord& record = edge_records[i];
+				record.id = edge.get_id();
+				record.start_node = node_index.at(edge.start_node);
+				record.end_node = node_index.at(edge.end_node);
+				record.way = way_index.at(edge.way);
+				record.length = edge.length;
+				record.orientation = edge.orientation;
+				record.opposite_side = static_cast<uint8_t>(edge.opposite_side);
+				record.lanes = { lane_begin[i], static_cast<uint32_t>(edge.lanes.size()) };
+				record.outgoing_edges = { static_cast<uint32_t>(outgoing_edges.size()), static_cast<uint32_t>(edge.outgoing_edges.size()) };
+				for (const Edge* out : edge.outgoing_edges) {
+					outgoing_edges.push_back(edge_index(out));
+				}
+
+				for (const Lane& lane : edge.lanes) {
+					LaneRecord& lane_record = lane_records[lane_index(&lane)];
+					lane_record.id = lane.get_id();
+					lane_record.index_in_edge = static_cast<uint32_t>(lane.index_in_edge);
+					lane_record.width = lane.width;
+					lane_record.length = lane.length;
+					lane_record.rotation_angle = lane.rotation_angle;
+					lane_record.turn = lane.turn;
+					lane_record.orientation = lane.orientation;
+					lane_record.center_line = append_range(center_lines, lane.centerLine.data(), lane.centerLine.size());
+				}
+			}
+			writer.array(edge_records);
+			writer.array(outgoing_edges);
+			writer.array(lane_records);
+			writer.array(center_lines);
+
+			// Lane links, per-lane connections are restored in this order
+			std::vector<LinkRecord> link_records(network.lane_links.size());
+			for (size_t i = 0; i < network.lane_links.size(); ++i) {
+				const LaneLink& link = network.lane_links[i];
+				link_records[i].from = lane_index(link.from);
+				link_records[i].to = lane_index(link.to);
+				link_records[i].yield = link.yield;
+			}
+			writer.array(link_records);
+
+			// Graph tables exactly as build_node_graph and build_lane_graph leave them
+			std::vector<uint32_t> graph_nodes;
+			graph_nodes.reserve(network.graph_nodes.size());
+			for (const Node* node : network.graph_nodes) {
+				graph_nodes.push_back(node_index.at(node));
+			}
+			writer.array(graph_nodes);
+			writer.csr(network.node_graph);
+			writer.csr(network.incoming_edges);
+			writer.csr(network.edge_transitions);
+			writer.csr(network.edge_predecessors);
+			writer.array(network.lane_offsets);
+			writer.csr(network.lane_graph);
+			writer.array(network.transition_goal_masks);
+			writer.array(network.entry_offsets);
+
+			std::vector<EntryRecord> entries;
+			entries.reserve(network.lane_entries.size());
+			for (const LaneEntry& entry : network.lane_entries) {
+				entries.push_back({ entry.lane ? lane_index(entry.lane) : NO_LANE, entry.yield });
+			}
+			writer.array(entries);
+			writer.array(network.edge_component);
+			writer.array(network.node_component);
+			writer.value<uint64_t>(network.component_words);
+			writer.array(network.component_reach);
+
+			// Spatial index: cells and both trees as they are
+			const SpatialGrid& grid = segment.spatialGrid;
+			std::vector<CellRecord> cell_records;
+			std::vector<uint32_t> cell_ways;
+			cell_records.reserve(grid.spatialGrid.size());
+			for (const auto& [key, entries] : grid.spatialGrid) {
+				CellRecord& record = cell_records.emplace_back();
+				record.x = key.first;
+				record.y = key.second;
+				record.ways = { static_cast<uint32_t>(cell_ways.size()), static_cast<uint32_t>(entries.size()) };
+				for (const WayInfo* way : entries) {
+					cell_ways.push_back(way_index.at(way));
+				}
+			}
+
+			std::vector<TreeNode> tree_nodes;
+			std::vector<common::BoundingBox> tree_boxes;
+			std::vector<Lane*> tree_lanes;
+			grid.tree.flatten(tree_nodes, tree_boxes, tree_lanes);
+			std::vector<uint32_t> tree_values;
+			tree_values.reserve(tree_lanes.size());
+			for (const Lane* lane : tree_lanes) {
+				tree_values.push_back(lane_index(lane));
+			}
+
+			std::vector<TreeNode> point_nodes;
+			std::vector<common::BoundingBox> point_boxes;
+			std::vector<Node*> point_objects;
+			grid.points.flatten(point_nodes, point_boxes, point_objects);
+			std::vector<uint32_t> point_values;
+			point_values.reserve(point_objects.size());
+			for (const Node* node : point_objects) {
+				point_values.push_back(node_index.at(node));
+			}
+
+			writer.value(grid.cellSize);
+			writer.array(cell_records);
+			writer.array(cell_ways);
+			writer.array(tree_nodes);
+			writer.array(tree_boxes);
+			writer.array(tree_values);
+			writer.array(point_nodes);
+			writer.array(point_boxes);
+			writer.array(point_values);
+
+			// Landmark tables, empty when the network has none
+			std::vector<uint32_t> landmarks;
+			std::vector<algo::LandmarkTable::Distances> distances;
+			if (network.landmarks) {
+				landmarks.assign(network.landmarks->landmarks().begin(), network.landmarks->landmarks().end());
+				distances.assign(network.landmarks->distances().begin(), network.landmarks->distances().end());
+			}
+			writer.array(landmarks);
+			writer.array(distances);
+		}
+
+		// ------------------------------------------------------------------ //
+		// Load                                                               //
+		// ------------------------------------------------------------------ //
+		std::unique_ptr<WorldSegment> load_segment(Reader& reader, int& next_edge_id, int& next_lane_id) {
+			auto segment = WorldSegment::create();
+			RoadNetwork& network = *segment->road_network;
+
+			std::span<const NodeRecord> node_records;
+			std::span<const uint32_t> node_ways;
+			std::span<const WayRecord> way_records;
+			std::span<const uint64_t> node_refs;
+			std::span<const uint32_t> way_nodes;
+			std::span<const TurnDirection> turns;
+			std::span<const uint32_t> way_edges;
+			std::span<const uint32_t> sorted_ways;
+			std::span<const EdgeRecord> edge_records;
+			std::span<const uint32_t> outgoing_edges;
+			std::span<const LaneRecord> lane_records;
+			std::span<const Coordinates> center_lines;
+			std::span<const LinkRecord> link_records;
+			std::span<const uint32_t> graph_nodes;
+			std::span<const uint32_t> node_graph_offsets;
+			std::span<const GraphArc> node_graph;
+			std::span<const uint32_t> incoming_offsets;
+			std::span<const uint32_t> incoming_edges;
+			std::span<const uint32_t> transition_offsets;
+			std::span<const uint32_t> transitions;
+			std::span<const uint32_t> predecessor_offsets;
+			std::span<const uint32_t> predecessors;
+			std::span<const uint32_t> lane_offsets;
+			std::span<const uint32_t> lane_graph_offsets;
+			std::span<const uint32_t> lane_graph;
+			std::span<const uint32_t> goal_masks;
+			std::span<const uint32_t> entry_offsets;
+			std::span<const EntryRecord> entries;
+			std::span<const uint32_t> edge_component;
+			std::span<const uint32_t> node_component;
+			uint64_t component_words = 0;
+			std::span<const uint64_t> component_reach;
+			double cell_size = 1.0;
+			std::span<const CellRecord> cell_records;
+			std::span<const uint32_t> cell_ways;
+			std::span<const TreeNode> tree_nodes;
+			std::span<const common::BoundingBox> tree_boxes;
+			std::span<const uint32_t> tree_values;
+			std::span<const TreeNode> point_nodes;
+			std::span<const common::BoundingBox> point_boxes;
+			std::span<const uint32_t> point_values;
+			std::span<const uint32_t> landmarks;
+			std::span<const algo::LandmarkTable::Distances> distances;
+
+			const bool read = reader.value(segment->boundingBox)
+							  && reader.array(node_records) && reader.array(node_ways)
+							  && reader.array(way_records) && reader.array(node_refs) && reader.array(way_nodes)
+							  && reader.array(turns) && reader.array(way_edges) && reader.array(sorted_ways)
+							  && reader.array(edge_records) && reader.array(outgoing_edges)
+							  && reader.array(lane_records) && reader.array(center_lines)
+							  && reader.array(link_records)
+							  && reader.array(graph_nodes) && reader.csr(node_graph_offsets, node_graph)
+							  && reader.csr(incoming_offsets, incoming_edges) && reader.csr(transition_offsets, transitions)
+							  && reader.csr(predecessor_offsets, predecessors) && reader.array(lane_offsets)
+							  && reader.csr(lane_graph_offsets, lane_graph) && reader.array(goal_masks)
+							  && reader.array(entry_offsets) && reader.array(entries)
+							  && reader.array(edge_component) && reader.array(node_component)
+							  && reader.value(component_words) && reader.array(component_reach)
+							  && reader.value(cell_size) && reader.array(cell_records) && reader.array(cell_ways)
+							  && reader.array(tree_nodes) && reader.array(tree_boxes) && reader.array(tree_values)
+							  && reader.array(point_nodes) && reader.array(point_boxes) && reader.array(point_values)
+							  && reader.array(landmarks) && reader.array(distances);
+			if (!read) {
+				return nullptr;
+			}
+
+			auto all_less = [](std::span<const uint32_t> indices, size_t size) {
+				return std::ranges::all_of(indices, [size](uint32_t i) { return i < size; });
+			};
+			if (!all_less(node_ways, way_records.size()) || !all_less(way_nodes, node_records.size())
+				|| !all_less(way_edges, edge_records.size()) || !all_less(sorted_ways, way_records.size())
+				|| !all_less(outgoing_edges, edge_records.size()) || !all_less(cell_ways, way_records.size())
+				|| !all_less(graph_nodes, node_records.size()) || !all_less(incoming_edges, edge_records.size())
+				|| !all_less(transitions, edge_records.size()) || !all_less(predecessors, edge_records.size())
+				|| !all_less(lane_graph, link_records.size())) {
+				return nullptr;
+			}
+
+			// Nodes and ways
+			std::vector<Node*> nodes;
+			nodes.reserve(node_records.size());
+			segment->nodes.reserve(node_records.size());
+			for (const NodeRecord& record : node_records) {
+				if (!in_bounds(record.ways, node_ways.size())) {
+					return nullptr;
+				}
+				auto node = Node::create(record.uid, record.coordinates, record.tags);
+				nodes.push_back(node.get());
+				segment->nodes[record.uid] = std::move(node);
+			}
+
+			std::vector<WayInfo*> ways;
+			ways.reserve(way_records.size());
+			segment->ways.reserve(way_records.size());
+			for (const WayRecord& record : way_records) {
+				if (!in_bounds(record.node_refs, node_refs.size()) || !in_bounds(record.nodes, way_nodes.size())
+					|| !in_bounds(record.forward_turns, turns.size()) || !in_bounds(record.backward_turns, turns.size())
+					|| !in_bounds(record.edges, way_edges.size())) {
+					return nullptr;
+				}
+				auto way = WayInfo::create(record.uid, record.lanes, record.max_speed, record.type, record.tags, record.layer);
+				way->lanesForward = record.lanes_forward;
+				way->lanesBackward = record.lanes_backward;
+				way->isOneway = record.is_oneway;
+				way->laneWidth = record.lane_width;
+
+				auto refs = node_refs.subspan(record.node_refs.begin, record.node_refs.count);
+				way->nodeRefs.assign(refs.begin(), refs.end());
+				auto forward = turns.subspan(record.forward_turns.begin, record.forward_turns.count);
+				way->forwardTurns.assign(forward.begin(), forward.end());
+				auto backward = turns.subspan(record.backward_turns.begin, record.backward_turns.count);
+				way->backwardTurns.assign(backward.begin(), backward.end());
+
+				way->nodes.reserve(record.nodes.count);
+				for (uint32_t i : way_nodes.subspan(record.nodes.begin, record.nodes.count)) {
+					way->nodes.push_back(nodes[i]);
+				}
+
+				ways.push_back(way.get());
+				segment->ways[record.uid] = std::move(way);
+			}
+
+			for (size_t i = 0; i < node_records.size(); ++i) {
+				const Range& range = node_records[i].ways;
+				nodes[i]->ways.reserve(range.count);
+				for (uint32_t w : node_ways.subspan(range.begin, range.count)) {
+					nodes[i]->ways.push_back(ways[w]);
+				}
+			}
+
+			segment->sorted_ways.reserve(sorted_ways.size());
+			for (uint32_t w : sorted_ways) {
+				segment->sorted_ways.push_back(ways[w]);
+			}
+
+			// Junctions and the node/way maps of the network are cheap to derive
+			preprocess_segment(*segment);
+
+			// Edges and lanes
+			std::vector<Lane*> lanes(lane_records.size(), nullptr);
+			network.edges.resize(edge_records.size());
+			for (size_t i = 0; i < edge_records.size(); ++i) {
+				const EdgeRecord& record = edge_records[i];
+				if (record.start_node >= nodes.size() || record.end_node >= nodes.size() || record.way >= ways.size()
+					|| !in_bounds(record.lanes, lane_records.size()) || !in_bounds(record.outgoing_edges, outgoing_edges.size())) {
+					return nullptr;
+				}
+
+				Edge& edge = network.edges[i];
+				edge.set_id(record.id);
+				edge.start_node = nodes[record.start_node];
+				edge.end_node = nodes[record.end_node];
+				edge.way = ways[record.way];
+				edge.length = record.length;
+				edge.orientation = record.orientation;
+				edge.opposite_side = static_cast<Edge::OppositeSide>(record.opposite_side);
+				next_edge_id = std::max(next_edge_id, record.id + 1);
+
+				edge.outgoing_edges.reserve(record.outgoing_edges.count);
+				for (uint32_t e : outgoing_edges.subspan(record.outgoing_edges.begin, record.outgoing_edges.count)) {
+					edge.outgoing_edges.push_back(&network.edges[e]);
+				}
+
+				edge.lanes.resize(record.lanes.count);
+				for (uint32_t l = 0; l < record.lanes.count; ++l) {
+					const LaneRecord& lane_record = lane_records[record.lanes.begin + l];
+					if (!in_bounds(lane_record.center_line, center_lines.size())) {
+						return nullptr;
+					}
+
+					Lane& lane = edge.lanes[l];
+					lane.set_id(lane_record.id);
+					lane.parent = &edge;
+					lane.index_in_edge = lane_record.index_in_edge;
+					lane.width = lane_record.width;
+					lane.length = lane_record.length;
+					lane.rotation_angle = lane_record.rotation_angle;
+					lane.turn = lane_record.turn;
+					lane.orientation = lane_record.orientation;
+					auto points = center_lines.subspan(lane_record.center_line.begin, lane_record.center_line.count);
+					lane.centerLine.assign(points.begin(), points.end());
+					lanes[record.lanes.begin + l] = &lane;
+					next_lane_id = std::max(next_lane_id, lane_record.id + 1);
+				}
+			}
+			if (std::ranges::find(lanes, nullptr) != lanes.end()) {
+				return nullptr;
+			}
+
+			// Node graph
+			network.graph_nodes.reserve(graph_nodes.size());
+			for (uint32_t n : graph_nodes) {
+				if (nodes[n]->graph_index != Node::NO_GRAPH_INDEX) {
+					return nullptr;
+				}
+				nodes[n]->graph_index = static_cast<uint32_t>(network.graph_nodes.size());
+				network.graph_nodes.push_back(nodes[n]);
+			}
+			const bool arcs_valid = std::ranges::all_of(node_graph, [&](const GraphArc& arc) {
+				return arc.edge < edge_records.size() && arc.target < graph_nodes.size();
+			});
+			if (!arcs_valid || !restore_csr(network.node_graph, node_graph_offsets, node_graph, graph_nodes.size())
+				|| !restore_csr(network.incoming_edges, incoming_offsets, incoming_edges, graph_nodes.size())) {
+				return nullptr;
+			}
+			if (lane_offsets.size() != edge_records.size() + 1 || !std::ranges::is_sorted(lane_offsets)
+				|| lane_offsets.front() != 0 || lane_offsets.back() != lane_records.size()) {
+				return nullptr;
+			}
+			network.lane_offsets.assign(lane_offsets.begin(), lane_offsets.end());
+			++network.revision;
+
+			for (size_t i = 0; i < way_records.size(); ++i) {
+				const Range& range = way_records[i].edges;
+				ways[i]->edges.reserve(range.count);
+				for (uint32_t e : way_edges.subspan(range.begin, range.count)) {
+					ways[i]->edges.push_back(EdgeHandler { network.edges, e });
+				}
+			}
+
+			// Lane links
+			network.lane_links.reserve(link_records.size());
+			for (const LinkRecord& record : link_records) {
+				if (record.from >= lanes.size() || record.to >= lanes.size()) {
+					return nullptr;
+				}
+				network.lane_links.push_back({ lanes[record.from], lanes[record.to], record.yield });
+			}
+			for (size_t i = 0; i < network.lane_links.size(); ++i) {
+				LaneLink& link = network.lane_links[i];
+				LaneLinkHandler handler { network.lane_links, i };
+				link.from->outgoing_connections.push_back(handler);
+				link.to->incoming_connections.push_back(handler);
+			}
+
+			// Lane graph, transition tables and components
+			if (!restore_csr(network.edge_transitions, transition_offsets, transitions, edge_records.size())
+				|| !restore_csr(network.edge_predecessors, predecessor_offsets, predecessors, edge_records.size())
+				|| !restore_csr(network.lane_graph, lane_graph_offsets, lane_graph, lane_records.size())
+				|| goal_masks.size() != transitions.size() || entry_offsets.size() != edge_records.size()) {
+				return nullptr;
+			}
+			for (size_t e = 0; e < edge_records.size(); ++e) {
+				const size_t end = size_t(entry_offsets[e]) + size_t(edge_records[e].lanes.count) * network.edge_transitions[e].size();
+				if (end > entries.size()) {
+					return nullptr;
+				}
+			}
+			network.transition_goal_masks.assign(goal_masks.begin(), goal_masks.end());
+			network.entry_offsets.assign(entry_offsets.begin(), entry_offsets.end());
+			network.lane_entries.reserve(entries.size());
+			for (const EntryRecord& record : entries) {
+				if (record.lane != NO_LANE && record.lane >= lanes.size()) {
+					return nullptr;
+				}
+				network.lane_entries.push_back({ record.lane == NO_LANE ? nullptr : lanes[record.lane], record.yield != 0 });
+			}
+
+			const uint32_t components = edge_component.empty() ? 0 : *std::ranges::max_element(edge_component) + 1;
+			const bool components_valid = edge_component.size() == edge_records.size()
+										   && node_component.size() == graph_nodes.size()
+										   && std::ranges::all_of(node_component, [components](uint32_t c) { return c == RoadNetwork::NO_COMPONENT || c < components; })
+										   && (component_reach.empty()
+											   ? component_words == 0
+											   : component_words == (components + 63) / 64 && component_reach.size() == components * component_words);
+			if (!components_valid) {
+				return nullptr;
+			}
+			network.edge_component.assign(edge_component.begin(), edge_component.end());
+			network.node_component.assign(node_component.begin(), node_component.end());
+			network.component_words = static_cast<uint32_t>(component_words);
+			network.component_reach.assign(component_reach.begin(), component_reach.end());
+			++network.revision;
+
+			// Spatial index
+			SpatialGrid& grid = segment->spatialGrid;
+			grid.cellSize = cell_size;
+			grid.spatialGrid.reserve(cell_records.size());
+			for (const CellRecord& record : cell_records) {
+				if (!in_bounds(record.ways, cell_ways.size())) {
+					return nullptr;
+				}
+				auto& cell = grid.spatialGrid[{ record.x, record.y }];
+				cell.reserve(record.ways.count);
+				for (uint32_t w : cell_ways.subspan(record.ways.begin, record.ways.count)) {
+					cell.push_back(ways[w]);
+				}
+			}
+			if (!restore_tree(grid.tree, tree_nodes, tree_boxes, tree_values, lanes)
+				|| !restore_tree(grid.points, point_nodes, point_boxes, point_values, nodes)) {
+				return nullptr;
+			}
+
+			if (!landmarks.empty()) {
+				network.landmarks = algo::LandmarkTable::restore(network, landmarks, distances);
+				if (!network.landmarks) {
+					return nullptr;
+				}
+			}
+
+			return segment;
+		}
+	} // namespace
+
+	std::filesystem::path map_cache_path(std::string_view source_file) {
+		std::filesystem::path path(source_file);
+		path += ".tjcache";
+		return path;
+	}
+
+	bool load_map_cache(WorldData& data, const std::filesystem::path& cache_file, const std::filesystem::path& source_file, bool car_ways_only) {
+		TJS_TRACY_NAMED("MapCache_Load");
+
+		uint64_t source_size = 0;
+		int64_t source_mtime = 0;
+		if (!source_stamp(source_file, source_size, source_mtime)) {
+			return false;
+		}
+
+		common::MappedFile file;
+		if (!file.open(cache_file)) {
+			return false;
+		}
+
+		Reader reader(file.data());
+		Header header {};
+		if (!reader.value(header) || header.magic != MAGIC || header.version != MAP_CACHE_VERSION
+			|| header.source_size != source_size || header.source_mtime != source_mtime
+			|| header.car_ways_only != static_cast<uint32_t>(car_ways_only)) {
+			return false;
+		}
+
+		int next_edge_id = 0;
+		int next_lane_id = 0;
+		WorldSegments segments;
+		for (uint32_t i = 0; i < header.segments; ++i) {
+			auto segment = load_segment(reader, next_edge_id, next_lane_id);
+			if (!segment) {
+				std::cerr << "Map cache " << cache_file.string() << " is corrupted, ignoring it" << std::endl;
+				Edge::reset_id();
+				Lane::reset_id();
+				return false;
+			}
+			segments.push_back(std::move(segment));
+		}
+
+		data.segments() = std::move(segments);
+		Edge::reset_id(next_edge_id);
+		Lane::reset_id(next_lane_id);
+		return true;
+	}
+
+	bool save_map_cache(WorldData& data, const std::filesystem::path& cache_file, const std::filesystem::path& source_file, bool car_ways_only) {
+		TJS_TRACY_NAMED("MapCache_Save");
+
+		Header header {};
+		header.magic = MAGIC;
+		header.version = MAP_CACHE_VERSION;
+		header.segments = static_cast<uint32_t>(data.segments().size());
+		header.car_ways_only = car_ways_only;
+		if (!source_stamp(source_file, header.source_size, header.source_mtime)) {
+			return false;
+		}
+
+		Writer writer;
+		writer.value(header);
+		try {
+			for (auto& segment : data.segments()) {
+				save_segment(writer, *segment);
+			}
+		} catch (const std::out_of_range&) {
+			// an object references something outside of its segment
+			std::cerr << "Cannot write map cache " << cache_file.string() << ": inconsistent segment" << std::endl;
+			return false;
+		}
+
+		// Write aside and rename so a concurrent or interrupted run never sees a
+		// partial file; the name is random so concurrent writers do not share it
+		std::random_device random;
+		const uint64_t suffix = static_cast<uint64_t>(random()) << 32 | random();
+		std::filesystem::path tmp_file = cache_file;
+		tmp_file += "." + std::to_string(suffix) + ".tmp";
+		{
+			std::ofstream out(tmp_file, std::ios::binary | std::ios::trunc);
+			out.write(reinterpret_cast<const char*>(writer.buffer().data()), static_cast<std::streamsize>(writer.buffer().size()));
+			if (!out) {
+				std::error_code ec;
+				std::filesystem::remove(tmp_file, ec);
+				return false;
+			}
+		}
+
+		std::error_code ec;
+		std::filesystem::rename(tmp_file, cache_file, ec);
+		if (ec) {
+			std::filesystem::remove(tmp_file, ec);
+			return false;
+		}
+		return true;
+	}
+} // namespace tjs::core::details
@@ -1,3 +1,246 @@
 #include <core/stdafx.h>
 
 #include <core/data_layer/road_network.h>
+
+#include <core/map_math/landmarks.h>
+
+#include <numeric>
+
+namespace tjs::core {
+	void RoadNetwork::build_node_graph() {
+		TJS_TRACY_NAMED("RoadNetwork_BuildNodeGraph");
+
+		for (Node* node : graph_nodes) {
+			node->graph_index = Node::NO_GRAPH_INDEX;
+		}
+		graph_nodes.clear();
+
+		// Nodes are numbered in order of first appearance in edges so the
+		// numbering depends only on the edge order
+		const auto index_of = [this](Node* node) {
+			if (node->graph_index == Node::NO_GRAPH_INDEX) {
+				node->graph_index = static_cast<uint32_t>(graph_nodes.size());
+				graph_nodes.push_back(node);
+			}
+			return node->graph_index;
+		};
+
+		std::vector<std::pair<uint32_t, GraphArc>> arcs;
+		std::vector<std::pair<uint32_t, uint32_t>> incoming;
+		arcs.reserve(edges.size());
+		incoming.reserve(edges.size());
+		lane_offsets.clear();
+		lane_offsets.reserve(edges.size() + 1);
+		lane_offsets.push_back(0);
+		for (size_t i = 0; i < edges.size(); ++i) {
+			Edge& edge = edges[i];
+			const uint32_t from = index_of(edge.start_node);
+			const uint32_t to = index_of(edge.end_node);
+			arcs.push_back({ from, GraphArc { static_cast<uint32_t>(i), to, edge.length } });
+			incoming.emplace_back(to, static_cast<uint32_t>(i));
+			lane_offsets.push_back(lane_offsets.back() + static_cast<uint32_t>(edge.lanes.size()));
+		}
+		node_graph.assign(graph_nodes.size(), arcs);
+		incoming_edges.assign(graph_nodes.size(), incoming);
+
+		// Links belong to the previous edge set
+		edge_transitions.clear();
+		edge_predecessors.clear();
+		lane_graph.clear();
+		transition_goal_masks.clear();
+		entry_offsets.clear();
+		lane_entries.clear();
+		edge_component.clear();
+		node_component.clear();
+		component_reach.clear();
+		component_words = 0;
+		landmarks.reset();
+		++revision;
+	}
+
+	void RoadNetwork::build_lane_graph() {
+		TJS_TRACY_NAMED("RoadNetwork_BuildLaneGraph");
+
+		edge_transitions.clear();
+		edge_transitions.targets.reserve(edges.size() * 2);
+		for (const Edge& edge : edges) {
+			for (const Edge* next : edge.outgoing_edges) {
+				edge_transitions.targets.push_back(edge_index(next));
+			}
+			edge_transitions.close_row();
+		}
+
+		std::vector<std::pair<uint32_t, uint32_t>> reversed;
+		reversed.reserve(edge_transitions.size());
+		for (uint32_t e = 0; e < edges.size(); ++e) {
+			for (uint32_t next : edge_transitions[e]) {
+				reversed.emplace_back(next, e);
+			}
+		}
+		edge_predecessors.assign(edges.size(), reversed);
+
+		std::vector<std::pair<uint32_t, uint32_t>> links;
+		links.reserve(lane_links.size());
+		for (size_t i = 0; i < lane_links.size(); ++i) {
+			links.emplace_back(lane_index(lane_links[i].from), static_cast<uint32_t>(i));
+		}
+		lane_graph.assign(lane_count(), links);
+
+		build_transition_tables();
+		build_components();
+		++revision;
+	}
+
+	void RoadNetwork::build_transition_tables() {
+		TJS_TRACY_NAMED("RoadNetwork_BuildTransitionTables");
+
+		transition_goal_masks.assign(edge_transitions.size(), 0);
+		entry_offsets.resize(edges.size());
+		size_t entries = 0;
+		for (size_t e = 0; e < edges.size(); ++e) {
+			entry_offsets[e] = static_cast<uint32_t>(entries);
+			entries += edges[e].lanes.size() * edge_transitions[e].size();
+		}
+		lane_entries.assign(entries, {});
+
+		for (uint32_t e = 0; e < edges.size(); ++e) {
+			const Edge& edge = edges[e];
+			for (const Lane& lane : edge.lanes) {
+				for (const LaneLinkHandler& h : lane.outgoing_connections) {
+					const LaneLink& link = *h;
+					if (!link.to) {
+						continue;
+					}
+					const uint32_t slot = transition_slot(edge, *link.to->parent);
+					if (slot == NO_TRANSITION) {
+						continue;
+					}
+					transition_goal_masks[edge_transitions.offsets[e] + slot] |= 1u << lane.index_in_edge;
+
+					// same preference the movement used to apply per crossing
+					LaneEntry& entry = lane_entries[entry_offsets[e] + lane.index_in_edge * edge_transitions[e].size() + slot];
+					const int shift = std::abs(int(link.to->index_in_edge) - int(lane.index_in_edge));
+					if (!entry.lane || (entry.yield && !link.yield)
+						|| (entry.yield == link.yield && shift < std::abs(int(entry.lane->index_in_edge) - int(lane.index_in_edge)))) {
+						entry.lane = link.to;
+						entry.yield = link.yield;
+					}
+				}
+			}
+		}
+	}
+
+	void RoadNetwork::build_components() {
+		TJS_TRACY_NAMED("RoadNetwork_BuildComponents");
+
+		// Iterative Tarjan; components complete sinks first, so numbering them
+		// from the top down gives the topological order
+		const uint32_t count = static_cast<uint32_t>(edges.size());
+		std::vector<uint32_t> order(count, NO_COMPONENT); // discovery time
+		std::vector<uint32_t> low(count, 0);
+		std::vector<uint32_t> stack;
+		std::vector<std::pair<uint32_t, uint32_t>> calls; // edge, next transition
+		std::vector<bool> on_stack(count, false);
+		edge_component.assign(count, NO_COMPONENT);
+
+		uint32_t time = 0;
+		uint32_t completed = 0;
+		for (uint32_t root = 0; root < count; ++root) {
+			if (order[root] != NO_COMPONENT) {
+				continue;
+			}
+			calls.push_back({ root, 0 });
+			order[root] = low[root] = time++;
+			stack.push_back(root);
+			on_stack[root] = true;
+
+			while (!calls.empty()) {
+				auto& [edge, next] = calls.back();
+				const auto transitions = edge_transitions[edge];
+				if (next < transitions.size()) {
+					const uint32_t to = transitions[next++];
+					if (order[to] == NO_COMPONENT) {
+						order[to] = low[to] = time++;
+						stack.push_back(to);
+						on_stack[to] = true;
+						calls.push_back({ to, 0 });
+					} else if (on_stack[to]) {
+						low[edge] = std::min(low[edge], order[to]);
+					}
+					continue;
+				}
+
+				const uint32_t done = edge;
+				calls.pop_back();
+				if (!calls.empty()) {
+					low[calls.back().first] = std::min(low[calls.back().first], low[done]);
+				}
+				if (low[done] == order[done]) {
+					uint32_t member = NO_COMPONENT;
+					do {
+						member = stack.back();
+						stack.pop_back();
+						on_stack[member] = false;
+						edge_component[member] = completed;
+					} while (member != done);
+					++completed;
+				}
+			}
+		}
+		for (uint32_t& component : edge_component) {
+			component = completed - 1 - component;
+		}
+
+		node_component.assign(graph_nodes.size(), NO_COMPONENT);
+		for (uint32_t e = 0; e < count; ++e) {
+			uint32_t& reach = node_component[edges[e].end_node->graph_index];
+			if (reach == NO_COMPONENT || edge_component[e] > reach) {
+				reach = edge_component[e];
+			}
+		}
+
+		component_reach.clear();
+		component_words = 0;
+		if (completed > MAX_REACH_COMPONENTS) {
+			return;
+		}
+
+		// Transitions only climb, so rows filled from the last component down
+		// are complete by the time a lower one ORs them in
+		component_words = (completed + 63) / 64;
+		component_reach.assign(size_t(completed) * component_words, 0);
+		std::vector<uint32_t> by_component(count);
+		std::iota(by_component.begin(), by_component.end(), 0u);
+		std::ranges::sort(by_component, std::greater<> {}, [this](uint32_t e) { return edge_component[e]; });
+		for (uint32_t e : by_component) {
+			const uint32_t c = edge_component[e];
+			uint64_t* row = component_reach.data() + size_t(c) * component_words;
+			row[c >> 6] |= uint64_t(1) << (c & 63);
+			for (uint32_t next : edge_transitions[e]) {
+				const uint32_t target = edge_component[next];
+				if (target != c) {
+					const uint64_t* from = component_reach.data() + size_t(target) * component_words;
+					for (uint32_t w = 0; w < component_words; ++w) {
+						row[w] |= from[w];
+					}
+				}
+			}
+		}
+	}
+
+	void RoadNetwork::set_edge_length(uint32_t edge, double length) {
+		edges[edge].length = length;
+
+		const uint32_t from = edges[edge].start_node->graph_index;
+		for (uint32_t i = node_graph.offsets[from]; i < node_graph.offsets[from + 1]; ++i) {
+			if (node_graph.targets[i].edge == edge) {
+				node_graph.targets[i].length = length;
+			}
+		}
+
+		if (landmarks && length < landmarks->base_length(edge)) {
+			landmarks.reset();
+		}
+		++revision;
+	}
+} // namespace tjs::core
@@ -4,6 +4,114 @@
 
 namespace tjs::core {
 
+	void VehicleStore::acquire(Vehicle& vehicle) {
+		vehicle.store = this;
+
+		if (!_free_rows.empty()) {
+			const uint32_t row = _free_rows.back();
+			_free_rows.pop_back();
+			s_on_lane[row] = 0.0;
+			s_next[row] = 0.0;
+			lateral_offset[row] = 0.0;
+			speed[row] = 0.0f;
+			v_next[row] = 0.0f;
+			length[row] = 0.0f;
+			state[row] = 0;
+			has_position_changes[row] = 0;
+			vehicle.row = row;
+		} else {
+			vehicle.row = static_cast<uint32_t>(rows());
+			s_on_lane.push_back(0.0);
+			s_next.push_back(0.0);
+			lateral_offset.push_back(0.0);
+			speed.push_back(0.0f);
+			v_next.push_back(0.0f);
+			length.push_back(0.0f);
+			state.push_back(0);
+			has_position_changes.push_back(0);
+		}
+
+		if (!_free_ids.empty()) {
+			vehicle.id = _free_ids.back();
+			_free_ids.pop_back();
+			info[vehicle.id] = {};
+		} else {
+			vehicle.id = static_cast<uint32_t>(info.size());
+			info.emplace_back();
+		}
+	}
+
+	void VehicleStore::release(const Vehicle& vehicle) {
+		_free_rows.push_back(vehicle.row);
+		_free_ids.push_back(vehicle.id);
+	}
+
+	void VehicleStore::clear() {
+		s_on_lane.clear();
+		s_next.clear();
+		lateral_offset.clear();
+		speed.clear();
+		v_next.clear();
+		length.clear();
+		state.clear();
+		has_position_changes.clear();
+		info.clear();
+		_free_rows.clear();
+		_free_ids.clear();
+	}
+
+	void VehicleStore::commit_step() noexcept {
+		// free rows are swept as well, acquire() resets them anyway
+		const size_t n = rows();
+		for (size_t i = 0; i < n; ++i) {
+			has_position_changes[i] = s_on_lane[i] != s_next[i];
+			s_on_lane[i] = s_next[i];
+			speed[i] = v_next[i];
+		}
+	}
+
+	bool VehicleStore::reorder(std::span<Vehicle* const> order) {
+		if (order.size() != live()) {
+			return false;
+		}
+
+		_taken.assign(rows(), 0);
+		_source.resize(order.size());
+		for (size_t i = 0; i < order.size(); ++i) {
+			const uint32_t row = order[i]->row;
+			if (row >= rows() || _taken[row]) {
+				return false;
+			}
+			_taken[row] = 1;
+			_source[i] = row;
+		}
+
+		// the old column becomes the scratch of the next one of its type,
+		// so once capacities settle nothing is allocated
+		const auto permute = [this](auto& column, auto& scratch) {
+			scratch.resize(_source.size());
+			for (size_t i = 0; i < _source.size(); ++i) {
+				scratch[i] = column[_source[i]];
+			}
+			column.swap(scratch);
+		};
+		permute(s_on_lane, _permuted_f64);
+		permute(s_next, _permuted_f64);
+		permute(lateral_offset, _permuted_f64);
+		permute(speed, _permuted_f32);
+		permute(v_next, _permuted_f32);
+		permute(length, _permuted_f32);
+		permute(state, _permuted_u16);
+		permute(has_position_changes, _permuted_u8);
+
+		for (size_t i = 0; i < order.size(); ++i) {
+			order[i]->row = static_cast<uint32_t>(i);
+		}
+		// live rows are packed now, nothing left to reuse
+		_free_rows.clear();
+		return true;
+	}
+
 	bool Vehicle::is_merging(const Lane& lane) const {
 		if (lane_target == nullptr) {
 			return false;
@@ -11,7 +119,7 @@ namespace tjs::core {
 
 		using namespace simulation;
 		const uint16_t change_state = static_cast<int>(VehicleStateBits::ST_PREPARE) | static_cast<int>(VehicleStateBits::ST_CROSS);
-		return &lane != current_lane && VehicleStateBitsV::has_any(state, change_state, VehicleStateBitsDivision::STATE);
+		return &lane != current_lane && VehicleStateBitsV::has_any(state(), change_state, VehicleStateBitsDivision::STATE);
 	}
 
 } // namespace tjs::core
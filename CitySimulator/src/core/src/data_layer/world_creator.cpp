@@ -2,58 +2,124 @@
 
 #include <core/data_layer/world_creator.h>
 #include <core/data_layer/world_data.h>
+#include <core/data_layer/map_cache.h>
 #include <core/map_math/contraction_builder.h>
 #include <core/map_math/lane_connector_builder.h>
+#include <core/map_math/landmarks.h>
 #include <core/math_constants.h>
+#include <core/events/map_loading_events.h>
 
 #include <core/random_generator.h>
+#include <common/io/mapped_file.h>
+#include <common/io/xml_stream_reader.h>
+
+#include <charconv>
 #include <sstream>
 #include <limits>
 
 namespace tjs::core {
-	bool WorldCreator::loadOSMData(WorldData& data, std::string_view osmFilename) {
-		Lane::reset_id();
-		Edge::reset_id();
-		bool result = false;
-		if (osmFilename.ends_with(".osmx")) {
-			result = details::loadOSMXmlData(data, osmFilename);
-		}
+	namespace details {
+		namespace {
+			// Throttles MapLoadProgress so a large map does not flood the dispatcher
+			class ProgressReporter {
+			public:
+				explicit ProgressReporter(common::MessageDispatcher* dispatcher)
+					: _dispatcher(dispatcher) {
+				}
 
-		// Prepare data
-		for (auto& segment : data.segments()) {
-			details::preprocess_segment(*segment);
-			details::create_road_network(*segment);
-		}
+				void report(events::MapLoadStage stage, double progress, size_t nodes = 0, size_t ways = 0) {
+					if (_dispatcher == nullptr) {
+						return;
+					}
+					if (stage == _stage && progress < _last_progress + 0.01 && progress < 1.0) {
+						return;
+					}
+					_stage = stage;
+					_last_progress = progress;
+					_dispatcher->handle_message(events::MapLoadProgress { stage, progress, nodes, ways }, "world_creator");
+				}
 
-		return result;
-	}
+				void finished(WorldData& data) {
+					size_t nodes = 0;
+					size_t ways = 0;
+					for (const auto& segment : data.segments()) {
+						nodes += segment->nodes.size();
+						ways += segment->ways.size();
+					}
+					report(events::MapLoadStage::Finished, 1.0, nodes, ways);
+				}
 
-	namespace details {
+			private:
+				common::MessageDispatcher* _dispatcher = nullptr;
+				events::MapLoadStage _stage = events::MapLoadStage::Count;
+				double _last_progress = 0.0;
+			};
+
+			template<typename T>
+			T parse_number(std::string_view text) {
+				T value {};
+				std::from_chars(text.data(), text.data() + text.size(), value);
+				return value;
+			}
+		} // namespace
+
+		// Reads .osmx in two streaming passes over the memory-mapped file:
+		// ways first, to learn which nodes are referenced, then only those nodes.
+		// Nothing but the kept nodes and ways is ever held in memory.
 		class OSMParser {
 		public:
-			static std::unique_ptr<WorldSegment> parse(std::string_view filename) {
+			using OSMTag = std::pair<std::string, std::string>;
+			using Token = common::XmlStreamReader::Token;
+
+			static std::unique_ptr<WorldSegment> parse(std::string_view filename, const MapLoadOptions& options, ProgressReporter& progress) {
+				common::MappedFile file;
+				if (!file.open(std::filesystem::path(filename))) {
+					std::cerr << "Failed to load OSM file: " << filename << std::endl;
+					return nullptr;
+				}
+				const std::string_view text(reinterpret_cast<const char*>(file.data().data()), file.size());
+
 				auto world = WorldSegment::create();
-				pugi::xml_document doc;
 
-				auto result = doc.load_file(filename.data());
-				if (!result) {
-					std::cerr << "Failed to load OSM file: " << filename << ": " << result.description() << std::endl;
+				// First pass: ways, in document order
+				std::unordered_set<uint64_t> used_nodes;
+				const bool ways_read = for_each_element(text, "way", [&](common::XmlStreamReader& reader) {
+					if (!read_way(reader, *world, options)) {
+						return false;
+					}
+					progress.report(events::MapLoadStage::ReadingWays, double(reader.offset()) / text.size(), 0, world->ways.size());
+					return true;
+				});
+				if (!ways_read) {
+					std::cerr << "Failed to load OSM file: " << filename << ": malformed XML" << std::endl;
 					return nullptr;
 				}
+				for (const WayInfo* way : world->sorted_ways) {
+					used_nodes.insert(way->nodeRefs.begin(), way->nodeRefs.end());
+				}
 
+				// Second pass: nodes. Bounds cover every valid node of the file so
+				// coordinates do not depend on which nodes are kept.
 				double minLat = std::numeric_limits<double>::max();
 				double maxLat = std::numeric_limits<double>::lowest();
 				double minLon = std::numeric_limits<double>::max();
 				double maxLon = std::numeric_limits<double>::lowest();
-
-				// First pass: parse all nodes
-				for (pugi::xml_node xml_node : doc.child("osm").children("node")) {
-					parseNode(xml_node, *world, minLat, maxLat, minLon, maxLon);
+				world->nodes.reserve(used_nodes.size());
+				const bool nodes_read = for_each_element(text, "node", [&](common::XmlStreamReader& reader) {
+					if (!read_node(reader, *world, used_nodes, minLat, maxLat, minLon, maxLon)) {
+						return false;
+					}
+					progress.report(events::MapLoadStage::ReadingNodes, double(reader.offset()) / text.size(), world->nodes.size(), world->ways.size());
+					return true;
+				});
+				if (!nodes_read) {
+					std::cerr << "Failed to load OSM file: " << filename << ": malformed XML" << std::endl;
+					return nullptr;
 				}
 
 				// Compute projection center from bounds
 				Coordinates center {};
-				if (!world->nodes.empty()) {
+				if (minLat <= maxLat) {
 					center.latitude = (minLat + maxLat) / 2.0;
 					center.longitude = (minLon + maxLon) / 2.0;
 					center.x = center.longitude * MathConstants::DEG_TO_RAD * MathConstants::EARTH_RADIUS;
@@ -70,9 +136,18 @@ namespace tjs::core {
 					world->boundingBox.bottom = { minLat, center.longitude, 0.0, -std::log(std::tan((90.0 + minLat) * MathConstants::DEG_TO_RAD / 2.0)) * MathConstants::EARTH_RADIUS - center.y };
 				}
 
-				// Second pass: parse all ways
-				for (pugi::xml_node xml_way : doc.child("osm").children("way")) {
-					parseWay(xml_way, *world);
+				// Resolve way nodes in document order, as a single pass would
+				for (WayInfo* way : world->sorted_ways) {
+					way->nodes.reserve(way->nodeRefs.size());
+					for (uint64_t nodeRef : way->nodeRefs) {
+						auto node = world->nodes.find(nodeRef);
+						if (node == world->nodes.end()) {
+							continue;
+						}
+						node->second->tags = node->second->tags | NodeTags::Way;
+						node->second->ways.emplace_back(way);
+						way->nodes.push_back(node->second.get());
+					}
 				}
 
 				// Sort by layer so rendering will be correct
@@ -84,56 +159,133 @@ namespace tjs::core {
 			}
 
 		private:
-			static void parseNode(
-				const pugi::xml_node& xml_node,
+			// Calls `fn` on every <`element`> directly under <osm>; the reader is
+			// positioned on its start tag and `fn` may consume its children
+			template<typename Fn>
+			static bool for_each_element(std::string_view text, std::string_view element, Fn&& fn) {
+				common::XmlStreamReader reader(text);
+				bool in_osm = false;
+				for (Token token = reader.next(); token != Token::End; token = reader.next()) {
+					if (token == Token::Error) {
+						return false;
+					}
+					if (token != Token::StartElement) {
+						continue;
+					}
+					if (reader.depth() == 1) {
+						in_osm = reader.name() == "osm";
+					} else if (in_osm && reader.depth() == 2 && reader.name() == element && !fn(reader)) {
+						return false;
+					}
+				}
+				return true;
+			}
+
+			// Calls `fn` on every direct child of the current element and stops after its end tag
+			template<typename Fn>
+			static bool for_each_child(common::XmlStreamReader& reader, Fn&& fn) {
+				const size_t depth = reader.depth();
+				for (;;) {
+					const Token token = reader.next();
+					if (token == Token::End || token == Token::Error) {
+						return false;
+					}
+					if (token == Token::EndElement && reader.depth() == depth) {
+						return true;
+					}
+					if (token == Token::StartElement && reader.depth() == depth + 1) {
+						fn(reader);
+					}
+				}
+			}
+
+			static bool read_way(common::XmlStreamReader& reader, WorldSegment& world, const MapLoadOptions& options) {
+				const uint64_t id = parse_number<uint64_t>(reader.attribute("id"));
+
+				std::vector<uint64_t> nodeRefs;
+				nodeRefs.reserve(10);
+				std::vector<OSMTag> tags;
+				const bool read = for_each_child(reader, [&](common::XmlStreamReader& child) {
+					if (child.name() == "nd") {
+						nodeRefs.push_back(parse_number<uint64_t>(child.attribute("ref")));
+					} else if (child.name() == "tag") {
+						tags.emplace_back(child.attribute_text("k"), child.attribute_text("v"));
+					}
+				});
+				if (!read) {
+					return false;
+				}
+
+				// Duplicated way would replace the first one and leave dangling pointers in nodes
+				if (world.ways.contains(id)) {
+					return true;
+				}
+
+				auto way = build_way(id, std::move(nodeRefs), tags);
+				if (!way || (options.car_ways_only && !way->is_car_accessible())) {
+					return true;
+				}
+				world.sorted_ways.push_back(way.get());
+				world.ways[id] = std::move(way);
+				return true;
+			}
+
+			static bool read_node(
+				common::XmlStreamReader& reader,
 				WorldSegment& world,
+				const std::unordered_set<uint64_t>& used_nodes,
 				double& minLat,
 				double& maxLat,
 				double& minLon,
 				double& maxLon) {
-				uint64_t id = xml_node.attribute("id").as_ullong();
-				double lat = xml_node.attribute("lat").as_double();
-				double lon = xml_node.attribute("lon").as_double();
+				uint64_t id = parse_number<uint64_t>(reader.attribute("id"));
+				double lat = parse_number<double>(reader.attribute("lat"));
+				double lon = parse_number<double>(reader.attribute("lon"));
+				const bool used = used_nodes.contains(id);
 
 				NodeTags tags = NodeTags::None;
 
 				// Parse node tags
-				for (pugi::xml_node tag : xml_node.children("tag")) {
-					std::string key = tag.attribute("k").as_string();
-					if (key == "highway" && std::string(tag.attribute("v").as_string()) == "traffic_signals") {
+				const bool read = for_each_child(reader, [&](common::XmlStreamReader& child) {
+					if (!used || child.name() != "tag") {
+						return;
+					}
+					if (child.attribute("k") == "highway" && child.attribute_text("v") == "traffic_signals") {
 						tags = tags | NodeTags::TrafficLight;
 					}
 					// Add other node tag checks as needed
+				});
+				if (!read) {
+					return false;
 				}
 
 				if (!(std::abs(lat) > 90.0 || std::abs(lon) > 180.0)) {
+					minLat = std::min(minLat, lat);
+					maxLat = std::max(maxLat, lat);
+					minLon = std::min(minLon, lon);
+					maxLon = std::max(maxLon, lon);
+
+					// Nodes no kept way goes through are not needed
+					if (!used) {
+						return true;
+					}
+
 					Coordinates coords {};
 					coords.latitude = lat;
 					coords.longitude = lon;
 					coords.x = lon * MathConstants::DEG_TO_RAD * MathConstants::EARTH_RADIUS;
 					coords.y = std::log(std::tan((90.0 + lat) * MathConstants::DEG_TO_RAD / 2.0)) * MathConstants::EARTH_RADIUS;
 					world.nodes[id] = Node::create(id, coords, tags);
-
-					minLat = std::min(minLat, lat);
-					maxLat = std::max(maxLat, lat);
-					minLon = std::min(minLon, lon);
-					maxLon = std::max(maxLon, lon);
 				}
+				return true;
 			}
 
-			static void parseWay(const pugi::xml_node& xml_way, WorldSegment& world) {
-				uint64_t id = xml_way.attribute("id").as_ullong();
-
-				// Collect node references
-				std::vector<uint64_t> nodeRefs;
-				nodeRefs.reserve(10);
-				for (pugi::xml_node nd : xml_way.children("nd")) {
-					nodeRefs.push_back(nd.attribute("ref").as_ullong());
-				}
-
+			// Classifies the way by its tags; nodes are resolved once all of them are read.
+			// Returns nullptr for ways the simulation does not use.
+			static std::unique_ptr<WayInfo> build_way(uint64_t id, std::vector<uint64_t>&& nodeRefs, const std::vector<OSMTag>& way_tags) {
 				// Skip ways with less than 2 nodes
 				if (nodeRefs.size() < 2) {
-					return;
+					return nullptr;
 				}
 
 				// Parse way properties
@@ -197,9 +349,7 @@ namespace tjs::core {
 				int layer = std::numeric_limits<int>::max();
 				WayTag tags { WayTag::None };
 
-				for (pugi::xml_node tag : xml_way.children("tag")) {
-					std::string key = tag.attribute("k").as_string();
-					std::string value = tag.attribute("v").as_string();
+				for (const auto& [key, value] : way_tags) {
 
 					if (key == "highway") {
 						auto it = roadDefaults.find(value);
@@ -231,13 +381,13 @@ namespace tjs::core {
 							isOneway = false;
 						}
 					} else if (key == "lanes") {
-						lanes = tag.attribute("v").as_int();
+						lanes = parse_int(value);
 						lanes_found = true;
 					} else if (key == "lanes:forward") {
-						lanesForward = tag.attribute("v").as_int();
+						lanesForward = parse_int(value);
 						lanes_found = true;
 					} else if (key == "lanes:backward") {
-						lanesBackward = tag.attribute("v").as_int();
+						lanesBackward = parse_int(value);
 						lanes_found = true;
 					} else if (key == "lane_width" || key == "lanes:width") {
 						laneWidth = std::stod(value);
@@ -256,7 +406,7 @@ namespace tjs::core {
 					} else if (key == "access") {
 						// Handle access restrictions
 						if (value == "private" || value == "no") {
-							return; // Skip private or no-access ways
+							return nullptr; // Skip private or no-access ways
 						}
 					} else if (key == "layer") {
 						layer = parse_int(value);
@@ -273,7 +423,7 @@ namespace tjs::core {
 
 				// Only add ways that have been classified
 				if (type == WayType::None) {
-					return;
+					return nullptr;
 				}
 
 				if (layer == std::numeric_limits<int>::max()) {
@@ -317,22 +467,8 @@ namespace tjs::core {
 				way->forwardTurns = std::move(turnsForward);
 				way->backwardTurns = std::move(turnsBackward);
 
-				std::vector<Node*> nodes;
-				nodes.reserve(nodeRefs.size());
-				for (uint64_t nodeRef : nodeRefs) {
-					auto node = world.nodes.find(nodeRef);
-					if (node == world.nodes.end()) {
-						continue;
-					}
-					node->second->tags = node->second->tags | NodeTags::Way;
-					node->second->ways.emplace_back(way.get());
-					nodes.push_back(node->second.get());
-				}
 				way->nodeRefs = std::move(nodeRefs);
-				way->nodes = std::move(nodes);
-
-				world.sorted_ways.push_back(way.get());
-				world.ways[id] = std::move(way);
+				return way;
 			}
 
 			static std::vector<TurnDirection> parseTurnLanes(const std::string& value) {
@@ -437,8 +573,9 @@ namespace tjs::core {
 		algo::LaneConnectorBuilder::build_lane_connections(*segment.road_network);
 	}
 
-	bool details::loadOSMXmlData(WorldData& data, std::string_view osmFilename) {
-		auto segment = details::OSMParser::parse(osmFilename);
+	bool details::loadOSMXmlData(WorldData& data, std::string_view osmFilename, const MapLoadOptions& options) {
+		ProgressReporter progress(options.dispatcher);
+		auto segment = details::OSMParser::parse(osmFilename, options, progress);
 		if (!segment) {
 			return false;
 		}
@@ -447,4 +584,50 @@ namespace tjs::core {
 		return true;
 	}
 
+	bool WorldCreator::loadOSMData(WorldData& data, std::string_view osmFilename, const MapLoadOptions& options) {
+		TJS_TRACY_NAMED("WorldCreator_LoadOSMData");
+
+		Lane::reset_id();
+		Edge::reset_id();
+		details::ProgressReporter progress(options.dispatcher);
+
+		const auto cache_file = details::map_cache_path(osmFilename);
+		if (options.use_cache) {
+			progress.report(events::MapLoadStage::ReadingCache, 0.0);
+			if (details::load_map_cache(data, cache_file, osmFilename, options.car_ways_only)) {
+				progress.finished(data);
+				return true;
+			}
+		}
+
+		bool result = false;
+		if (osmFilename.ends_with(".osmx")) {
+			result = details::loadOSMXmlData(data, osmFilename, options);
+		}
+
+		// Prepare data
+		const auto& segments = data.segments();
+		for (size_t i = 0; i < segments.size(); ++i) {
+			progress.report(events::MapLoadStage::BuildingRoadNetwork, double(i) / segments.size());
+			details::preprocess_segment(*segments[i]);
+			details::create_road_network(*segments[i]);
+		}
+
+		if (result && options.use_cache) {
+			// the cache is where landmark preprocessing pays off
+			for (const auto& segment : segments) {
+				segment->road_network->landmarks = algo::LandmarkTable::build(*segment->road_network);
+			}
+			progress.report(events::MapLoadStage::WritingCache, 0.0);
+			if (!details::save_map_cache(data, cache_file, osmFilename, options.car_ways_only)) {
+				std::cerr << "Failed to write map cache " << cache_file.string() << std::endl;
+			}
+		}
+
+		if (result) {
+			progress.finished(data);
+		}
+		return result;
+	}
+
 } // namespace tjs::core
@@ -108,11 +108,10 @@ namespace tjs::core::algo {
 
 	void ContractionBuilder::build_graph(core::RoadNetwork& network) {
 		// Clear previous data
-		network.adjacency_list.clear();
 		network.edges.clear();
-		network.edge_graph.clear();
-
-		std::unordered_map<Node*, std::vector<size_t>> edge_graph_indices;
+		for (const auto& [way_id, way] : network.ways) {
+			way->edges.clear();
+		}
 
 		for (const auto& [way_id, way] : network.ways) {
 			// Skip ways that are not suitable for cars
@@ -130,30 +129,14 @@ namespace tjs::core::algo {
 				// Calculate distance between nodes
 				double dist = euclidean_distance(current->coordinates, next->coordinates);
 
-				// Add edges based on way direction and lanes
-				if (way->isOneway) {
-					if (way->lanesForward > 0) {
-						network.adjacency_list[current].emplace_back(next, dist);
-					}
-				} else {
-					if (way->lanesForward > 0) {
-						network.adjacency_list[current].emplace_back(next, dist);
-					}
-					if (way->lanesBackward > 0) {
-						network.adjacency_list[next].emplace_back(current, dist);
-					}
-				}
-
 				if (way->lanesForward > 0) {
 					network.edges.push_back(create_edge(current, next, way, dist, LaneOrientation::Forward));
 					way->edges.push_back({ EdgeHandler { network.edges, network.edges.size() - 1 } });
-					edge_graph_indices[current].push_back(network.edges.size() - 1);
 				}
 
 				if (!way->isOneway && way->lanesBackward > 0) {
 					network.edges.push_back(create_edge(next, current, way, dist, LaneOrientation::Backward));
 					way->edges.push_back({ EdgeHandler { network.edges, network.edges.size() - 1 } });
-					edge_graph_indices[next].push_back(network.edges.size() - 1);
 				}
 
 				current->tags = current->tags | NodeTags::Way;
@@ -167,11 +150,7 @@ namespace tjs::core::algo {
 			}
 		}
 
-		for (const auto& [node, indices] : edge_graph_indices) {
-			for (const auto& index : indices) {
-				network.edge_graph[node].push_back(&network.edges[index]);
-			}
-		}
+		network.build_node_graph();
 	}
 
 } // namespace tjs::core::algo
@@ -0,0 +1,112 @@
+#include <core/stdafx.h>
+
+#include <core/map_math/landmarks.h>
+
+#include <core/data_layer/road_network.h>
+
+#include <common/indexed_heap.h>
+
+namespace tjs::core::algo {
+	namespace {
+		constexpr double INF = std::numeric_limits<double>::infinity();
+
+		// Distances from `source` over `graph`, infinity where it does not reach
+		void dijkstra(const common::CsrAdjacency<GraphArc>& graph, uint32_t source, std::vector<double>& distance, common::IndexedDaryHeap<4>& open) {
+			distance.assign(graph.rows(), INF);
+			open.clear();
+			distance[source] = 0.0;
+			open.push_or_decrease(source, 0.0);
+			while (!open.empty()) {
+				const uint32_t current = open.pop();
+				const double base = distance[current];
+				for (const GraphArc& arc : graph[current]) {
+					const double candidate = base + arc.length;
+					if (candidate < distance[arc.target]) {
+						distance[arc.target] = candidate;
+						open.push_or_decrease(arc.target, candidate);
+					}
+				}
+			}
+		}
+
+		// Farthest reached node, ignoring the ones `distance` does not reach
+		uint32_t farthest(const std::vector<double>& distance) {
+			uint32_t best = 0;
+			for (uint32_t node = 1; node < distance.size(); ++node) {
+				if (std::isfinite(distance[node]) && (!std::isfinite(distance[best]) || distance[node] > distance[best])) {
+					best = node;
+				}
+			}
+			return best;
+		}
+	} // namespace
+
+	std::shared_ptr<LandmarkTable> LandmarkTable::build(const RoadNetwork& network, size_t count) {
+		TJS_TRACY_NAMED("LandmarkTable_Build");
+
+		const size_t nodes = network.graph_nodes.size();
+		auto table = std::make_shared<LandmarkTable>();
+		if (nodes == 0 || count == 0) {
+			return table;
+		}
+		count = std::min(count, nodes);
+
+		// arcs turned around, for distances *to* a landmark
+		std::vector<std::pair<uint32_t, GraphArc>> reversed;
+		reversed.reserve(network.node_graph.size());
+		for (uint32_t node = 0; node < nodes; ++node) {
+			for (const GraphArc& arc : network.node_graph[node]) {
+				reversed.push_back({ arc.target, GraphArc { arc.edge, node, arc.length } });
+			}
+		}
+		common::CsrAdjacency<GraphArc> backward_graph;
+		backward_graph.assign(nodes, reversed);
+
+		common::IndexedDaryHeap<4> open;
+		open.resize(nodes);
+		std::vector<double> from;
+		std::vector<double> to;
+
+		table->_landmarks.reserve(count);
+		table->_distances.resize(nodes * count);
+		// closest landmark of each node so far
+		std::vector<double> nearest(nodes, INF);
+
+		// the first landmark is the far end of the map seen from node 0
+		dijkstra(network.node_graph, 0, from, open);
+		uint32_t landmark = farthest(from);
+		for (size_t i = 0; i < count; ++i) {
+			table->_landmarks.push_back(landmark);
+			dijkstra(network.node_graph, landmark, from, open);
+			dijkstra(backward_graph, landmark, to, open);
+			for (size_t node = 0; node < nodes; ++node) {
+				table->_distances[node * count + i] = { from[node], to[node] };
+				nearest[node] = std::min(nearest[node], from[node]);
+			}
+			landmark = farthest(nearest);
+		}
+
+		table->_base_lengths.reserve(network.edges.size());
+		for (const Edge& edge : network.edges) {
+			table->_base_lengths.push_back(edge.length);
+		}
+		return table;
+	}
+
+	std::shared_ptr<LandmarkTable> LandmarkTable::restore(const RoadNetwork& network, std::span<const uint32_t> landmarks, std::span<const Distances> distances) {
+		const size_t nodes = network.graph_nodes.size();
+		if (landmarks.empty() || distances.size() != landmarks.size() * nodes
+			|| std::ranges::any_of(landmarks, [nodes](uint32_t node) { return node >= nodes; })) {
+			return nullptr;
+		}
+
+		auto table = std::make_shared<LandmarkTable>();
+		table->_landmarks.assign(landmarks.begin(), landmarks.end());
+		table->_distances.assign(distances.begin(), distances.end());
+		table->_base_lengths.reserve(network.edges.size());
+		for (const Edge& edge : network.edges) {
+			table->_base_lengths.push_back(edge.length);
+		}
+		return table;
+	}
+} // namespace tjs::core::algo
@@ -4,6 +4,8 @@
 #include <core/map_math/earth_math.h>
 #include <core/math_constants.h>
 
+#include <common/threading/worker_pool.h>
+
 namespace tjs::core::algo {
 	namespace {
 		// Forward declaration for helper below
@@ -116,26 +118,30 @@ namespace tjs::core::algo {
 
 	details::AdjacentEdges details::get_adjacent_edges(RoadNetwork& network, Node* node) {
 		AdjacentEdges adjacent;
-
-		auto& incoming = adjacent.incoming;
-		auto& outgoing = adjacent.outgoing;
-		WayType min_priority = WayType::Count;
-
 		for (auto& edge : network.edges) {
-			if (edge.end_node == node) {
-				incoming.push_back(&edge);
-				if (edge.way->type < min_priority) {
-					min_priority = edge.way->type;
-					adjacent.primary = &edge;
-				}
-			}
-			if (edge.start_node == node) {
-				outgoing.push_back(&edge);
+			add_adjacent_edge(adjacent, &edge, node);
+		}
+		order_adjacent_edges(adjacent);
+		return adjacent;
+	}
+
+	void details::add_adjacent_edge(AdjacentEdges& adjacent, Edge* edge, Node* node) {
+		if (edge->end_node == node) {
+			adjacent.incoming.push_back(edge);
+			if (adjacent.primary == nullptr || edge->way->type < adjacent.primary->way->type) {
+				adjacent.primary = edge;
 			}
 		}
+		if (edge->start_node == node) {
+			adjacent.outgoing.push_back(edge);
+		}
+	}
 
+	void details::order_adjacent_edges(AdjacentEdges& adjacent) {
+		auto& incoming = adjacent.incoming;
+		auto& outgoing = adjacent.outgoing;
 		if (incoming.size() == 0) {
-			return adjacent;
+			return;
 		}
 
 		// if the road is upward, the rightest will be with max x coordinate
@@ -154,8 +160,20 @@ namespace tjs::core::algo {
 			}
 			return a->end_node->coordinates.x < b->end_node->coordinates.x;
 		});
+	}
 
-		return adjacent;
+	details::EdgeIncidence details::build_edge_incidence(RoadNetwork& network) {
+		EdgeIncidence incidence;
+		incidence.reserve(network.nodes.size());
+		// edges are visited in storage order, so every node sees them in the
+		// same order as a scan over network.edges would
+		for (auto& edge : network.edges) {
+			add_adjacent_edge(incidence[edge.start_node], &edge, edge.start_node);
+			if (edge.end_node != edge.start_node) {
+				add_adjacent_edge(incidence[edge.end_node], &edge, edge.end_node);
+			}
+		}
+		return incidence;
 	}
 
 	void details::process_node(RoadNetwork& network, Node* node) {
@@ -165,9 +183,15 @@ namespace tjs::core::algo {
 
 		auto adjacent = get_adjacent_edges(network, node);
 
-		std::vector<Edge*>& incoming = adjacent.incoming;
-		std::vector<Edge*>& outgoing = adjacent.outgoing;
-		Edge* primary = adjacent.primary;
+		std::vector<LaneLink> links;
+		connect_lanes(adjacent, links);
+		store_links(network, links);
+	}
+
+	void details::connect_lanes(const AdjacentEdges& adjacent, std::vector<LaneLink>& links) {
+		const std::vector<Edge*>& incoming = adjacent.incoming;
+		const std::vector<Edge*>& outgoing = adjacent.outgoing;
+		const size_t first_link = links.size();
 
 		// General case: connect every incoming lane to an
 		// appropriate lane on each outgoing edge respecting
@@ -227,6 +251,12 @@ namespace tjs::core::algo {
 					if (it != from_lane.outgoing_connections.end()) {
 						continue;
 					}
+					const bool pending = std::any_of(links.begin() + first_link, links.end(), [&from_lane, to_lane](const LaneLink& link) {
+						return link.from == &from_lane && link.to == to_lane;
+					});
+					if (pending) {
+						continue;
+					}
 
 					// TODO: adjust lane
 					const bool turning_lane = has_flag(from_lane.turn, TurnDirection::Left) || has_flag(from_lane.turn, TurnDirection::Right);
@@ -240,11 +270,7 @@ namespace tjs::core::algo {
 						++processed_lanes;
 					}
 
-					network.lane_links.push_back({ &from_lane, to_lane, is_link_type(in_edge->way->type) });
-					LaneLinkHandler link_handler { network.lane_links, network.lane_links.size() - 1 };
-					from_lane.outgoing_connections.push_back(link_handler);
-					to_lane->incoming_connections.push_back(link_handler);
-					network.lane_graph[&from_lane].push_back(link_handler);
+					links.push_back({ &from_lane, to_lane, is_link_type(in_edge->way->type) });
 
 					if (std::ranges::find(from_lane.parent->outgoing_edges, to_lane->parent) == from_lane.parent->outgoing_edges.end()) {
 						from_lane.parent->outgoing_edges.push_back(to_lane->parent);
@@ -254,7 +280,18 @@ namespace tjs::core::algo {
 		}
 	}
 
-	void LaneConnectorBuilder::build_lane_connections(core::RoadNetwork& network) {
+	void details::store_links(RoadNetwork& network, const std::vector<LaneLink>& links) {
+		for (const LaneLink& link : links) {
+			network.lane_links.push_back(link);
+			LaneLinkHandler link_handler { network.lane_links, network.lane_links.size() - 1 };
+			link.from->outgoing_connections.push_back(link_handler);
+			link.to->incoming_connections.push_back(link_handler);
+		}
+	}
+
+	void LaneConnectorBuilder::build_lane_connections(core::RoadNetwork& network, size_t threads) {
+		TJS_TRACY_NAMED("LaneConnectorBuilder_Build");
+
 		// Remove any previously generated links so the builder can be
 		// called multiple times without leaking connections.
 		for (auto& edge : network.edges) {
@@ -266,9 +303,46 @@ namespace tjs::core::algo {
 		network.lane_links.clear();
 		network.lane_graph.clear();
 
+		auto incidence = details::build_edge_incidence(network);
+
+		std::vector<details::AdjacentEdges*> nodes;
+		nodes.reserve(network.nodes.size());
 		for (const auto& [nid, node] : network.nodes) {
-			details::process_node(network, node);
+			if (auto it = incidence.find(node); it != incidence.end()) {
+				nodes.push_back(&it->second);
+			}
+		}
+
+		// A node only writes the outgoing side of its incoming lanes and the
+		// incoming side of its outgoing lanes, so nodes are independent.
+		// Links are merged in node order to keep lane_links and every
+		// per-lane connection list the same as a sequential pass.
+		constexpr size_t NODES_PER_TASK = 256;
+		const size_t tasks = (nodes.size() + NODES_PER_TASK - 1) / NODES_PER_TASK;
+		std::vector<std::vector<LaneLink>> task_links(tasks);
+
+		if (threads == 0) {
+			threads = std::thread::hardware_concurrency();
+		}
+		common::WorkerPool pool(std::clamp<size_t>(tasks, 1, std::max<size_t>(threads, 1)));
+		pool.parallel_for(tasks, [&](size_t task, size_t) {
+			const size_t end = std::min(nodes.size(), (task + 1) * NODES_PER_TASK);
+			for (size_t i = task * NODES_PER_TASK; i < end; ++i) {
+				details::order_adjacent_edges(*nodes[i]);
+				details::connect_lanes(*nodes[i], task_links[task]);
+			}
+		});
+
+		size_t total = 0;
+		for (const auto& links : task_links) {
+			total += links.size();
 		}
+		network.lane_links.reserve(total);
+		for (const auto& links : task_links) {
+			details::store_links(network, links);
+		}
+
+		network.build_lane_graph();
 	}
 
 } // namespace tjs::core::algo
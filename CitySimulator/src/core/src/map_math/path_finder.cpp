@@ -6,276 +6,525 @@
 #include <core/data_layer/data_types.h>
 
 #include <core/map_math/earth_math.h>
+#include <core/map_math/search_context.h>
+#include <core/map_math/landmarks.h>
 
 namespace tjs::core::algo {
+	namespace {
+		constexpr uint32_t NO_INDEX = SearchContext::NO_INDEX;
+		using NodeRecord = SearchContext::NodeRecord;
+
+		// Straight-line distance to the target
+		struct StraightLineBound {
+			const RoadNetwork& network;
+			Coordinates target;
+
+			double operator()(uint32_t node) const {
+				const Coordinates& position = network.graph_nodes[node]->coordinates;
+				const double dx = target.x - position.x;
+				const double dy = target.y - position.y;
+				return std::sqrt(dx * dx + dy * dy);
+			}
+		};
 
-	std::deque<Node*> PathFinder::find_path_a_star(const RoadNetwork& network, Node* source, Node* target) {
-		using NodeEntry = std::pair<double, Node*>;
-		std::priority_queue<NodeEntry, std::vector<NodeEntry>, std::greater<>> open_set;
-
-		std::unordered_map<Node*, double> g_score;
-		std::unordered_map<Node*, Node*> came_from;
-		std::unordered_set<Node*> closed_set;
-
-		g_score[source] = 0.0;
-		double h_start = core::algo::euclidean_distance(source->coordinates, target->coordinates);
-		open_set.emplace(h_start, source);
-
-		while (!open_set.empty()) {
-			Node* current = open_set.top().second;
-			open_set.pop();
-
-			if (current == target) {
-				std::deque<Node*> path;
-				while (current != nullptr) {
-					path.push_front(current);
-					current = came_from[current];
-				}
-				return path;
+		// The better of the straight line and the landmark bounds
+		struct LandmarkBound {
+			StraightLineBound line;
+			const LandmarkTable& table;
+			uint32_t target;
+
+			double operator()(uint32_t node) const {
+				return std::max(line(node), table.lower_bound(node, target));
 			}
+		};
+
+		// Lower bound of the route length from `source` to a node, by landmarks
+		struct LandmarkSourceBound {
+			StraightLineBound line;
+			const LandmarkTable& table;
+			uint32_t source;
 
-			if (closed_set.count(current)) {
-				continue;
+			double operator()(uint32_t node) const {
+				return std::max(line(node), table.lower_bound(source, node));
 			}
-			closed_set.insert(current);
+		};
 
-			const auto& neighbors = network.adjacency_list.find(current);
-			if (neighbors == network.adjacency_list.end()) {
-				continue;
+		// Heuristic of `node`, computed once per node and search
+		template<typename Bound>
+		double heuristic(SearchContext::NodeRecord& record, uint32_t node, const Bound& bound) {
+			if (record.h_score < 0.0) {
+				record.h_score = bound(node);
 			}
+			return record.h_score;
+		}
 
-			for (const auto& [neighbor, edge_cost] : neighbors->second) {
-				if (closed_set.count(neighbor)) {
-					continue;
+		// Plain A* over node_graph, leaves the search tree in `context`
+		bool search_a_star(const RoadNetwork& network, uint32_t source, const Node* target, SearchContext& context) {
+			auto& open_set = context.open();
+			NodeRecord& start = context.record(source);
+			start.g_score = 0.0;
+			const StraightLineBound bound { network, target->coordinates };
+			open_set.push_or_decrease(source, heuristic(start, source, bound));
+
+			while (!open_set.empty()) {
+				const uint32_t current = open_set.pop();
+				if (current == target->graph_index) {
+					return true;
 				}
 
-				double tentative_g = g_score[current] + edge_cost;
+				NodeRecord& current_record = context.record(current);
+				current_record.closed = true;
+				context.count_expanded();
+				const double current_g = current_record.g_score;
 
-				if (!g_score.count(neighbor) || tentative_g < g_score[neighbor]) {
-					came_from[neighbor] = current;
-					g_score[neighbor] = tentative_g;
-					double h = core::algo::euclidean_distance(neighbor->coordinates, target->coordinates);
-					open_set.emplace(tentative_g + h, neighbor);
+				for (const GraphArc& arc : network.node_graph[current]) {
+					NodeRecord& neighbor = context.record(arc.target);
+					if (neighbor.closed) {
+						continue;
+					}
+
+					const double tentative_g = current_g + arc.length;
+					if (tentative_g < neighbor.g_score) {
+						neighbor.parent = current;
+						neighbor.via = arc.edge;
+						neighbor.g_score = tentative_g;
+						open_set.push_or_decrease(arc.target, tentative_g + heuristic(neighbor, arc.target, bound));
+					}
 				}
 			}
+			return false;
 		}
 
-		return {}; // Путь не найден
-	}
-
-	std::unordered_set<Node*> PathFinder::reachable_nodes(const RoadNetwork& network, Node* source) {
-		std::unordered_set<Node*> visited;
-		if (!source) {
-			return visited;
+		// Walks parents back from `node` into context.path(), then puts it in travel order
+		void collect_path(SearchContext& context, uint32_t node) {
+			auto& path = context.path();
+			path.clear();
+			for (uint32_t n = node; n != NO_INDEX && context.record(n).via != NO_INDEX; n = context.record(n).parent) {
+				path.push_back(context.record(n).via);
+			}
+			std::ranges::reverse(path);
 		}
 
-		std::queue<Node*> queue;
-		queue.push(source);
-		visited.insert(source);
+		bool in_graph(const RoadNetwork& network, const Node* node) {
+			return node != nullptr && node->graph_index < network.graph_nodes.size() && network.graph_nodes[node->graph_index] == node;
+		}
 
-		while (!queue.empty()) {
-			Node* current = queue.front();
-			queue.pop();
+		// ────────────────────────────────────────────────────────────────────
+		//  A* from *lane*            (multi-source front edges)
+		//  --------------------------------------------------
+		//  • start_lane  : the lane the vehicle is physically in **now**
+		//  • target      : destination node
+		//  • network     : RoadNetwork with node_graph and lane graph built
+		//
+		//  Leaves edge sequence   start_lane → … → target   in context.path()
+		//  and returns false if no route exists. `bound` is the heuristic;
+		//  context must be reset and the target in the graph.
+		// ────────────────────────────────────────────────────────────────────
+		template<typename Bound>
+		bool search_from_lane(
+			const RoadNetwork& network,
+			const Lane* start_lane,
+			const Node* target,
+			bool look_adjacent_lanes,
+			const Bound& bound,
+			SearchContext& context) {
+			auto& open_set = context.open();
+
+			auto seed_successors = [&](const Lane* ln) {
+				for (LaneLinkHandler h : ln->outgoing_connections) {
+					const LaneLink& link = *h;
+					const Edge* e = link.to ? link.to->parent : nullptr;
+					if (!e) {
+						continue;
+					}
 
-			auto it = network.edge_graph.find(current);
-			if (it == network.edge_graph.end()) {
-				continue;
-			}
+					const uint32_t node = e->end_node->graph_index;
+					NodeRecord& rec = context.record(node);
+					rec.parent = NO_INDEX;
+					rec.via = network.edge_index(e);
+					rec.g_score = 0.0;
+					open_set.push_or_decrease(node, heuristic(rec, node, bound));
+				}
+			};
 
-			for (const Edge* edge : it->second) {
-				Node* neighbor = edge->end_node;
-				if (!visited.contains(neighbor)) {
-					visited.insert(neighbor);
-					queue.push(neighbor);
+			if (look_adjacent_lanes) {
+				for (auto& lane : start_lane->parent->lanes) {
+					seed_successors(&lane);
 				}
+			} else {
+				seed_successors(start_lane);
 			}
-		}
 
-		return visited;
-	}
+			const auto has_transition = [&network](uint32_t from, uint32_t to) {
+				const auto transitions = network.edge_transitions[from];
+				return std::ranges::find(transitions, to) != transitions.end();
+			};
 
-	std::vector<const Edge*> PathFinder::find_edge_path_a_star(const RoadNetwork& network, Node* source, Node* target) {
-		using NodeEntry = std::pair<double, Node*>;
-		std::priority_queue<NodeEntry, std::vector<NodeEntry>, std::greater<>> open_set;
-
-		std::unordered_map<Node*, double> g_score;
-		std::unordered_map<Node*, Node*> came_from;
-		std::unordered_map<Node*, const Edge*> came_by_edge;
-		std::unordered_set<Node*> closed_set;
-
-		g_score[source] = 0.0;
-		double h_start = core::algo::euclidean_distance(source->coordinates, target->coordinates);
-		open_set.emplace(h_start, source);
-
-		while (!open_set.empty()) {
-			Node* current = open_set.top().second;
-			open_set.pop();
-
-			if (current == target) {
-				std::vector<const Edge*> path;
-				while (current != source) {
-					const Edge* e = came_by_edge[current];
-					path.insert(path.begin(), e);
-					current = came_from[current];
+			while (!open_set.empty()) {
+				const uint32_t current = open_set.pop();
+
+				if (current == target->graph_index) {
+					collect_path(context, current);
+					return !context.path().empty();
 				}
-				return path;
-			}
 
-			if (closed_set.count(current)) {
-				continue;
-			}
-			closed_set.insert(current);
+				NodeRecord& from = context.record(current);
+				from.closed = true;
+				context.count_expanded();
 
-			auto it = network.edge_graph.find(current);
-			if (it == network.edge_graph.end()) {
-				continue;
-			}
+				const double tentative_base = from.g_score;
+				const uint32_t from_via = from.via;
 
-			for (const Edge* edge : it->second) {
-				Node* neighbor = edge->end_node;
-				double tentative_g = g_score[current] + edge->length;
+				for (const GraphArc& arc : network.node_graph[current]) {
+					// check lane-level connectivity
+					if (from_via != NO_INDEX && !has_transition(from_via, arc.edge)) {
+						continue;
+					}
 
-				if (!g_score.count(neighbor) || tentative_g < g_score[neighbor]) {
-					came_from[neighbor] = current;
-					came_by_edge[neighbor] = edge;
-					g_score[neighbor] = tentative_g;
-					double h = core::algo::euclidean_distance(neighbor->coordinates, target->coordinates);
-					open_set.emplace(tentative_g + h, neighbor);
+					const double tentative_g = tentative_base + arc.length;
+					NodeRecord& neighbor = context.record(arc.target);
+					if (tentative_g < neighbor.g_score) {
+						// a closed node keeps the better parent but is not expanded again
+						neighbor.parent = current;
+						neighbor.via = arc.edge;
+						neighbor.g_score = tentative_g;
+						if (!neighbor.closed) {
+							open_set.push_or_decrease(arc.target, tentative_g + heuristic(neighbor, arc.target, bound));
+						}
+					}
 				}
 			}
-		}
-
-		return {};
-	}
 
-	struct NodeRecord {
-		Node* parent = nullptr;
-		const Edge* via = nullptr;
-		double g_score = std::numeric_limits<double>::infinity();
-	};
-
-	// ────────────────────────────────────────────────────────────────────
-	//  A* from *lane*            (multi-source front edges)
-	//  --------------------------------------------------
-	//  • start_lane  : the lane the vehicle is physically in **now**
-	//  • target      : destination node
-	//  • network     : unchanged RoadNetwork with edge_graph
-	//
-	//  Returns edge sequence   start_lane → … → target
-	//  or empty vector if no route exists.
-	// ────────────────────────────────────────────────────────────────────
-	std::vector<const Edge*> PathFinder::find_edge_path_a_star_from_lane(
-		const RoadNetwork& network,
-		const Lane* start_lane,
-		Node* target,
-		bool look_adjacent_lanes) {
-		TJS_TRACY_NAMED("PathFinder::find_edge_path_a_star_from_lane");
+			return false; // no path found
+		}
 
-		using NodeEntry = std::pair<double, Node*>;
-		using OpenSetQueue = std::priority_queue<
-			std::pair<double, Node*>,
-			std::vector<std::pair<double, Node*>>,
-			std::greater<>>;
-
-		static thread_local std::unordered_map<Node*, NodeRecord> records;
-		static thread_local std::unordered_set<Node*> closed_set;
-		static thread_local OpenSetQueue open_set;
-
-		records.reserve(128);
-		closed_set.reserve(128);
-
-		records.clear();
-		closed_set.clear();
-		open_set = {};
-
-		auto seed_successors = [&](const Lane* ln) {
-			for (LaneLinkHandler h : ln->outgoing_connections) {
-				const LaneLink& link = *h;
-				const Edge* e = link.to ? link.to->parent : nullptr;
-				if (!e) {
-					continue;
+		// ────────────────────────────────────────────────────────────────────
+		//  Bidirectional A* over edges
+		//  --------------------------------------------------
+		//  Records are per edge. Forward g is the length from the start lane's
+		//  junction to the end of the edge, backward g the length from the end
+		//  of the edge to `target`; a route through edge e costs the sum.
+		//  parent is the previous edge forward and the next edge backward.
+		//
+		//  With p(e) the average potential of the edge end, keys are g + p
+		//  forward and g - p backward, so the search may stop once the two
+		//  smallest keys add up to the best route seen.
+		// ────────────────────────────────────────────────────────────────────
+		template<typename ToTarget, typename FromSource>
+		bool search_bidirectional(
+			const RoadNetwork& network,
+			const Lane* start_lane,
+			const Node* target,
+			bool look_adjacent_lanes,
+			const ToTarget& to_target,
+			const FromSource& from_source,
+			BidirectionalSearchContext& context) {
+			SearchContext& forward = context.forward;
+			SearchContext& backward = context.backward;
+
+			// average of the bounds to the target and from the source, consistent
+			// forward and, negated, backward. Landmark bounds are cached, one per
+			// half; straight lines are cheaper to recompute than to look up.
+			const auto potential = [&](uint32_t edge) {
+				const uint32_t node = network.edges[edge].end_node->graph_index;
+				if constexpr (std::is_same_v<ToTarget, StraightLineBound>) {
+					return 0.5 * (to_target(node) - from_source(node));
+				} else {
+					return 0.5 * (heuristic(forward.record(edge), node, to_target) - heuristic(backward.record(edge), node, from_source));
 				}
+			};
+
+			double best = std::numeric_limits<double>::infinity();
+			uint32_t meeting = NO_INDEX;
+			const auto meet = [&](uint32_t edge, double length) {
+				if (length < best) {
+					best = length;
+					meeting = edge;
+				}
+			};
 
-				Node* node = e->end_node;
-				NodeRecord rec;
-				rec.parent = nullptr;
-				rec.via = e;
+			for (uint32_t edge : network.incoming_edges[target->graph_index]) {
+				NodeRecord& rec = backward.record(edge);
 				rec.g_score = 0.0;
-				records[node] = rec;
-
-				double h_cost = core::algo::euclidean_distance(node->coordinates, target->coordinates);
-				open_set.emplace(h_cost, node);
+				backward.open().push_or_decrease(edge, -potential(edge));
 			}
-		};
 
-		if (look_adjacent_lanes) {
-			for (auto& lane : start_lane->parent->lanes) {
-				seed_successors(&lane);
+			auto seed_successors = [&](const Lane* ln) {
+				for (LaneLinkHandler h : ln->outgoing_connections) {
+					const Edge* e = h->to ? h->to->parent : nullptr;
+					if (!e) {
+						continue;
+					}
+					const uint32_t edge = network.edge_index(e);
+					NodeRecord& rec = forward.record(edge);
+					if (e->length < rec.g_score) {
+						rec.g_score = e->length;
+						forward.open().push_or_decrease(edge, rec.g_score + potential(edge));
+						if (backward.touched(edge)) {
+							meet(edge, rec.g_score + backward.get(edge).g_score);
+						}
+					}
+				}
+			};
+
+			if (look_adjacent_lanes) {
+				for (auto& lane : start_lane->parent->lanes) {
+					seed_successors(&lane);
+				}
+			} else {
+				seed_successors(start_lane);
 			}
-		} else {
-			seed_successors(start_lane);
-		}
 
-		const auto has_transition = [](const Edge& from, const Edge& to) {
-			return std::ranges::find(from.outgoing_edges, &to) != from.outgoing_edges.end();
-		};
+			// a side that runs empty has seen every route through it
+			while (!forward.open().empty() && !backward.open().empty()) {
+				if (forward.open().top_key() + backward.open().top_key() >= best) {
+					break;
+				}
 
-		while (!open_set.empty()) {
-			Node* current = open_set.top().second;
-			open_set.pop();
-
-			if (current == target) {
-				std::vector<const Edge*> path;
-				Node* n = current;
-				while (records.contains(n)) {
-					const auto& rec = records[n];
-					if (!rec.via) {
-						break; // entry point
+				if (forward.open().size() <= backward.open().size()) {
+					const uint32_t current = forward.open().pop();
+					NodeRecord& from = forward.record(current);
+					from.closed = true;
+					forward.count_expanded();
+
+					const double base = from.g_score;
+					for (uint32_t next : network.edge_transitions[current]) {
+						const double tentative_g = base + network.edges[next].length;
+						NodeRecord& neighbor = forward.record(next);
+						if (tentative_g < neighbor.g_score) {
+							neighbor.parent = current;
+							neighbor.g_score = tentative_g;
+							forward.open().push_or_decrease(next, tentative_g + potential(next));
+							if (backward.touched(next)) {
+								meet(next, tentative_g + backward.get(next).g_score);
+							}
+						}
+					}
+				} else {
+					const uint32_t current = backward.open().pop();
+					NodeRecord& to = backward.record(current);
+					to.closed = true;
+					backward.count_expanded();
+
+					const double tentative_g = to.g_score + network.edges[current].length;
+					for (uint32_t previous : network.edge_predecessors[current]) {
+						NodeRecord& neighbor = backward.record(previous);
+						if (tentative_g < neighbor.g_score) {
+							neighbor.parent = current;
+							neighbor.g_score = tentative_g;
+							backward.open().push_or_decrease(previous, tentative_g - potential(previous));
+							if (forward.touched(previous)) {
+								meet(previous, forward.get(previous).g_score + tentative_g);
+							}
+						}
 					}
-					path.insert(path.begin(), rec.via);
-					n = rec.parent;
 				}
-				return path;
 			}
 
-			auto result = closed_set.insert(current);
-			if (!result.second) {
-				continue;
+			if (meeting == NO_INDEX) {
+				return false;
 			}
 
-			auto it = network.edge_graph.find(current);
-			if (it == network.edge_graph.end()) {
-				continue;
+			auto& path = context.path;
+			for (uint32_t e = meeting; e != NO_INDEX; e = forward.get(e).parent) {
+				path.push_back(e);
 			}
+			std::ranges::reverse(path);
+			for (uint32_t e = backward.get(meeting).parent; e != NO_INDEX; e = backward.get(e).parent) {
+				path.push_back(e);
+			}
+			return true;
+		}
+	} // namespace
 
-			auto from_it = records.find(current);
-			const double tentative_base = from_it->second.g_score;
+	SearchContext& thread_search_context() {
+		static thread_local SearchContext context;
+		return context;
+	}
 
-			for (const Edge* edge : it->second) {
-				Node* neighbor = edge->end_node;
+	BidirectionalSearchContext& thread_bidirectional_context() {
+		static thread_local BidirectionalSearchContext context;
+		return context;
+	}
 
-				// check lane-level connectivity
-				if (from_it->second.via) {
-					if (!has_transition(*from_it->second.via, *edge)) {
-						continue;
-					}
-				}
+	std::deque<Node*> PathFinder::find_path_a_star(const RoadNetwork& network, Node* source, Node* target) {
+		if (source == target) {
+			return { source };
+		}
+		if (!in_graph(network, source) || !in_graph(network, target)) {
+			return {};
+		}
 
-				const double tentative_g = tentative_base + edge->length;
-				const double h = core::algo::euclidean_distance(neighbor->coordinates, target->coordinates);
+		auto& context = thread_search_context();
+		context.reset(network.graph_nodes.size());
+		if (!search_a_star(network, source->graph_index, target, context)) {
+			return {}; // Путь не найден
+		}
+
+		std::deque<Node*> path;
+		for (uint32_t n = target->graph_index; n != NO_INDEX; n = context.record(n).parent) {
+			path.push_front(network.graph_nodes[n]);
+		}
+		return path;
+	}
+
+	std::unordered_set<Node*> PathFinder::reachable_nodes(const RoadNetwork& network, Node* source) {
+		std::unordered_set<Node*> visited;
+		if (!source) {
+			return visited;
+		}
+		visited.insert(source);
+		if (!in_graph(network, source)) {
+			return visited;
+		}
 
-				auto it = records.find(neighbor);
-				if (it == records.end()) {
-					records[neighbor] = NodeRecord { current, edge, tentative_g };
-					open_set.emplace(tentative_g + h, neighbor);
-				} else if (tentative_g < it->second.g_score) {
-					it->second = NodeRecord { current, edge, tentative_g };
-					open_set.emplace(tentative_g + h, neighbor);
+		std::vector<bool> seen(network.graph_nodes.size(), false);
+		std::vector<uint32_t> queue;
+		queue.push_back(source->graph_index);
+		seen[source->graph_index] = true;
+
+		for (size_t head = 0; head < queue.size(); ++head) {
+			for (const GraphArc& arc : network.node_graph[queue[head]]) {
+				if (!seen[arc.target]) {
+					seen[arc.target] = true;
+					queue.push_back(arc.target);
+					visited.insert(network.graph_nodes[arc.target]);
 				}
 			}
 		}
 
-		return {}; // no path found
+		return visited;
+	}
+
+	bool PathFinder::find_edge_path_a_star(const RoadNetwork& network, const Node* source, const Node* target, SearchContext& context) {
+		context.reset(network.graph_nodes.size());
+		if (source == target || !in_graph(network, source) || !in_graph(network, target)) {
+			return false;
+		}
+		if (!search_a_star(network, source->graph_index, target, context)) {
+			return false;
+		}
+		collect_path(context, target->graph_index);
+		return true;
+	}
+
+	std::vector<const Edge*> PathFinder::find_edge_path_a_star(const RoadNetwork& network, Node* source, Node* target) {
+		auto& context = thread_search_context();
+		if (!find_edge_path_a_star(network, source, target, context)) {
+			return {};
+		}
+		return to_edges(network, context.path());
+	}
+
+	bool PathFinder::find_edge_path_a_star_from_lane(
+		const RoadNetwork& network,
+		const Lane* start_lane,
+		const Node* target,
+		bool look_adjacent_lanes,
+		SearchContext& context) {
+		TJS_TRACY_NAMED("PathFinder::find_edge_path_a_star_from_lane");
+
+		context.reset(network.graph_nodes.size());
+
+		// lane-level transitions come from the lane graph
+		if (!in_graph(network, target) || network.edge_transitions.rows() != network.edges.size()) {
+			return false;
+		}
+		const StraightLineBound bound { network, target->coordinates };
+		return search_from_lane(network, start_lane, target, look_adjacent_lanes, bound, context);
+	}
+
+	std::vector<const Edge*> PathFinder::find_edge_path_a_star_from_lane(
+		const RoadNetwork& network,
+		const Lane* start_lane,
+		Node* target,
+		bool look_adjacent_lanes) {
+		auto& context = thread_search_context();
+		if (!find_edge_path_a_star_from_lane(network, start_lane, target, look_adjacent_lanes, context)) {
+			return {};
+		}
+		return to_edges(network, context.path());
+	}
+
+	bool PathFinder::find_edge_path_alt_from_lane(
+		const RoadNetwork& network,
+		const Lane* start_lane,
+		const Node* target,
+		bool look_adjacent_lanes,
+		SearchContext& context) {
+		TJS_TRACY_NAMED("PathFinder::find_edge_path_alt_from_lane");
+
+		const LandmarkTable* table = network.landmarks.get();
+		if (table == nullptr || table->node_count() != network.graph_nodes.size()) {
+			return find_edge_path_a_star_from_lane(network, start_lane, target, look_adjacent_lanes, context);
+		}
+
+		context.reset(network.graph_nodes.size());
+		if (!in_graph(network, target) || network.edge_transitions.rows() != network.edges.size()) {
+			return false;
+		}
+		const LandmarkBound bound { { network, target->coordinates }, *table, target->graph_index };
+		return search_from_lane(network, start_lane, target, look_adjacent_lanes, bound, context);
+	}
+
+	std::vector<const Edge*> PathFinder::find_edge_path_alt_from_lane(
+		const RoadNetwork& network,
+		const Lane* start_lane,
+		Node* target,
+		bool look_adjacent_lanes) {
+		auto& context = thread_search_context();
+		if (!find_edge_path_alt_from_lane(network, start_lane, target, look_adjacent_lanes, context)) {
+			return {};
+		}
+		return to_edges(network, context.path());
+	}
+
+	bool PathFinder::find_edge_path_bidirectional_from_lane(
+		const RoadNetwork& network,
+		const Lane* start_lane,
+		const Node* target,
+		bool look_adjacent_lanes,
+		BidirectionalSearchContext& context) {
+		TJS_TRACY_NAMED("PathFinder::find_edge_path_bidirectional_from_lane");
+
+		context.forward.reset(network.edges.size());
+		context.backward.reset(network.edges.size());
+		context.path.clear();
+		if (!in_graph(network, target) || network.edge_predecessors.rows() != network.edges.size()) {
+			return false;
+		}
+
+		const Node* source = start_lane->parent->end_node;
+		const StraightLineBound to_target { network, target->coordinates };
+		const StraightLineBound from_source { network, source->coordinates };
+		const LandmarkTable* table = network.landmarks.get();
+		if (table != nullptr && table->node_count() == network.graph_nodes.size()) {
+			const LandmarkBound landmarks_to_target { to_target, *table, target->graph_index };
+			const LandmarkSourceBound landmarks_from_source { from_source, *table, source->graph_index };
+			return search_bidirectional(network, start_lane, target, look_adjacent_lanes, landmarks_to_target, landmarks_from_source, context);
+		}
+		return search_bidirectional(network, start_lane, target, look_adjacent_lanes, to_target, from_source, context);
+	}
+
+	std::vector<const Edge*> PathFinder::find_edge_path_bidirectional_from_lane(
+		const RoadNetwork& network,
+		const Lane* start_lane,
+		Node* target,
+		bool look_adjacent_lanes) {
+		auto& context = thread_bidirectional_context();
+		if (!find_edge_path_bidirectional_from_lane(network, start_lane, target, look_adjacent_lanes, context)) {
+			return {};
+		}
+		return to_edges(network, context.path);
+	}
+
+	std::vector<const Edge*> PathFinder::to_edges(const RoadNetwork& network, std::span<const uint32_t> edge_indices) {
+		std::vector<const Edge*> path;
+		path.reserve(edge_indices.size());
+		for (uint32_t e : edge_indices) {
+			path.push_back(&network.edges[e]);
+		}
+		return path;
 	}
 
 } // namespace tjs::core::algo
@@ -0,0 +1,135 @@
+#include <core/stdafx.h>
+
+#include <core/map_math/shortest_path_tree.h>
+
+#include <core/data_layer/road_network.h>
+
+#include <common/threading/worker_pool.h>
+
+namespace tjs::core::algo {
+	namespace {
+		constexpr double INF = std::numeric_limits<double>::infinity();
+
+		bool in_graph(const RoadNetwork& network, const Node* node) {
+			return node != nullptr && node->graph_index < network.graph_nodes.size() && network.graph_nodes[node->graph_index] == node;
+		}
+	} // namespace
+
+	bool ShortestPathTree::build(const RoadNetwork& network, const Node* source, std::span<const uint32_t> targets) {
+		TJS_TRACY_NAMED("ShortestPathTree_Build");
+
+		const size_t nodes = network.graph_nodes.size();
+		const size_t edges = network.edges.size();
+		_edge_distance.assign(edges, INF);
+		_edge_parent.assign(edges, NO_INDEX);
+		_node_distance.assign(nodes, INF);
+		_node_via.assign(nodes, NO_INDEX);
+		_open.resize(edges);
+		_open.clear();
+
+		if (!in_graph(network, source) || network.edge_transitions.rows() != edges) {
+			return false;
+		}
+
+		const uint32_t root = source->graph_index;
+		_node_distance[root] = 0.0;
+
+		size_t remaining = 0;
+		_wanted.assign(nodes, false);
+		for (uint32_t target : targets) {
+			if (target < nodes && target != root && !_wanted[target]) {
+				_wanted[target] = true;
+				++remaining;
+			}
+		}
+		const bool stop_early = !targets.empty();
+		if (stop_early && remaining == 0) {
+			return true;
+		}
+
+		auto relax = [this](uint32_t edge, uint32_t parent, double distance) {
+			if (distance < _edge_distance[edge]) {
+				_edge_distance[edge] = distance;
+				_edge_parent[edge] = parent;
+				_open.push_or_decrease(edge, distance);
+			}
+		};
+
+		for (const GraphArc& arc : network.node_graph[root]) {
+			relax(arc.edge, NO_INDEX, arc.length);
+		}
+
+		while (!_open.empty()) {
+			const uint32_t edge = _open.pop();
+			const double base = _edge_distance[edge];
+
+			// edges leave the heap in order, the first one to end at a node is its best
+			const uint32_t end = network.edges[edge].end_node->graph_index;
+			if (end != root && _node_via[end] == NO_INDEX) {
+				_node_distance[end] = base;
+				_node_via[end] = edge;
+				if (stop_early && _wanted[end] && --remaining == 0) {
+					return true;
+				}
+			}
+
+			for (uint32_t next : network.edge_transitions[edge]) {
+				relax(next, edge, base + network.edges[next].length);
+			}
+		}
+		return true;
+	}
+
+	bool ShortestPathTree::route_to(uint32_t node, std::vector<uint32_t>& path) const {
+		path.clear();
+		if (node >= _node_distance.size() || !std::isfinite(_node_distance[node])) {
+			return false;
+		}
+		for (uint32_t edge = _node_via[node]; edge != NO_INDEX; edge = _edge_parent[edge]) {
+			path.push_back(edge);
+		}
+		std::ranges::reverse(path);
+		return true;
+	}
+
+	std::vector<double> distance_matrix(
+		const RoadNetwork& network,
+		std::span<const Node* const> origins,
+		std::span<const Node* const> destinations,
+		size_t threads) {
+		TJS_TRACY_NAMED("DistanceMatrix");
+
+		const size_t columns = destinations.size();
+		std::vector<double> matrix(origins.size() * columns, INF);
+		if (origins.empty() || columns == 0) {
+			return matrix;
+		}
+
+		std::vector<uint32_t> targets;
+		targets.reserve(columns);
+		for (const Node* destination : destinations) {
+			if (in_graph(network, destination)) {
+				targets.push_back(destination->graph_index);
+			}
+		}
+		if (targets.empty()) {
+			return matrix;
+		}
+
+		common::WorkerPool pool(threads);
+		std::vector<ShortestPathTree> trees(pool.size());
+		pool.parallel_for(origins.size(), [&](size_t row, size_t worker) {
+			ShortestPathTree& tree = trees[worker];
+			if (!tree.build(network, origins[row], targets)) {
+				return;
+			}
+			double* out = matrix.data() + row * columns;
+			for (size_t column = 0; column < columns; ++column) {
+				if (in_graph(network, destinations[column])) {
+					out[column] = tree.distance(destinations[column]->graph_index);
+				}
+			}
+		});
+		return matrix;
+	}
+} // namespace tjs::core::algo
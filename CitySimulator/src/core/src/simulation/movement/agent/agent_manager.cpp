@@ -15,6 +15,20 @@
 namespace tjs::core::simulation {
 
 	namespace details {
+		// Pairs a new agent with `vehicle`, each keeping the other's handle.
+		// nullptr when the pool is full
+		AgentData* create_agent(AgentPool& agent_pool, Vehicle& vehicle) {
+			const AgentHandle handle = agent_pool.acquire_handle(vehicle.uid(), vehicle.handle);
+			AgentData* agent = agent_pool.resolve(handle);
+			if (!agent) {
+				std::cerr << "AgentManager: agent pool is full" << std::endl;
+				return nullptr;
+			}
+			agent->handle = handle;
+			vehicle.agent() = handle;
+			return agent;
+		}
+
 		// Generate till count that was set
 		class BulkGenerator : public IAgentGenerator {
 		public:
@@ -45,7 +59,8 @@ namespace tjs::core::simulation {
 
 				auto& agent_manager = system().agent_manager();
 
-				const size_t max_attempts = 100;
+				// big populations would otherwise hit the creation ticks limit before filling up
+				const size_t max_attempts = std::max<size_t>(100, _expected_vehicles / 50);
 				size_t attempts = 0;
 				auto& edges = segment->road_network->edges;
 
@@ -62,8 +77,11 @@ namespace tjs::core::simulation {
 					}
 
 					// Create agent using object pool
-					auto agent_ptr = _agent_pool.acquire_ptr(result.value()->uid, result.value());
-					result.value()->agent = agent_ptr;
+					if (!create_agent(_agent_pool, *result.value())) {
+						vehicle_system.remove_vehicle(result.value());
+						_state = State::Error;
+						break;
+					}
 
 					++agnets_count;
 					++created;
@@ -190,11 +208,13 @@ namespace tjs::core::simulation {
 						auto result = vehicle_system.create_vehicle(*point.lane, type, 10.0f);
 						if (result.has_value()) {
 							// Create agent using object pool
-							auto agent_ptr = _agent_pool.acquire_ptr(result.value()->uid, result.value());
-							agent_ptr->profile.goal_selection = point.goal_selection_type;
-							agent_ptr->profile.goal = point.goal;
-
-							result.value()->agent = agent_ptr;
+							AgentData* agent = create_agent(_agent_pool, *result.value());
+							if (!agent) {
+								vehicle_system.remove_vehicle(result.value());
+								break;
+							}
+							agent->profile.goal_selection = point.goal_selection_type;
+							agent->profile.goal = point.goal;
 
 							++created;
 							++point.generated;
@@ -259,7 +279,6 @@ namespace tjs::core::simulation {
 	void AgentManager::update() {
 		remove_agents();
 		populate_agents();
-		_agent_pool.update_objects();
 	}
 
 	void AgentManager::populate_agents() {
@@ -275,7 +294,7 @@ namespace tjs::core::simulation {
 			need_send = true;
 			if (agents().size() == 1) {
 				auto& store = _system.store();
-				store.get_entry<core::model::VehicleAnalyzeData>()->agent = agents()[0];
+				store.get_entry<core::model::VehicleAnalyzeData>()->agent = agents()[0]->handle;
 			}
 		}
 
@@ -293,10 +312,13 @@ namespace tjs::core::simulation {
 
 	void AgentManager::remove_agents() {
 		auto& vehicle_system = _system.vehicle_system();
-		for (auto& agent : agents()) {
+		const auto& live = agents();
+		// a release moves the last agent into the freed place, walk from the back
+		for (size_t i = live.size(); i-- > 0;) {
+			AgentData* agent = live[i];
 			if (agent->to_remove) {
-				vehicle_system.remove_vehicle(agent->vehicle);
-				_agent_pool.release(agent);
+				vehicle_system.remove_vehicle(vehicle_system.get(agent->vehicle));
+				_agent_pool.release(agent->handle);
 			}
 		}
 	}
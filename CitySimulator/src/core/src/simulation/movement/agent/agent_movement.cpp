@@ -8,7 +8,6 @@
 #include <core/data_layer/world_data.h>
 #include <core/map_math/earth_math.h>
 #include <core/data_layer/road_network.h>
-#include <core/data_layer/lane_vehicle_utils.h>
 //#include <core/simulation/movement/idm/lane_agnostic_movement.h>
 #include <core/simulation/movement/movement_utils.h>
 
@@ -23,7 +22,8 @@ namespace tjs::core::simulation {
 
 		for (size_t i = 0; i < agents.size(); ++i) {
 			movement_details::update_agent(i, *agents[i], _system);
-			agents[i]->vehicle->previous_state = agents[i]->vehicle->state;
+			Vehicle& vehicle = *_system.vehicle_system().get(agents[i]->vehicle);
+			vehicle.previous_state() = vehicle.state();
 		}
 	}
 
@@ -53,100 +53,97 @@ namespace tjs::core::simulation {
 		return result;
 	}
 
-	Lane* find_lane(const Coordinates& coordinates, RoadNetwork& network) {
-		double min_distance = std::numeric_limits<double>::max();
-		Lane* candidate = nullptr;
-		for (auto& edge : network.edges) {
-			for (auto& lane : edge.lanes) {
-				double distance = core::algo::euclidean_distance(lane.parent->start_node->coordinates, coordinates);
-				if (distance > 15.0 && distance < min_distance) {
-					min_distance = distance;
-					candidate = &lane;
+	// First lane out of the closest node more than 15 m away
+	Lane* find_lane(const Coordinates& coordinates, WorldSegment& segment) {
+		RoadNetwork& network = *segment.road_network;
+		auto starting_lane = [&network](const Node* node) -> Lane* {
+			if (node->graph_index == Node::NO_GRAPH_INDEX) {
+				return nullptr;
+			}
+			for (const GraphArc& arc : network.node_graph[node->graph_index]) {
+				Edge& edge = network.edges[arc.edge];
+				if (!edge.lanes.empty()) {
+					return &edge.lanes.front();
 				}
 			}
-		}
-		return candidate;
+			return nullptr;
+		};
+		auto metric = [&](const Node* node, const common::BoundingBox&) {
+			const double distance = core::algo::euclidean_distance(node->coordinates, coordinates);
+			return distance > 15.0 && starting_lane(node) ? distance : std::numeric_limits<double>::infinity();
+		};
+
+		Node* nearest = nullptr;
+		segment.spatialGrid.points.nearest(coordinates.x, coordinates.y, 1, &nearest, metric);
+		return nearest ? starting_lane(nearest) : nullptr;
 	}
 
 	namespace movement_details {
 
 		void check_move_beginning(AgentData& agent, TrafficSimulationSystem& system) {
-			Vehicle& vehicle = *agent.vehicle;
+			Vehicle& vehicle = *system.vehicle_system().get(agent.vehicle);
 			auto parent_edge = vehicle.current_lane->parent;
 			if (!agent.path.empty()) {
 				auto target_edge = agent.path[agent.path_offset];
+				vehicle.s_on_lane() = 0.f;
 				if (
 					parent_edge != target_edge
 					&& parent_edge->start_node == target_edge->start_node) {
-					Lane* old_lane = vehicle.current_lane;
-					vehicle.current_lane = &target_edge->lanes[0];
-					if (old_lane) {
-						remove_vehicle(*old_lane, &vehicle);
-					}
-					insert_vehicle_sorted(*vehicle.current_lane, &vehicle);
+					system.vehicle_system().move_to_lane(vehicle, &target_edge->lanes[0]);
 				} else {
 					// TODO[simulation]: error handling when cannot find out edge
-					Lane* old_lane = vehicle.current_lane;
-					vehicle.current_lane = &target_edge->lanes[0];
-					if (old_lane) {
-						remove_vehicle(*old_lane, &vehicle);
-					}
-					insert_vehicle_sorted(*vehicle.current_lane, &vehicle);
+					system.vehicle_system().move_to_lane(vehicle, &target_edge->lanes[0]);
 				}
-				vehicle.s_on_lane = 0.f;
 				++agent.path_offset;
 			}
 		}
 
 		void adjust_lane(AgentData& agent, TrafficSimulationSystem& system) {
-			Vehicle& vehicle = *agent.vehicle;
+			Vehicle& vehicle = *system.vehicle_system().get(agent.vehicle);
 			if (vehicle.current_lane != nullptr) {
 				return;
 			}
 			auto& world = system.worldData();
-			auto& segment = world.segments().front();
-			auto& road_network = *segment->road_network;
+			auto& segment = *world.segments().front();
 
 			// TODO: REMOVE HACK
-			vehicle.current_lane = find_lane(vehicle.coordinates, road_network);
-			if (vehicle.current_lane) {
-				insert_vehicle_sorted(*vehicle.current_lane, &vehicle);
-			}
+			system.vehicle_system().move_to_lane(vehicle, find_lane(vehicle.coordinates(), segment));
 		}
 
 		void adjust_speed(Vehicle& vehicle) {
 			const Lane* lane = vehicle.current_lane;
-			vehicle.currentSpeed = std::min(
+			vehicle.currentSpeed() = std::min(
 				static_cast<float>(lane->parent->way->maxSpeed),
-				vehicle.maxSpeed);
+				vehicle.maxSpeed());
 		}
 
 		void move_vehicle(Vehicle& vehicle, Lane& lane, double move) {
 			const auto& start = lane.centerLine.front();
 			const auto& end = lane.centerLine.back();
 
-			vehicle.s_on_lane += move;
-			vehicle.coordinates = move_towards(start, end, vehicle.s_on_lane, lane.length);
+			vehicle.s_on_lane() += move;
+			vehicle.coordinates() = move_towards(start, end, vehicle.s_on_lane(), lane.length);
 
 			core::Coordinates dir {};
 			dir.x = end.x - start.x;
 			dir.y = end.y - start.y;
-			vehicle.rotationAngle = atan2(dir.y, dir.x);
+			vehicle.rotationAngle() = atan2(dir.y, dir.x);
 		}
 
 		void advance_vehicle(size_t i, AgentData& agent, TrafficSimulationSystem& system) {
-			Vehicle& vehicle = *agent.vehicle;
+			VehicleSystem& vehicle_system = system.vehicle_system();
+			Vehicle& vehicle = *vehicle_system.get(agent.vehicle);
 			double delta_time = system.timeModule().state().fixed_dt();
-			double speed_mps = vehicle.currentSpeed * 1000.0 / 3600.0;
+			double speed_mps = vehicle.currentSpeed() * 1000.0 / 3600.0;
 			double remaining_move = speed_mps * delta_time;
 
 			while (remaining_move > 0 && vehicle.current_lane) {
 				Lane* lane = vehicle.current_lane;
-				double to_end = lane->length - vehicle.s_on_lane;
+				double to_end = lane->length - vehicle.s_on_lane();
 				double move = std::min(remaining_move, to_end);
 
 				move_vehicle(vehicle, *lane, move);
-				update_vehicle_position(*lane, &vehicle);
+				vehicle_system.move_to_lane(vehicle, lane);
 
 				remaining_move -= move;
 				if (remaining_move <= 0) {
@@ -180,22 +177,18 @@ namespace tjs::core::simulation {
 						}
 					}
 					if (current_teleport) {
-						remove_vehicle(*lane, &vehicle);
-						vehicle.current_lane = current_teleport;
-						vehicle.s_on_lane = current_teleport->length;
-						move_vehicle(vehicle, *vehicle.current_lane, 0.0);
-						insert_vehicle_sorted(*vehicle.current_lane, &vehicle);
+						vehicle.s_on_lane() = current_teleport->length;
+						move_vehicle(vehicle, *current_teleport, 0.0);
+						vehicle_system.move_to_lane(vehicle, current_teleport);
 						lane = vehicle.current_lane;
 					}
 				}
 
 				if (next_lane) {
-					remove_vehicle(*lane, &vehicle);
-					vehicle.current_lane = next_lane;
-					vehicle.s_on_lane = 0;
-					move_vehicle(vehicle, *vehicle.current_lane, 0.0);
+					vehicle.s_on_lane() = 0;
+					move_vehicle(vehicle, *next_lane, 0.0);
 					++agent.path_offset;
-					insert_vehicle_sorted(*vehicle.current_lane, &vehicle);
+					vehicle_system.move_to_lane(vehicle, next_lane);
 				} else {
 					stop_moving(i, agent, vehicle, lane,
 						outgoing.empty() ? VehicleMovementError::ER_NO_OUTGOING_CONNECTION : VehicleMovementError::ER_NO_NEXT_LANE);
@@ -205,14 +198,14 @@ namespace tjs::core::simulation {
 		}
 
 		void process_vehicle_state(size_t i, AgentData& agent, TrafficSimulationSystem& system) {
-			auto& vehicle = *agent.vehicle;
+			auto& vehicle = *system.vehicle_system().get(agent.vehicle);
 
-			if (VehicleStateBitsV::has_info(vehicle.previous_state, VehicleStateBits::ST_STOPPED)) {
-				if (VehicleStateBitsV::has_info(vehicle.state, VehicleStateBits::ST_FOLLOW)) {
+			if (VehicleStateBitsV::has_info(vehicle.previous_state(), VehicleStateBits::ST_STOPPED)) {
+				if (VehicleStateBitsV::has_info(vehicle.state(), VehicleStateBits::ST_FOLLOW)) {
 					check_move_beginning(agent, system);
 					adjust_lane(agent, system);
 				}
-			} else if (VehicleStateBitsV::has_info(vehicle.state, VehicleStateBits::ST_FOLLOW)) {
+			} else if (VehicleStateBitsV::has_info(vehicle.state(), VehicleStateBits::ST_FOLLOW)) {
 				adjust_speed(vehicle);
 				advance_vehicle(i, agent, system);
 			}
@@ -0,0 +1,233 @@
+#include <core/stdafx.h>
+
+#include <core/simulation/movement/idm/idm_kernel.h>
+#include <core/simulation/movement/idm/lane_agnostic_movement.h>
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+#define TJS_IDM_X86 1
+#include <immintrin.h>
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+#else
+#define TJS_IDM_X86 0
+#endif
+
+// GCC/Clang need the ISA enabled per function to emit AVX2 without global -mavx2,
+// MSVC accepts intrinsics of any ISA as is.
+#if TJS_IDM_X86 && (defined(__GNUC__) || defined(__clang__))
+#define TJS_TARGET_AVX2 __attribute__((target("avx2")))
+#else
+#define TJS_TARGET_AVX2
+#endif
+
+namespace tjs::core::simulation::idm {
+	namespace {
+		// Parameters shared by every lane of a batch, hoisted out of the loops
+		struct BatchConstants {
+			float s0;
+			float t_headway;
+			float inv_root; // 1 / (2·sqrt(a·b))
+			float inv_v0;
+			float a_max;
+			float neg_b_comf;
+			float neg_b_hard;
+
+			explicit BatchConstants(const idm_params_t& p)
+				: s0(p.s0)
+				, t_headway(p.t_headway)
+				, inv_root(1.0f / (2.0f * std::sqrt(p.a_max * p.b_comf)))
+				, inv_v0(1.0f / p.v_desired)
+				, a_max(p.a_max)
+				, neg_b_comf(-p.b_comf)
+				, neg_b_hard(-p.b_hard) {
+			}
+		};
+
+		inline float accel_delta4(const float v, const float v_lead, const float gap, const BatchConstants& c) noexcept {
+			const float braking_add = std::max(0.0f, v * (v - v_lead) * c.inv_root);
+			const float s_star = c.s0 + v * c.t_headway + braking_add;
+
+			const float x = v * c.inv_v0;
+			const float x2 = x * x;
+			const float r = s_star / std::max(1e-3f, gap);
+
+			float a = c.a_max * (1.0f - x2 * x2 - r * r);
+			if (a < c.neg_b_comf) {
+				a = std::max(a, c.neg_b_hard);
+			}
+			return a;
+		}
+
+		void batch_scalar(const float* v_f, const float* v_l, const float* gap, float* out, size_t n, size_t from, const BatchConstants& c) noexcept {
+			for (size_t i = from; i < n; ++i) {
+				out[i] = accel_delta4(v_f[i], v_l[i], gap[i], c);
+			}
+		}
+
+#if TJS_IDM_X86
+		void batch_sse(const float* v_f, const float* v_l, const float* gap, float* out, size_t n, const BatchConstants& c) noexcept {
+			const __m128 s0 = _mm_set1_ps(c.s0);
+			const __m128 t_headway = _mm_set1_ps(c.t_headway);
+			const __m128 inv_root = _mm_set1_ps(c.inv_root);
+			const __m128 inv_v0 = _mm_set1_ps(c.inv_v0);
+			const __m128 a_max = _mm_set1_ps(c.a_max);
+			const __m128 neg_b_comf = _mm_set1_ps(c.neg_b_comf);
+			const __m128 neg_b_hard = _mm_set1_ps(c.neg_b_hard);
+			const __m128 min_gap = _mm_set1_ps(1e-3f);
+			const __m128 one = _mm_set1_ps(1.0f);
+			const __m128 zero = _mm_setzero_ps();
+
+			size_t i = 0;
+			for (; i + 4 <= n; i += 4) {
+				const __m128 v = _mm_loadu_ps(v_f + i);
+				const __m128 dv = _mm_sub_ps(v, _mm_loadu_ps(v_l + i));
+
+				const __m128 braking_add = _mm_max_ps(zero, _mm_mul_ps(_mm_mul_ps(v, dv), inv_root));
+				const __m128 s_star = _mm_add_ps(_mm_add_ps(s0, _mm_mul_ps(v, t_headway)), braking_add);
+
+				const __m128 x = _mm_mul_ps(v, inv_v0);
+				const __m128 x2 = _mm_mul_ps(x, x);
+				const __m128 r = _mm_div_ps(s_star, _mm_max_ps(min_gap, _mm_loadu_ps(gap + i)));
+
+				const __m128 term = _mm_sub_ps(_mm_sub_ps(one, _mm_mul_ps(x2, x2)), _mm_mul_ps(r, r));
+				const __m128 a = _mm_mul_ps(a_max, term);
+
+				// a < -b_comf ? max(a, -b_hard) : a
+				const __m128 hard = _mm_cmplt_ps(a, neg_b_comf);
+				const __m128 clamped = _mm_max_ps(a, neg_b_hard);
+				_mm_storeu_ps(out + i, _mm_or_ps(_mm_and_ps(hard, clamped), _mm_andnot_ps(hard, a)));
+			}
+			batch_scalar(v_f, v_l, gap, out, n, i, c);
+		}
+
+		TJS_TARGET_AVX2 void batch_avx2(const float* v_f, const float* v_l, const float* gap, float* out, size_t n, const BatchConstants& c) noexcept {
+			const __m256 s0 = _mm256_set1_ps(c.s0);
+			const __m256 t_headway = _mm256_set1_ps(c.t_headway);
+			const __m256 inv_root = _mm256_set1_ps(c.inv_root);
+			const __m256 inv_v0 = _mm256_set1_ps(c.inv_v0);
+			const __m256 a_max = _mm256_set1_ps(c.a_max);
+			const __m256 neg_b_comf = _mm256_set1_ps(c.neg_b_comf);
+			const __m256 neg_b_hard = _mm256_set1_ps(c.neg_b_hard);
+			const __m256 min_gap = _mm256_set1_ps(1e-3f);
+			const __m256 one = _mm256_set1_ps(1.0f);
+			const __m256 zero = _mm256_setzero_ps();
+
+			size_t i = 0;
+			for (; i + 8 <= n; i += 8) {
+				const __m256 v = _mm256_loadu_ps(v_f + i);
+				const __m256 dv = _mm256_sub_ps(v, _mm256_loadu_ps(v_l + i));
+
+				const __m256 braking_add = _mm256_max_ps(zero, _mm256_mul_ps(_mm256_mul_ps(v, dv), inv_root));
+				const __m256 s_star = _mm256_add_ps(_mm256_add_ps(s0, _mm256_mul_ps(v, t_headway)), braking_add);
+
+				const __m256 x = _mm256_mul_ps(v, inv_v0);
+				const __m256 x2 = _mm256_mul_ps(x, x);
+				const __m256 r = _mm256_div_ps(s_star, _mm256_max_ps(min_gap, _mm256_loadu_ps(gap + i)));
+
+				const __m256 term = _mm256_sub_ps(_mm256_sub_ps(one, _mm256_mul_ps(x2, x2)), _mm256_mul_ps(r, r));
+				const __m256 a = _mm256_mul_ps(a_max, term);
+
+				// a < -b_comf ? max(a, -b_hard) : a
+				const __m256 hard = _mm256_cmp_ps(a, neg_b_comf, _CMP_LT_OQ);
+				_mm256_storeu_ps(out + i, _mm256_blendv_ps(a, _mm256_max_ps(a, neg_b_hard), hard));
+			}
+			// avoid the AVX→SSE transition penalty in the non-VEX tail
+			_mm256_zeroupper();
+			batch_scalar(v_f, v_l, gap, out, n, i, c);
+		}
+
+		bool cpu_has_avx2() noexcept {
+#if defined(_MSC_VER)
+			int info[4] = {};
+			__cpuid(info, 1);
+			const bool os_avx = (info[2] & (1 << 27)) && (info[2] & (1 << 28)) && ((_xgetbv(0) & 0x6) == 0x6);
+			if (!os_avx) {
+				return false;
+			}
+			__cpuidex(info, 7, 0);
+			return (info[1] & (1 << 5)) != 0;
+#else
+			return __builtin_cpu_supports("avx2");
+#endif
+		}
+#endif
+	} // namespace
+
+	void build_leader_inputs(LaneSoA& lane, size_t first, size_t n) noexcept {
+		if (n == 0) {
+			return;
+		}
+
+		const float* s = lane.s_on_lane.data() + first;
+		const float* v = lane.v_follower.data() + first;
+		const float* len = lane.length.data() + first;
+		float* v_leader = lane.v_leader.data() + first;
+		float* s_gap = lane.s_gap.data() + first;
+
+		v_leader[0] = v[0];
+		s_gap[0] = FREE_ROAD_GAP;
+
+		// plain loop, vectorised by the compiler
+		for (size_t k = 1; k < n; ++k) {
+			v_leader[k] = v[k];
+			s_gap[k] = std::max(0.0f, (s[k - 1] - s[k]) - 0.5f * (len[k - 1] + len[k]));
+		}
+	}
+
+	KernelIsa best_kernel_isa() noexcept {
+#if TJS_IDM_X86
+		static const KernelIsa isa = cpu_has_avx2() ? KernelIsa::AVX2 : KernelIsa::SSE;
+		return isa;
+#else
+		return KernelIsa::Scalar;
+#endif
+	}
+
+	const char* to_string(KernelIsa isa) noexcept {
+		switch (isa) {
+			case KernelIsa::AVX2:
+				return "avx2";
+			case KernelIsa::SSE:
+				return "sse";
+			default:
+				return "scalar";
+		}
+	}
+
+	void idm_accel_batch(
+		const float* v_follower,
+		const float* v_leader,
+		const float* s_gap,
+		float* out,
+		size_t n,
+		const idm_params_t& p,
+		KernelIsa isa) noexcept {
+		// Packed kernels are specialised for the standard exponent only
+		if (p.delta != 4.0f) {
+			for (size_t i = 0; i < n; ++i) {
+				out[i] = idm_scalar(v_follower[i], v_leader[i], s_gap[i], p);
+			}
+			return;
+		}
+
+		const BatchConstants c(p);
+		if (isa > best_kernel_isa()) {
+			isa = best_kernel_isa();
+		}
+
+		switch (isa) {
+#if TJS_IDM_X86
+			case KernelIsa::AVX2:
+				batch_avx2(v_follower, v_leader, s_gap, out, n, c);
+				break;
+			case KernelIsa::SSE:
+				batch_sse(v_follower, v_leader, s_gap, out, n, c);
+				break;
+#endif
+			default:
+				batch_scalar(v_follower, v_leader, s_gap, out, n, 0, c);
+				break;
+		}
+	}
+} // namespace tjs::core::simulation::idm
@@ -59,15 +59,15 @@ namespace tjs::core::simulation {
 
 		double dt = _system.timeModule().state().fixed_dt();
 
-		idm::phase1_simd(_system, agents, lane_rt, dt);
+		idm::phase1_simd(_system, lane_rt, dt);
 		idm::phase2_commit(_system, agents, lane_rt, dt);
 
 		for (size_t i = 0; i < vs.vehicles().size(); ++i) {
 			Vehicle& v = *vs.vehicles()[i];
-			if (v.has_position_changes && v.current_lane) {
-				v.has_position_changes = false;
-				v.coordinates = lane_position(*v.current_lane, v.s_on_lane, v.lateral_offset);
-				v.rotationAngle = v.current_lane->rotation_angle;
+			if (v.has_position_changes() && v.current_lane) {
+				v.has_position_changes() = false;
+				v.coordinates() = lane_position(*v.current_lane, v.s_on_lane(), v.lateral_offset());
+				v.rotationAngle() = v.current_lane->rotation_angle;
 			}
 		}
 	}
@@ -36,13 +36,10 @@ namespace tjs::core::simulation::idm {
 		const float len_new,
 		const idm::idm_params_t& p,
 		const double dt) {
-		const auto& idx = tgt_rt.idx; // descending s_curr
+		const auto& idx = tgt_rt.idx; // descending s_curr, may hold holes
 
 		// Find insertion point (same as before)
-		auto it = std::lower_bound(idx.begin(), idx.end(), s_new,
-			[&](Vehicle* vehicle, double pos) {
-				return vehicle->s_on_lane > pos;
-			});
+		const std::size_t pos = lane_position(idx, s_new);
 
 		auto enough_gap_and_brake = [&](float gap,
 										float v_follow,
@@ -72,25 +69,23 @@ namespace tjs::core::simulation::idm {
 		};
 
 		/* ---------- leader gap ------------------------------------------------- */
-		if (it != idx.begin()) {
-			Vehicle* j_lead = *(it - 1);
-			float gap = idm::actual_gap(static_cast<float>(j_lead->s_on_lane),
+		if (Vehicle* j_lead = lane_ahead(idx, pos)) {
+			float gap = idm::actual_gap(static_cast<float>(j_lead->s_on_lane()),
 				static_cast<float>(s_new),
-				j_lead->length, len_new);
+				j_lead->length(), len_new);
 			if (!enough_gap_and_brake(gap, /* follower = newcomer */
-					newcomer_speed, j_lead->currentSpeed)) {
+					newcomer_speed, j_lead->currentSpeed())) {
 				return false;
 			}
 		}
 
 		/* ---------- follower (vehicle behind newcomer) ------------------------- */
-		if (it != idx.end()) {
-			Vehicle* j_follow = *it;
+		if (Vehicle* j_follow = lane_behind(idx, pos)) {
 			float gap = idm::actual_gap(static_cast<float>(s_new),
-				static_cast<float>(j_follow->s_on_lane),
-				len_new, j_follow->length);
+				static_cast<float>(j_follow->s_on_lane()),
+				len_new, j_follow->length());
 			if (!enough_gap_and_brake(gap, /* follower behind */
-					j_follow->currentSpeed, newcomer_speed)) {
+					j_follow->currentSpeed(), newcomer_speed)) {
 				return false;
 			}
 		}
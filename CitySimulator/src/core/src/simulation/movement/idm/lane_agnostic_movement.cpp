@@ -2,6 +2,7 @@
 
 #include <core/simulation/movement/idm/lane_agnostic_movement.h>
 #include <core/simulation/movement/idm/idm_utils.h>
+#include <core/simulation/movement/idm/idm_kernel.h>
 
 #include <core/simulation/movement/movement_utils.h>
 
@@ -12,6 +13,8 @@
 #include <core/data_layer/lane.h>
 #include <core/data_layer/edge.h>
 #include <core/data_layer/vehicle.h>
+#include <core/data_layer/road_network.h>
+#include <core/data_layer/world_data.h>
 
 #include <core/simulation/agent/agent_data.h>
 #include <core/simulation/simulation_system.h>
@@ -50,140 +53,51 @@ namespace tjs::core::simulation {
 		}
 
 		void move_index(Vehicle* vehicle_ptr,
-			std::vector<LaneRuntime>& lane_rt,
+			VehicleSystem& vehicles,
 			const Lane* src,
-			const Lane* tgt,
-			bool shadow) {
+			const Lane* tgt) {
 			// nothing to do
 			if (src == tgt) {
 				return;
 			}
 
-			auto& v_src = lane_rt[src->index_in_buffer].idx;
-			auto& v_tgt = lane_rt[tgt->index_in_buffer].idx;
-
-			/* ---- 1. O(1) erase from source by swap-and-pop ---------------- */
-			if (!shadow) {
-				const auto it = std::find(v_src.begin(), v_src.end(), vehicle_ptr);
-				if (it != v_src.end()) {
-					Vehicle* moved = v_src.back();
-					// it's not the last element
-					const bool need_reinsert = !v_src.empty() && (it != v_src.end() - 1);
-
-					*it = moved;
-					v_src.pop_back();
-
-					// … but now the element that was at the tail sits at *it* and may
-					// violate descending order.  Re‑insert it where it belongs.
-					if (!v_src.empty() && need_reinsert) {
-						auto correct = std::upper_bound(
-							v_src.begin(), v_src.end(), moved,
-							[&](Vehicle* lhs, Vehicle* rhs) {
-								return lhs->s_on_lane > rhs->s_on_lane; // descending
-							});
-
-						// Rotate [first, middle, last): moves *it* to `correct` with O(distance)
-						if (correct < it) {
-							std::rotate(correct, it, it + 1);
-						} else if (correct > it) {
-							std::rotate(it, it + 1, correct);
-						}
-					}
-				}
-			}
-
-			/* ---- 2. O(log N) insert into target, keep sorted -------------- */
-			if (std::ranges::find(v_tgt, vehicle_ptr) == v_tgt.end()) {
-				const double s = vehicle_ptr->s_on_lane;
-				auto it_ins = std::lower_bound(
-					v_tgt.begin(), v_tgt.end(), s,
-					[&](Vehicle* j, double pos) {
-						return j->s_on_lane > pos;
-					});
-
-				v_tgt.insert(it_ins, vehicle_ptr);
-			}
+			// stored position in the source, sorted insert into the target
+			lane_erase(vehicles.lane_runtime(*src), vehicle_ptr);
+			lane_insert(vehicles.lane_runtime(*tgt), vehicle_ptr);
 		}
 
-		Lane* choose_entry_lane(const Lane* src_lane, const Edge* next_edge, VehicleMovementError& err) {
-			Lane* best = nullptr;
-			bool best_is_yield = true; // so non-yield wins
-			int best_shift = INT_MAX;  // minimise |Δlane|
-
-			const std::size_t src_idx = src_lane->index_in_edge; // local index in its edge
-			err = VehicleMovementError::ER_NO_ERROR;
-			for (const LaneLinkHandler& h : src_lane->outgoing_connections) {
-				const LaneLink& link = *h;
-				Lane* tgt = link.to;
-				// wrong edge
-				if (!tgt || tgt->parent != next_edge) {
-					continue;
-				}
-
-				bool is_yield = link.yield;
-				int shift = std::abs(int(tgt->index_in_edge) - int(src_idx));
-
-				if (!best || (best_is_yield && !is_yield) || (is_yield == best_is_yield && shift < best_shift)) {
-					best = tgt;
-					best_is_yield = is_yield;
-					best_shift = shift;
-				}
-			}
-
+		Lane* choose_entry_lane(const RoadNetwork& network, const Lane* src_lane, const Edge* next_edge, VehicleMovementError& err) {
 			if (src_lane->outgoing_connections.empty()) {
 				err = VehicleMovementError::ER_NO_OUTGOING_CONNECTION;
 				return nullptr;
 			}
-			if (!best) {
-				bool has_connection = false;
-				for (auto& lane : src_lane->parent->lanes) {
-					if (&lane == src_lane) {
-						continue;
-					}
-					for (auto& link : lane.outgoing_connections) {
-						if (link->to->parent == next_edge) {
-							has_connection = true;
-							break;
-						}
-					}
-					if (has_connection) {
-						break;
-					}
-				}
 
-				// If has connection we are on the wrong lane, if not - totally wrong edge (how we get here?)
-				err = has_connection ? VehicleMovementError::ER_INCORRECT_LANE : VehicleMovementError::ER_INCORRECT_EDGE;
-				// TODO[simulation]: algo error handling
-				//throw std::runtime_error(
-				//	"Route impossible: no LaneLink from edge " + std::to_string(src_lane->parent->get_id()) + " to edge " + std::to_string(next_edge->get_id()) + '.');
-				return src_lane->outgoing_connections[0]->to;
+			const uint32_t slot = network.transition_slot(*src_lane->parent, *next_edge);
+			if (slot != RoadNetwork::NO_TRANSITION) {
+				if (Lane* entry = network.lane_entry(*src_lane, slot).lane) {
+					err = VehicleMovementError::ER_NO_ERROR;
+					return entry;
+				}
 			}
-			err = VehicleMovementError::ER_NO_ERROR;
-			return best;
+
+			// If another lane links there we are on the wrong lane, if not - totally wrong edge (how we get here?)
+			err = slot != RoadNetwork::NO_TRANSITION ? VehicleMovementError::ER_INCORRECT_LANE : VehicleMovementError::ER_INCORRECT_EDGE;
+			// TODO[simulation]: algo error handling
+			//throw std::runtime_error(
+			//	"Route impossible: no LaneLink from edge " + std::to_string(src_lane->parent->get_id()) + " to edge " + std::to_string(next_edge->get_id()) + '.');
+			return src_lane->outgoing_connections[0]->to;
 		}
 
 		inline Vehicle* tgt_leader(const std::vector<Vehicle*>& idx, const Vehicle& self_v) {
-			auto it = std::lower_bound(idx.begin(), idx.end(), self_v.s_on_lane,
-				[&self_v](const Vehicle* v, double pos) {
-					return v->s_on_lane > pos;
-				});
-			return (it != idx.begin()) ? *(it - 1) : nullptr;
+			return lane_ahead(idx, lane_position(idx, self_v.s_on_lane()));
 		}
 		inline Vehicle* tgt_follower(const std::vector<Vehicle*>& idx, const Vehicle& self_v) {
-			auto it = std::lower_bound(idx.begin(), idx.end(), self_v.s_on_lane,
-				[](const Vehicle* v, double pos) {
-					return v->s_on_lane > pos;
-				});
-
-			if (it == idx.end()) {
-				return nullptr;
-			}
-
-			if (*it == &self_v) {
-				++it;
+			for (std::size_t pos = lane_position(idx, self_v.s_on_lane()); pos < idx.size(); ++pos) {
+				if (idx[pos] != nullptr && idx[pos] != &self_v) {
+					return idx[pos];
+				}
 			}
-
-			return (it != idx.end()) ? *it : nullptr;
+			return nullptr;
 		}
 
 		// Returns nearest set bit to curr_idx within [0, lanes_count).
@@ -225,245 +139,348 @@ namespace tjs::core::simulation {
 			return -1; // should not happen if mask!=0 and lanes_count>0
 		}
 
-		void phase1_simd(
-			TrafficSimulationSystem& system,
-			const std::vector<AgentData*>& agents,
+		// Phase 1 write-ownership rules (what makes the lane-parallel pass safe):
+		//  • a lane task only writes vehicles listed in its own `idx` and not merging
+		//    into it, so each vehicle is written by exactly one task;
+		//  • kinematics (v_next, s_next) and per-vehicle bookkeeping
+		//    (cooperation_vehicle, action_time) are written in place;
+		//  • `state` and `lane_target` are also read from *other* vehicles (the
+		//    cooperation partner), so they are computed on a local copy and queued
+		//    in a per-worker buffer that is applied after the join. Every task
+		//    therefore observes the state of the previous step, whatever the
+		//    thread count or scheduling order.
+		// This differs from the former serial loop, which wrote both in place: a
+		// vehicle scanned after its cooperation partner saw the partner's new
+		// state (e.g. ST_PREPARE) in the same step, now it sees it one step later.
+		struct Phase1Pending {
+			Vehicle* vehicle;
+			uint16_t state;
+			Lane* lane_target;
+		};
+
+		struct Phase1Scratch {
+			std::vector<std::pair<size_t, size_t>> chunks; // [begin, end) lane ranges
+			std::vector<std::vector<Phase1Pending>> pending;
+			std::vector<LaneSoA> soa; // packed car-following inputs, one per worker
+		};
+
+		static void split_lanes(const std::vector<LaneRuntime>& lane_rt, const size_t workers, std::vector<std::pair<size_t, size_t>>& chunks) {
+			chunks.clear();
+
+			size_t total = 0;
+			for (const LaneRuntime& rt : lane_rt) {
+				total += rt.idx.size() + 1; // +1 so empty lanes still weigh something
+			}
+
+			// a few chunks per worker to smooth out uneven lanes
+			const size_t chunks_count = workers == 1 ? 1 : workers * 4;
+			const size_t per_chunk = std::max<size_t>(1, total / chunks_count);
+
+			size_t begin = 0;
+			size_t weight = 0;
+			for (size_t L = 0; L < lane_rt.size(); ++L) {
+				weight += lane_rt[L].idx.size() + 1;
+				if (weight >= per_chunk) {
+					chunks.emplace_back(begin, L + 1);
+					begin = L + 1;
+					weight = 0;
+				}
+			}
+			if (begin < lane_rt.size()) {
+				chunks.emplace_back(begin, lane_rt.size());
+			}
+		}
+
+		// 1. Car-following for a whole chunk: gather its lanes into one packed batch
+		//    (lanes are short, so a per-lane batch would rarely fill a vector) and
+		//    run the vector kernel once.
+		static void phase1_car_following(
 			const std::vector<LaneRuntime>& lane_rt,
-			const double dt) {
-			TJS_TRACY_NAMED("VehicleMovement::IDM::Phase1");
+			const VehicleSystem& vehicles,
+			const VehicleStore& store,
+			const std::size_t begin,
+			const std::size_t end,
+			const idm_params_t& idm_def,
+			LaneSoA& soa) {
+			std::size_t total = 0;
+			for (std::size_t L = begin; L < end; ++L) {
+				total += lane_rt[L].idx.size();
+			}
+			soa.resize(total);
+
+			std::size_t offset = 0;
+			for (std::size_t L = begin; L < end; ++L) {
+				const auto& idx = lane_rt[L].idx;
+				for (std::size_t k = 0; k < idx.size(); ++k) {
+					const uint32_t row = idx[k]->row;
+					soa.s_on_lane[offset + k] = static_cast<float>(store.s_on_lane[row]);
+					soa.v_follower[offset + k] = store.speed[row];
+					soa.length[offset + k] = store.length[row];
+				}
+				build_leader_inputs(soa, offset, idx.size());
 
-			static constexpr float D_PREP_PER_LANE = 60.0f; // extra [m] per missing lane
-			static constexpr float D_PREP = 80.0f;          // distance to start lane‑prep [m]
-			static constexpr float T_MIN = 1.5f;            // cool‑down expiry threshold [s]
+				// crossing vehicles also follow the leader of their target lane
+				for (std::size_t k = 0; k < idx.size(); ++k) {
+					const Vehicle* vehicle = idx[k];
+					if (!VehicleStateBitsV::has_info(store.state[vehicle->row], VehicleStateBits::ST_CROSS) || vehicle->lane_target == nullptr) {
+						continue;
+					}
+
+					const auto& tgt_rt = vehicles.lane_runtime(*vehicle->lane_target);
+					auto tgt_lead = tgt_leader(tgt_rt.idx, *vehicle);
+					if (tgt_lead != nullptr) {
+						const std::size_t i = offset + k;
+						soa.v_leader[i] = std::min(soa.v_leader[i], tgt_lead->currentSpeed());
+						soa.s_gap[i] = std::min(
+							soa.s_gap[i],
+							idm::actual_gap(tgt_lead->s_on_lane(), soa.s_on_lane[i], tgt_lead->length(), tgt_lead->length()));
+					}
+				}
+				offset += idx.size();
+			}
+
+			idm_accel_batch(soa, total, idm_def);
+		}
 
+		static void phase1_lane(
+			TrafficSimulationSystem& system,
+			const LaneRuntime& rt,
+			VehicleStore& store,
+			const idm_params_t& idm_def,
+			const double dt,
+			const LaneSoA& soa,
+			const std::size_t offset, // first packed row of this lane
+			std::vector<Phase1Pending>& pending) {
 #if TJS_SIMULATION_DEBUG
 			auto& debug = system.settings().debug_data;
 #endif
 
-			idm::idm_params_t idm_def {}; // default calibrated parameters
+			const auto& idx = rt.idx; // sorted front→rear vehicle pointers
+			const std::size_t n = idx.size();
+			VehicleSystem& vehicles = system.vehicle_system();
 
-			/* threaded outer loop over lanes (keep free to add OpenMP/TBB) */
-			// #pragma omp parallel for schedule(dynamic,4)
-			for (std::size_t L = 0; L < lane_rt.size(); ++L) {
-				const LaneRuntime& rt = lane_rt[L];
-				const auto& idx = rt.idx; // sorted rear→front vehicle pointers
-				const std::size_t n = idx.size();
+			TJS_BREAK_IF(
+				debug.movement_phase == SimulationMovementPhase::IDM_Phase1_Lane
+				&& debug.lane_id == static_cast<size_t>(rt.static_lane->get_id()));
 
-				TJS_BREAK_IF(
-					debug.movement_phase == SimulationMovementPhase::IDM_Phase1_Lane
-					&& debug.lane_id == rt.static_lane->get_id());
-
-				// ---------------------------------------------------------------------
-				// Scalar inner loop – one follower row at a time (will become gather/SIMD)
-				// ---------------------------------------------------------------------
-				for (std::size_t k = 0; k < n; ++k) {
-					Vehicle* vehicle = idx[k]; // follower vehicle pointer
-
-					TJS_BREAK_IF(
-						debug.movement_phase == SimulationMovementPhase::IDM_Phase1_Vehicle
-						&& debug.lane_id == rt.static_lane->get_id()
-						&& debug.vehicle_indices.size() == 1
-						&& k == debug.vehicle_indices[0]);
-
-					// Skip broken cars
-					if (VehicleStateBitsV::has_info(vehicle->state, VehicleStateBits::FL_ERROR)) {
-						continue;
-					}
+			// ---------------------------------------------------------------------
+			// Per-vehicle decisions – cooperation, lane change, cool-down
+			// ---------------------------------------------------------------------
+			for (std::size_t k = 0; k < n; ++k) {
+				Vehicle* vehicle = idx[k]; // follower vehicle pointer
+				const uint32_t row = vehicle->row;
 
-					if (vehicle->is_merging(*rt.static_lane)) {
-						continue;
-					}
-
-					// ─── 1. Gather follower state ────────────────────────────────────
-					const float s_f = static_cast<float>(vehicle->s_on_lane); // [m]
-					const float v_f = vehicle->currentSpeed;                  // [m/s]
-					const float l_f = vehicle->length;                        // bumper‑to‑bumper length [m]
-
-					// ─── 1b. Gather leader state (if any) ────────────────────────────
-					float s_gap = 1e9f;   // sentinel = "free road"
-					float v_leader = v_f; // same speed → Δv = 0
+				TJS_BREAK_IF(
+					debug.movement_phase == SimulationMovementPhase::IDM_Phase1_Vehicle
+					&& debug.lane_id == static_cast<size_t>(rt.static_lane->get_id())
+					&& debug.vehicle_indices.size() == 1
+					&& k == debug.vehicle_indices[0]);
+
+				// Skip broken cars
+				const uint16_t current_state = store.state[row];
+				if (VehicleStateBitsV::has_info(current_state, VehicleStateBits::FL_ERROR)) {
+					continue;
+				}
 
-					if (debug.agent_id == vehicle->uid) {
-						std::cout << "";
-					}
+				if (vehicle->is_merging(*rt.static_lane)) {
+					continue;
+				}
 
-					// Find leader in current lane (or check it in coherent lane)
-					if (k > 0) {
-						Vehicle* leader = idx[k - 1];
-						if (debug.agent_id == vehicle->uid) {
-							std::cout << "";
+				// Shared fields are committed after the join (see ownership rules above)
+				uint16_t state = current_state;
+				Lane* lane_target = vehicle->lane_target;
+
+				const float s_f = soa.s_on_lane[offset + k];  // [m]
+				const float v_f = soa.v_follower[offset + k]; // [m/s]
+
+				// try to pass vehicle
+				float a_cooperative = std::numeric_limits<float>::max();
+				if (idm_def.is_cooperating
+					&& VehicleStateBitsV::has_info(state, VehicleStateBits::ST_FOLLOW)
+					&& !VehicleStateBitsV::has_info(state, VehicleStateBits::FL_COOLDOWN)) {
+					if (!vehicle->cooperation_vehicle) {
+						for (auto it_slot = rt.vehicle_slots.rbegin(); it_slot != rt.vehicle_slots.rend(); ++it_slot) {
+							float gg = (*it_slot)->s_on_lane() - s_f;
+							if (gg > 15.0f) {
+								break;
+							}
+							if (gg > 0.0f) {
+								vehicle->cooperation_vehicle = (*it_slot)->handle;
+								vehicle->action_time = 0.0;
+								break;
+							}
 						}
-						s_gap = idm::actual_gap(leader->s_on_lane, s_f, leader->length, l_f);
 					}
+				} else {
+					vehicle->cooperation_vehicle.reset();
+				}
 
-					// try to pass vehicle
-					float a_cooperative = std::numeric_limits<float>::max();
-					if (idm_def.is_cooperating
-						&& VehicleStateBitsV::has_info(vehicle->state, VehicleStateBits::ST_FOLLOW)
-						&& !VehicleStateBitsV::has_info(vehicle->state, VehicleStateBits::FL_COOLDOWN)) {
-						if (vehicle->cooperation_vehicle == nullptr) {
-							for (auto it_slot = rt.vehicle_slots.rbegin(); it_slot != rt.vehicle_slots.rend(); ++it_slot) {
-								float gg = (*it_slot)->s_on_lane - s_f;
-								if (gg > 15.0f) {
-									break;
-								}
-								if (gg > 0.0f) {
-									vehicle->cooperation_vehicle = *it_slot;
-									vehicle->action_time = 0.0;
-									break;
-								}
-							}
-						}
+				if (vehicle->cooperation_vehicle) {
+					const Vehicle* merging = vehicles.get(vehicle->cooperation_vehicle);
+					// reset cooperation vehicle if it is gone, not merging in our lane or not in prepare state
+					if (merging == nullptr || !VehicleStateBitsV::has_info(merging->state(), VehicleStateBits::ST_PREPARE) || merging->lane_target != rt.static_lane) {
+						vehicle->cooperation_vehicle.reset();
 					} else {
-						vehicle->cooperation_vehicle = nullptr;
+						vehicle->action_time += dt;
+						if (vehicle->action_time >= idm_def.t_max_coop_time) {
+							vehicle->cooperation_vehicle.reset();
+							vehicle->action_time = 0.0;
+							VehicleStateBitsV::set_info(state, VehicleStateBits::FL_COOLDOWN, VehicleStateBitsDivision::FLAGS);
+						} else {
+							float merging_gap = idm::actual_gap(
+								merging->s_on_lane(), s_f, merging->length(), merging->length());
+							a_cooperative = idm::idm_scalar(v_f, merging->currentSpeed(), merging_gap, idm_def);
+							a_cooperative = std::max(a_cooperative, -idm_def.a_coop_max);
+						}
 					}
+				}
 
-					if (vehicle->cooperation_vehicle != nullptr) {
-						// reset cooperation vehicle if it is not merging in our lane or not in prepare state
-						if (!VehicleStateBitsV::has_info(vehicle->cooperation_vehicle->state, VehicleStateBits::ST_PREPARE) || vehicle->cooperation_vehicle->lane_target != rt.static_lane) {
-							vehicle->cooperation_vehicle = nullptr;
-						} else {
-							vehicle->action_time += dt;
-							if (vehicle->action_time >= idm_def.t_max_coop_time) {
-								vehicle->cooperation_vehicle = nullptr;
+				// ─── 2. IDM acceleration (from the batch kernel) ────────────────
+				const float a = std::max(-idm_def.b_hard, std::min(soa.accel[offset + k], a_cooperative)); // clamp by hard brake
+
+				// ─── 3. Kinematics update (Euler forward) ────────────────────────
+				const float v_next = std::clamp(v_f + a * static_cast<float>(dt), 0.0f, rt.max_speed + idm_def.v_limits_violate);
+				store.v_next[row] = v_next;
+				store.s_next[row] = s_f + v_f * dt + 0.5f * a * static_cast<float>(dt * dt);
+
+				// ─── 4. Lane‑change decision (unchanged, but uses new kinematics) ─
+				const float dist_to_node = rt.length - s_f;
+
+				const uint16_t change_state = static_cast<int>(VehicleStateBits::ST_PREPARE) | static_cast<int>(VehicleStateBits::ST_CROSS) | static_cast<int>(VehicleStateBits::ST_ALIGN);
+				if (!VehicleStateBitsV::has_any(state, change_state, VehicleStateBitsDivision::STATE)) {
+					const int curr_idx = rt.static_lane->index_in_edge; // 0 = right-most
+					const int lanes_cnt = static_cast<int>(rt.static_lane->parent->lanes.size());
+					const uint32_t mask = vehicle->goal_lane_mask;
+					const int goal_idx = nearest_goal_idx(mask, curr_idx, lanes_cnt);
+
+					if (goal_idx >= 0 && goal_idx != curr_idx && !VehicleStateBitsV::has_info(state, VehicleStateBits::FL_COOLDOWN)) {
+						const int lanes_delta = goal_idx - curr_idx; // +ve ⇒ need to go LEFT
+						// preparation for one lane and extra 0.8 for each lane above 1
+						const float prep = idm_def.s_preparation + (std::abs(lanes_delta) - 1) * idm_def.s_preparation * 0.8f;
+
+						if (dist_to_node < prep) {
+							Lane* neigh = (lanes_delta > 0) ? rt.static_lane->left() : rt.static_lane->right();
+							if (neigh) {
+								lane_target = neigh; // step one lane toward goal
+								VehicleStateBitsV::set_info(state, VehicleStateBits::ST_PREPARE, VehicleStateBitsDivision::STATE);
 								vehicle->action_time = 0.0;
-								VehicleStateBitsV::set_info(vehicle->state, VehicleStateBits::FL_COOLDOWN, VehicleStateBitsDivision::FLAGS);
-							} else {
-								float merging_gap = idm::actual_gap(
-									vehicle->cooperation_vehicle->s_on_lane, s_f, vehicle->cooperation_vehicle->length, vehicle->cooperation_vehicle->length);
-								a_cooperative = idm::idm_scalar(v_f, vehicle->cooperation_vehicle->currentSpeed, merging_gap, idm_def);
-								a_cooperative = std::max(a_cooperative, -idm_def.a_coop_max);
 							}
 						}
 					}
+				}
 
-					// check for leader in target lane
-					if (
-						VehicleStateBitsV::has_info(vehicle->state, VehicleStateBits::ST_CROSS)
-						&& vehicle->lane_target != nullptr) {
-						const auto& tgt_rt = lane_rt[vehicle->lane_target->index_in_buffer];
-						auto tgt_lead = tgt_leader(tgt_rt.idx, *vehicle);
-						if (tgt_lead != nullptr) {
-							v_leader = std::min(v_leader, tgt_lead->currentSpeed);
-
-							s_gap = std::min(
-								s_gap,
-								idm::actual_gap(tgt_lead->s_on_lane, s_f, tgt_lead->length, tgt_lead->length));
-						}
+				// ─── 5. Cool‑down bookkeeping (unchanged) ────────────────────────
+				if (VehicleStateBitsV::has_info(state, VehicleStateBits::FL_COOLDOWN)) {
+					vehicle->action_time += dt;
+					if (vehicle->action_time > idm_def.t_cooldown) {
+						VehicleStateBitsV::remove_info(state, VehicleStateBits::FL_COOLDOWN, VehicleStateBitsDivision::FLAGS);
+						vehicle->action_time = 0.0f;
 					}
+				}
 
-					// ─── 2. IDM acceleration ────────────────────────────────────────
-					const float a_self = idm::idm_scalar(v_f, v_leader, s_gap, idm_def);
-					const float a = std::max(-idm_def.b_hard, std::min(a_self, a_cooperative)); // clamp by hard brake
+				if (state != current_state || lane_target != vehicle->lane_target) {
+					pending.push_back(Phase1Pending { vehicle, state, lane_target });
+				}
+			}
+		}
 
-					// ─── 3. Kinematics update (Euler forward) ────────────────────────
-					const float v_next = std::clamp(v_f + a * static_cast<float>(dt), 0.0f, rt.max_speed + idm_def.v_limits_violate);
-					vehicle->v_next = v_next;
-					vehicle->s_next = s_f + v_f * dt + 0.5f * a * static_cast<float>(dt * dt);
+		void phase1_simd(
+			TrafficSimulationSystem& system,
+			const std::vector<LaneRuntime>& lane_rt,
+			const double dt) {
+			TJS_TRACY_NAMED("VehicleMovement::IDM::Phase1");
 
-					if (debug.agent_id == vehicle->uid && vehicle->v_next < vehicle->currentSpeed) {
-						std::cout << "";
-					}
+			static const idm::idm_params_t idm_def {}; // default calibrated parameters
+			static thread_local Phase1Scratch tls_scratch;
+			// workers must see the caller's buffers, not their own thread_local copy
+			Phase1Scratch& scratch = tls_scratch;
 
-					// ─── 4. Lane‑change decision (unchanged, but uses new kinematics) ─
-					const float dist_to_node = rt.length - s_f;
-
-					const uint16_t change_state = static_cast<int>(VehicleStateBits::ST_PREPARE) | static_cast<int>(VehicleStateBits::ST_CROSS) | static_cast<int>(VehicleStateBits::ST_ALIGN);
-					if (!VehicleStateBitsV::has_any(vehicle->state, change_state, VehicleStateBitsDivision::STATE)) {
-						const int curr_idx = rt.static_lane->index_in_edge; // 0 = right-most
-						const int lanes_cnt = static_cast<int>(rt.static_lane->parent->lanes.size());
-						const uint32_t mask = vehicle->goal_lane_mask;
-						const int goal_idx = nearest_goal_idx(mask, curr_idx, lanes_cnt);
-
-						if (goal_idx >= 0 && goal_idx != curr_idx && !VehicleStateBitsV::has_info(vehicle->state, VehicleStateBits::FL_COOLDOWN)) {
-							const int lanes_delta = goal_idx - curr_idx; // +ve ⇒ need to go LEFT
-							// preparation for one lane and extra 0.8 for each lane above 1
-							const float prep = idm_def.s_preparation + (std::abs(lanes_delta) - 1) * idm_def.s_preparation * 0.8f;
-
-							if (dist_to_node < prep) {
-								Lane* neigh = (lanes_delta > 0) ? rt.static_lane->left() : rt.static_lane->right();
-								if (neigh) {
-									if (vehicle->current_lane->get_id() == 28 && neigh->get_id() == 5) {
-										std::cout << "";
-									}
-									vehicle->lane_target = neigh; // step one lane toward goal
-									VehicleStateBitsV::set_info(vehicle->state, VehicleStateBits::ST_PREPARE, VehicleStateBitsDivision::STATE);
-									vehicle->action_time = 0.0;
-								}
-							}
-						}
-					}
+			auto& pool = system.worker_pool();
+			VehicleStore& store = system.vehicle_system().store();
+			split_lanes(lane_rt, pool.size(), scratch.chunks);
 
-					// ─── 5. Cool‑down bookkeeping (unchanged) ────────────────────────
-					if (VehicleStateBitsV::has_info(vehicle->state, VehicleStateBits::FL_COOLDOWN)) {
-						vehicle->action_time += dt;
-						if (vehicle->action_time > idm_def.t_cooldown) {
-							VehicleStateBitsV::remove_info(vehicle->state, VehicleStateBits::FL_COOLDOWN, VehicleStateBitsDivision::FLAGS);
-							vehicle->action_time = 0.0f;
-						}
-					}
+			scratch.pending.resize(pool.size());
+			scratch.soa.resize(pool.size());
+			for (auto& pending : scratch.pending) {
+				pending.clear();
+			}
+
+			/* threaded outer loop over lane chunks */
+			pool.parallel_for(scratch.chunks.size(), [&](size_t chunk, size_t worker) {
+				const auto [begin, end] = scratch.chunks[chunk];
+				auto& pending = scratch.pending[worker];
+				auto& soa = scratch.soa[worker];
+
+				phase1_car_following(lane_rt, system.vehicle_system(), store, begin, end, idm_def, soa);
+
+				std::size_t offset = 0;
+				for (std::size_t L = begin; L < end; ++L) {
+					phase1_lane(system, lane_rt[L], store, idm_def, dt, soa, offset, pending);
+					offset += lane_rt[L].idx.size();
+				}
+			});
+
+			// every vehicle is queued at most once, so the apply order does not matter
+			for (const auto& pending : scratch.pending) {
+				for (const Phase1Pending& p : pending) {
+					p.vehicle->state() = p.state;
+					p.vehicle->lane_target = p.lane_target;
 				}
 			}
 		}
 
 		bool check_can_switch(
-			const std::vector<LaneRuntime>& lane_rt,
+			const VehicleSystem& vehicles,
 			const Lane* tgt,
 			Vehicle* vehicle,
 			const idm_params_t& p_idm,
 			bool is_mandatory_switch) {
 			// --- current-lane leader (for a_old) ---
-			const auto& idx_curr = lane_rt[vehicle->current_lane->index_in_buffer].idx;
-			Vehicle* curr_lead = nullptr;
-			if (idx_curr.size() > 1) {
-				auto it = std::find(idx_curr.begin(), idx_curr.end(), vehicle);
-				if (it != idx_curr.begin()) {
-					curr_lead = *(it - 1);
-				}
-			}
+			const auto& idx_curr = vehicles.lane_runtime(*vehicle->current_lane).idx;
+			Vehicle* curr_lead = lane_ahead(idx_curr, vehicle->idx_in_lane);
 			float gap_curr = std::numeric_limits<float>::infinity();
-			float v_lead_curr = vehicle->currentSpeed;
+			float v_lead_curr = vehicle->currentSpeed();
 			if (curr_lead) {
-				gap_curr = idm::actual_gap((float)curr_lead->s_on_lane,
-					(float)vehicle->s_on_lane,
-					curr_lead->length, vehicle->length);
-				v_lead_curr = curr_lead->currentSpeed;
+				gap_curr = idm::actual_gap((float)curr_lead->s_on_lane(),
+					(float)vehicle->s_on_lane(),
+					curr_lead->length(), vehicle->length());
+				v_lead_curr = curr_lead->currentSpeed();
 			}
 
 			// --- target-lane neighbors ---
-			const auto& idx_tgt = lane_rt[tgt->index_in_buffer].idx;
+			const auto& idx_tgt = vehicles.lane_runtime(*tgt).idx;
 			Vehicle* lead = tgt_leader(idx_tgt, *vehicle);
 			Vehicle* foll = tgt_follower(idx_tgt, *vehicle);
 
 			// front gap (ego vs target-lane leader)
 			float gap_front = std::numeric_limits<float>::infinity();
-			float v_lead = vehicle->currentSpeed;
+			float v_lead = vehicle->currentSpeed();
 			if (lead) {
-				gap_front = idm::actual_gap((float)lead->s_on_lane,
-					(float)vehicle->s_on_lane,
-					lead->length, vehicle->length);
-				v_lead = lead->currentSpeed;
+				gap_front = idm::actual_gap((float)lead->s_on_lane(),
+					(float)vehicle->s_on_lane(),
+					lead->length(), vehicle->length());
+				v_lead = lead->currentSpeed();
 			}
 
 			// divide t_headway by coeff to change faster
-			const float req_gap = std::max(p_idm.t_headway * p_idm.t_cross_headway_coeff * vehicle->currentSpeed, p_idm.s0);
+			const float req_gap = std::max(p_idm.t_headway * p_idm.t_cross_headway_coeff * vehicle->currentSpeed(), p_idm.s0);
 			const bool front_ok = (gap_front >= req_gap);
 
 			// rear safety (new follower vs ego as new leader)
 			bool rear_safe = true;
 			if (foll) {
-				const float gap_rear = idm::actual_gap((float)vehicle->s_on_lane,
-					(float)foll->s_on_lane,
-					vehicle->length, foll->length);
-				const float a_after = idm::idm_scalar(foll->currentSpeed,
-					vehicle->currentSpeed,
+				const float gap_rear = idm::actual_gap((float)vehicle->s_on_lane(),
+					(float)foll->s_on_lane(),
+					vehicle->length(), foll->length());
+				const float a_after = idm::idm_scalar(foll->currentSpeed(),
+					vehicle->currentSpeed(),
 					gap_rear, p_idm);
 				rear_safe = (a_after >= -p_idm.b_comf);
 			}
 
 			// --- Benefit / politeness (keep your mandatory override) ---
-			const float a_old = idm::idm_scalar(vehicle->currentSpeed, v_lead_curr, gap_curr, p_idm);
-			const float a_new = idm::idm_scalar(vehicle->currentSpeed, v_lead, gap_front, p_idm);
+			const float a_old = idm::idm_scalar(vehicle->currentSpeed(), v_lead_curr, gap_curr, p_idm);
+			const float a_new = idm::idm_scalar(vehicle->currentSpeed(), v_lead, gap_front, p_idm);
 			const float benefit = a_new - a_old;
 			const bool polite = (is_mandatory_switch && a_new > -(p_idm.b_comf * 2.0f)) || (benefit > p_idm.a_politeness_threshold);
 
@@ -471,21 +488,11 @@ namespace tjs::core::simulation {
 			return ok;
 		}
 
-		void flush_target(Vehicle* v, std::vector<LaneRuntime>& lane_rt) {
+		void flush_target(Vehicle* v, VehicleSystem& vehicles) {
 			if (v->lane_target == nullptr) {
 				return;
 			}
-			auto& rt = lane_rt[v->lane_target->index_in_buffer];
-			auto it = std::ranges::find(rt.idx, v);
-			if (it != rt.idx.end()) {
-				rt.idx.erase(it);
-			}
-
-			auto it_slot = std::ranges::find(rt.vehicle_slots, v);
-			if (it_slot != rt.vehicle_slots.end()) {
-				rt.vehicle_slots.erase(it_slot);
-			}
-
+			slot_erase(vehicles.lane_runtime(*v->lane_target), v);
 			v->lane_target = nullptr;
 		}
 
@@ -501,40 +508,41 @@ namespace tjs::core::simulation {
 			auto& debug = system.settings().debug_data;
 #endif
 
-			// Swap current and next values for all vehicles
-			for (auto agent : agents) {
-				auto& vehicle = *agent->vehicle;
-				vehicle.has_position_changes = vehicle.s_on_lane != vehicle.s_next;
-				vehicle.s_on_lane = vehicle.s_next;
-				vehicle.currentSpeed = vehicle.v_next;
+			VehicleSystem& vehicles = system.vehicle_system();
+
+			// Swap current and next values for all vehicles, column-wise
+			vehicles.store().commit_step();
+			// positions moved, restore the lane order and the stored slots
+			for (LaneRuntime& rt : lane_rt) {
+				lane_resort(rt);
 			}
 
 			static const idm::idm_params_t p_idm {};
+			const RoadNetwork& network = *system.worldData().segments().front()->road_network;
 
 			// Extra structure so first cycle could be constant with indices
 			struct PendingMove {
 				Vehicle* vehicle;
 				Lane* src;
 				Lane* tgt;
-				bool shadow;
 			};
 
 			std::vector<PendingMove> pending_moves;
 			// Suppose that 10% will be moved in one tick
 			pending_moves.reserve(agents.size() / 10);
 
-			/*auto _check = [&lane_rt](const Lane& _lane_s) {
-				auto _lane = lane_rt[_lane_s.index_in_buffer];
+			/*auto _check = [&vehicles](const Lane& _lane_s) {
+				auto _lane = vehicles.lane_runtime(_lane_s);
 				float s = std::numeric_limits<float>::max();
 				for (size_t i = 0; i < _lane.idx.size(); ++i) {
 					auto v = _lane.idx[i];
-					if (VehicleStateBitsV::has_info(v->state, VehicleStateBits::ST_PREPARE)) {
+					if (VehicleStateBitsV::has_info(v->state(), VehicleStateBits::ST_PREPARE)) {
 						continue;
 					}
-					if (v->s_on_lane > s) {
+					if (v->s_on_lane() > s) {
 						return (int)i;
 					}
-					s = v->s_on_lane;
+					s = v->s_on_lane();
 				}
 				return -1;
 			};*/
@@ -547,70 +555,64 @@ namespace tjs::core::simulation {
 						continue;
 					}
 
-					if (VehicleStateBitsV::has_info(vehicle->state, VehicleStateBits::ST_STOPPED)) {
+					if (VehicleStateBitsV::has_info(vehicle->state(), VehicleStateBits::ST_STOPPED)) {
 						continue;
 					}
 
 					Lane* tgt = vehicle->lane_target;
-					if (VehicleStateBitsV::has_info(vehicle->state, VehicleStateBits::ST_PREPARE) && tgt) {
+					if (VehicleStateBitsV::has_info(vehicle->state(), VehicleStateBits::ST_PREPARE) && tgt) {
 						vehicle->action_time += dt;
 						bool ready = vehicle->action_time >= p_idm.t_prepare;
 
-						if (debug.agent_id == vehicle->uid) {
+						if (debug.agent_id == vehicle->uid()) {
 							std::cout << "";
 						}
 
 						// insert shadow
-						if (auto& rt_tgt = lane_rt[tgt->index_in_buffer]; std::ranges::find(rt_tgt.vehicle_slots, vehicle) == rt_tgt.vehicle_slots.end()) {
-							auto it_ins = std::lower_bound(rt_tgt.vehicle_slots.begin(), rt_tgt.vehicle_slots.end(),
-								vehicle->s_on_lane, [](Vehicle* v, float s) {
-									return v->s_on_lane > s;
-								});
-							rt_tgt.vehicle_slots.insert(it_ins, vehicle);
-						}
+						slot_insert(vehicles.lane_runtime(*tgt), vehicle);
 
-						bool can_switch = ready && check_can_switch(lane_rt, tgt, vehicle, p_idm, true);
+						bool can_switch = ready && check_can_switch(vehicles, tgt, vehicle, p_idm, true);
 						if (ready && can_switch) {
-							if (debug.agent_id == vehicle->uid) {
+							if (debug.agent_id == vehicle->uid()) {
 								std::cout << "";
 							}
-							vehicle->has_position_changes = true;
+							vehicle->has_position_changes() = true;
 
 							auto& start = vehicle->current_lane->centerLine.front();
 							auto& end = vehicle->current_lane->centerLine.back();
 
 							const bool positive_dir = algo::is_in_first_or_fourth(start, end, start, tgt->centerLine.front());
 							vehicle->lane_change_dir = positive_dir ? 1 : -1;
-							vehicle->lateral_offset = 0.0f;
+							vehicle->lateral_offset() = 0.0f;
 							vehicle->action_time = 0.0;
-							VehicleStateBitsV::overwrite_info(vehicle->state, VehicleStateBits::ST_CROSS, VehicleStateBitsDivision::STATE);
+							VehicleStateBitsV::overwrite_info(vehicle->state(), VehicleStateBits::ST_CROSS, VehicleStateBitsDivision::STATE);
 							continue;
 						}
-					} else if (VehicleStateBitsV::has_info(vehicle->state, VehicleStateBits::ST_CROSS)) {
-						if (debug.agent_id == vehicle->uid) {
+					} else if (VehicleStateBitsV::has_info(vehicle->state(), VehicleStateBits::ST_CROSS)) {
+						if (debug.agent_id == vehicle->uid()) {
 							std::cout << "";
 						}
 						vehicle->action_time += dt;
 						double prog = std::min(vehicle->action_time / p_idm.t_cross, 1.0);
 						double cos_term = std::sin(tjs::core::MathConstants::M_PI * 0.5 * prog);
-						vehicle->lateral_offset = vehicle->lane_change_dir * vehicle->current_lane->width * cos_term;
-						vehicle->has_position_changes = true;
+						vehicle->lateral_offset() = vehicle->lane_change_dir * vehicle->current_lane->width * cos_term;
+						vehicle->has_position_changes() = true;
 						if (prog >= 1.0f) {
-							if (debug.agent_id == vehicle->uid) {
+							if (debug.agent_id == vehicle->uid()) {
 								std::cout << "";
 							}
-							pending_moves.push_back(PendingMove { vehicle, rt.static_lane, tgt, false });
-							flush_target(vehicle, lane_rt);
+							pending_moves.push_back(PendingMove { vehicle, rt.static_lane, tgt });
+							flush_target(vehicle, vehicles);
 
-							vehicle->lateral_offset = 0.0f;
+							vehicle->lateral_offset() = 0.0f;
 							vehicle->action_time = 0.0;
-							VehicleStateBitsV::overwrite_info(vehicle->state, VehicleStateBits::ST_ALIGN, VehicleStateBitsDivision::STATE);
+							VehicleStateBitsV::overwrite_info(vehicle->state(), VehicleStateBits::ST_ALIGN, VehicleStateBitsDivision::STATE);
 						}
-					} else if (VehicleStateBitsV::has_info(vehicle->state, VehicleStateBits::ST_ALIGN)) {
+					} else if (VehicleStateBitsV::has_info(vehicle->state(), VehicleStateBits::ST_ALIGN)) {
 						vehicle->action_time += dt;
 						if (vehicle->action_time >= p_idm.t_align) {
-							VehicleStateBitsV::overwrite_info(vehicle->state, VehicleStateBits::ST_FOLLOW, VehicleStateBitsDivision::STATE);
-							VehicleStateBitsV::set_info(vehicle->state, VehicleStateBits::FL_COOLDOWN, VehicleStateBitsDivision::FLAGS);
+							VehicleStateBitsV::overwrite_info(vehicle->state(), VehicleStateBits::ST_FOLLOW, VehicleStateBitsDivision::STATE);
+							VehicleStateBitsV::set_info(vehicle->state(), VehicleStateBits::FL_COOLDOWN, VehicleStateBitsDivision::FLAGS);
 							vehicle->action_time = 0.0;
 						}
 					}
@@ -619,13 +621,8 @@ namespace tjs::core::simulation {
 
 			/* ----------------  Do all moves after scanning--------------------------------------- */
 			for (const auto& m : pending_moves) {
-				idm::move_index(m.vehicle, lane_rt, m.src, m.tgt, m.shadow);
-				if (!m.shadow) {
-					m.vehicle->current_lane = m.tgt;
-					if (m.vehicle->lane_target != nullptr) {
-						std::cout << "";
-					}
-				}
+				idm::move_index(m.vehicle, vehicles, m.src, m.tgt);
+				m.vehicle->current_lane = m.tgt;
 			}
 
 			using VSB = VehicleStateBits;
@@ -634,7 +631,7 @@ namespace tjs::core::simulation {
 
 			/* A small helper to test whether a car is still measurably off‑centre. */
 			const auto off_centre = [](Vehicle& vehicle) noexcept {
-				return std::fabs(vehicle.lateral_offset) > 0.5f; // 50 cm tolerance
+				return std::fabs(vehicle.lateral_offset()) > 0.5f; // 50 cm tolerance
 			};
 
 			/* ---------------- edge hop loop -------------------------------------- */
@@ -644,25 +641,25 @@ namespace tjs::core::simulation {
 					continue;
 				}
 
-				auto& v = *ag.vehicle;
+				auto& v = *vehicles.get(ag.vehicle);
 
-				double remain = v.s_on_lane;
+				double remain = v.s_on_lane();
 				Lane* lane = v.current_lane;
 
 				TJS_BREAK_IF(
 					debug.movement_phase == SimulationMovementPhase::IDM_Phase2_Agent
 					&& i == debug.agent_id
-					&& debug.lane_id == lane->get_id());
+					&& debug.lane_id == static_cast<size_t>(lane->get_id()));
 
 				while (remain >= lane->length - 1e-6) {
-					if (v.uid == debug.agent_id) {
+					if (v.uid() == debug.agent_id) {
 						std::cout << "";
 					}
 					remain -= lane->length;
 
 					++ag.path_offset;
 					if (ag.path_offset >= ag.path.size()) {
-						flush_target(&v, lane_rt);
+						flush_target(&v, vehicles);
 						stop_moving(i, ag, v, lane, VehicleMovementError::ER_NO_PATH);
 						break;
 					}
@@ -673,21 +670,21 @@ namespace tjs::core::simulation {
 					TJS_BREAK_IF(
 						debug.movement_phase == SimulationMovementPhase::IDM_Phase2_ChooseLane
 						&& i == debug.agent_id
-						&& debug.lane_id == lane->get_id());
+						&& debug.lane_id == static_cast<size_t>(lane->get_id()));
 
-					Lane* entry = choose_entry_lane(lane, next_edge, err);
+					Lane* entry = choose_entry_lane(network, lane, next_edge, err);
 					if (err != VehicleMovementError::ER_NO_ERROR || !entry) {
-						flush_target(&v, lane_rt);
+						flush_target(&v, vehicles);
 						stop_moving(i, ag, v, lane, err);
 						break;
 					}
 
-					if (!gap_ok(lane_rt[entry->index_in_buffer],
-							v.currentSpeed,
-							remain, v.length,
+					if (!gap_ok(vehicles.lane_runtime(*entry),
+							v.currentSpeed(),
+							remain, v.length(),
 							p_idm, dt)) {
-						v.s_on_lane = lane->length - 0.01;
-						v.s_next = v.s_on_lane;
+						v.s_on_lane() = lane->length - 0.01;
+						v.s_next() = v.s_on_lane();
 						break;
 					}
 
@@ -697,36 +694,35 @@ namespace tjs::core::simulation {
 					* --------------------------------------------- */
 					// Changing lane in this cycle has more priority over changing lane in lateral movement because
 					bit_t change_mask = (bit_t)VSB::ST_PREPARE | (bit_t)VSB::ST_CROSS;
-					bool busy = VehicleStateBitsV::has_any(v.state, change_mask, DIV::STATE) || (VehicleStateBitsV::has_info(v.state, VSB::ST_ALIGN) && off_centre(v));
+					bool busy = VehicleStateBitsV::has_any(v.state(), change_mask, DIV::STATE) || (VehicleStateBitsV::has_info(v.state(), VSB::ST_ALIGN) && off_centre(v));
 					if (busy) {
 						if (remain >= lane->length - 1e-3) {
-							v.s_on_lane = v.s_next = lane->length - 1e-3;
+							v.s_on_lane() = v.s_next() = lane->length - 1e-3;
 						}
 						break;
 					}
 
 					/* ----- commit hop ------------------------------------------- */
-					v.s_on_lane = remain;
-					idm::move_index(&v, lane_rt, lane, entry);
-					flush_target(&v, lane_rt);
+					v.s_on_lane() = remain;
+					idm::move_index(&v, vehicles, lane, entry);
+					flush_target(&v, vehicles);
 
 					lane = entry;
 					v.current_lane = entry;
 
 					if (ag.path_offset < ag.path.size() - 1) {
-						v.goal_lane_mask = build_goal_mask(*entry->parent, *ag.path[ag.path_offset + 1]);
+						v.goal_lane_mask = build_goal_mask(network, *entry->parent, *ag.path[ag.path_offset + 1]);
 					} else {
 						v.goal_lane_mask = 0xFFFF;
 					}
 					/* ----- SUMO‑style speed clamp ------------------------------ */
-					const auto& tgt_idx = lane_rt[entry->index_in_buffer].idx;
-					if (!tgt_idx.empty() && tgt_idx.front() != &v) {
-						Vehicle* j_lead = tgt_idx.front();
-						float gap_leader = idm::actual_gap(static_cast<float>(j_lead->s_on_lane),
-							static_cast<float>(v.s_on_lane),
-							j_lead->length, v.length);
-						float v_safe = idm::safe_entry_speed(j_lead->currentSpeed, gap_leader, dt);
-						v.currentSpeed = std::clamp(v_safe, 0.0f, v.currentSpeed);
+					Vehicle* j_lead = lane_behind(vehicles.lane_runtime(*entry).idx, 0);
+					if (j_lead != nullptr && j_lead != &v) {
+						float gap_leader = idm::actual_gap(static_cast<float>(j_lead->s_on_lane()),
+							static_cast<float>(v.s_on_lane()),
+							j_lead->length(), v.length());
+						float v_safe = idm::safe_entry_speed(j_lead->currentSpeed(), gap_leader, dt);
+						v.currentSpeed() = std::clamp(v_safe, 0.0f, v.currentSpeed());
 					}
 				}
 			}
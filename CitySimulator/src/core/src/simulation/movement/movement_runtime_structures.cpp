@@ -0,0 +1,166 @@
+#include <core/stdafx.h>
+
+#include <core/simulation/movement/movement_runtime_structures.h>
+
+#include <core/data_layer/vehicle.h>
+
+#include <cassert>
+
+namespace tjs::core::simulation {
+
+	namespace {
+		using position_t = uint32_t Vehicle::*;
+
+		// front→rear: strictly ahead goes first, equal positions keep their order
+		bool is_ahead(const Vehicle* lhs, const Vehicle* rhs) {
+			return lhs->s_on_lane() > rhs->s_on_lane();
+		}
+
+		void renumber(std::vector<Vehicle*>& list, std::size_t from, position_t position) {
+			for (std::size_t i = from; i < list.size(); ++i) {
+				if (list[i]) {
+					list[i]->*position = static_cast<uint32_t>(i);
+				}
+			}
+		}
+
+		void insert(std::vector<Vehicle*>& list, uint32_t& holes, Vehicle* vehicle, position_t position) {
+			const std::size_t pos = lane_position(list, vehicle->s_on_lane());
+			// any hole between the neighbours keeps the order
+			const bool hole_here = pos < list.size() && list[pos] == nullptr;
+			const bool hole_before = pos > 0 && list[pos - 1] == nullptr;
+			if (!hole_here && !hole_before) {
+				list.insert(list.begin() + pos, vehicle);
+				renumber(list, pos, position);
+				return;
+			}
+			const std::size_t at = hole_here ? pos : pos - 1;
+			list[at] = vehicle;
+			vehicle->*position = static_cast<uint32_t>(at);
+			--holes;
+		}
+
+		bool erase(std::vector<Vehicle*>& list, uint32_t& holes, Vehicle* vehicle, position_t position, const char* what) {
+			const std::size_t pos = vehicle->*position;
+			assert(pos < list.size() && list[pos] == vehicle && "stale stored lane position");
+			if (pos >= list.size() || list[pos] != vehicle) {
+				std::cerr << what << ": vehicle is not at its stored position " << pos << std::endl;
+				return false;
+			}
+
+			vehicle->*position = LaneRuntime::NO_SLOT;
+			list[pos] = nullptr;
+			++holes;
+			// holes at the rear cost nothing to drop
+			while (!list.empty() && list.back() == nullptr) {
+				list.pop_back();
+				--holes;
+			}
+			return true;
+		}
+
+		void compact(std::vector<Vehicle*>& list, uint32_t& holes, position_t position) {
+			if (holes == 0) {
+				return;
+			}
+			std::size_t out = 0;
+			for (std::size_t i = 0; i < list.size(); ++i) {
+				if (Vehicle* vehicle = list[i]) {
+					list[out] = vehicle;
+					vehicle->*position = static_cast<uint32_t>(out);
+					++out;
+				}
+			}
+			list.resize(out);
+			holes = 0;
+		}
+
+		// insertion sort, one shift per inversion, and renumber while passing by
+		void resort(std::vector<Vehicle*>& list, position_t position) {
+			for (std::size_t i = 0; i < list.size(); ++i) {
+				Vehicle* vehicle = list[i];
+				std::size_t j = i;
+				for (; j > 0 && is_ahead(vehicle, list[j - 1]); --j) {
+					list[j] = list[j - 1];
+					list[j]->*position = static_cast<uint32_t>(j);
+				}
+				list[j] = vehicle;
+				vehicle->*position = static_cast<uint32_t>(j);
+			}
+		}
+	} // namespace
+
+	std::size_t lane_position(const std::vector<Vehicle*>& list, double s) {
+		std::size_t lo = 0;
+		std::size_t hi = list.size();
+		while (lo < hi) {
+			const std::size_t mid = lo + (hi - lo) / 2;
+			// probe the first vehicle at or after mid, holes are few
+			std::size_t probe = mid;
+			while (probe < hi && list[probe] == nullptr) {
+				++probe;
+			}
+			if (probe == hi) {
+				hi = mid;
+			} else if (list[probe]->s_on_lane() > s) {
+				lo = probe + 1;
+			} else {
+				hi = probe;
+			}
+		}
+		return lo;
+	}
+
+	Vehicle* lane_ahead(const std::vector<Vehicle*>& list, std::size_t pos) {
+		while (pos > 0) {
+			if (Vehicle* vehicle = list[--pos]) {
+				return vehicle;
+			}
+		}
+		return nullptr;
+	}
+
+	Vehicle* lane_behind(const std::vector<Vehicle*>& list, std::size_t pos) {
+		for (; pos < list.size(); ++pos) {
+			if (Vehicle* vehicle = list[pos]) {
+				return vehicle;
+			}
+		}
+		return nullptr;
+	}
+
+	void lane_insert(LaneRuntime& rt, Vehicle* vehicle) {
+		insert(rt.idx, rt.idx_holes, vehicle, &Vehicle::idx_in_lane);
+	}
+
+	void lane_erase(LaneRuntime& rt, Vehicle* vehicle) {
+		erase(rt.idx, rt.idx_holes, vehicle, &Vehicle::idx_in_lane, "lane_erase");
+	}
+
+	void slot_insert(LaneRuntime& rt, Vehicle* vehicle) {
+		if (vehicle->idx_in_target_lane != LaneRuntime::NO_SLOT) {
+			return;
+		}
+		insert(rt.vehicle_slots, rt.slot_holes, vehicle, &Vehicle::idx_in_target_lane);
+	}
+
+	void slot_erase(LaneRuntime& rt, Vehicle* vehicle) {
+		// not merging anywhere is fine, any other mismatch is a bookkeeping bug
+		if (vehicle->idx_in_target_lane == LaneRuntime::NO_SLOT) {
+			return;
+		}
+		erase(rt.vehicle_slots, rt.slot_holes, vehicle, &Vehicle::idx_in_target_lane, "slot_erase");
+	}
+
+	void lane_compact(LaneRuntime& rt) {
+		compact(rt.idx, rt.idx_holes, &Vehicle::idx_in_lane);
+		compact(rt.vehicle_slots, rt.slot_holes, &Vehicle::idx_in_target_lane);
+	}
+
+	void lane_resort(LaneRuntime& rt) {
+		lane_compact(rt);
+		resort(rt.idx, &Vehicle::idx_in_lane);
+		resort(rt.vehicle_slots, &Vehicle::idx_in_target_lane);
+	}
+
+} // namespace tjs::core::simulation
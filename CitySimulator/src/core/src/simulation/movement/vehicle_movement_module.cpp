@@ -34,6 +34,8 @@ namespace tjs::core::simulation {
 		TJS_TRACY_NAMED("VehicleMovement_Update");
 
 		_algorithm->update();
+		// lane hops and merges leave holes, readers between steps get dense lists
+		_system.vehicle_system().compact_lanes();
 	}
 
 } // namespace tjs::core::simulation
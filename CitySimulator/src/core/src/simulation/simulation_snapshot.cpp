@@ -0,0 +1,120 @@
+#include <core/stdafx.h>
+
+#include <core/simulation/simulation_snapshot.h>
+
+#include <core/simulation/simulation_system.h>
+#include <core/simulation/agent/agent_data.h>
+#include <core/store_models/idata_model.h>
+#include <core/store_models/vehicle_analyze_data.h>
+
+#include <core/data_layer/lane.h>
+#include <core/data_layer/edge.h>
+#include <core/data_layer/node.h>
+
+namespace tjs::core::simulation {
+	void SimulationSnapshot::Vehicles::clear() {
+		uid.clear();
+		agent_id.clear();
+		coordinates.clear();
+		rotation_angle.clear();
+		length.clear();
+		width.clear();
+		s_on_lane.clear();
+		type.clear();
+		state.clear();
+		lane_id.clear();
+		target_id.clear();
+	}
+
+	void SimulationSnapshot::Vehicles::reserve(size_t n) {
+		uid.reserve(n);
+		agent_id.reserve(n);
+		coordinates.reserve(n);
+		rotation_angle.reserve(n);
+		length.reserve(n);
+		width.reserve(n);
+		s_on_lane.reserve(n);
+		type.reserve(n);
+		state.reserve(n);
+		lane_id.reserve(n);
+		target_id.reserve(n);
+	}
+
+	namespace {
+		void capture_tracked(const AgentData& agent, const Vehicle* vehicle, SimulationSnapshot::TrackedAgent& tracked) {
+			tracked.id = agent.id;
+			tracked.behaviour = agent.behaviour;
+
+			tracked.has_vehicle = vehicle != nullptr;
+			if (vehicle) {
+				tracked.vehicle_uid = vehicle->uid();
+				tracked.vehicle_position = vehicle->coordinates();
+			}
+
+			tracked.has_goal = agent.currentGoal != nullptr;
+			if (agent.currentGoal) {
+				tracked.goal_uid = agent.currentGoal->uid;
+				tracked.goal = agent.currentGoal->coordinates;
+			}
+
+			tracked.path.clear();
+			tracked.path.reserve(agent.path.size());
+			for (size_t i = 0; i < agent.path.size(); ++i) {
+				const Edge* edge = agent.path[i];
+				if (edge == nullptr || edge->start_node == nullptr || edge->end_node == nullptr) {
+					continue;
+				}
+				tracked.path.push_back({ edge->start_node->coordinates, edge->end_node->coordinates, edge->end_node->uid });
+			}
+			tracked.path_offset = agent.path_offset;
+		}
+	} // namespace
+
+	void capture_snapshot(TrafficSimulationSystem& system, SimulationSnapshot& snapshot) {
+		TJS_TRACY_NAMED("Simulation_CaptureSnapshot");
+
+		const TimeState& time_state = system.timeModule().state();
+		snapshot.current_time = time_state.current_time();
+		snapshot.paused = time_state.isPaused;
+
+		VehicleSystem& vehicle_system = system.vehicle_system();
+		AgentManager& agent_manager = system.agent_manager();
+		const auto& vehicles = vehicle_system.vehicles();
+		auto& out = snapshot.vehicles;
+		out.clear();
+		out.reserve(vehicles.size());
+		for (const Vehicle* vehicle : vehicles) {
+			out.uid.push_back(vehicle->uid());
+			const AgentData* agent = agent_manager.get(vehicle->agent());
+			out.agent_id.push_back(agent ? agent->id : 0);
+			out.coordinates.push_back(vehicle->coordinates());
+			out.rotation_angle.push_back(vehicle->rotationAngle());
+			out.length.push_back(vehicle->length());
+			out.width.push_back(vehicle->width());
+			out.s_on_lane.push_back(static_cast<float>(vehicle->s_on_lane()));
+			out.type.push_back(vehicle->type());
+			out.state.push_back(vehicle->state());
+			out.lane_id.push_back(vehicle->current_lane ? vehicle->current_lane->get_id() : -1);
+			out.target_id.push_back(vehicle->lane_target ? vehicle->lane_target->get_id() : -1);
+		}
+
+		const auto& agents = system.agents();
+		snapshot.agents.clear();
+		snapshot.agents.reserve(agents.size());
+		for (const AgentData* agent : agents) {
+			const Vehicle* vehicle = vehicle_system.get(agent->vehicle);
+			snapshot.agents.push_back({ agent->id, vehicle ? vehicle->uid() : 0, agent->stucked });
+		}
+
+		auto* analyze = system.store().get_entry<model::VehicleAnalyzeData>();
+		const AgentData* tracked = analyze ? agent_manager.get(analyze->agent) : nullptr;
+		if (tracked == nullptr) {
+			snapshot.tracked.reset();
+			return;
+		}
+		if (!snapshot.tracked) {
+			snapshot.tracked.emplace();
+		}
+		capture_tracked(*tracked, vehicle_system.get(tracked->vehicle), *snapshot.tracked);
+	}
+} // namespace tjs::core::simulation
@@ -31,21 +31,12 @@ namespace tjs::core::simulation {
 
 	void TrafficSimulationSystem::initialize() {
 		_timeModule.initialize();
+		_worker_pool.resize(_settings.simulation_threads);
 
 		if (!_settings.randomSeed) {
 			RandomGenerator::set_seed(_settings.seedValue);
 		}
 
-		// clear lanes from vehicles
-		if (!_worldData.segments().empty()) {
-			auto& segment = _worldData.segments()[0];
-			for (auto& edge : segment->road_network->edges) {
-				for (auto& lane : edge.lanes) {
-					lane.vehicles.clear();
-				}
-			}
-		}
-
 		_agent_manager.initialize();
 		_vehicle_system.initialize();
 
@@ -89,6 +80,8 @@ namespace tjs::core::simulation {
 		_strategicModule.update();
 		_tacticalModule.update();
 		_vehicleMovementModule.update();
+		// route searches overlap the movement phase
+		_tacticalModule.apply_routes();
 	}
 
 } // namespace tjs::core::simulation
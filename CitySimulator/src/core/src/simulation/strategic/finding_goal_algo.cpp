@@ -10,12 +10,24 @@
 #include <core/random_generator.h>
 
 namespace tjs::core::simulation {
+	namespace {
+		Node* acceptable_end(const WayInfo& way, const std::function<bool(const Node&)>& accept) {
+			if (way.nodes.empty()) {
+				return nullptr;
+			}
+			if (!accept || accept(*way.nodes.front())) {
+				return way.nodes.front();
+			}
+			return accept(*way.nodes.back()) ? way.nodes.back() : nullptr;
+		}
+	} // namespace
 
 	core::Node* find_random_goal(
 		const core::SpatialGrid& grid,
 		const core::Coordinates& coord,
 		double minRadius,
-		double maxRadius) {
+		double maxRadius,
+		const std::function<bool(const Node&)>& accept) {
 		// Step 1: Find the grid cell for the given coordinate
 		auto origin_cell = grid.get_entries_in_cell(coord);
 		if (!origin_cell.has_value()) {
@@ -53,9 +65,9 @@ namespace tjs::core::simulation {
 				if (!random_way->is_car_accessible()) {
 					continue;
 				}
-				// Return the first node of the way
-				if (!random_way->nodes.empty()) {
-					return random_way->nodes[0];
+				// Return the first node of the way, or its last one if only that fits
+				if (Node* node = acceptable_end(*random_way, accept)) {
+					return node;
 				}
 			}
 		}
@@ -64,8 +76,14 @@ namespace tjs::core::simulation {
 		auto it = grid.spatialGrid.begin();
 		std::advance(it, random_inc);
 
-		if (it != grid.spatialGrid.end()) {
-			return it->second[0]->nodes[0];
+		// the first acceptable cell from a random one on
+		for (size_t i = 0; i < grid.spatialGrid.size() && it != grid.spatialGrid.end(); ++i) {
+			if (Node* node = acceptable_end(*it->second[0], accept)) {
+				return node;
+			}
+			if (++it == grid.spatialGrid.end()) {
+				it = grid.spatialGrid.begin();
+			}
 		}
 
 		return nullptr; // Failed to find a suitable node after max attempts
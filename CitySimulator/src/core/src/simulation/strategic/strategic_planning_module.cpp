@@ -29,7 +29,8 @@ namespace tjs::core::simulation {
 	}
 
 	void StrategicPlanningModule::update_agent_strategy(AgentData& agent) {
-		if (agent.vehicle == nullptr || agent.stucked) {
+		const Vehicle* vehicle = _system.vehicle_system().get(agent.vehicle);
+		if (vehicle == nullptr || agent.stucked) {
 			return;
 		}
 
@@ -46,7 +47,7 @@ namespace tjs::core::simulation {
 		Node* goal = nullptr;
 		switch (agent.profile.goal_selection) {
 			case AgentGoalSelectionType::GoalNodeId: {
-				if (auto current_lane = agent.vehicle->current_lane; current_lane && current_lane->parent->end_node == agent.profile.goal) {
+				if (auto current_lane = vehicle->current_lane; current_lane && current_lane->parent->end_node == agent.profile.goal) {
 					_system.agent_manager().remove_agent(agent);
 				} else {
 					goal = agent.profile.goal;
@@ -55,11 +56,20 @@ namespace tjs::core::simulation {
 			case AgentGoalSelectionType::Profile:
 			case AgentGoalSelectionType::RandomSelection:
 			default: {
+				// a goal in a component the vehicle cannot get to would only
+				// cost a failed search over everything it can reach
+				const RoadNetwork& network = *segment->road_network;
+				const Lane* lane = vehicle->current_lane;
 				goal = find_random_goal(
 					segment->spatialGrid,
-					agent.vehicle->coordinates,
+					vehicle->coordinates(),
 					min_radius,
-					max_radius);
+					max_radius,
+					[&network, lane](const Node& node) { return lane == nullptr || network.can_reach(*lane->parent, node); });
+				// nothing reachable around, give up like after failed searches
+				if (goal == nullptr && ++agent.goalFailCount >= 5) {
+					agent.stucked = true;
+				}
 			} break;
 		}
 
@@ -0,0 +1,33 @@
+#include <core/stdafx.h>
+
+#include <core/simulation/tactical/route_cache.h>
+
+#include <core/data_layer/road_network.h>
+#include <core/data_layer/lane.h>
+
+namespace tjs::core::simulation {
+
+	RouteKey RouteCache::make_key(const RoadNetwork& network, const Lane* start_lane, const Node* goal, bool look_adjacent_lanes, RoutingAlgoType algo) {
+		// adjacent lanes seed the search from the whole edge, any of its lanes asks the same
+		const uint32_t start = look_adjacent_lanes
+								   ? network.edge_index(start_lane->parent)
+								   : network.lane_index(start_lane);
+		return { start, goal->graph_index, algo, look_adjacent_lanes };
+	}
+
+	void RouteCache::validate(const RoadNetwork& network) {
+		if (_network != &network || _revision != network.revision) {
+			_routes.clear();
+			_network = &network;
+			_revision = network.revision;
+		}
+	}
+
+	void RouteCache::reset(size_t capacity) {
+		_routes.clear();
+		_routes.set_capacity(capacity);
+		_routes.reset_stats();
+		_network = nullptr;
+	}
+
+} // namespace tjs::core::simulation
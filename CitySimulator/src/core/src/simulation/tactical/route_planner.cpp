@@ -0,0 +1,121 @@
+#include <core/stdafx.h>
+
+#include <core/simulation/tactical/route_planner.h>
+
+#include <core/data_layer/road_network.h>
+#include <core/map_math/path_finder.h>
+#include <core/map_math/search_context.h>
+
+namespace tjs::core::simulation {
+
+	RoutePlanner::~RoutePlanner() {
+		stop();
+	}
+
+	Route RoutePlanner::search(const RoadNetwork& network, const Request& request) {
+		TJS_TRACY_NAMED("RoutePlanner_Search");
+
+		if (request.algo == RoutingAlgoType::Bidirectional) {
+			auto& context = algo::thread_bidirectional_context();
+			if (!algo::PathFinder::find_edge_path_bidirectional_from_lane(network, request.start_lane, request.goal, request.look_adjacent_lanes, context)) {
+				return nullptr;
+			}
+			return std::make_shared<const std::vector<uint32_t>>(context.path);
+		}
+
+		auto& context = algo::thread_search_context();
+		if (request.algo == RoutingAlgoType::Landmarks) {
+			if (!algo::PathFinder::find_edge_path_alt_from_lane(network, request.start_lane, request.goal, request.look_adjacent_lanes, context)) {
+				return nullptr;
+			}
+			return std::make_shared<const std::vector<uint32_t>>(context.path());
+		}
+		if (!algo::PathFinder::find_edge_path_a_star_from_lane(network, request.start_lane, request.goal, request.look_adjacent_lanes, context)) {
+			return nullptr;
+		}
+		return std::make_shared<const std::vector<uint32_t>>(context.path());
+	}
+
+	void RoutePlanner::resize(size_t threads) {
+		if (threads == _threads.size()) {
+			return;
+		}
+
+		stop();
+		_stopping = false;
+		_threads.reserve(threads);
+		for (size_t i = 0; i < threads; ++i) {
+			_threads.emplace_back([this]() { worker_loop(); });
+		}
+	}
+
+	size_t RoutePlanner::submit(const RoadNetwork& network, const Request& request) {
+		size_t ticket = 0;
+		{
+			std::lock_guard lock(_mutex);
+			_network = &network;
+			ticket = _requests.size();
+			_requests.push_back(request);
+			_results.emplace_back();
+		}
+		_wake.notify_one();
+		return ticket;
+	}
+
+	std::vector<Route> RoutePlanner::collect() {
+		TJS_TRACY_NAMED("RoutePlanner_Collect");
+
+		std::unique_lock lock(_mutex);
+		// the caller would only wait, so it searches too
+		while (_next < _requests.size()) {
+			run_next(lock);
+		}
+		_done.wait(lock, [this]() { return _finished == _requests.size(); });
+
+		std::vector<Route> results = std::move(_results);
+		_results.clear();
+		_requests.clear();
+		_next = 0;
+		_finished = 0;
+		return results;
+	}
+
+	void RoutePlanner::worker_loop() {
+		std::unique_lock lock(_mutex);
+		for (;;) {
+			_wake.wait(lock, [this]() { return _stopping || _next < _requests.size(); });
+			if (_stopping) {
+				return;
+			}
+			run_next(lock);
+		}
+	}
+
+	void RoutePlanner::run_next(std::unique_lock<std::mutex>& lock) {
+		const size_t ticket = _next++;
+		const Request request = _requests[ticket];
+		const RoadNetwork& network = *_network;
+
+		lock.unlock();
+		Route route = search(network, request);
+		lock.lock();
+
+		_results[ticket] = std::move(route);
+		if (++_finished == _requests.size()) {
+			_done.notify_all();
+		}
+	}
+
+	void RoutePlanner::stop() {
+		{
+			std::lock_guard lock(_mutex);
+			_stopping = true;
+		}
+		_wake.notify_all();
+		for (auto& thread : _threads) {
+			thread.join();
+		}
+		_threads.clear();
+	}
+
+} // namespace tjs::core::simulation
@@ -8,7 +8,7 @@
 #include <core/data_layer/world_data.h>
 #include <core/map_math/earth_math.h>
 
-#include <core/map_math/path_finder.h>
+#include <core/map_math/landmarks.h>
 
 namespace tjs::core::simulation {
 
@@ -17,9 +17,30 @@ namespace tjs::core::simulation {
 	}
 
 	void TacticalPlanningModule::initialize() {
+		_route_cache.reset(_system.settings().route_cache_size);
+		_planner.collect();
+		_planner.resize(_system.settings().route_planner_threads);
+		_pending.clear();
+		_tickets.clear();
+
+		auto& segments = _system.worldData().segments();
+		if (segments.empty()) {
+			return;
+		}
+
+		// preprocessing is paid once per graph; rebuilding the graph drops it
+		auto& road_network = *segments.front()->road_network;
+		const auto& settings = _system.settings();
+		if (settings.routing_algo == RoutingAlgoType::Landmarks
+			&& (!road_network.landmarks || road_network.landmarks->landmarks().size() != settings.landmarks_count)) {
+			road_network.landmarks = core::algo::LandmarkTable::build(road_network, settings.landmarks_count);
+		}
 	}
 
 	void TacticalPlanningModule::release() {
+		_planner.collect();
+		_pending.clear();
+		_tickets.clear();
 	}
 
 	void TacticalPlanningModule::update() {
@@ -31,36 +52,6 @@ namespace tjs::core::simulation {
 	}
 
 	namespace simulation_details {
-		std::vector<Edge*> find_path(Lane* start_lane, Node* goal, RoadNetwork& road_network, bool look_adjacent_lanes) {
-			std::vector<Edge*> result;
-			auto edge_path = core::algo::PathFinder::find_edge_path_a_star_from_lane(
-				road_network,
-				start_lane,
-				goal,
-				look_adjacent_lanes);
-			result.reserve(edge_path.size());
-			for (const auto* edge : edge_path) {
-				result.push_back(const_cast<Edge*>(edge));
-			}
-
-			return result;
-		}
-
-		Node* find_nearest_node(const Coordinates& coords, RoadNetwork& road_network) {
-			Node* nearest = nullptr;
-			double min_distance = std::numeric_limits<double>::max();
-
-			for (const auto& [id, node] : road_network.nodes) {
-				double dist = core::algo::euclidean_distance(node->coordinates, coords);
-				if (dist < min_distance) {
-					min_distance = dist;
-					nearest = node;
-				}
-			}
-
-			return nearest;
-		}
-
 		void reset_goals(AgentData& agent, bool success, bool mark = true) {
 			agent.currentGoal = nullptr;
 			agent.path.clear();
@@ -75,25 +66,46 @@ namespace tjs::core::simulation {
 			}
 		}
 
+		// Start edge followed by the route, or the error state when there is none
+		void apply_route(AgentData& agent, Vehicle& vehicle, Lane& start_lane, const Route& route, RoadNetwork& road_network) {
+			if (!route) {
+				VehicleStateBitsV::set_info(vehicle.state(), VehicleStateBits::FL_ERROR, VehicleStateBitsDivision::FLAGS);
+				reset_goals(agent, false);
+				return;
+			}
+
+			agent.path = AgentPath(road_network, *start_lane.parent, route);
+			Edge* first_edge = agent.path[1];
+
+			agent.path_offset = 0;
+			vehicle.goal_lane_mask = build_goal_mask(road_network, *start_lane.parent, *first_edge);
+
+			agent.distanceTraveled = 0.0; // Reset distance for new path
+			agent.goalFailCount = 0;
+			VehicleStateBitsV::overwrite_info(vehicle.state(), VehicleStateBits::ST_FOLLOW, VehicleStateBitsDivision::STATE);
+			VehicleStateBitsV::remove_info(vehicle.state(), VehicleStateBits::FL_ERROR, VehicleStateBitsDivision::FLAGS);
+		}
+
 		void update_agent(size_t i, AgentData& agent, TrafficSimulationSystem& system) {
 			TJS_TRACY_NAMED("TacticalPlanning::update_agent");
-			if (agent.vehicle == nullptr || agent.currentGoal == nullptr) {
+			Vehicle* vehicle_ptr = system.vehicle_system().get(agent.vehicle);
+			if (vehicle_ptr == nullptr || agent.currentGoal == nullptr) {
 				return;
 			}
 
-			auto& vehicle = *agent.vehicle;
+			auto& vehicle = *vehicle_ptr;
 
 			auto& world = system.worldData();
 			auto& segment = world.segments().front();
 			auto& road_network = *segment->road_network;
 			auto& spatial_grid = segment->spatialGrid;
 
-			if (VehicleStateBitsV::has_info(vehicle.state, VehicleStateBits::ST_STOPPED)) {
+			if (VehicleStateBitsV::has_info(vehicle.state(), VehicleStateBits::ST_STOPPED)) {
 				// reach goal
-				if (vehicle.error == VehicleMovementError::ER_NO_PATH) {
-					vehicle.error = VehicleMovementError::ER_NO_ERROR;
+				if (vehicle.error() == VehicleMovementError::ER_NO_PATH) {
+					vehicle.error() = VehicleMovementError::ER_NO_ERROR;
 					if (agent.currentGoal != nullptr) {
-						const double distance_to_target = core::algo::euclidean_distance(vehicle.coordinates, agent.currentGoal->coordinates);
+						const double distance_to_target = core::algo::euclidean_distance(vehicle.coordinates(), agent.currentGoal->coordinates);
 						if (distance_to_target > SimulationConstants::ARRIVAL_THRESHOLD) {
 							// TODO[simulation]: handle agent not close enough to target
 							reset_goals(agent, true);
@@ -103,50 +115,96 @@ namespace tjs::core::simulation {
 					return;
 				}
 
-				if (vehicle.error == VehicleMovementError::ER_NO_OUTGOING_CONNECTION) {
+				if (vehicle.error() == VehicleMovementError::ER_NO_OUTGOING_CONNECTION) {
 					reset_goals(agent, true);
 					agent.stucked = true;
 					return;
 				}
 
-				if (vehicle.error == VehicleMovementError::ER_INCORRECT_EDGE || vehicle.error == VehicleMovementError::ER_INCORRECT_LANE) {
+				if (vehicle.error() == VehicleMovementError::ER_INCORRECT_EDGE || vehicle.error() == VehicleMovementError::ER_INCORRECT_LANE) {
 					// need rebuild path
 					agent.path.clear();
-					VehicleStateBitsV::remove_info(vehicle.state, VehicleStateBits::FL_ERROR, VehicleStateBitsDivision::FLAGS);
+					VehicleStateBitsV::remove_info(vehicle.state(), VehicleStateBits::FL_ERROR, VehicleStateBitsDivision::FLAGS);
 				}
 			}
 
 			// new goal
-			if (agent.path.empty() && VehicleStateBitsV::has_info(vehicle.state, VehicleStateBits::ST_STOPPED)) {
+			if (agent.path.empty() && VehicleStateBitsV::has_info(vehicle.state(), VehicleStateBits::ST_STOPPED)) {
 				Node* start_node = vehicle.current_lane->parent->start_node;
 
 				Lane* start_lane = vehicle.current_lane;
 
 				Node* goal_node = agent.currentGoal;
 				if (start_lane && goal_node) {
-					const bool find_adjacent = vehicle.s_on_lane < (vehicle.current_lane->length - 2.0);
-					agent.path = find_path(start_lane, goal_node, road_network, find_adjacent);
+					const bool find_adjacent = vehicle.s_on_lane() < (vehicle.current_lane->length - 2.0);
+					system.tacticalModule().plan_route(agent, *start_lane, *goal_node, find_adjacent);
+				}
+			}
+		}
 
-					if (!agent.path.empty()) {
-						Edge* first_edge = agent.path.front();
-						agent.path.insert(agent.path.begin(), start_lane->parent);
+	} // namespace simulation_details
 
-						agent.path_offset = 0;
-						agent.vehicle->goal_lane_mask = build_goal_mask(*start_lane->parent, *first_edge);
+	void TacticalPlanningModule::plan_route(AgentData& agent, Lane& start_lane, Node& goal, bool look_adjacent_lanes) {
+		auto& road_network = *_system.worldData().segments().front()->road_network;
+		const RoutingAlgoType algo = _system.settings().routing_algo;
+		Vehicle& vehicle = *_system.vehicle_system().get(agent.vehicle);
 
-						agent.distanceTraveled = 0.0; // Reset distance for new path
-						agent.goalFailCount = 0;
-						VehicleStateBitsV::overwrite_info(vehicle.state, VehicleStateBits::ST_FOLLOW, VehicleStateBitsDivision::STATE);
-						VehicleStateBitsV::remove_info(vehicle.state, VehicleStateBits::FL_ERROR, VehicleStateBitsDivision::FLAGS);
+		// no search needed to tell no route leads to the goal
+		if (!road_network.can_reach(*start_lane.parent, goal)) {
+			simulation_details::apply_route(agent, vehicle, start_lane, nullptr, road_network);
+			return;
+		}
 
-					} else {
-						VehicleStateBitsV::set_info(vehicle.state, VehicleStateBits::FL_ERROR, VehicleStateBitsDivision::FLAGS);
-						reset_goals(agent, false);
-					}
-				}
-			}
+		_route_cache.validate(road_network);
+		const RouteKey key = RouteCache::make_key(road_network, &start_lane, &goal, look_adjacent_lanes, algo);
+		if (const Route* cached = _route_cache.find(key)) {
+			simulation_details::apply_route(agent, vehicle, start_lane, *cached, road_network);
+			return;
 		}
 
-	} // namespace simulation_details
+		// Searched routes apply in apply_routes() for any planner thread count,
+		// with none collect() runs the searches there.
+		// Agents asking the same question this step share one search
+		const RoutePlanner::Request request { &start_lane, &goal, look_adjacent_lanes, algo };
+		auto [it, inserted] = _tickets.try_emplace(key, 0);
+		if (inserted) {
+			it->second = _planner.submit(road_network, request);
+		}
+		_pending.push_back({ agent.handle, &start_lane, key, it->second });
+	}
+
+	void TacticalPlanningModule::apply_routes() {
+		if (_pending.empty()) {
+			return;
+		}
+		TJS_TRACY_NAMED("TacticalPlanning_ApplyRoutes");
+
+		auto& road_network = *_system.worldData().segments().front()->road_network;
+		const std::vector<Route> routes = _planner.collect();
+		std::vector<bool> stored(routes.size(), false);
+
+		// in the order update() queued them, whatever order the searches finished in
+		for (const PendingRoute& pending : _pending) {
+			const Route& route = routes[pending.ticket];
+			if (!stored[pending.ticket]) {
+				_route_cache.store(pending.key, route);
+				stored[pending.ticket] = true;
+			}
+
+			// an agent retired this step or a vehicle that left its lane
+			// meanwhile, the latter asks again next step
+			AgentData* agent = _system.agent_manager().get(pending.agent);
+			if (agent == nullptr) {
+				continue;
+			}
+			Vehicle* vehicle = _system.vehicle_system().get(agent->vehicle);
+			if (vehicle == nullptr || vehicle->current_lane != pending.start_lane || !agent->path.empty()) {
+				continue;
+			}
+			simulation_details::apply_route(*agent, *vehicle, *pending.start_lane, route, road_network);
+		}
+		_pending.clear();
+		_tickets.clear();
+	}
 
 } // namespace tjs::core::simulation
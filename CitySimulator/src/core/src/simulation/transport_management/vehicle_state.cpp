@@ -39,19 +39,19 @@ namespace tjs::core::simulation {
 	}
 
 	void VehicleBuffers::add_vehicle(Vehicle& vehicle) {
-		s_curr.push_back(vehicle.s_on_lane);
-		s_next.push_back(vehicle.s_on_lane);
-		v_curr.push_back(vehicle.currentSpeed);
-		v_next.push_back(vehicle.currentSpeed);
-		desired_v.push_back(vehicle.maxSpeed);
-		length.push_back(vehicle.length);
-		lateral_off.push_back(vehicle.lateral_offset);
+		s_curr.push_back(vehicle.s_on_lane());
+		s_next.push_back(vehicle.s_on_lane());
+		v_curr.push_back(vehicle.currentSpeed());
+		v_next.push_back(vehicle.currentSpeed());
+		desired_v.push_back(vehicle.maxSpeed());
+		length.push_back(vehicle.length());
+		lateral_off.push_back(vehicle.lateral_offset());
 		lane.push_back(vehicle.current_lane);
 		lane_target.push_back(nullptr);
 		lane_after.push_back(nullptr);
 		action_time.push_back(0.0f);
 		lane_change_dir.push_back(0);
-		flags.push_back(vehicle.state);
-		uids.push_back(vehicle.uid);
+		flags.push_back(vehicle.state());
+		uids.push_back(vehicle.uid());
 	}*/
 } // namespace tjs::core::simulation
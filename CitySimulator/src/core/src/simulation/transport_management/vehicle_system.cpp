@@ -17,54 +17,52 @@
 #include <core/data_layer/world_data.h>
 #include <core/data_layer/way_info.h>
 #include <core/data_layer/lane.h>
-#include <core/data_layer/lane_vehicle_utils.h>
 
 namespace tjs::core::simulation {
 
 	// Helper function to create vehicle with ObjectPool
 	Vehicle* create_vehicle_impl(
 		VehicleSystem::VehiclePool& vehicle_pool,
+		VehicleStore& store,
 		Lane& lane,
-		std::vector<LaneRuntime>& lane_rt,
+		LaneRuntime& lane_rt,
 		const VehicleConfig& config,
 		VehicleType type,
 		float desired_speed) {
-		auto vehicle_ptr = vehicle_pool.acquire_ptr();
+		const VehicleHandle handle = vehicle_pool.acquire_handle();
+		Vehicle* vehicle_ptr = vehicle_pool.resolve(handle);
 		if (!vehicle_ptr) {
 			return nullptr;
 		}
 
 		Vehicle& vehicle = *vehicle_ptr;
+		vehicle.handle = handle;
+		store.acquire(vehicle);
 		// TODO[simulation]: correct UID
-		vehicle.uid = RandomGenerator::get().next_int(1, 10000000);
-		vehicle.type = type;
-
-		vehicle.length = config.length;
-		vehicle.width = config.width;
-		vehicle.currentSpeed = desired_speed;
-		vehicle.maxSpeed = RandomGenerator::get().next_float(40, 100.0f);
-		vehicle.coordinates = lane.parent->start_node->coordinates;
-		vehicle.currentSegmentIndex = 0;
+		vehicle.uid() = RandomGenerator::get().next_int(1, 10000000);
+		vehicle.type() = type;
+
+		vehicle.length() = config.length;
+		vehicle.width() = config.width;
+		vehicle.currentSpeed() = desired_speed;
+		vehicle.maxSpeed() = RandomGenerator::get().next_float(40, 100.0f);
+		vehicle.coordinates() = lane.parent->start_node->coordinates;
+		vehicle.info().currentSegmentIndex = 0;
 		vehicle.current_lane = &lane;
-		vehicle.s_on_lane = vehicle.length / 2.0f;
-		vehicle.lateral_offset = 0.0;
+		vehicle.s_on_lane() = vehicle.length() / 2.0f;
+		vehicle.lateral_offset() = 0.0;
 		vehicle.goal_lane_mask = 0;
-		VehicleStateBitsV::set_info(vehicle.state, VehicleStateBits::ST_STOPPED, VehicleStateBitsDivision::STATE);
-		vehicle.previous_state = vehicle.state;
-		vehicle.error = VehicleMovementError::ER_NO_ERROR;
+		VehicleStateBitsV::set_info(vehicle.state(), VehicleStateBits::ST_STOPPED, VehicleStateBitsDivision::STATE);
+		vehicle.previous_state() = vehicle.state();
+		vehicle.error() = VehicleMovementError::ER_NO_ERROR;
 
-		vehicle.s_next = 0.0;
-		vehicle.v_next = 0.0f;
 		vehicle.lane_target = nullptr;
 		vehicle.action_time = 0.0f;
 		vehicle.lane_change_dir = 0;
-		vehicle.idx_in_lane = vehicle.current_lane->vehicles.size();
-		vehicle.idx_in_target_lane = 0;
+		vehicle.idx_in_target_lane = LaneRuntime::NO_SLOT;
 
 		// we know that this is the last vehicle in the lane (allow_on_lane)
-		vehicle.current_lane->vehicles.push_back(&vehicle);
-		lane_rt[lane.index_in_buffer].idx.push_back(&vehicle);
-		vehicle.has_position_changes = false;
+		lane_insert(lane_rt, &vehicle);
 
 		return vehicle_ptr;
 	}
@@ -103,18 +101,31 @@ namespace tjs::core::simulation {
 		auto& network = *segment->road_network;
 
 		_lane_runtime.clear();
+		_lane_slots.clear();
+		int last_lane_id = std::numeric_limits<int>::min();
+		_first_lane_id = std::numeric_limits<int>::max();
 		for (auto& edge : network.edges) {
 			for (auto& lane : edge.lanes) {
 				_lane_runtime.push_back({ &lane,
 					lane.length,
 					edge.way->maxSpeed / 3.6f,
+					{},
 					{} });
-				lane.index_in_buffer = _lane_runtime.size() - 1;
+				_first_lane_id = std::min(_first_lane_id, lane.get_id());
+				last_lane_id = std::max(last_lane_id, lane.get_id());
+			}
+		}
+		if (!_lane_runtime.empty()) {
+			_lane_slots.assign(static_cast<size_t>(last_lane_id - _first_lane_id) + 1, LaneRuntime::NO_SLOT);
+			for (size_t i = 0; i < _lane_runtime.size(); ++i) {
+				_lane_slots[_lane_runtime[i].static_lane->get_id() - _first_lane_id] = static_cast<uint32_t>(i);
 			}
 		}
 
 		// Reserve capacity in the object pool
 		_vehicle_pool.clear();
+		_store.clear();
+		_steps_since_reorder = 0;
 		_vehicle_pool.reserve(_system.settings().vehiclesCount);
 	}
 
@@ -122,17 +133,6 @@ namespace tjs::core::simulation {
 		// ObjectPool will automatically clean up when destroyed
 	}
 
-	void VehicleSystem::commit() {
-		for (LaneRuntime& rt : _lane_runtime) {
-			Lane& lane = *rt.static_lane;
-			auto& idx = rt.idx;
-			lane.vehicles.resize(idx.size());
-			for (std::size_t i = 0; i < idx.size(); ++i) {
-				lane.vehicles[i] = idx[i];
-			}
-		}
-	}
-
 	std::optional<Vehicle*> VehicleSystem::create_vehicle(Lane& lane, VehicleType type, float desired_speed) {
 		auto it_config = _vehicle_configs.find(type);
 		if (it_config == _vehicle_configs.end()) {
@@ -141,17 +141,75 @@ namespace tjs::core::simulation {
 		}
 
 		const auto& config = it_config->second;
-		const auto& lr = _lane_runtime[lane.index_in_buffer];
+		auto& lr = lane_runtime(lane);
 		double dt = _system.timeModule().state().fixed_dt();
 		if (!allowed_on_lane(lr, config.length, desired_speed, dt)) {
 			// TODO[simulation]: log no allowed on lane
 			return {};
 		}
-		return create_vehicle_impl(_vehicle_pool, lane, _lane_runtime, config, type, desired_speed);
+		Vehicle* vehicle = create_vehicle_impl(_vehicle_pool, _store, lane, lr, config, type, desired_speed);
+		if (!vehicle) {
+			std::cerr << "VehicleSystem: vehicle pool is full" << std::endl;
+			return {};
+		}
+		return vehicle;
 	}
 
 	void VehicleSystem::update() {
-		_vehicle_pool.update_objects();
+		// vehicles removed this step left holes, the movement phases expect dense lists
+		compact_lanes();
+
+		// Rows follow the lanes, so movement phases walking LaneRuntime::idx
+		// read the hot columns sequentially. Vehicles leave their lane slowly,
+		// renumbering every few steps keeps most of the order for a fraction of the cost.
+		if (++_steps_since_reorder < REORDER_INTERVAL) {
+			return;
+		}
+		_steps_since_reorder = 0;
+
+		_row_order.clear();
+		_row_taken.assign(_store.rows(), 0);
+		const auto take = [this](Vehicle* vehicle) {
+			if (!_row_taken[vehicle->row]) {
+				_row_taken[vehicle->row] = 1;
+				_row_order.push_back(vehicle);
+			}
+		};
+		for (const LaneRuntime& rt : _lane_runtime) {
+			for (Vehicle* vehicle : rt.idx) {
+				// a merging vehicle is listed in its target lane too
+				if (vehicle->current_lane == rt.static_lane) {
+					take(vehicle);
+				}
+			}
+		}
+		// vehicles missing from their lane keep their relative order at the end
+		if (_row_order.size() != _store.live()) {
+			for (Vehicle* vehicle : _vehicle_pool.objects()) {
+				take(vehicle);
+			}
+		}
+		_store.reorder(_row_order);
+	}
+
+	void VehicleSystem::compact_lanes() {
+		for (LaneRuntime& rt : _lane_runtime) {
+			lane_compact(rt);
+		}
+	}
+
+	const std::vector<Vehicle*>& VehicleSystem::lane_vehicles(const Lane& lane) const {
+		return lane_runtime(lane).idx;
+	}
+
+	void VehicleSystem::move_to_lane(Vehicle& vehicle, Lane* lane) {
+		if (vehicle.current_lane) {
+			lane_erase(lane_runtime(*vehicle.current_lane), &vehicle);
+		}
+		vehicle.current_lane = lane;
+		if (lane) {
+			lane_insert(lane_runtime(*lane), &vehicle);
+		}
 	}
 
 	void VehicleSystem::remove_vehicle(Vehicle* vehicle) {
@@ -159,27 +217,19 @@ namespace tjs::core::simulation {
 			return;
 		}
 
-		// Remove from lane
-		if (vehicle->current_lane) {
-			core::remove_vehicle(*vehicle->current_lane, vehicle);
-
-			// Remove from lane runtime
-			if (vehicle->current_lane->index_in_buffer < _lane_runtime.size()) {
-				auto& idx = _lane_runtime[vehicle->current_lane->index_in_buffer].idx;
-				auto it = std::find(idx.begin(), idx.end(), vehicle);
-				if (it != idx.end()) {
-					idx.erase(it);
-				}
-			}
-
-			if (vehicle->cooperation_vehicle) {
-				vehicle->cooperation_vehicle->cooperation_vehicle = nullptr;
-				vehicle->cooperation_vehicle = nullptr;
-			}
+		// Remove from lane runtime
+		if (vehicle->current_lane && lane_slot(*vehicle->current_lane) != LaneRuntime::NO_SLOT) {
+			lane_erase(lane_runtime(*vehicle->current_lane), vehicle);
+		}
+		// ... and from the lane it was merging into
+		if (vehicle->lane_target && lane_slot(*vehicle->lane_target) != LaneRuntime::NO_SLOT) {
+			slot_erase(lane_runtime(*vehicle->lane_target), vehicle);
 		}
 
-		// Release back to pool
-		_vehicle_pool.release(vehicle);
+		// Release back to pool; handles to the vehicle (cooperation partners,
+		// the agent's one) stop resolving from here
+		_store.release(*vehicle);
+		_vehicle_pool.release(vehicle->handle);
 	}
 
 } // namespace tjs::core::simulation
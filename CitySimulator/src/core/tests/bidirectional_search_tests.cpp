@@ -0,0 +1,106 @@
+#include "stdafx.h"
+
+#include <data_loader_mixin.h>
+#include <core/data_layer/world_creator.h>
+#include <core/data_layer/world_data.h>
+#include <core/map_math/path_finder.h>
+#include <core/map_math/search_context.h>
+
+#include <queue>
+
+using namespace tjs::core;
+
+namespace {
+	constexpr double INF = std::numeric_limits<double>::infinity();
+
+	// Plain Dijkstra over edges from the lanes `start_lane` links into
+	std::vector<double> edge_distances(const RoadNetwork& network, const Lane& start_lane, bool look_adjacent_lanes) {
+		using Entry = std::pair<double, uint32_t>;
+		std::vector<double> dist(network.edges.size(), INF);
+		std::priority_queue<Entry, std::vector<Entry>, std::greater<>> open;
+		for (const Lane& lane : start_lane.parent->lanes) {
+			if (!look_adjacent_lanes && &lane != &start_lane) {
+				continue;
+			}
+			for (const LaneLinkHandler& link : lane.outgoing_connections) {
+				const uint32_t edge = network.edge_index(link->to->parent);
+				dist[edge] = network.edges[edge].length;
+				open.emplace(dist[edge], edge);
+			}
+		}
+		while (!open.empty()) {
+			const auto [d, edge] = open.top();
+			open.pop();
+			if (d > dist[edge]) {
+				continue;
+			}
+			for (uint32_t next : network.edge_transitions[edge]) {
+				const double candidate = d + network.edges[next].length;
+				if (candidate < dist[next]) {
+					dist[next] = candidate;
+					open.emplace(candidate, next);
+				}
+			}
+		}
+		return dist;
+	}
+} // namespace
+
+class BidirectionalSearchTest : public ::testing::TestWithParam<const char*>, public tjs::core::tests::DataLoaderMixin {
+protected:
+	WorldData world;
+
+	// test_data first, then sample_maps
+	void SetUp() override {
+		auto path = data_file(GetParam());
+		if (!std::filesystem::exists(path)) {
+			path = sample_file(GetParam());
+		}
+		ASSERT_TRUE(WorldCreator::loadOSMData(world, path.string()));
+	}
+
+	RoadNetwork& network() {
+		return *world.segments().front()->road_network;
+	}
+};
+
+TEST_P(BidirectionalSearchTest, FindsShortestValidRoutes) {
+	const auto& net = network();
+	algo::BidirectionalSearchContext context;
+	size_t found = 0;
+	for (const Edge& edge : net.edges) {
+		for (const Lane& lane : edge.lanes) {
+			const bool adjacent = lane.index_in_edge % 2 == 0;
+			const auto dist = edge_distances(net, lane, adjacent);
+			for (const Node* target : net.graph_nodes) {
+				double expected = INF;
+				for (uint32_t incoming : net.incoming_edges[target->graph_index]) {
+					expected = std::min(expected, dist[incoming]);
+				}
+
+				ASSERT_EQ(algo::PathFinder::find_edge_path_bidirectional_from_lane(net, &lane, target, adjacent, context), std::isfinite(expected));
+				if (context.path.empty()) {
+					continue;
+				}
+
+				++found;
+				const auto& path = context.path;
+				EXPECT_EQ(net.edges[path.front()].start_node, edge.end_node);
+				EXPECT_EQ(net.edges[path.back()].end_node, target);
+				double length = 0.0;
+				for (size_t i = 0; i < path.size(); ++i) {
+					length += net.edges[path[i]].length;
+					if (i > 0) {
+						const auto transitions = net.edge_transitions[path[i - 1]];
+						EXPECT_NE(std::ranges::find(transitions, path[i]), transitions.end());
+					}
+				}
+				EXPECT_NEAR(length, expected, 1e-6);
+			}
+		}
+	}
+	EXPECT_GT(found, 0);
+}
+
+INSTANTIATE_TEST_SUITE_P(Maps, BidirectionalSearchTest,
+	::testing::Values("simple_grid.osmx", "complex_streets.osmx", "cross_junction.osmx", "grid_osm_with_turn_restrictions.osmx"));
@@ -0,0 +1,258 @@
+#include <stdafx.h>
+
+#include <core/data_layer/world_data.h>
+#include <core/data_layer/world_creator.h>
+#include <core/data_layer/map_cache.h>
+#include <core/data_layer/data_types.h>
+#include <core/map_math/landmarks.h>
+
+#include <data_loader_mixin.h>
+
+using namespace tjs::core;
+
+class MapCacheTest
+	: public ::testing::TestWithParam<std::string_view>
+	, public tests::DataLoaderMixin {
+protected:
+	void SetUp() override {
+		// work on a copy so no cache file lands in test_data
+		_dir = std::filesystem::temp_directory_path() / "tjs_map_cache_tests";
+		std::filesystem::create_directories(_dir);
+		_map = _dir / GetParam();
+		std::filesystem::copy_file(data_file(GetParam()), _map, std::filesystem::copy_options::overwrite_existing);
+		std::filesystem::remove(details::map_cache_path(_map.string()));
+	}
+
+	void TearDown() override {
+		std::filesystem::remove(details::map_cache_path(_map.string()));
+		std::filesystem::remove(_map);
+	}
+
+	static size_t lane_index(const RoadNetwork& network, const Lane* lane) {
+		size_t index = 0;
+		for (const Edge& edge : network.edges) {
+			if (lane->parent == &edge) {
+				return index + lane->index_in_edge;
+			}
+			index += edge.lanes.size();
+		}
+		return index;
+	}
+
+	std::filesystem::path _dir;
+	std::filesystem::path _map;
+};
+
+TEST_P(MapCacheTest, CachedLoadMatchesFullLoad) {
+	WorldData fresh;
+	ASSERT_TRUE(WorldCreator::loadOSMData(fresh, _map.string(), { .use_cache = true }));
+	ASSERT_TRUE(std::filesystem::exists(details::map_cache_path(_map.string())));
+	for (const auto& entry : std::filesystem::directory_iterator(_dir)) {
+		EXPECT_NE(entry.path().extension(), ".tmp") << entry.path();
+	}
+
+	WorldData cached;
+	ASSERT_TRUE(details::load_map_cache(cached, details::map_cache_path(_map.string()), _map));
+
+	ASSERT_EQ(fresh.segments().size(), cached.segments().size());
+	const WorldSegment& a = *fresh.segments().front();
+	const WorldSegment& b = *cached.segments().front();
+
+	ASSERT_EQ(a.nodes.size(), b.nodes.size());
+	for (const auto& [uid, node] : a.nodes) {
+		const Node& other = *b.nodes.at(uid);
+		EXPECT_EQ(node->coordinates.x, other.coordinates.x);
+		EXPECT_EQ(node->coordinates.y, other.coordinates.y);
+		EXPECT_EQ(node->tags, other.tags);
+		ASSERT_EQ(node->ways.size(), other.ways.size());
+		for (size_t i = 0; i < node->ways.size(); ++i) {
+			EXPECT_EQ(node->ways[i]->uid, other.ways[i]->uid);
+		}
+	}
+	EXPECT_EQ(a.junctions.size(), b.junctions.size());
+
+	ASSERT_EQ(a.sorted_ways.size(), b.sorted_ways.size());
+	for (size_t i = 0; i < a.sorted_ways.size(); ++i) {
+		const WayInfo& way = *a.sorted_ways[i];
+		const WayInfo& other = *b.sorted_ways[i];
+		EXPECT_EQ(way.uid, other.uid);
+		EXPECT_EQ(way.lanesForward, other.lanesForward);
+		EXPECT_EQ(way.lanesBackward, other.lanesBackward);
+		EXPECT_EQ(way.maxSpeed, other.maxSpeed);
+		EXPECT_EQ(way.type, other.type);
+		EXPECT_EQ(way.nodeRefs, other.nodeRefs);
+		EXPECT_EQ(way.forwardTurns, other.forwardTurns);
+		ASSERT_EQ(way.edges.size(), other.edges.size());
+		for (size_t e = 0; e < way.edges.size(); ++e) {
+			EXPECT_EQ(way.edges[e]->get_id(), other.edges[e]->get_id());
+		}
+	}
+
+	const RoadNetwork& na = *a.road_network;
+	const RoadNetwork& nb = *b.road_network;
+	EXPECT_EQ(na.nodes.size(), nb.nodes.size());
+	EXPECT_EQ(na.ways.size(), nb.ways.size());
+	ASSERT_EQ(na.edges.size(), nb.edges.size());
+	for (size_t i = 0; i < na.edges.size(); ++i) {
+		const Edge& edge = na.edges[i];
+		const Edge& other = nb.edges[i];
+		EXPECT_EQ(edge.get_id(), other.get_id());
+		EXPECT_EQ(edge.start_node->uid, other.start_node->uid);
+		EXPECT_EQ(edge.end_node->uid, other.end_node->uid);
+		EXPECT_EQ(edge.way->uid, other.way->uid);
+		EXPECT_EQ(edge.length, other.length);
+		EXPECT_EQ(edge.orientation, other.orientation);
+		EXPECT_EQ(edge.opposite_side, other.opposite_side);
+		ASSERT_EQ(edge.outgoing_edges.size(), other.outgoing_edges.size());
+		for (size_t o = 0; o < edge.outgoing_edges.size(); ++o) {
+			EXPECT_EQ(edge.outgoing_edges[o]->get_id(), other.outgoing_edges[o]->get_id());
+		}
+
+		ASSERT_EQ(edge.lanes.size(), other.lanes.size());
+		for (size_t l = 0; l < edge.lanes.size(); ++l) {
+			const Lane& lane = edge.lanes[l];
+			const Lane& other_lane = other.lanes[l];
+			EXPECT_EQ(lane.get_id(), other_lane.get_id());
+			EXPECT_EQ(other_lane.parent, &other);
+			EXPECT_EQ(lane.turn, other_lane.turn);
+			EXPECT_EQ(lane.length, other_lane.length);
+			EXPECT_EQ(lane.rotation_angle, other_lane.rotation_angle);
+			ASSERT_EQ(lane.centerLine.size(), other_lane.centerLine.size());
+			ASSERT_EQ(lane.outgoing_connections.size(), other_lane.outgoing_connections.size());
+			for (size_t c = 0; c < lane.outgoing_connections.size(); ++c) {
+				EXPECT_EQ(lane.outgoing_connections[c]->to->get_id(), other_lane.outgoing_connections[c]->to->get_id());
+				EXPECT_EQ(lane.outgoing_connections[c]->yield, other_lane.outgoing_connections[c]->yield);
+			}
+			ASSERT_EQ(lane.incoming_connections.size(), other_lane.incoming_connections.size());
+			for (size_t c = 0; c < lane.incoming_connections.size(); ++c) {
+				EXPECT_EQ(lane.incoming_connections[c]->from->get_id(), other_lane.incoming_connections[c]->from->get_id());
+			}
+		}
+	}
+
+	ASSERT_EQ(na.lane_links.size(), nb.lane_links.size());
+	for (size_t i = 0; i < na.lane_links.size(); ++i) {
+		EXPECT_EQ(lane_index(na, na.lane_links[i].from), lane_index(nb, nb.lane_links[i].from));
+		EXPECT_EQ(lane_index(na, na.lane_links[i].to), lane_index(nb, nb.lane_links[i].to));
+	}
+	ASSERT_EQ(na.graph_nodes.size(), nb.graph_nodes.size());
+	for (size_t i = 0; i < na.graph_nodes.size(); ++i) {
+		EXPECT_EQ(na.graph_nodes[i]->uid, nb.graph_nodes[i]->uid);
+		EXPECT_EQ(nb.graph_nodes[i]->graph_index, i);
+	}
+	EXPECT_EQ(na.node_graph.offsets, nb.node_graph.offsets);
+	ASSERT_EQ(na.node_graph.size(), nb.node_graph.size());
+	for (size_t i = 0; i < na.node_graph.size(); ++i) {
+		EXPECT_EQ(na.node_graph.targets[i].edge, nb.node_graph.targets[i].edge);
+		EXPECT_EQ(na.node_graph.targets[i].target, nb.node_graph.targets[i].target);
+		EXPECT_EQ(na.node_graph.targets[i].length, nb.node_graph.targets[i].length);
+	}
+	EXPECT_EQ(na.incoming_edges.offsets, nb.incoming_edges.offsets);
+	EXPECT_EQ(na.incoming_edges.targets, nb.incoming_edges.targets);
+	EXPECT_EQ(na.edge_transitions.offsets, nb.edge_transitions.offsets);
+	EXPECT_EQ(na.edge_transitions.targets, nb.edge_transitions.targets);
+	EXPECT_EQ(na.edge_predecessors.offsets, nb.edge_predecessors.offsets);
+	EXPECT_EQ(na.edge_predecessors.targets, nb.edge_predecessors.targets);
+	EXPECT_EQ(na.lane_offsets, nb.lane_offsets);
+	EXPECT_EQ(na.lane_graph.offsets, nb.lane_graph.offsets);
+	EXPECT_EQ(na.lane_graph.targets, nb.lane_graph.targets);
+	EXPECT_EQ(na.transition_goal_masks, nb.transition_goal_masks);
+	EXPECT_EQ(na.entry_offsets, nb.entry_offsets);
+	ASSERT_EQ(na.lane_entries.size(), nb.lane_entries.size());
+	for (size_t i = 0; i < na.lane_entries.size(); ++i) {
+		ASSERT_EQ(na.lane_entries[i].lane == nullptr, nb.lane_entries[i].lane == nullptr);
+		if (na.lane_entries[i].lane) {
+			EXPECT_EQ(na.lane_entries[i].lane->get_id(), nb.lane_entries[i].lane->get_id());
+		}
+		EXPECT_EQ(na.lane_entries[i].yield, nb.lane_entries[i].yield);
+	}
+	EXPECT_EQ(na.edge_component, nb.edge_component);
+	EXPECT_EQ(na.node_component, nb.node_component);
+	EXPECT_EQ(na.component_words, nb.component_words);
+	EXPECT_EQ(na.component_reach, nb.component_reach);
+
+	ASSERT_NE(na.landmarks, nullptr);
+	ASSERT_NE(nb.landmarks, nullptr);
+	EXPECT_TRUE(std::ranges::equal(na.landmarks->landmarks(), nb.landmarks->landmarks()));
+	ASSERT_EQ(na.landmarks->distances().size(), nb.landmarks->distances().size());
+	for (size_t i = 0; i < na.landmarks->distances().size(); ++i) {
+		EXPECT_EQ(na.landmarks->distances()[i].from, nb.landmarks->distances()[i].from);
+		EXPECT_EQ(na.landmarks->distances()[i].to, nb.landmarks->distances()[i].to);
+	}
+
+	EXPECT_EQ(a.spatialGrid.cellSize, b.spatialGrid.cellSize);
+	EXPECT_EQ(a.spatialGrid.spatialGrid.size(), b.spatialGrid.spatialGrid.size());
+	std::vector<Lane*> lanes_a;
+	std::vector<Lane*> lanes_b;
+	const tjs::common::BoundingBox everything { -1e9, -1e9, 1e9, 1e9 };
+	a.spatialGrid.tree.query(everything, std::back_inserter(lanes_a));
+	b.spatialGrid.tree.query(everything, std::back_inserter(lanes_b));
+	ASSERT_EQ(lanes_a.size(), lanes_b.size());
+	for (size_t i = 0; i < lanes_a.size(); ++i) {
+		EXPECT_EQ(lanes_a[i]->get_id(), lanes_b[i]->get_id());
+	}
+	std::vector<Node*> nodes_a;
+	std::vector<Node*> nodes_b;
+	a.spatialGrid.points.query(everything, std::back_inserter(nodes_a));
+	b.spatialGrid.points.query(everything, std::back_inserter(nodes_b));
+	ASSERT_EQ(nodes_a.size(), nodes_b.size());
+	for (size_t i = 0; i < nodes_a.size(); ++i) {
+		EXPECT_EQ(nodes_a[i]->uid, nodes_b[i]->uid);
+	}
+
+	// the trees themselves, not only their contents
+	std::vector<tjs::common::RTree<Lane*>::FlatNode> tree_a;
+	std::vector<tjs::common::RTree<Lane*>::FlatNode> tree_b;
+	std::vector<tjs::common::BoundingBox> boxes_a;
+	std::vector<tjs::common::BoundingBox> boxes_b;
+	a.spatialGrid.tree.flatten(tree_a, boxes_a, lanes_a);
+	b.spatialGrid.tree.flatten(tree_b, boxes_b, lanes_b);
+	ASSERT_EQ(tree_a.size(), tree_b.size());
+	for (size_t i = 0; i < tree_a.size(); ++i) {
+		EXPECT_EQ(tree_a[i].first, tree_b[i].first);
+		EXPECT_EQ(tree_a[i].count, tree_b[i].count);
+		EXPECT_EQ(tree_a[i].leaf, tree_b[i].leaf);
+	}
+
+	// objects created after a cached load continue the id sequence
+	EXPECT_EQ(Lane().get_id(), std::ranges::max(lanes_b, {}, &Lane::get_id)->get_id() + 1);
+}
+
+TEST_P(MapCacheTest, StaleCacheIsIgnored) {
+	WorldData data;
+	ASSERT_TRUE(WorldCreator::loadOSMData(data, _map.string(), { .use_cache = true }));
+
+	// source edited after the cache was written
+	std::filesystem::last_write_time(_map, std::filesystem::last_write_time(_map) + std::chrono::seconds(5));
+	WorldData stale;
+	EXPECT_FALSE(details::load_map_cache(stale, details::map_cache_path(_map.string()), _map));
+	EXPECT_TRUE(stale.segments().empty());
+
+	// full load refreshes it
+	ASSERT_TRUE(WorldCreator::loadOSMData(data, _map.string(), { .use_cache = true }));
+	EXPECT_TRUE(details::load_map_cache(stale, details::map_cache_path(_map.string()), _map));
+}
+
+TEST_P(MapCacheTest, CorruptedCacheIsIgnored) {
+	WorldData data;
+	ASSERT_TRUE(WorldCreator::loadOSMData(data, _map.string(), { .use_cache = true }));
+	const auto cache = details::map_cache_path(_map.string());
+	std::filesystem::resize_file(cache, std::filesystem::file_size(cache) / 2);
+
+	WorldData broken;
+	EXPECT_FALSE(details::load_map_cache(broken, cache, _map));
+	EXPECT_TRUE(broken.segments().empty());
+
+	// falls back to parsing
+	EXPECT_TRUE(WorldCreator::loadOSMData(broken, _map.string(), { .use_cache = true }));
+	EXPECT_FALSE(broken.segments().front()->road_network->edges.empty());
+}
+
+INSTANTIATE_TEST_SUITE_P(
+	TestMaps,
+	MapCacheTest,
+	::testing::Values("simple_grid.osmx", "complex_streets.osmx", "test_lanes.osmx"),
+	[](const auto& info) {
+		std::string name(info.param.substr(0, info.param.find('.')));
+		return name;
+	});
@@ -0,0 +1,140 @@
+#include <stdafx.h>
+
+#include <core/data_layer/world_data.h>
+#include <core/data_layer/world_creator.h>
+#include <core/data_layer/data_types.h>
+#include <core/events/map_loading_events.h>
+
+#include <fstream>
+
+using namespace tjs::core;
+using tjs::core::events::MapLoadStage;
+
+namespace {
+	// Two crossing streets, a footway sharing node 3 and two nodes no way uses
+	constexpr std::string_view MAP = R"(<?xml version="1.0" encoding="UTF-8"?>
+<osm version="0.6">
+  <!-- nodes before ways, as OSM exports them -->
+  <node id="1" lat="41.0000" lon="-87.0010"/>
+  <node id="2" lat="41.0000" lon="-87.0000"/>
+  <node id="3" lat="41.0000" lon="-86.9990"/>
+  <node id="4" lat="41.0010" lon="-87.0000"/>
+  <node id="5" lat="40.9990" lon="-87.0000">
+    <tag k="highway" v="traffic_signals"/>
+  </node>
+  <node id="6" lat="41.0010" lon="-86.9990"/>
+  <node id="90" lat="41.0020" lon="-87.0020"/>
+  <node id="91" lat="40.9980" lon="-86.9980"/>
+  <way id="10">
+    <nd ref="1"/>
+    <nd ref="2"/>
+    <nd ref="3"/>
+    <tag k="highway" v="primary"/>
+    <tag k="name" v="Main &amp; First"/>
+    <tag k="lanes" v="2"/>
+  </way>
+  <way id="11">
+    <nd ref="4"/>
+    <nd ref="2"/>
+    <nd ref="5"/>
+    <tag k="highway" v="residential"/>
+  </way>
+  <way id="12">
+    <nd ref="3"/>
+    <nd ref="6"/>
+    <tag k="highway" v="footway"/>
+  </way>
+</osm>
+)";
+
+	std::vector<MapLoadStage> received_stages;
+	size_t received_nodes = 0;
+	size_t received_ways = 0;
+
+	void on_progress(const events::MapLoadProgress& event) {
+		if (received_stages.empty() || received_stages.back() != event.stage) {
+			received_stages.push_back(event.stage);
+		}
+		received_nodes = event.nodes;
+		received_ways = event.ways;
+	}
+} // namespace
+
+class OSMLoaderTest : public ::testing::Test {
+protected:
+	void SetUp() override {
+		_map = std::filesystem::temp_directory_path() / "tjs_osm_loader_tests.osmx";
+		std::ofstream(_map, std::ios::binary) << MAP;
+	}
+
+	void TearDown() override {
+		std::filesystem::remove(_map);
+	}
+
+	std::filesystem::path _map;
+};
+
+TEST_F(OSMLoaderTest, DropsUnreferencedNodes) {
+	WorldData world;
+	ASSERT_TRUE(details::loadOSMXmlData(world, _map.string()));
+	const WorldSegment& segment = *world.segments().front();
+
+	EXPECT_EQ(segment.ways.size(), 3);
+	EXPECT_EQ(segment.nodes.size(), 6);
+	EXPECT_FALSE(segment.nodes.contains(90));
+	EXPECT_FALSE(segment.nodes.contains(91));
+
+	EXPECT_TRUE(segment.nodes.at(5)->hasTag(NodeTags::TrafficLight));
+	EXPECT_EQ(segment.nodes.at(2)->ways.size(), 2);
+	EXPECT_EQ(segment.ways.at(10)->nodes.size(), 3);
+	EXPECT_EQ(segment.ways.at(10)->nodes.front()->uid, 1);
+
+	// dropped nodes still define the map bounds
+	EXPECT_DOUBLE_EQ(segment.boundingBox.left.longitude, -87.0020);
+	EXPECT_DOUBLE_EQ(segment.boundingBox.right.longitude, -86.9980);
+}
+
+TEST_F(OSMLoaderTest, CarWaysOnly) {
+	WorldData all;
+	ASSERT_TRUE(details::loadOSMXmlData(all, _map.string()));
+	WorldData cars;
+	ASSERT_TRUE(details::loadOSMXmlData(cars, _map.string(), { .car_ways_only = true }));
+	const WorldSegment& segment = *cars.segments().front();
+
+	EXPECT_EQ(segment.ways.size(), 2);
+	EXPECT_FALSE(segment.ways.contains(12));
+	EXPECT_FALSE(segment.nodes.contains(6));
+	EXPECT_EQ(segment.nodes.size(), 5);
+	EXPECT_EQ(segment.nodes.at(3)->ways.size(), 1);
+
+	// same projection as the full load
+	const WorldSegment& full = *all.segments().front();
+	EXPECT_EQ(segment.nodes.at(1)->coordinates.x, full.nodes.at(1)->coordinates.x);
+	EXPECT_EQ(segment.nodes.at(1)->coordinates.y, full.nodes.at(1)->coordinates.y);
+}
+
+TEST_F(OSMLoaderTest, ReportsProgress) {
+	received_stages.clear();
+	tjs::common::MessageDispatcher dispatcher;
+	dispatcher.register_handler(&on_progress, "OSMLoaderTest", "world_creator");
+
+	WorldData world;
+	ASSERT_TRUE(WorldCreator::loadOSMData(world, _map.string(), { .dispatcher = &dispatcher }));
+
+	const std::vector<MapLoadStage> expected {
+		MapLoadStage::ReadingWays,
+		MapLoadStage::ReadingNodes,
+		MapLoadStage::BuildingRoadNetwork,
+		MapLoadStage::Finished
+	};
+	EXPECT_EQ(received_stages, expected);
+	EXPECT_EQ(received_nodes, 6);
+	EXPECT_EQ(received_ways, 3);
+}
+
+TEST_F(OSMLoaderTest, MalformedFileFails) {
+	std::ofstream(_map, std::ios::binary | std::ios::trunc) << MAP.substr(0, MAP.find("<way id=\"11\">") + 10);
+	WorldData world;
+	EXPECT_FALSE(details::loadOSMXmlData(world, _map.string()));
+	EXPECT_TRUE(world.segments().empty());
+}
@@ -1,6 +1,10 @@
 #include <stdafx.h>
 
 #include <core/data_layer/data_types.h>
+#include <core/data_layer/world_creator.h>
+#include <core/data_layer/world_data.h>
+
+#include <data_loader_mixin.h>
 
 using namespace tjs::core;
 
@@ -390,3 +394,83 @@ TEST_F(SpatialGridTest, GetWaysByCoordinatesConstCorrectness) {
 	static_assert(std::is_const_v<std::remove_reference_t<decltype(result->get())>>,
 		"Should return const reference");
 }
+
+/*
+=======================================
+Nearest-neighbour lookups
+======================================
+*/
+class SpatialGridNearestTest : public ::testing::Test, public tests::DataLoaderMixin {
+protected:
+	void SetUp() override {
+		ASSERT_TRUE(WorldCreator::loadOSMData(world, data_file("complex_streets.osmx").string()));
+	}
+
+	WorldSegment& segment() {
+		return *world.segments().front();
+	}
+
+	// query points around and between the nodes of the map
+	std::vector<Coordinates> probes() {
+		std::vector<Coordinates> result;
+		size_t i = 0;
+		for (const auto& [_, node] : segment().nodes) {
+			const double shift = double(i++ % 7) * 9.5 - 30.0;
+			result.push_back(make_xy(node->coordinates.x + shift, node->coordinates.y - shift * 0.5));
+		}
+		return result;
+	}
+
+	static double segment_distance(const Coordinates& p, const Coordinates& a, const Coordinates& b) {
+		const double dx = b.x - a.x;
+		const double dy = b.y - a.y;
+		const double length2 = dx * dx + dy * dy;
+		const double t = length2 > 0.0 ? std::clamp(((p.x - a.x) * dx + (p.y - a.y) * dy) / length2, 0.0, 1.0) : 0.0;
+		return std::hypot(a.x + t * dx - p.x, a.y + t * dy - p.y);
+	}
+
+	WorldData world;
+};
+
+TEST_F(SpatialGridNearestTest, NodesMatchLinearScan) {
+	const auto& grid = segment().spatialGrid;
+	for (const Coordinates& probe : probes()) {
+		std::vector<double> expected;
+		for (const auto& [_, node] : segment().nodes) {
+			if (!node->ways.empty()) {
+				expected.push_back(std::hypot(node->coordinates.x - probe.x, node->coordinates.y - probe.y));
+			}
+		}
+		std::ranges::sort(expected);
+
+		const auto nearest = find_nearest_nodes(grid, probe, 5);
+		ASSERT_EQ(nearest.size(), std::min<size_t>(5, expected.size()));
+		for (size_t i = 0; i < nearest.size(); ++i) {
+			EXPECT_DOUBLE_EQ(std::hypot(nearest[i]->coordinates.x - probe.x, nearest[i]->coordinates.y - probe.y), expected[i]);
+		}
+		EXPECT_EQ(find_nearest_node(grid, probe), nearest.front());
+		EXPECT_EQ(find_nearest_node(grid, probe, expected.front() * 0.5), expected.front() > 0.0 ? nullptr : nearest.front());
+	}
+}
+
+TEST_F(SpatialGridNearestTest, LanesMatchLinearScan) {
+	const auto& grid = segment().spatialGrid;
+	for (const Coordinates& probe : probes()) {
+		double expected = std::numeric_limits<double>::infinity();
+		for (const Edge& edge : segment().road_network->edges) {
+			for (const Lane& lane : edge.lanes) {
+				for (size_t i = 0; i + 1 < lane.centerLine.size(); ++i) {
+					expected = std::min(expected, segment_distance(probe, lane.centerLine[i], lane.centerLine[i + 1]));
+				}
+			}
+		}
+
+		const Lane* lane = find_nearest_lane(grid, probe);
+		ASSERT_NE(lane, nullptr);
+		double found = std::numeric_limits<double>::infinity();
+		for (size_t i = 0; i + 1 < lane->centerLine.size(); ++i) {
+			found = std::min(found, segment_distance(probe, lane->centerLine[i], lane->centerLine[i + 1]));
+		}
+		EXPECT_NEAR(found, expected, 1e-9);
+	}
+}
@@ -0,0 +1,92 @@
+#include <stdafx.h>
+
+#include <core/data_layer/vehicle.h>
+
+using namespace tjs::core;
+
+TEST(VehicleStoreTest, ReusesReleasedRowsAndRecords) {
+	VehicleStore store;
+	Vehicle first {};
+	Vehicle second {};
+	store.acquire(first);
+	store.acquire(second);
+	EXPECT_EQ(store.rows(), 2u);
+	EXPECT_NE(first.row, second.row);
+	EXPECT_NE(first.id, second.id);
+
+	first.s_on_lane() = 12.0;
+	first.currentSpeed() = 3.0f;
+	first.uid() = 7;
+	second.s_on_lane() = 5.0;
+
+	const uint32_t row = first.row;
+	const uint32_t id = first.id;
+	store.release(first);
+	EXPECT_EQ(store.live(), 1u);
+
+	Vehicle third {};
+	store.acquire(third);
+	EXPECT_EQ(third.row, row);
+	EXPECT_EQ(third.id, id);
+	EXPECT_EQ(store.rows(), 2u);
+	// reused slots start from scratch
+	EXPECT_EQ(third.s_on_lane(), 0.0);
+	EXPECT_EQ(third.currentSpeed(), 0.0f);
+	EXPECT_EQ(third.uid(), 0u);
+	EXPECT_EQ(second.s_on_lane(), 5.0);
+}
+
+TEST(VehicleStoreTest, CommitStepMovesToNextState) {
+	VehicleStore store;
+	Vehicle moving {};
+	Vehicle standing {};
+	store.acquire(moving);
+	store.acquire(standing);
+
+	moving.s_on_lane() = 1.0;
+	moving.s_next() = 2.5;
+	moving.v_next() = 4.0f;
+	standing.s_on_lane() = 3.0;
+	standing.s_next() = 3.0;
+
+	store.commit_step();
+	EXPECT_EQ(moving.s_on_lane(), 2.5);
+	EXPECT_EQ(moving.currentSpeed(), 4.0f);
+	EXPECT_TRUE(moving.has_position_changes());
+	EXPECT_EQ(standing.s_on_lane(), 3.0);
+	EXPECT_FALSE(standing.has_position_changes());
+}
+
+TEST(VehicleStoreTest, ReorderFollowsGivenOrder) {
+	VehicleStore store;
+	std::array<Vehicle, 4> vehicles {};
+	for (size_t i = 0; i < vehicles.size(); ++i) {
+		store.acquire(vehicles[i]);
+		vehicles[i].s_on_lane() = 10.0 * i;
+		vehicles[i].state() = static_cast<uint16_t>(i);
+		vehicles[i].uid() = 100 + i;
+	}
+	store.release(vehicles[1]);
+
+	std::vector<Vehicle*> order { &vehicles[3], &vehicles[0], &vehicles[2] };
+	ASSERT_TRUE(store.reorder(order));
+	EXPECT_EQ(store.rows(), 3u);
+	EXPECT_EQ(store.live(), 3u);
+	for (size_t i = 0; i < order.size(); ++i) {
+		EXPECT_EQ(order[i]->row, i);
+	}
+	// rows move with their vehicle, records stay put
+	EXPECT_EQ(vehicles[3].s_on_lane(), 30.0);
+	EXPECT_EQ(vehicles[3].state(), 3);
+	EXPECT_EQ(vehicles[0].s_on_lane(), 0.0);
+	EXPECT_EQ(vehicles[2].uid(), 102u);
+	EXPECT_EQ(store.s_on_lane[0], 30.0);
+
+	// a missing or repeated vehicle leaves the store untouched
+	std::vector<Vehicle*> repeated { &vehicles[3], &vehicles[3], &vehicles[2] };
+	EXPECT_FALSE(store.reorder(repeated));
+	std::vector<Vehicle*> partial { &vehicles[3], &vehicles[0] };
+	EXPECT_FALSE(store.reorder(partial));
+	EXPECT_EQ(vehicles[3].row, 0u);
+	EXPECT_EQ(vehicles[2].s_on_lane(), 20.0);
+}
@@ -0,0 +1,139 @@
+#include "stdafx.h"
+
+#include <data_loader_mixin.h>
+#include <core/data_layer/world_creator.h>
+#include <core/data_layer/world_data.h>
+#include <core/map_math/landmarks.h>
+#include <core/map_math/path_finder.h>
+#include <core/map_math/search_context.h>
+
+#include <queue>
+
+using namespace tjs::core;
+
+namespace {
+	// Plain Dijkstra over node_graph
+	std::vector<double> distances_from(const RoadNetwork& network, uint32_t source) {
+		using Entry = std::pair<double, uint32_t>;
+		std::vector<double> dist(network.graph_nodes.size(), std::numeric_limits<double>::infinity());
+		std::priority_queue<Entry, std::vector<Entry>, std::greater<>> open;
+		dist[source] = 0.0;
+		open.emplace(0.0, source);
+		while (!open.empty()) {
+			const auto [d, node] = open.top();
+			open.pop();
+			if (d > dist[node]) {
+				continue;
+			}
+			for (const GraphArc& arc : network.node_graph[node]) {
+				if (d + arc.length < dist[arc.target]) {
+					dist[arc.target] = d + arc.length;
+					open.emplace(dist[arc.target], arc.target);
+				}
+			}
+		}
+		return dist;
+	}
+
+	double route_cost(const RoadNetwork& network, const std::vector<uint32_t>& path) {
+		double cost = 0.0;
+		for (uint32_t edge : path) {
+			cost += network.edges[edge].length;
+		}
+		return cost;
+	}
+
+	// Every lane to every node: ALT finds a route exactly when A* does, of the
+	// same length when `same_cost`. Closing nodes makes the search from a lane
+	// inexact under turn restrictions whatever the heuristic, so there the
+	// heuristic may change which detour is found.
+	void expect_same_routes(const RoadNetwork& network, bool same_cost) {
+		algo::SearchContext alt;
+		algo::SearchContext a_star;
+		size_t found = 0;
+		for (const Edge& edge : network.edges) {
+			for (const Lane& lane : edge.lanes) {
+				for (const Node* target : network.graph_nodes) {
+					const bool expected = algo::PathFinder::find_edge_path_a_star_from_lane(network, &lane, target, true, a_star);
+					ASSERT_EQ(algo::PathFinder::find_edge_path_alt_from_lane(network, &lane, target, true, alt), expected);
+					found += expected;
+					if (expected && same_cost) {
+						EXPECT_NEAR(route_cost(network, alt.path()), route_cost(network, a_star.path()), 1e-6);
+					}
+				}
+			}
+		}
+		EXPECT_GT(found, 0);
+	}
+} // namespace
+
+class LandmarkTest : public ::testing::TestWithParam<const char*>, public tjs::core::tests::DataLoaderMixin {
+protected:
+	WorldData world;
+
+	// test_data first, then sample_maps
+	void SetUp() override {
+		auto path = data_file(GetParam());
+		if (!std::filesystem::exists(path)) {
+			path = sample_file(GetParam());
+		}
+		ASSERT_TRUE(WorldCreator::loadOSMData(world, path.string()));
+	}
+
+	RoadNetwork& network() {
+		return *world.segments().front()->road_network;
+	}
+
+	static bool has_turn_restrictions() {
+		return std::string_view(GetParam()).find("turn_restrictions") != std::string_view::npos;
+	}
+};
+
+TEST_P(LandmarkTest, BoundsAreAdmissible) {
+	auto& net = network();
+	net.landmarks = algo::LandmarkTable::build(net, 4);
+	ASSERT_EQ(net.landmarks->landmarks().size(), 4);
+	ASSERT_EQ(net.landmarks->node_count(), net.graph_nodes.size());
+
+	double tightest = 0.0;
+	for (uint32_t source = 0; source < net.graph_nodes.size(); ++source) {
+		const auto dist = distances_from(net, source);
+		for (uint32_t target = 0; target < dist.size(); ++target) {
+			const double bound = net.landmarks->lower_bound(source, target);
+			if (std::isfinite(dist[target])) {
+				EXPECT_LE(bound, dist[target] + 1e-6);
+				tightest = std::max(tightest, bound);
+			}
+		}
+	}
+	EXPECT_GT(tightest, 0.0);
+}
+
+TEST_P(LandmarkTest, SameRoutesAsAStar) {
+	auto& net = network();
+	net.landmarks = algo::LandmarkTable::build(net);
+	expect_same_routes(net, !has_turn_restrictions());
+}
+
+TEST_P(LandmarkTest, TablesSurviveGrowingCosts) {
+	auto& net = network();
+	net.landmarks = algo::LandmarkTable::build(net);
+	const auto table = net.landmarks;
+
+	// congestion only makes edges longer, the bounds still hold
+	for (uint32_t edge = 0; edge < net.edges.size(); edge += 3) {
+		net.set_edge_length(edge, net.edges[edge].length * 2.5);
+	}
+	EXPECT_EQ(net.landmarks, table);
+	expect_same_routes(net, !has_turn_restrictions());
+
+	net.set_edge_length(0, table->base_length(0) * 0.5);
+	EXPECT_EQ(net.landmarks, nullptr);
+
+	net.landmarks = algo::LandmarkTable::build(net);
+	net.build_node_graph();
+	EXPECT_EQ(net.landmarks, nullptr);
+}
+
+INSTANTIATE_TEST_SUITE_P(Maps, LandmarkTest,
+	::testing::Values("simple_grid.osmx", "complex_streets.osmx", "cross_junction.osmx", "grid_osm_with_turn_restrictions.osmx"));
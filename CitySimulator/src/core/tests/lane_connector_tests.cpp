@@ -3,6 +3,7 @@
 #include <data_loader_mixin.h>
 #include <core/data_layer/world_creator.h>
 #include <core/data_layer/world_data.h>
+#include <core/map_math/lane_connector_builder.h>
 
 using namespace tjs::core;
 
@@ -30,3 +31,83 @@ TEST_F(LaneConnectorTest, ConnectionsCreated) {
 	const auto& lane = incoming->lanes.front();
 	EXPECT_GT(lane.outgoing_connections.size(), 0u);
 }
+
+class LaneConnectorParallelTest : public ::testing::TestWithParam<std::string_view>, public tjs::core::tests::DataLoaderMixin {
+protected:
+	using LinkIds = std::vector<std::tuple<int, int, bool>>;
+
+	static LinkIds links_of(const RoadNetwork& network) {
+		LinkIds ids;
+		for (const auto& link : network.lane_links) {
+			ids.emplace_back(link.from->get_id(), link.to->get_id(), link.yield);
+		}
+		return ids;
+	}
+
+	// per-lane connection lists in lane order
+	static std::vector<std::vector<int>> connections_of(const RoadNetwork& network) {
+		std::vector<std::vector<int>> result;
+		for (const auto& edge : network.edges) {
+			for (const auto& lane : edge.lanes) {
+				auto& out = result.emplace_back();
+				for (const auto& link : lane.outgoing_connections) {
+					out.push_back(link->to->get_id());
+				}
+				auto& in = result.emplace_back();
+				for (const auto& link : lane.incoming_connections) {
+					in.push_back(link->from->get_id());
+				}
+			}
+		}
+		return result;
+	}
+
+	WorldData world;
+};
+
+TEST_P(LaneConnectorParallelTest, MatchesSequentialScan) {
+	// the sample grid is big enough to be split between several workers
+	const auto map = std::filesystem::exists(data_file(GetParam())) ? data_file(GetParam()) : sample_file(GetParam());
+	ASSERT_TRUE(WorldCreator::loadOSMData(world, map.string()));
+	auto& network = *world.segments().front()->road_network;
+
+	// reference: one node at a time with the full edge scan
+	for (auto& edge : network.edges) {
+		for (auto& lane : edge.lanes) {
+			lane.outgoing_connections.clear();
+			lane.incoming_connections.clear();
+		}
+	}
+	network.lane_links.clear();
+	network.lane_graph.clear();
+	for (const auto& [nid, node] : network.nodes) {
+		algo::details::process_node(network, node);
+	}
+	const auto expected_links = links_of(network);
+	const auto expected_connections = connections_of(network);
+	ASSERT_FALSE(expected_links.empty());
+
+	for (size_t threads : { 1u, 4u }) {
+		algo::LaneConnectorBuilder::build_lane_connections(network, threads);
+		EXPECT_EQ(links_of(network), expected_links) << threads << " threads";
+		EXPECT_EQ(connections_of(network), expected_connections) << threads << " threads";
+		ASSERT_EQ(network.lane_graph.rows(), network.lane_count());
+		for (const Edge& edge : network.edges) {
+			for (const Lane& lane : edge.lanes) {
+				const auto links = network.outgoing_links(&lane);
+				ASSERT_EQ(std::ranges::distance(links), lane.outgoing_connections.size());
+				for (size_t i = 0; i < lane.outgoing_connections.size(); ++i) {
+					EXPECT_EQ(links[i], &*lane.outgoing_connections[i]);
+				}
+			}
+		}
+	}
+}
+
+INSTANTIATE_TEST_SUITE_P(
+	TestMaps,
+	LaneConnectorParallelTest,
+	::testing::Values("cross_junction.osmx", "complex_streets.osmx", "test_lanes.osmx", "simple_grid.osmx", "10k_lanes_grid.osmx"),
+	[](const auto& info) {
+		return "map_" + std::string(info.param.substr(0, info.param.find('.')));
+	});
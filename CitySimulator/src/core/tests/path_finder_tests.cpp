@@ -4,6 +4,7 @@
 #include <core/data_layer/world_creator.h>
 #include <core/data_layer/world_data.h>
 #include <core/map_math/path_finder.h>
+#include <core/map_math/search_context.h>
 
 using namespace tjs::core;
 
@@ -141,3 +142,166 @@ TEST_F(ChicagoGridTest, EdgePathFromLane) {
 		EXPECT_EQ(path_with_adjacent[i], expected_path[i]);
 	}
 }
+
+TEST_F(ComplexStreetsTest, DenseGraphMatchesEdges) {
+	auto& network = *world.segments().front()->road_network;
+	ASSERT_EQ(network.node_graph.rows(), network.graph_nodes.size());
+	ASSERT_EQ(network.node_graph.size(), network.edges.size());
+	ASSERT_EQ(network.edge_transitions.rows(), network.edges.size());
+
+	for (size_t i = 0; i < network.graph_nodes.size(); ++i) {
+		EXPECT_EQ(network.graph_nodes[i]->graph_index, i);
+	}
+	for (const Edge& edge : network.edges) {
+		const auto outgoing = network.outgoing_edges(edge.start_node);
+		EXPECT_EQ(std::ranges::count(outgoing, &edge), 1);
+		for (const GraphArc& arc : network.arcs(edge.start_node)) {
+			EXPECT_EQ(network.graph_nodes[arc.target], network.edges[arc.edge].end_node);
+			EXPECT_EQ(arc.length, network.edges[arc.edge].length);
+		}
+
+		const auto transitions = network.edge_transitions[network.edge_index(&edge)];
+		ASSERT_EQ(transitions.size(), edge.outgoing_edges.size());
+		for (size_t t = 0; t < transitions.size(); ++t) {
+			EXPECT_EQ(&network.edges[transitions[t]], edge.outgoing_edges[t]);
+		}
+	}
+}
+
+TEST_F(ComplexStreetsTest, ReusedContextMatchesFreshOne) {
+	auto& network = *world.segments().front()->road_network;
+
+	std::vector<const Lane*> lanes;
+	for (const Edge& edge : network.edges) {
+		for (const Lane& lane : edge.lanes) {
+			lanes.push_back(&lane);
+		}
+	}
+
+	algo::SearchContext reused;
+	size_t found = 0;
+	for (const Lane* lane : lanes) {
+		for (const Node* target : network.graph_nodes) {
+			algo::SearchContext fresh;
+			const bool expected = algo::PathFinder::find_edge_path_a_star_from_lane(network, lane, target, true, fresh);
+			ASSERT_EQ(algo::PathFinder::find_edge_path_a_star_from_lane(network, lane, target, true, reused), expected);
+			EXPECT_EQ(reused.path(), fresh.path());
+			found += expected;
+		}
+	}
+	EXPECT_GT(found, 0);
+
+	// node-to-node search through the same context
+	Node* start = network.nodes.at(1);
+	Node* target = network.nodes.at(16);
+	ASSERT_TRUE(algo::PathFinder::find_edge_path_a_star(network, start, target, reused));
+	const auto edges = algo::PathFinder::to_edges(network, reused.path());
+	ASSERT_FALSE(edges.empty());
+	EXPECT_EQ(edges.front()->start_node, start);
+	EXPECT_EQ(edges.back()->end_node, target);
+	for (size_t i = 1; i < edges.size(); ++i) {
+		EXPECT_EQ(edges[i - 1]->end_node, edges[i]->start_node);
+	}
+}
+
+TEST_F(ComplexStreetsTest, ComponentsTellReachableGoals) {
+	auto& network = *world.segments().front()->road_network;
+	ASSERT_EQ(network.edge_component.size(), network.edges.size());
+	ASSERT_EQ(network.node_component.size(), network.graph_nodes.size());
+
+	// topological numbering
+	for (uint32_t e = 0; e < network.edges.size(); ++e) {
+		for (uint32_t next : network.edge_transitions[e]) {
+			EXPECT_LE(network.edge_component[e], network.edge_component[next]);
+		}
+	}
+
+	// exact both ways, against a plain search over edge_transitions
+	ASSERT_FALSE(network.component_reach.empty());
+	size_t rejected = 0;
+	for (const Edge& edge : network.edges) {
+		std::vector<bool> seen(network.edges.size(), false);
+		std::vector<uint32_t> queue;
+		for (uint32_t next : network.edge_transitions[network.edge_index(&edge)]) {
+			seen[next] = true;
+			queue.push_back(next);
+		}
+		for (size_t head = 0; head < queue.size(); ++head) {
+			for (uint32_t next : network.edge_transitions[queue[head]]) {
+				if (!seen[next]) {
+					seen[next] = true;
+					queue.push_back(next);
+				}
+			}
+		}
+
+		for (const Node* target : network.graph_nodes) {
+			const bool reachable = std::ranges::any_of(queue, [&](uint32_t e) { return network.edges[e].end_node == target; });
+			EXPECT_EQ(network.can_reach(edge, *target), reachable) << "edge " << network.edge_index(&edge) << ", node " << target->graph_index;
+			rejected += !reachable;
+		}
+	}
+	EXPECT_GT(rejected, 0);
+}
+
+TEST(RoadNetworkComponents, DisjointRoadsDoNotReachEachOther) {
+	WorldData world;
+	tjs::core::tests::DataLoaderMixin loader;
+	ASSERT_TRUE(WorldCreator::loadOSMData(world, loader.data_file("disjoint_roads.osmx").string()));
+	auto& network = *world.segments().front()->road_network;
+
+	// the other road sits in a higher component for one of the two, which
+	// comparing component numbers alone lets through
+	size_t higher = 0;
+	for (const Edge& edge : network.edges) {
+		for (const Edge& other : network.edges) {
+			if (edge.way == other.way) {
+				continue;
+			}
+			EXPECT_FALSE(network.can_reach(edge, *other.end_node));
+			higher += network.edge_component[network.edge_index(&other)] > network.edge_component[network.edge_index(&edge)];
+		}
+	}
+	EXPECT_GT(higher, 0);
+
+	// along its own road
+	const Edge& first = *std::ranges::find_if(network.edges, [](const Edge& e) { return !e.outgoing_edges.empty(); });
+	EXPECT_TRUE(network.can_reach(first, *first.outgoing_edges.front()->end_node));
+}
+
+TEST_F(ComplexStreetsTest, TransitionTablesMatchLaneLinks) {
+	auto& network = *world.segments().front()->road_network;
+	size_t entries = 0;
+	for (const Edge& edge : network.edges) {
+		const auto transitions = network.edge_transitions[network.edge_index(&edge)];
+		for (uint32_t slot = 0; slot < transitions.size(); ++slot) {
+			const Edge& next = network.edges[transitions[slot]];
+			ASSERT_EQ(network.transition_slot(edge, next), slot);
+
+			uint32_t mask = 0;
+			for (const Lane& lane : edge.lanes) {
+				// non-yield first, then the smallest lane shift, first link on ties
+				const LaneLink* best = nullptr;
+				for (const LaneLinkHandler& h : lane.outgoing_connections) {
+					if (h->to->parent != &next) {
+						continue;
+					}
+					mask |= 1u << lane.index_in_edge;
+					const auto shift = [&lane](const LaneLink& link) { return std::abs(int(link.to->index_in_edge) - int(lane.index_in_edge)); };
+					if (!best || (best->yield && !h->yield) || (best->yield == h->yield && shift(*h) < shift(*best))) {
+						best = &*h;
+					}
+				}
+
+				const LaneEntry& entry = network.lane_entry(lane, slot);
+				EXPECT_EQ(entry.lane, best ? best->to : nullptr);
+				if (best) {
+					EXPECT_EQ(entry.yield, best->yield);
+					++entries;
+				}
+			}
+			EXPECT_EQ(network.goal_mask(edge, slot), mask);
+		}
+	}
+	EXPECT_GT(entries, 0);
+}
@@ -0,0 +1,118 @@
+#include "stdafx.h"
+
+#include <data_loader_mixin.h>
+#include <core/data_layer/world_creator.h>
+#include <core/data_layer/world_data.h>
+#include <core/map_math/shortest_path_tree.h>
+
+using namespace tjs::core;
+
+namespace {
+	constexpr double INF = std::numeric_limits<double>::infinity();
+
+	// Bellman-Ford over the same edge labels, from every edge leaving `source`
+	std::vector<double> node_distances(const RoadNetwork& network, uint32_t source) {
+		std::vector<double> edge_distance(network.edges.size(), INF);
+		for (const GraphArc& arc : network.node_graph[source]) {
+			edge_distance[arc.edge] = arc.length;
+		}
+		for (bool changed = true; changed;) {
+			changed = false;
+			for (uint32_t edge = 0; edge < network.edges.size(); ++edge) {
+				for (uint32_t next : network.edge_transitions[edge]) {
+					const double candidate = edge_distance[edge] + network.edges[next].length;
+					if (candidate < edge_distance[next]) {
+						edge_distance[next] = candidate;
+						changed = true;
+					}
+				}
+			}
+		}
+
+		std::vector<double> result(network.graph_nodes.size(), INF);
+		for (uint32_t edge = 0; edge < network.edges.size(); ++edge) {
+			double& distance = result[network.edges[edge].end_node->graph_index];
+			distance = std::min(distance, edge_distance[edge]);
+		}
+		result[source] = 0.0;
+		return result;
+	}
+} // namespace
+
+class ShortestPathTreeTest : public ::testing::TestWithParam<const char*>, public tjs::core::tests::DataLoaderMixin {
+protected:
+	WorldData world;
+
+	// test_data first, then sample_maps
+	void SetUp() override {
+		auto path = data_file(GetParam());
+		if (!std::filesystem::exists(path)) {
+			path = sample_file(GetParam());
+		}
+		ASSERT_TRUE(WorldCreator::loadOSMData(world, path.string()));
+	}
+
+	RoadNetwork& network() {
+		return *world.segments().front()->road_network;
+	}
+};
+
+TEST_P(ShortestPathTreeTest, MatchesReferenceAndRoutesAreValid) {
+	const auto& net = network();
+	algo::ShortestPathTree tree;
+	std::vector<uint32_t> route;
+	size_t reached = 0;
+	for (uint32_t source = 0; source < net.graph_nodes.size(); ++source) {
+		ASSERT_TRUE(tree.build(net, net.graph_nodes[source]));
+		const auto expected = node_distances(net, source);
+		for (uint32_t node = 0; node < expected.size(); ++node) {
+			EXPECT_DOUBLE_EQ(tree.distance(node), expected[node]);
+			ASSERT_EQ(tree.route_to(node, route), std::isfinite(expected[node]));
+			if (route.empty()) {
+				continue;
+			}
+
+			++reached;
+			double length = 0.0;
+			for (size_t i = 0; i < route.size(); ++i) {
+				length += net.edges[route[i]].length;
+				if (i > 0) {
+					const auto transitions = net.edge_transitions[route[i - 1]];
+					EXPECT_NE(std::ranges::find(transitions, route[i]), transitions.end());
+				}
+			}
+			EXPECT_EQ(net.edges[route.front()].start_node->graph_index, source);
+			EXPECT_EQ(net.edges[route.back()].end_node->graph_index, node);
+			EXPECT_NEAR(length, tree.distance(node), 1e-6);
+		}
+	}
+	EXPECT_GT(reached, 0);
+}
+
+TEST_P(ShortestPathTreeTest, MatrixMatchesTrees) {
+	const auto& net = network();
+	std::vector<const Node*> origins;
+	std::vector<const Node*> destinations;
+	for (uint32_t node = 0; node < net.graph_nodes.size(); ++node) {
+		(node % 2 ? origins : destinations).push_back(net.graph_nodes[node]);
+	}
+	// not in the graph: the column stays infinite
+	Node outside;
+	destinations.push_back(&outside);
+
+	const auto matrix = algo::distance_matrix(net, origins, destinations, 3);
+	ASSERT_EQ(matrix.size(), origins.size() * destinations.size());
+	EXPECT_EQ(algo::distance_matrix(net, origins, destinations, 1), matrix);
+
+	algo::ShortestPathTree tree;
+	for (size_t row = 0; row < origins.size(); ++row) {
+		ASSERT_TRUE(tree.build(net, origins[row]));
+		for (size_t column = 0; column + 1 < destinations.size(); ++column) {
+			EXPECT_DOUBLE_EQ(matrix[row * destinations.size() + column], tree.distance(destinations[column]->graph_index));
+		}
+		EXPECT_EQ(matrix[row * destinations.size() + destinations.size() - 1], INF);
+	}
+}
+
+INSTANTIATE_TEST_SUITE_P(Maps, ShortestPathTreeTest,
+	::testing::Values("simple_grid.osmx", "complex_streets.osmx", "cross_junction.osmx", "grid_osm_with_turn_restrictions.osmx"));
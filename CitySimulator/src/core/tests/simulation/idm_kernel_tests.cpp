@@ -0,0 +1,96 @@
+#include "stdafx.h"
+
+#include <core/simulation/movement/idm/idm_kernel.h>
+#include <core/simulation/movement/idm/idm_utils.h>
+#include <core/simulation/movement/idm/lane_agnostic_movement.h>
+
+using namespace tjs::core::simulation;
+using namespace tjs::core::simulation::idm;
+
+class IDMKernelTest : public ::testing::TestWithParam<KernelIsa> {
+protected:
+	// Deterministic spread over the whole operating range: stopped to speeding,
+	// bumper-to-bumper to free road. 1003 samples to exercise the vector tails.
+	void fill(size_t n) {
+		std::mt19937 rng(42);
+		std::uniform_real_distribution<float> speed(0.0f, 35.0f);
+		std::uniform_real_distribution<float> gap(0.0f, 150.0f);
+
+		v_follower.resize(n);
+		v_leader.resize(n);
+		s_gap.resize(n);
+		for (size_t i = 0; i < n; ++i) {
+			v_follower[i] = speed(rng);
+			v_leader[i] = speed(rng);
+			s_gap[i] = gap(rng);
+		}
+		s_gap[0] = 0.0f;
+		s_gap[1] = FREE_ROAD_GAP;
+		v_follower[2] = 0.0f;
+	}
+
+	std::vector<float> v_follower;
+	std::vector<float> v_leader;
+	std::vector<float> s_gap;
+};
+
+TEST_P(IDMKernelTest, MatchesScalarWithinTolerance) {
+	const idm_params_t p {};
+	fill(1003);
+
+	std::vector<float> out(v_follower.size());
+	idm_accel_batch(v_follower.data(), v_leader.data(), s_gap.data(), out.data(), out.size(), p, GetParam());
+
+	for (size_t i = 0; i < out.size(); ++i) {
+		const float expected = idm_scalar(v_follower[i], v_leader[i], s_gap[i], p);
+		ASSERT_NEAR(out[i], expected, KERNEL_TOLERANCE) << "sample " << i << " isa " << to_string(GetParam());
+	}
+}
+
+TEST_P(IDMKernelTest, NonStandardExponentFallsBackToScalar) {
+	idm_params_t p {};
+	p.delta = 3.5f;
+	fill(17);
+
+	std::vector<float> out(v_follower.size());
+	idm_accel_batch(v_follower.data(), v_leader.data(), s_gap.data(), out.data(), out.size(), p, GetParam());
+
+	for (size_t i = 0; i < out.size(); ++i) {
+		EXPECT_EQ(out[i], idm_scalar(v_follower[i], v_leader[i], s_gap[i], p));
+	}
+}
+
+INSTANTIATE_TEST_SUITE_P(
+	AllIsa,
+	IDMKernelTest,
+	::testing::Values(KernelIsa::Scalar, KernelIsa::SSE, KernelIsa::AVX2));
+
+TEST(IDMKernelLeaderInputs, MatchesActualGap) {
+	LaneSoA lane;
+	lane.resize(3);
+	lane.s_on_lane = { 100.0f, 90.0f, 89.0f };
+	lane.v_follower = { 10.0f, 8.0f, 6.0f };
+	lane.length = { 4.0f, 5.0f, 4.0f };
+
+	build_leader_inputs(lane, 0, 3);
+
+	EXPECT_EQ(lane.s_gap[0], FREE_ROAD_GAP);
+	EXPECT_EQ(lane.s_gap[1], actual_gap(100.0f, 90.0f, 4.0f, 5.0f));
+	EXPECT_EQ(lane.s_gap[2], 0.0f); // overlapping vehicles are clamped
+	EXPECT_EQ(lane.v_leader, lane.v_follower);
+}
+
+TEST(IDMKernelLeaderInputs, LanesInOneBatchAreIndependent) {
+	LaneSoA lanes;
+	lanes.resize(4);
+	lanes.s_on_lane = { 50.0f, 40.0f, 80.0f, 60.0f };
+	lanes.v_follower = { 5.0f, 5.0f, 7.0f, 7.0f };
+	lanes.length = { 4.0f, 4.0f, 4.0f, 4.0f };
+
+	build_leader_inputs(lanes, 0, 2);
+	build_leader_inputs(lanes, 2, 2);
+
+	// second lane starts with its own free road, not behind the last car of the first lane
+	EXPECT_EQ(lanes.s_gap[2], FREE_ROAD_GAP);
+	EXPECT_EQ(lanes.s_gap[3], actual_gap(80.0f, 60.0f, 4.0f, 4.0f));
+}
@@ -0,0 +1,83 @@
+#include "stdafx.h"
+
+#include <core/data_layer/world_creator.h>
+#include <core/data_layer/world_data.h>
+#include <core/data_layer/lane.h>
+#include <core/data_layer/edge.h>
+#include <core/store_models/idata_model.h>
+#include <core/store_models/vehicle_analyze_data.h>
+#include <core/simulation/simulation_system.h>
+
+#include <data_loader_mixin.h>
+
+using namespace tjs::core;
+using namespace tjs::core::simulation;
+
+namespace {
+	struct VehicleTrace {
+		double s_on_lane;
+		float speed;
+		uint16_t state;
+		int lane_id;
+		int target_id;
+
+		bool operator==(const VehicleTrace&) const = default;
+	};
+
+	class IDMParallelTest
+		: public ::testing::Test,
+		  public ::tests::DataLoaderMixin {
+	protected:
+		// Runs `steps` IDM steps on a freshly loaded map and records every vehicle after each step
+		std::vector<VehicleTrace> run(size_t threads, int steps) {
+			Lane::reset_id();
+			Edge::reset_id();
+
+			WorldData world;
+			EXPECT_TRUE(WorldCreator::loadOSMData(world, data_file("simple_grid.osmx").string()));
+
+			model::DataModelStore store;
+			store.create<model::VehicleAnalyzeData>();
+
+			SimulationSettings settings;
+			settings.randomSeed = false;
+			settings.seedValue = 42;
+			settings.vehiclesCount = 150;
+			settings.movement_algo = MovementAlgoType::IDM;
+			settings.simulation_threads = threads;
+
+			TrafficSimulationSystem system(world, store, settings);
+			system.initialize();
+			EXPECT_EQ(system.worker_pool().size(), threads);
+
+			std::vector<VehicleTrace> trace;
+			for (int i = 0; i < steps; ++i) {
+				system.step();
+				for (Vehicle* v : system.vehicle_system().vehicles()) {
+					trace.push_back(VehicleTrace {
+						v->s_on_lane(),
+						v->currentSpeed(),
+						v->state(),
+						v->current_lane ? v->current_lane->get_id() : -1,
+						v->lane_target ? v->lane_target->get_id() : -1 });
+				}
+			}
+			system.release();
+			return trace;
+		}
+	};
+} // namespace
+
+TEST_F(IDMParallelTest, MultithreadedPhase1IsBitIdentical) {
+	const auto serial = run(1, 200);
+	ASSERT_FALSE(serial.empty());
+	ASSERT_TRUE(std::ranges::any_of(serial, [](const VehicleTrace& t) { return t.speed > 0.0f; }));
+
+	for (size_t threads : { 2u, 4u, 7u }) {
+		const auto parallel = run(threads, 200);
+		ASSERT_EQ(serial.size(), parallel.size()) << "threads = " << threads;
+		for (size_t i = 0; i < serial.size(); ++i) {
+			ASSERT_EQ(serial[i], parallel[i]) << "threads = " << threads << ", record " << i;
+		}
+	}
+}
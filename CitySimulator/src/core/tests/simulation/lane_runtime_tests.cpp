@@ -0,0 +1,179 @@
+#include "stdafx.h"
+
+#include <core/data_layer/world_creator.h>
+#include <core/data_layer/world_data.h>
+#include <core/data_layer/lane.h>
+#include <core/data_layer/edge.h>
+#include <core/data_layer/vehicle.h>
+#include <core/store_models/idata_model.h>
+#include <core/store_models/vehicle_analyze_data.h>
+#include <core/simulation/simulation_system.h>
+#include <core/simulation/movement/movement_runtime_structures.h>
+
+#include <data_loader_mixin.h>
+
+using namespace tjs::core;
+using namespace tjs::core::simulation;
+
+namespace {
+	class LaneRuntimeTest : public ::testing::Test {
+	protected:
+		void SetUp() override {
+			for (size_t i = 0; i < vehicles.size(); ++i) {
+				store.acquire(vehicles[i]);
+				vehicles[i].idx_in_target_lane = LaneRuntime::NO_SLOT;
+				vehicles[i].s_on_lane() = 10.0 * i;
+			}
+		}
+
+		void expect_positions() const {
+			for (size_t i = 0; i < rt.idx.size(); ++i) {
+				EXPECT_EQ(rt.idx[i]->idx_in_lane, i);
+				if (i > 0) {
+					EXPECT_GE(rt.idx[i - 1]->s_on_lane(), rt.idx[i]->s_on_lane());
+				}
+			}
+			for (size_t i = 0; i < rt.vehicle_slots.size(); ++i) {
+				EXPECT_EQ(rt.vehicle_slots[i]->idx_in_target_lane, i);
+			}
+		}
+
+		VehicleStore store;
+		std::array<Vehicle, 5> vehicles {};
+		LaneRuntime rt {};
+	};
+} // namespace
+
+TEST_F(LaneRuntimeTest, InsertEraseKeepPositions) {
+	for (Vehicle& v : vehicles) {
+		lane_insert(rt, &v);
+	}
+	ASSERT_EQ(rt.idx.size(), vehicles.size());
+	EXPECT_EQ(rt.idx.front(), &vehicles[4]);
+	expect_positions();
+
+	// the rear hole is dropped, the middle one stays until compaction
+	lane_erase(rt, &vehicles[3]);
+	lane_erase(rt, &vehicles[0]);
+	ASSERT_EQ(rt.idx.size(), 4u);
+	EXPECT_EQ(rt.idx[1], nullptr);
+	EXPECT_EQ(rt.idx_holes, 1u);
+	EXPECT_EQ(vehicles[3].idx_in_lane, LaneRuntime::NO_SLOT);
+	EXPECT_EQ(vehicles[2].idx_in_lane, 2u);
+
+	lane_compact(rt);
+	ASSERT_EQ(rt.idx.size(), 3u);
+	EXPECT_EQ(rt.idx[1], &vehicles[2]);
+	EXPECT_EQ(rt.idx_holes, 0u);
+	expect_positions();
+
+	slot_insert(rt, &vehicles[1]);
+	slot_insert(rt, &vehicles[3]);
+	slot_insert(rt, &vehicles[1]);
+	ASSERT_EQ(rt.vehicle_slots.size(), 2u);
+	expect_positions();
+
+	slot_erase(rt, &vehicles[3]);
+	EXPECT_EQ(vehicles[3].idx_in_target_lane, LaneRuntime::NO_SLOT);
+	lane_compact(rt);
+	ASSERT_EQ(rt.vehicle_slots.size(), 1u);
+	expect_positions();
+}
+
+TEST_F(LaneRuntimeTest, HolesAreSkippedAndReused) {
+	for (Vehicle& v : vehicles) {
+		lane_insert(rt, &v);
+	}
+	// 40 30 20 10 0 → 40 _ 20 _ 0
+	lane_erase(rt, &vehicles[3]);
+	lane_erase(rt, &vehicles[1]);
+	ASSERT_EQ(rt.idx.size(), 5u);
+
+	// right behind the vehicle ahead, the hole counts as a free slot
+	EXPECT_EQ(lane_position(rt.idx, 25.0), 1u);
+	EXPECT_EQ(lane_ahead(rt.idx, 2), &vehicles[4]);
+	EXPECT_EQ(lane_behind(rt.idx, 1), &vehicles[2]);
+	EXPECT_EQ(lane_behind(rt.idx, 3), &vehicles[0]);
+	EXPECT_EQ(lane_ahead(rt.idx, 0), nullptr);
+	EXPECT_EQ(lane_behind(rt.idx, 5), nullptr);
+
+	// lands in the hole, nobody else moves
+	vehicles[3].s_on_lane() = 15.0;
+	lane_insert(rt, &vehicles[3]);
+	EXPECT_EQ(rt.idx[3], &vehicles[3]);
+	EXPECT_EQ(vehicles[3].idx_in_lane, 3u);
+	EXPECT_EQ(vehicles[0].idx_in_lane, 4u);
+	EXPECT_EQ(rt.idx_holes, 1u);
+
+	lane_resort(rt);
+	ASSERT_EQ(rt.idx.size(), 4u);
+	expect_positions();
+}
+
+TEST_F(LaneRuntimeTest, ResortRestoresOrder) {
+	for (Vehicle& v : vehicles) {
+		lane_insert(rt, &v);
+		slot_insert(rt, &v);
+	}
+
+	// the rear vehicle overtakes two others, one swap further ahead
+	vehicles[0].s_on_lane() = 25.0;
+	vehicles[4].s_on_lane() = 29.0;
+	lane_resort(rt);
+
+	const std::vector<Vehicle*> expected { &vehicles[3], &vehicles[4], &vehicles[0], &vehicles[2], &vehicles[1] };
+	EXPECT_EQ(rt.idx, expected);
+	EXPECT_EQ(rt.vehicle_slots, expected);
+	expect_positions();
+}
+
+namespace {
+	class LaneRuntimeSimulationTest
+		: public ::testing::Test,
+		  public ::tests::DataLoaderMixin {
+	};
+} // namespace
+
+TEST_F(LaneRuntimeSimulationTest, StoredPositionsFollowTheSimulation) {
+	Lane::reset_id();
+	Edge::reset_id();
+
+	WorldData world;
+	ASSERT_TRUE(WorldCreator::loadOSMData(world, data_file("simple_grid.osmx").string()));
+
+	model::DataModelStore data_store;
+	data_store.create<model::VehicleAnalyzeData>();
+
+	SimulationSettings settings;
+	settings.randomSeed = false;
+	settings.seedValue = 42;
+	settings.vehiclesCount = 150;
+	settings.movement_algo = MovementAlgoType::IDM;
+
+	TrafficSimulationSystem system(world, data_store, settings);
+	system.initialize();
+
+	auto& lane_rt = system.vehicle_system().lane_runtime();
+	// the lookup lives in the simulation, the map lanes are left alone
+	for (const LaneRuntime& rt : lane_rt) {
+		ASSERT_EQ(&system.vehicle_system().lane_runtime(*rt.static_lane), &rt);
+	}
+	for (int step = 0; step < 300; ++step) {
+		system.step();
+
+		size_t listed = 0;
+		for (const LaneRuntime& rt : lane_rt) {
+			listed += rt.idx.size();
+			for (size_t i = 0; i < rt.idx.size(); ++i) {
+				ASSERT_EQ(rt.idx[i]->idx_in_lane, i) << "step " << step;
+				ASSERT_EQ(rt.idx[i]->current_lane, rt.static_lane) << "step " << step;
+			}
+			for (size_t i = 0; i < rt.vehicle_slots.size(); ++i) {
+				ASSERT_EQ(rt.vehicle_slots[i]->idx_in_target_lane, i) << "step " << step;
+				ASSERT_EQ(rt.vehicle_slots[i]->lane_target, rt.static_lane) << "step " << step;
+			}
+		}
+		ASSERT_EQ(listed, system.vehicle_system().vehicles().size()) << "step " << step;
+	}
+	system.release();
+}
@@ -19,6 +19,7 @@ protected:
 
 TEST_F(MergeSplitIntegrationTest, DISABLED_VehiclePassesMergeNode) {
 	auto& agent = *system->agents()[0];
+	Vehicle& vehicle = *system->vehicle_system().get(agent.vehicle);
 	auto& network = *world.segments().front()->road_network;
 
 	Edge* incoming = nullptr;
@@ -37,12 +38,13 @@ TEST_F(MergeSplitIntegrationTest, DISABLED_VehiclePassesMergeNode) {
 	Node* start = incoming->start_node;
 	Node* goal = outgoing->end_node;
 
-	agent.vehicle->coordinates = start->coordinates;
-	agent.vehicle->current_lane = &incoming->lanes[0];
-	//agent.target_lane = agent.vehicle->current_lane;
+	vehicle.coordinates() = start->coordinates;
+	vehicle.current_lane = &incoming->lanes[0];
+	//agent.target_lane = vehicle.current_lane;
 	agent.currentGoal = goal;
 
 	system->tacticalModule().update();
+	system->tacticalModule().apply_routes();
 	//ASSERT_EQ(agent.current_goal, incoming);
 	ASSERT_EQ(agent.path.size(), 1u);
 	EXPECT_EQ(agent.path.front(), outgoing);
@@ -51,16 +53,18 @@ TEST_F(MergeSplitIntegrationTest, DISABLED_VehiclePassesMergeNode) {
 	system->vehicleMovementModule().update();
 
 	system->tacticalModule().update();
+	system->tacticalModule().apply_routes();
 	//EXPECT_EQ(agent.current_goal, outgoing);
 	EXPECT_TRUE(agent.path.empty());
 
 	system->timeModule().update(0.1);
 	system->vehicleMovementModule().update();
-	EXPECT_EQ(agent.vehicle->current_lane, &outgoing->lanes[0]);
+	EXPECT_EQ(vehicle.current_lane, &outgoing->lanes[0]);
 
 	system->timeModule().update(70.0);
 	system->vehicleMovementModule().update();
 
 	system->tacticalModule().update();
+	system->tacticalModule().apply_routes();
 	EXPECT_EQ(agent.currentGoal, nullptr);
 }
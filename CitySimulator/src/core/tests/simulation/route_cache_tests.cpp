@@ -0,0 +1,112 @@
+#include "stdafx.h"
+
+#include <data_loader_mixin.h>
+#include <core/data_layer/world_creator.h>
+#include <core/data_layer/world_data.h>
+#include <core/simulation/agent/agent_data.h>
+#include <core/simulation/tactical/route_cache.h>
+
+using namespace tjs::core;
+using namespace tjs::core::simulation;
+
+class RouteCacheTest : public ::testing::Test, public tjs::core::tests::DataLoaderMixin {
+protected:
+	WorldData world;
+
+	void SetUp() override {
+		ASSERT_TRUE(WorldCreator::loadOSMData(world, data_file("test_lanes.osmx").string()));
+	}
+
+	RoadNetwork& network() {
+		return *world.segments().front()->road_network;
+	}
+};
+
+TEST_F(RouteCacheTest, AdjacentLanesShareKey) {
+	auto& net = network();
+	const Edge* edge = nullptr;
+	for (const Edge& e : net.edges) {
+		if (e.lanes.size() > 1) {
+			edge = &e;
+			break;
+		}
+	}
+	ASSERT_NE(edge, nullptr);
+	const Node* goal = net.graph_nodes.back();
+
+	const auto first = RouteCache::make_key(net, &edge->lanes[0], goal, true, RoutingAlgoType::AStar);
+	const auto second = RouteCache::make_key(net, &edge->lanes[1], goal, true, RoutingAlgoType::AStar);
+	EXPECT_EQ(first, second);
+
+	// without adjacent lanes the lane itself is the question
+	EXPECT_NE(
+		RouteCache::make_key(net, &edge->lanes[0], goal, false, RoutingAlgoType::AStar),
+		RouteCache::make_key(net, &edge->lanes[1], goal, false, RoutingAlgoType::AStar));
+	EXPECT_NE(first, RouteCache::make_key(net, &edge->lanes[0], goal, true, RoutingAlgoType::Landmarks));
+}
+
+TEST_F(RouteCacheTest, SharesRoutesUntilNetworkChanges) {
+	auto& net = network();
+	const Lane* lane = &net.edges.front().lanes.front();
+	const Node* goal = net.graph_nodes.back();
+
+	RouteCache cache;
+	cache.reset(16);
+	cache.validate(net);
+
+	const auto key = RouteCache::make_key(net, lane, goal, true, RoutingAlgoType::AStar);
+	EXPECT_EQ(cache.find(key), nullptr);
+
+	const Route route = std::make_shared<const std::vector<uint32_t>>(std::vector<uint32_t> { 1, 2, 3 });
+	cache.store(key, route);
+	const auto unreachable = RouteCache::make_key(net, lane, net.graph_nodes.front(), true, RoutingAlgoType::AStar);
+	cache.store(unreachable, nullptr);
+
+	cache.validate(net);
+	const Route* cached = cache.find(key);
+	ASSERT_NE(cached, nullptr);
+	EXPECT_EQ(cached->get(), route.get());
+	ASSERT_NE(cache.find(unreachable), nullptr);
+	EXPECT_EQ(*cache.find(unreachable), nullptr);
+	EXPECT_EQ(cache.stats().hits, 3);
+	EXPECT_EQ(cache.stats().misses, 1);
+
+	net.build_node_graph();
+	cache.validate(net);
+	EXPECT_EQ(cache.size(), 0);
+	EXPECT_EQ(cache.find(key), nullptr);
+}
+
+TEST_F(RouteCacheTest, ZeroCapacityDisables) {
+	auto& net = network();
+	RouteCache cache;
+	cache.reset(0);
+	cache.validate(net);
+
+	const auto key = RouteCache::make_key(net, &net.edges.front().lanes.front(), net.graph_nodes.back(), true, RoutingAlgoType::AStar);
+	cache.store(key, std::make_shared<const std::vector<uint32_t>>());
+	EXPECT_EQ(cache.find(key), nullptr);
+	EXPECT_EQ(cache.size(), 0);
+}
+
+TEST_F(RouteCacheTest, AgentPathsShareRoute) {
+	auto& net = network();
+	ASSERT_GE(net.edges.size(), 4u);
+	const Route route = std::make_shared<const std::vector<uint32_t>>(std::vector<uint32_t> { 2, 3 });
+
+	AgentPath first(net, net.edges[0], route);
+	AgentPath second(net, net.edges[1], route);
+	EXPECT_EQ(first.route().get(), second.route().get());
+	EXPECT_EQ(route.use_count(), 3);
+
+	ASSERT_EQ(first.size(), 3u);
+	EXPECT_EQ(first.front(), &net.edges[0]);
+	EXPECT_EQ(first[1], &net.edges[2]);
+	EXPECT_EQ(first.back(), &net.edges[3]);
+	EXPECT_EQ(second.front(), &net.edges[1]);
+
+	first.clear();
+	EXPECT_TRUE(first.empty());
+	EXPECT_EQ(first.size(), 0u);
+	EXPECT_EQ(route.use_count(), 2);
+}
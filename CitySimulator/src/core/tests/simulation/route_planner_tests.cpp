@@ -0,0 +1,167 @@
+#include "stdafx.h"
+
+#include <core/data_layer/world_creator.h>
+#include <core/data_layer/world_data.h>
+#include <core/data_layer/lane.h>
+#include <core/data_layer/edge.h>
+#include <core/store_models/idata_model.h>
+#include <core/store_models/vehicle_analyze_data.h>
+#include <core/simulation/simulation_system.h>
+#include <core/simulation/tactical/route_planner.h>
+#include <core/map_math/path_finder.h>
+
+#include <data_loader_mixin.h>
+
+using namespace tjs::core;
+using namespace tjs::core::simulation;
+
+namespace {
+	struct VehicleTrace {
+		double s_on_lane;
+		float speed;
+		uint16_t state;
+		int lane_id;
+		size_t path_size;
+
+		bool operator==(const VehicleTrace&) const = default;
+	};
+
+	class RoutePlannerTest
+		: public ::testing::Test,
+		  public ::tests::DataLoaderMixin {
+	protected:
+		// Runs `steps` steps with the route cache off, so every request is a search
+		std::vector<VehicleTrace> run(size_t planner_threads, int steps) {
+			Lane::reset_id();
+			Edge::reset_id();
+
+			WorldData world;
+			EXPECT_TRUE(WorldCreator::loadOSMData(world, data_file("simple_grid.osmx").string()));
+
+			model::DataModelStore store;
+			store.create<model::VehicleAnalyzeData>();
+
+			SimulationSettings settings;
+			settings.randomSeed = false;
+			settings.seedValue = 42;
+			settings.vehiclesCount = 150;
+			settings.movement_algo = MovementAlgoType::IDM;
+			settings.route_cache_size = 0;
+			settings.route_planner_threads = planner_threads;
+
+			TrafficSimulationSystem system(world, store, settings);
+			system.initialize();
+
+			std::vector<VehicleTrace> trace;
+			for (int i = 0; i < steps; ++i) {
+				system.step();
+				for (const AgentData* agent : system.agents()) {
+					const Vehicle* v = system.vehicle_system().get(agent->vehicle);
+					trace.push_back(VehicleTrace {
+						v->s_on_lane(),
+						v->currentSpeed(),
+						v->state(),
+						v->current_lane ? v->current_lane->get_id() : -1,
+						agent->path.size() });
+				}
+			}
+			system.release();
+			return trace;
+		}
+	};
+} // namespace
+
+TEST_F(RoutePlannerTest, BackgroundSearchesAreDeterministic) {
+	const auto single = run(1, 200);
+	ASSERT_FALSE(single.empty());
+	ASSERT_TRUE(std::ranges::any_of(single, [](const VehicleTrace& t) { return t.path_size > 0; }));
+
+	// 0 runs the searches on the simulation thread, at the same step boundary
+	for (size_t threads : { 0u, 2u, 4u }) {
+		const auto parallel = run(threads, 200);
+		ASSERT_EQ(single.size(), parallel.size()) << "threads = " << threads;
+		for (size_t i = 0; i < single.size(); ++i) {
+			ASSERT_EQ(single[i], parallel[i]) << "threads = " << threads << ", record " << i;
+		}
+	}
+}
+
+TEST_F(RoutePlannerTest, CollectReturnsResultsByTicket) {
+	WorldData world;
+	ASSERT_TRUE(WorldCreator::loadOSMData(world, data_file("simple_grid.osmx").string()));
+	auto& network = *world.segments().front()->road_network;
+
+	std::vector<RoutePlanner::Request> requests;
+	for (size_t i = 0; i < network.edges.size(); i += 7) {
+		requests.push_back({ &network.edges[i].lanes.front(), network.graph_nodes[i % network.graph_nodes.size()], true, RoutingAlgoType::AStar });
+	}
+
+	RoutePlanner planner;
+	planner.resize(3);
+	for (size_t i = 0; i < requests.size(); ++i) {
+		EXPECT_EQ(planner.submit(network, requests[i]), i);
+	}
+	const auto routes = planner.collect();
+	ASSERT_EQ(routes.size(), requests.size());
+	for (size_t i = 0; i < requests.size(); ++i) {
+		const Route expected = RoutePlanner::search(network, requests[i]);
+		ASSERT_EQ(routes[i] == nullptr, expected == nullptr) << "request " << i;
+		if (expected) {
+			EXPECT_EQ(*routes[i], *expected) << "request " << i;
+		}
+	}
+
+	// the planner starts over after collect()
+	EXPECT_EQ(planner.submit(network, requests.front()), 0);
+	EXPECT_EQ(planner.collect().size(), 1);
+}
+
+TEST_F(RoutePlannerTest, RetiredAgentsAreSkipped) {
+	Lane::reset_id();
+	Edge::reset_id();
+
+	WorldData world;
+	ASSERT_TRUE(WorldCreator::loadOSMData(world, data_file("simple_grid.osmx").string()));
+	model::DataModelStore store;
+	store.create<model::VehicleAnalyzeData>();
+
+	SimulationSettings settings;
+	settings.randomSeed = false;
+	settings.seedValue = 42;
+	settings.vehiclesCount = 10;
+	settings.route_planner_threads = 2;
+	settings.route_cache_size = 0;
+
+	TrafficSimulationSystem system(world, store, settings);
+	system.initialize();
+	system.step();
+	ASSERT_GE(system.agents().size(), 2u);
+
+	AgentData& retired = *system.agents()[0];
+	AgentData& kept = *system.agents()[1];
+	Lane& lane = *system.vehicle_system().get(kept.vehicle)->current_lane;
+	auto& network = *world.segments().front()->road_network;
+	const auto reachable = std::ranges::find_if(network.graph_nodes, [&](Node* node) {
+		return !algo::PathFinder::find_edge_path_a_star_from_lane(network, &lane, node, true).empty();
+	});
+	ASSERT_NE(reachable, network.graph_nodes.end());
+	Node& goal = **reachable;
+	const AgentHandle retired_handle = retired.handle;
+
+	// both ask the same question, one search answers them
+	retired.path.clear();
+	kept.path.clear();
+	auto& tactical = system.tacticalModule();
+	tactical.plan_route(retired, lane, goal, true);
+	tactical.plan_route(kept, lane, goal, true);
+
+	system.agent_manager().remove_agent(retired);
+	system.agent_manager().update();
+	ASSERT_EQ(system.agent_manager().get(retired_handle), nullptr);
+
+	tactical.route_cache().reset(16);
+	tactical.apply_routes();
+	EXPECT_EQ(tactical.route_cache().size(), 1u);
+	EXPECT_FALSE(kept.path.empty());
+	system.release();
+}
@@ -29,30 +29,35 @@ TEST_F(SimulationModuleTest, DISABLED_TacticalBuildsPath) {
 	auto& agent = *system->agents()[0];
 	system->strategicModule().update();
 	system->tacticalModule().update();
+	system->tacticalModule().apply_routes();
 	EXPECT_GT(agent.path.size(), 0u);
 }
 
 TEST_F(SimulationModuleTest, DISABLED_VehicleMovesTowardsGoal) {
 	auto& agent = *system->agents()[0];
+	Vehicle& vehicle = *system->vehicle_system().get(agent.vehicle);
 	system->strategicModule().update();
 	system->tacticalModule().update();
-	Coordinates start = agent.vehicle->coordinates;
+	system->tacticalModule().apply_routes();
+	Coordinates start = vehicle.coordinates();
 	system->timeModule().update(0.016);
 	system->vehicleMovementModule().update();
-	EXPECT_NE(start.x, agent.vehicle->coordinates.x);
-	EXPECT_NE(start.y, agent.vehicle->coordinates.y);
+	EXPECT_NE(start.x, vehicle.coordinates().x);
+	EXPECT_NE(start.y, vehicle.coordinates().y);
 }
 
 TEST_F(SimulationModuleTest, DISABLED_TacticalMarksAgentStuckAfterFailures) {
 	auto& agent = *system->agents()[0];
-	auto unreachable = tjs::core::Node::create(9999, agent.vehicle->coordinates, tjs::core::NodeTags::None);
+	Vehicle& vehicle = *system->vehicle_system().get(agent.vehicle);
+	auto unreachable = tjs::core::Node::create(9999, vehicle.coordinates(), tjs::core::NodeTags::None);
 
-	agent.vehicle->state = 0; //VehicleState::Stopped;
+	vehicle.state() = 0; //VehicleState::Stopped;
 	for (int i = 0; i < 5; ++i) {
 		agent.currentGoal = unreachable.get();
 		agent.path.clear();
 		//agent.last_segment = false;
 		system->tacticalModule().update();
+		system->tacticalModule().apply_routes();
 	}
 
 	EXPECT_TRUE(agent.stucked);
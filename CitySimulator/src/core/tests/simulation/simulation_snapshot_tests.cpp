@@ -0,0 +1,170 @@
+#include "stdafx.h"
+
+#include <core/data_layer/world_creator.h>
+#include <core/data_layer/world_data.h>
+#include <core/data_layer/lane.h>
+#include <core/data_layer/edge.h>
+#include <core/store_models/idata_model.h>
+#include <core/store_models/vehicle_analyze_data.h>
+#include <core/simulation/simulation_system.h>
+#include <core/simulation/simulation_snapshot.h>
+#include <core/simulation/agent/agent_data.h>
+
+#include <data_loader_mixin.h>
+
+using namespace tjs::core;
+using namespace tjs::core::simulation;
+
+namespace {
+	class SimulationSnapshotTest
+		: public ::testing::Test,
+		  public ::tests::DataLoaderMixin {
+	protected:
+		void SetUp() override {
+			Lane::reset_id();
+			Edge::reset_id();
+			ASSERT_TRUE(WorldCreator::loadOSMData(world, data_file("simple_grid.osmx").string()));
+
+			store.create<model::VehicleAnalyzeData>();
+
+			settings.randomSeed = false;
+			settings.seedValue = 42;
+			settings.vehiclesCount = 50;
+			settings.movement_algo = MovementAlgoType::IDM;
+
+			system = std::make_unique<TrafficSimulationSystem>(world, store, settings);
+			system->initialize();
+		}
+
+		void TearDown() override {
+			system->release();
+		}
+
+		WorldData world;
+		model::DataModelStore store;
+		SimulationSettings settings;
+		std::unique_ptr<TrafficSimulationSystem> system;
+	};
+} // namespace
+
+TEST_F(SimulationSnapshotTest, CaptureMatchesVehicles) {
+	for (int i = 0; i < 50; ++i) {
+		system->step();
+	}
+
+	SimulationSnapshot snapshot;
+	capture_snapshot(*system, snapshot);
+
+	const auto& vehicles = system->vehicle_system().vehicles();
+	ASSERT_FALSE(vehicles.empty());
+	ASSERT_EQ(snapshot.vehicles.size(), vehicles.size());
+	ASSERT_EQ(snapshot.agents.size(), system->agents().size());
+	EXPECT_EQ(snapshot.current_time, system->timeModule().state().current_time());
+
+	for (size_t i = 0; i < vehicles.size(); ++i) {
+		const Vehicle& vehicle = *vehicles[i];
+		EXPECT_EQ(snapshot.vehicles.uid[i], vehicle.uid());
+		EXPECT_EQ(snapshot.vehicles.coordinates[i].x, vehicle.coordinates().x);
+		EXPECT_EQ(snapshot.vehicles.coordinates[i].y, vehicle.coordinates().y);
+		EXPECT_EQ(snapshot.vehicles.rotation_angle[i], vehicle.rotationAngle());
+		EXPECT_EQ(snapshot.vehicles.type[i], vehicle.type());
+		EXPECT_EQ(snapshot.vehicles.lane_id[i], vehicle.current_lane ? vehicle.current_lane->get_id() : -1);
+	}
+
+	// capture reuses storage and does not append
+	capture_snapshot(*system, snapshot);
+	EXPECT_EQ(snapshot.vehicles.size(), vehicles.size());
+}
+
+TEST_F(SimulationSnapshotTest, TracksSelectedAgent) {
+	for (int i = 0; i < 10; ++i) {
+		system->step();
+	}
+	ASSERT_FALSE(system->agents().empty());
+
+	SimulationSnapshot snapshot;
+	store.get_entry<model::VehicleAnalyzeData>()->agent.reset();
+	capture_snapshot(*system, snapshot);
+	EXPECT_FALSE(snapshot.tracked.has_value());
+
+	AgentData* agent = system->agents().front();
+	store.get_entry<model::VehicleAnalyzeData>()->agent = agent->handle;
+	capture_snapshot(*system, snapshot);
+	ASSERT_TRUE(snapshot.tracked.has_value());
+	EXPECT_EQ(snapshot.tracked->id, agent->id);
+	EXPECT_EQ(snapshot.tracked->path_offset, agent->path_offset);
+	EXPECT_LE(snapshot.tracked->path.size(), agent->path.size());
+}
+
+TEST(SnapshotBufferTest, PublishSwapsBuffers) {
+	SnapshotBuffer buffer;
+	buffer.back().agents.push_back({ 1, 2, false });
+
+	EXPECT_TRUE(buffer.read()->agents.empty());
+	buffer.publish();
+	{
+		auto front = buffer.read();
+		ASSERT_EQ(front->agents.size(), 1u);
+		EXPECT_EQ(front->version, 1u);
+	}
+
+	// the writer gets the other buffer and never the one readers see
+	EXPECT_NE(&buffer.back(), &*buffer.read());
+	buffer.back().agents.clear();
+	EXPECT_EQ(buffer.read()->agents.size(), 1u);
+
+	buffer.publish();
+	EXPECT_TRUE(buffer.read()->agents.empty());
+	EXPECT_EQ(buffer.read()->version, 2u);
+}
+
+TEST(SnapshotBufferTest, PublishDoesNotWaitForReaders) {
+	SnapshotBuffer buffer;
+	buffer.publish();
+
+	{
+		auto front = buffer.read();
+		ASSERT_EQ(front->version, 1u);
+
+		// the writer keeps going while the guard is alive
+		for (int i = 0; i < 5; ++i) {
+			EXPECT_NE(&buffer.back(), &*front);
+			buffer.back().agents.assign(3, { 7, 7, false });
+			buffer.publish();
+		}
+		EXPECT_TRUE(front->agents.empty());
+		EXPECT_EQ(front->version, 1u);
+
+		// nested reads share the front
+		EXPECT_EQ(&*buffer.read(), &*front);
+	}
+
+	// the latest publish once the guard is gone
+	auto front = buffer.read();
+	EXPECT_EQ(front->version, 6u);
+	EXPECT_EQ(front->agents.size(), 3u);
+}
+
+TEST(SnapshotBufferTest, ReaderSeesCompleteSnapshots) {
+	SnapshotBuffer buffer;
+	std::atomic<bool> done { false };
+
+	// writer keeps every column of a snapshot equal to its version
+	std::thread writer([&buffer, &done]() {
+		for (uint64_t i = 1; i <= 2000; ++i) {
+			auto& back = buffer.back();
+			back.agents.assign(i % 17, { i, i, false });
+			buffer.publish();
+		}
+		done = true;
+	});
+
+	while (!done) {
+		auto front = buffer.read();
+		for (const auto& agent : front->agents) {
+			ASSERT_EQ(agent.id, front->agents.front().id);
+		}
+		ASSERT_EQ(front->agents.size(), front->version % 17);
+	}
+	writer.join();
+}
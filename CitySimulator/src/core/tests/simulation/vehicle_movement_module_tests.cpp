@@ -7,7 +7,6 @@
 #include <core/math_constants.h>
 #include <core/map_math/earth_math.h>
 #include <core/data_layer/way_info.h>
-#include <core/data_layer/lane_vehicle_utils.h>
 #include <core/simulation/time_module.h>
 #include <core/map_math/lane_connector_builder.h>
 
@@ -53,18 +52,22 @@ protected:
 		return *system->agents()[0];
 	}
 
+	Vehicle& getVehicle() {
+		return *system->vehicle_system().get(getAgent().vehicle);
+	}
+
 	void setup_goal(Node* goal = nullptr) {
 		getAgent().currentGoal = goal != nullptr ? goal : world.segments().front()->nodes.begin()->second.get();
-		VehicleStateBitsV::overwrite_info(getAgent().vehicle->state, VehicleStateBits::ST_FOLLOW, VehicleStateBitsDivision::STATE);
-		VehicleStateBitsV::remove_info(getAgent().vehicle->state, VehicleStateBits::FL_ERROR, VehicleStateBitsDivision::FLAGS);
+		VehicleStateBitsV::overwrite_info(getVehicle().state(), VehicleStateBits::ST_FOLLOW, VehicleStateBitsDivision::STATE);
+		VehicleStateBitsV::remove_info(getVehicle().state(), VehicleStateBits::FL_ERROR, VehicleStateBitsDivision::FLAGS);
 	}
 
 	void place_at_position(size_t way_idx = 0, size_t edge_idx = 0, size_t lane_idx = 0) {
 		auto& agent = getAgent();
 		auto& way = get_segment().ways.begin()->second;
 		auto& edge = way->edges[0];
-		agent.vehicle->current_lane = &edge->lanes[0];
-		agent.vehicle->coordinates = edge->lanes[0].centerLine[0];
+		system->vehicle_system().move_to_lane(getVehicle(), &edge->lanes[0]);
+		getVehicle().coordinates() = edge->lanes[0].centerLine[0];
 	}
 };
 
@@ -78,20 +81,20 @@ TEST_F(VehicleMovementModuleTest, NoMovementWhenCurrentGoalIsNullptr) {
 	auto testLane = createTestLane(
 		make_latlon(0.0, 0.0),
 		make_latlon(0.001, 0.001));
-	agent.vehicle->current_lane = &testLane;
+	getVehicle().current_lane = &testLane;
 
 	// Record initial position
-	Coordinates initialPosition = agent.vehicle->coordinates;
-	double initialSOnLane = agent.vehicle->s_on_lane;
+	Coordinates initialPosition = getVehicle().coordinates();
+	double initialSOnLane = getVehicle().s_on_lane();
 
 	// Update time and run movement
 	system->timeModule().update(0.016); // 16ms delta time
 	system->vehicleMovementModule().update();
 
 	// Verify no movement occurred
-	EXPECT_EQ(agent.vehicle->coordinates.x, initialPosition.x);
-	EXPECT_EQ(agent.vehicle->coordinates.y, initialPosition.y);
-	EXPECT_EQ(agent.vehicle->s_on_lane, initialSOnLane);
+	EXPECT_EQ(getVehicle().coordinates().x, initialPosition.x);
+	EXPECT_EQ(getVehicle().coordinates().y, initialPosition.y);
+	EXPECT_EQ(getVehicle().s_on_lane(), initialSOnLane);
 }
 
 TEST_F(VehicleMovementModuleTest, NoMovementWhencurrent_laneIsNullptr) {
@@ -101,17 +104,17 @@ TEST_F(VehicleMovementModuleTest, NoMovementWhencurrent_laneIsNullptr) {
 	agent.currentGoal = get_segment().nodes.begin()->second.get();
 
 	// Record initial position
-	Coordinates initialPosition = agent.vehicle->coordinates;
-	double initialSOnLane = agent.vehicle->s_on_lane;
+	Coordinates initialPosition = getVehicle().coordinates();
+	double initialSOnLane = getVehicle().s_on_lane();
 
 	// Update time and run movement
 	system->timeModule().update(0.016);
 	system->vehicleMovementModule().update();
 
 	// Verify no movement occurred
-	EXPECT_EQ(agent.vehicle->coordinates.x, initialPosition.x);
-	EXPECT_EQ(agent.vehicle->coordinates.y, initialPosition.y);
-	EXPECT_EQ(agent.vehicle->s_on_lane, initialSOnLane);
+	EXPECT_EQ(getVehicle().coordinates().x, initialPosition.x);
+	EXPECT_EQ(getVehicle().coordinates().y, initialPosition.y);
+	EXPECT_EQ(getVehicle().s_on_lane(), initialSOnLane);
 }
 
 TEST_F(VehicleMovementModuleTest, NoMovementWhenBothCurrentGoalAndLaneAreNullptr) {
@@ -119,20 +122,20 @@ TEST_F(VehicleMovementModuleTest, NoMovementWhenBothCurrentGoalAndLaneAreNullptr
 
 	// Set both to nullptr
 	agent.currentGoal = nullptr;
-	agent.vehicle->current_lane = nullptr;
+	getVehicle().current_lane = nullptr;
 
 	// Record initial position
-	Coordinates initialPosition = agent.vehicle->coordinates;
-	double initialSOnLane = agent.vehicle->s_on_lane;
+	Coordinates initialPosition = getVehicle().coordinates();
+	double initialSOnLane = getVehicle().s_on_lane();
 
 	// Update time and run movement
 	system->timeModule().update(0.016);
 	system->vehicleMovementModule().update();
 
 	// Verify no movement occurred
-	EXPECT_EQ(agent.vehicle->coordinates.x, initialPosition.x);
-	EXPECT_EQ(agent.vehicle->coordinates.y, initialPosition.y);
-	EXPECT_EQ(agent.vehicle->s_on_lane, initialSOnLane);
+	EXPECT_EQ(getVehicle().coordinates().x, initialPosition.x);
+	EXPECT_EQ(getVehicle().coordinates().y, initialPosition.y);
+	EXPECT_EQ(getVehicle().s_on_lane(), initialSOnLane);
 }
 
 TEST_F(VehicleMovementModuleTest, DISABLED_MovementOccursWithValidGoalAndLane) {
@@ -143,24 +146,24 @@ TEST_F(VehicleMovementModuleTest, DISABLED_MovementOccursWithValidGoalAndLane) {
 	setup_goal();
 
 	// set lower speed for way
-	agent.vehicle->current_lane->parent->way->maxSpeed = 43;
+	getVehicle().current_lane->parent->way->maxSpeed = 43;
 
 	// Record initial position
-	Coordinates initialPosition = agent.vehicle->coordinates;
-	double initialSOnLane = agent.vehicle->s_on_lane;
+	Coordinates initialPosition = getVehicle().coordinates();
+	double initialSOnLane = getVehicle().s_on_lane();
 
-	ASSERT_TRUE(VehicleStateBitsV::has_info(agent.vehicle->state, VehicleStateBits::ST_FOLLOW));
+	ASSERT_TRUE(VehicleStateBitsV::has_info(getVehicle().state(), VehicleStateBits::ST_FOLLOW));
 	// Update time and run movement
 	system->vehicleMovementModule().update();
 	system->vehicleMovementModule().update();
 
 	// Verify movement occurred
-	EXPECT_NE(agent.vehicle->coordinates.x, initialPosition.x);
-	EXPECT_EQ(agent.vehicle->coordinates.y, initialPosition.y);
-	EXPECT_GT(agent.vehicle->s_on_lane, initialSOnLane);
+	EXPECT_NE(getVehicle().coordinates().x, initialPosition.x);
+	EXPECT_EQ(getVehicle().coordinates().y, initialPosition.y);
+	EXPECT_GT(getVehicle().s_on_lane(), initialSOnLane);
 
 	// verify speed is set correctely - will be broken when accel will be added
-	EXPECT_EQ(agent.vehicle->currentSpeed, agent.vehicle->current_lane->parent->way->maxSpeed);
+	EXPECT_EQ(getVehicle().currentSpeed(), getVehicle().current_lane->parent->way->maxSpeed);
 }
 
 TEST_F(VehicleMovementModuleTest, SpeedIsCappedAtMaxSpeed) {
@@ -171,20 +174,20 @@ TEST_F(VehicleMovementModuleTest, SpeedIsCappedAtMaxSpeed) {
 	setup_goal();
 
 	// set lower speed for way and vehicle
-	agent.vehicle->current_lane->parent->way->maxSpeed = 100;
-	agent.vehicle->maxSpeed = 30;
+	getVehicle().current_lane->parent->way->maxSpeed = 100;
+	getVehicle().maxSpeed() = 30;
 
 	// Record initial position
-	Coordinates initialPosition = agent.vehicle->coordinates;
-	double initialSOnLane = agent.vehicle->s_on_lane;
+	Coordinates initialPosition = getVehicle().coordinates();
+	double initialSOnLane = getVehicle().s_on_lane();
 
-	ASSERT_TRUE(VehicleStateBitsV::has_info(agent.vehicle->state, VehicleStateBits::ST_FOLLOW));
+	ASSERT_TRUE(VehicleStateBitsV::has_info(getVehicle().state(), VehicleStateBits::ST_FOLLOW));
 	// Update time and run movement
 	system->vehicleMovementModule().update();
 	system->vehicleMovementModule().update();
 
 	// verify speed is set correctely - will be broken when accel will be added
-	EXPECT_EQ(agent.vehicle->currentSpeed, 30);
+	EXPECT_EQ(getVehicle().currentSpeed(), 30);
 }
 
 TEST_F(VehicleMovementModuleTest, LaneChangeOccursWhenExceedingLaneLength) {
@@ -198,29 +201,22 @@ TEST_F(VehicleMovementModuleTest, LaneChangeOccursWhenExceedingLaneLength) {
 	auto& f_lane = first_edge.lanes[0];
 	auto& second_edge = f_lane.outgoing_connections[0]->to->parent;
 
-	agent.vehicle->current_lane = &first_edge.lanes[0];
-	agent.vehicle->coordinates = first_edge.lanes[0].centerLine.front();
-	insert_vehicle_sorted(*agent.vehicle->current_lane, agent.vehicle);
+	system->vehicle_system().move_to_lane(getVehicle(), &first_edge.lanes[0]);
+	getVehicle().coordinates() = first_edge.lanes[0].centerLine.front();
 
 	setup_goal(second_edge->end_node);
-	agent.path.push_back(&(*second_edge));
+	agent.path = AgentPath(*segment.road_network, *second_edge, std::make_shared<const std::vector<uint32_t>>());
 
 	const double delta = (first_edge.lanes[0].length / (way->maxSpeed / 3.6)) + 10.0;
 	const_cast<TimeState&>(system->timeModule().state()).set_fixed_delta(delta);
 	system->vehicleMovementModule().update();
 
-	EXPECT_EQ(agent.vehicle->current_lane->parent->get_id(), second_edge->get_id());
+	EXPECT_EQ(getVehicle().current_lane->parent->get_id(), second_edge->get_id());
 	EXPECT_EQ(agent.path_offset, agent.path.size());
-	EXPECT_TRUE(std::find(
-					first_edge.lanes[0].vehicles.begin(),
-					first_edge.lanes[0].vehicles.end(),
-					agent.vehicle)
-				== first_edge.lanes[0].vehicles.end());
-	EXPECT_TRUE(std::find(
-					second_edge->lanes[0].vehicles.begin(),
-					second_edge->lanes[0].vehicles.end(),
-					agent.vehicle)
-				!= second_edge->lanes[0].vehicles.end());
+	const auto& first_vehicles = system->vehicle_system().lane_vehicles(first_edge.lanes[0]);
+	const auto& second_vehicles = system->vehicle_system().lane_vehicles(second_edge->lanes[0]);
+	EXPECT_TRUE(std::ranges::find(first_vehicles, &getVehicle()) == first_vehicles.end());
+	EXPECT_TRUE(std::ranges::find(second_vehicles, &getVehicle()) != second_vehicles.end());
 }
 
 // Need to make population by demand
@@ -231,24 +227,27 @@ TEST_F(VehicleMovementModuleTest, DISABLED_VehiclesRemainSortedAfterUpdate) {
 	auto& edge = way->edges[0];
 	auto& lane = edge->lanes[0];
 
-	agent.vehicle->current_lane = &lane;
-	agent.vehicle->coordinates = lane.centerLine.front();
-	agent.vehicle->s_on_lane = 20.0;
-	agent.vehicle->state = 0; //VehicleState::Moving;
+	getVehicle().current_lane = &lane;
+	getVehicle().coordinates() = lane.centerLine.front();
+	getVehicle().s_on_lane() = 20.0;
+	getVehicle().state() = 0; //VehicleState::Moving;
 	agent.currentGoal = lane.parent->end_node;
 
 	Vehicle other {};
-	other.uid = 2;
+	system->vehicle_system().store().acquire(other);
+	other.uid() = 2;
 	other.current_lane = &lane;
-	other.s_on_lane = 10.0;
-	other.coordinates = lane.centerLine.front();
+	other.s_on_lane() = 10.0;
+	other.coordinates() = lane.centerLine.front();
 
-	lane.vehicles.push_back(agent.vehicle);
-	lane.vehicles.push_back(&other); // intentionally unsorted
+	auto& rt = system->vehicle_system().lane_runtime(lane);
+	rt.idx.push_back(&getVehicle());
+	rt.idx.push_back(&other); // intentionally unsorted
 
 	system->timeModule().update(1.0);
 	system->vehicleMovementModule().update();
 
-	ASSERT_EQ(lane.vehicles.size(), 2u);
-	EXPECT_LE(lane.vehicles[0]->s_on_lane, lane.vehicles[1]->s_on_lane);
+	const auto& vehicles = system->vehicle_system().lane_vehicles(lane);
+	ASSERT_EQ(vehicles.size(), 2u);
+	EXPECT_LE(vehicles[0]->s_on_lane(), vehicles[1]->s_on_lane());
 }
@@ -0,0 +1,230 @@
+#include "stdafx.h"
+
+#include "headless_runner.h"
+
+#include <core/data_layer/world_data.h>
+#include <core/data_layer/world_creator.h>
+#include <core/events/map_loading_events.h>
+#include <core/store_models/idata_model.h>
+#include <core/store_models/vehicle_analyze_data.h>
+#include <core/simulation/simulation_system.h>
+#include <core/simulation/time_module.h>
+
+namespace tjs::headless {
+	namespace {
+		using Clock = std::chrono::steady_clock;
+
+		double seconds_since(Clock::time_point start) {
+			return std::chrono::duration<double>(Clock::now() - start).count();
+		}
+
+		void print_usage(const char* exe) {
+			std::cerr
+				<< "Usage: " << exe << " --map <file.osmx> [options]\n"
+				<< "  --settings <file.json>  SimulationSettings (or the app settings.json)\n"
+				<< "  --steps <N>             simulation steps to run (default 1000)\n"
+				<< "  --vehicles <N>          override vehiclesCount\n"
+				<< "  --threads <N>           override simulation_threads (0 = all cores)\n"
+				<< "  --planner-threads <N>   override route_planner_threads (0 = search on the simulation thread)\n"
+				<< "  --seed <N>              fixed random seed\n"
+				<< "  --map-cache <0|1>       use the binary map cache next to the map (default 0)\n"
+				<< "  --car-ways-only <0|1>   load only ways cars can drive on (default 0)\n"
+				<< "  --output <file.json>    write report to file instead of stdout\n";
+		}
+
+		// One line per loading stage on stderr, the report stays alone on stdout
+		void print_load_progress(const core::events::MapLoadProgress& event) {
+			static constexpr std::array<const char*, static_cast<size_t>(core::events::MapLoadStage::Count)> NAMES = {
+				"reading cache", "reading ways", "reading nodes", "building road network", "writing cache", "finished"
+			};
+			static core::events::MapLoadStage last_stage = core::events::MapLoadStage::Count;
+			if (event.stage == last_stage) {
+				return;
+			}
+			last_stage = event.stage;
+			std::cerr << "[load] " << NAMES[static_cast<size_t>(event.stage)];
+			if (event.stage == core::events::MapLoadStage::Finished) {
+				std::cerr << ": " << event.nodes << " nodes, " << event.ways << " ways";
+			}
+			std::cerr << "\n";
+		}
+
+		template<typename T>
+		bool parse_number(std::string_view text, T& value) {
+			try {
+				size_t pos = 0;
+				const auto parsed = std::stoll(std::string(text), &pos);
+				if (pos != text.size() || parsed < 0) {
+					return false;
+				}
+				value = static_cast<T>(parsed);
+				return true;
+			} catch (...) {
+				return false;
+			}
+		}
+	} // namespace
+
+	std::optional<RunOptions> parse_options(int argc, char* argv[]) {
+		RunOptions options;
+		for (int i = 1; i < argc; ++i) {
+			const std::string_view arg = argv[i];
+			if (arg == "--help" || arg == "-h") {
+				print_usage(argv[0]);
+				return {};
+			}
+
+			if (i + 1 >= argc) {
+				std::cerr << "Missing value for " << arg << "\n";
+				print_usage(argv[0]);
+				return {};
+			}
+			const std::string_view value = argv[++i];
+
+			bool ok = true;
+			if (arg == "--map") {
+				options.map_file = value;
+			} else if (arg == "--settings") {
+				options.settings_file = value;
+			} else if (arg == "--output") {
+				options.output_file = value;
+			} else if (arg == "--steps") {
+				ok = parse_number(value, options.steps);
+			} else if (arg == "--vehicles") {
+				ok = parse_number(value, options.vehicles.emplace());
+			} else if (arg == "--threads") {
+				ok = parse_number(value, options.threads.emplace());
+			} else if (arg == "--planner-threads") {
+				ok = parse_number(value, options.planner_threads.emplace());
+			} else if (arg == "--seed") {
+				ok = parse_number(value, options.seed.emplace());
+			} else if (arg == "--map-cache") {
+				ok = value == "0" || value == "1";
+				options.map_cache = value == "1";
+			} else if (arg == "--car-ways-only") {
+				ok = value == "0" || value == "1";
+				options.car_ways_only = value == "1";
+			} else {
+				std::cerr << "Unknown option " << arg << "\n";
+				print_usage(argv[0]);
+				return {};
+			}
+
+			if (!ok) {
+				std::cerr << "Invalid value '" << value << "' for " << arg << "\n";
+				print_usage(argv[0]);
+				return {};
+			}
+		}
+
+		if (options.map_file.empty()) {
+			print_usage(argv[0]);
+			return {};
+		}
+		return options;
+	}
+
+	bool load_settings(const std::string& file, core::SimulationSettings& settings) {
+		std::ifstream stream(file);
+		if (!stream) {
+			std::cerr << "Cannot open settings " << file << "\n";
+			return false;
+		}
+
+		try {
+			const auto json = nlohmann::json::parse(stream);
+			const auto& node = json.contains(core::SimulationSettings::NAME) ? json.at(core::SimulationSettings::NAME) : json;
+			settings = node.get<core::SimulationSettings>();
+		} catch (const std::exception& e) {
+			std::cerr << "Invalid settings " << file << ": " << e.what() << "\n";
+			return false;
+		}
+		return true;
+	}
+
+	std::optional<RunReport> run(const RunOptions& options) {
+		core::SimulationSettings settings;
+		if (!options.settings_file.empty() && !load_settings(options.settings_file, settings)) {
+			return {};
+		}
+
+		if (options.vehicles) {
+			settings.vehiclesCount = *options.vehicles;
+		}
+		if (options.threads) {
+			settings.simulation_threads = *options.threads;
+		}
+		if (options.planner_threads) {
+			settings.route_planner_threads = *options.planner_threads;
+		}
+		if (options.seed) {
+			settings.randomSeed = false;
+			settings.seedValue = *options.seed;
+		}
+
+		RunReport report;
+		report.map_file = options.map_file;
+
+		common::MessageDispatcher dispatcher;
+		dispatcher.register_handler(&print_load_progress, "headless", "world_creator");
+
+		core::MapLoadOptions load_options;
+		load_options.use_cache = options.map_cache;
+		load_options.car_ways_only = options.car_ways_only;
+		load_options.dispatcher = &dispatcher;
+
+		core::WorldData world;
+		auto start = Clock::now();
+		if (!core::WorldCreator::loadOSMData(world, options.map_file, load_options)) {
+			std::cerr << "Cannot load map " << options.map_file << "\n";
+			return {};
+		}
+		report.load_time_sec = seconds_since(start);
+
+		core::model::DataModelStore store;
+		store.create<core::model::VehicleAnalyzeData>();
+
+		start = Clock::now();
+		core::simulation::TrafficSimulationSystem system(world, store, settings);
+		system.initialize();
+		report.init_time_sec = seconds_since(start);
+		report.threads = system.worker_pool().size();
+
+		start = Clock::now();
+		for (size_t i = 0; i < options.steps; ++i) {
+			system.step();
+			report.vehicle_updates += system.vehicle_system().vehicles().size();
+		}
+		report.run_time_sec = seconds_since(start);
+
+		report.steps = options.steps;
+		const auto& time = system.timeModule().state();
+		report.simulated_time_sec = core::SimDuration(time.current_time() - time.start_time()).count();
+		report.vehicles_final = system.vehicle_system().vehicles().size();
+		const auto& route_stats = system.tacticalModule().route_cache().stats();
+		report.route_cache_hits = route_stats.hits;
+		report.route_cache_misses = route_stats.misses;
+
+		system.release();
+		return report;
+	}
+
+	nlohmann::json to_json(const RunReport& report) {
+		return nlohmann::json {
+			{ "map", report.map_file },
+			{ "steps", report.steps },
+			{ "threads", report.threads },
+			{ "vehicles_final", report.vehicles_final },
+			{ "vehicle_updates", report.vehicle_updates },
+			{ "load_time_sec", report.load_time_sec },
+			{ "init_time_sec", report.init_time_sec },
+			{ "run_time_sec", report.run_time_sec },
+			{ "simulated_time_sec", report.simulated_time_sec },
+			{ "route_cache_hits", report.route_cache_hits },
+			{ "route_cache_misses", report.route_cache_misses },
+			{ "steps_per_sec", report.steps_per_sec() },
+			{ "vehicle_updates_per_sec", report.vehicle_updates_per_sec() }
+		};
+	}
+
+} // namespace tjs::headless
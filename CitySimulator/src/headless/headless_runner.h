@@ -0,0 +1,56 @@
+#pragma once
+
+#include <core/simulation/simulation_settings.h>
+
+namespace tjs::headless {
+	struct RunOptions {
+		std::string map_file;
+		std::string settings_file; // optional, defaults of SimulationSettings otherwise
+		std::string output_file;   // optional, report goes to stdout otherwise
+		size_t steps = 1000;
+		bool map_cache = false;     // read/write <map>.tjcache
+		bool car_ways_only = false; // skip ways cars cannot use while loading
+
+		// overrides on top of the settings file
+		std::optional<size_t> vehicles;
+		std::optional<size_t> threads;
+		std::optional<size_t> planner_threads;
+		std::optional<int> seed;
+	};
+
+	struct RunReport {
+		std::string map_file;
+		size_t steps = 0;
+		size_t threads = 0;
+		size_t vehicles_final = 0;
+		uint64_t vehicle_updates = 0; // sum of live vehicles over all steps
+
+		double load_time_sec = 0.0;
+		double init_time_sec = 0.0;
+		double run_time_sec = 0.0;
+		double simulated_time_sec = 0.0;
+
+		size_t route_cache_hits = 0;
+		size_t route_cache_misses = 0;
+
+		double steps_per_sec() const {
+			return run_time_sec > 0.0 ? steps / run_time_sec : 0.0;
+		}
+		double vehicle_updates_per_sec() const {
+			return run_time_sec > 0.0 ? vehicle_updates / run_time_sec : 0.0;
+		}
+	};
+
+	// Parses command line, returns nullopt and prints usage on error
+	std::optional<RunOptions> parse_options(int argc, char* argv[]);
+
+	// Accepts both a bare SimulationSettings object and the application's
+	// settings.json where it is stored under SimulationSettings::NAME.
+	bool load_settings(const std::string& file, core::SimulationSettings& settings);
+
+	// Loads the map and runs `options.steps` simulation steps back to back, without frame pacing
+	std::optional<RunReport> run(const RunOptions& options);
+
+	nlohmann::json to_json(const RunReport& report);
+
+} // namespace tjs::headless
@@ -0,0 +1,33 @@
+#include "stdafx.h"
+
+#include "headless_runner.h"
+
+int main(int argc, char* argv[]) {
+	auto options = tjs::headless::parse_options(argc, argv);
+	if (!options) {
+		return 2;
+	}
+
+	auto report = tjs::headless::run(*options);
+	if (!report) {
+		return 1;
+	}
+
+	const std::string json = tjs::headless::to_json(*report).dump(4);
+	if (options->output_file.empty()) {
+		std::cout << json << std::endl;
+		return 0;
+	}
+
+	std::ofstream out(options->output_file);
+	if (!out) {
+		std::cerr << "Cannot write report to " << options->output_file << "\n";
+		return 1;
+	}
+	out << json << std::endl;
+
+	std::cerr << report->steps << " steps in " << report->run_time_sec << " s: "
+			  << report->steps_per_sec() << " steps/s, "
+			  << report->vehicle_updates_per_sec() << " vehicle-updates/s\n";
+	return 0;
+}
@@ -0,0 +1,15 @@
+#pragma once
+
+#include <memory>
+#include <vector>
+#include <string>
+#include <string_view>
+#include <optional>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <chrono>
+
+#include <nlohmann/json.hpp>
+
+#include <core/core_includes.h>